@@ -0,0 +1,48 @@
+#include "NullAudioSink.h"
+#include "SfxMixer.h"
+
+#include <chrono>
+
+NullAudioSink::NullAudioSink(SfxMixer& mixer, int periodFrames)
+    : mixer(mixer), periodFrames(periodFrames > 0 ? periodFrames : 256) {
+    buffer.resize((size_t)this->periodFrames * SfxMixer::kChannels);
+}
+
+NullAudioSink::~NullAudioSink() {
+    stop();
+}
+
+void NullAudioSink::start() {
+    if (running.exchange(true)) return;
+    thread = std::thread(&NullAudioSink::run, this);
+}
+
+void NullAudioSink::stop() {
+    if (!running.exchange(false)) return;
+    if (thread.joinable()) thread.join();
+}
+
+void NullAudioSink::run() {
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::nanoseconds((int64_t)periodFrames * 1000000000LL / mixer.getSampleRate());
+    Clock::time_point next = Clock::now();
+
+    while (running.load(std::memory_order_relaxed)) {
+        Clock::time_point begin = Clock::now();
+        mixer.render(buffer.data(), periodFrames);
+        uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin).count();
+
+        periods.fetch_add(1, std::memory_order_relaxed);
+        renderTotalNs.fetch_add(ns, std::memory_order_relaxed);
+        if (ns > renderMaxNs.load(std::memory_order_relaxed)) renderMaxNs.store(ns, std::memory_order_relaxed);
+
+        next += period;
+        Clock::time_point now = Clock::now();
+        if (now > next) {
+            // 落后超过一个周期就不再追赶，和声卡欠载后的行为一致
+            latePeriods.fetch_add(1, std::memory_order_relaxed);
+            if (now - next > period) next = now;
+        }
+        std::this_thread::sleep_until(next);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef NULL_AUDIO_SINK_H
+#define NULL_AUDIO_SINK_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+class SfxMixer;
+
+/**
+ * NullAudioSink - 无声输出（不依赖 Qt）
+ *
+ * 在自己的线程里按真实时间节奏每 periodFrames 帧调用一次 SfxMixer::render 并丢弃结果，
+ * 行为和声卡回调一致。没有音频设备的机器上 AudioEngine 用它代替 QAudioSink，
+ * bejeweled_audiobench 用它在无头环境下测量触发延迟和混音开销。
+ */
+class NullAudioSink {
+public:
+    NullAudioSink(SfxMixer& mixer, int periodFrames);
+    ~NullAudioSink();
+
+    void start();
+    void stop();
+    bool isRunning() const { return running.load(std::memory_order_relaxed); }
+    int getPeriodFrames() const { return periodFrames; }
+
+    uint64_t getPeriods() const { return periods.load(std::memory_order_relaxed); }
+    uint64_t getRenderMaxNs() const { return renderMaxNs.load(std::memory_order_relaxed); }
+    uint64_t getRenderTotalNs() const { return renderTotalNs.load(std::memory_order_relaxed); }
+    uint64_t getLatePeriods() const { return latePeriods.load(std::memory_order_relaxed); }  // 没赶上节拍的周期
+
+private:
+    void run();
+
+    SfxMixer& mixer;
+    int periodFrames;
+    std::vector<int16_t> buffer;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> periods{0};
+    std::atomic<uint64_t> renderMaxNs{0};
+    std::atomic<uint64_t> renderTotalNs{0};
+    std::atomic<uint64_t> latePeriods{0};
+};
+
+#endif // NULL_AUDIO_SINK_H
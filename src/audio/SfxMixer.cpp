@@ -0,0 +1,219 @@
+#include "SfxMixer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+SfxMixer::SfxMixer(int sampleRate)
+    : sampleRate(sampleRate) {
+}
+
+int64_t SfxMixer::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int SfxMixer::addSound(std::vector<int16_t> pcm, float volume, int maxPolyphony) {
+    Sound sound;
+    sound.frames = (int)(pcm.size() / kChannels);
+    sound.pcm = std::move(pcm);
+    sound.volume = volume;
+    sound.maxPolyphony = std::clamp(maxPolyphony, 1, kMaxVoices);
+    sounds.push_back(std::move(sound));
+    soundVolumes.push_back(volume);
+    return (int)sounds.size() - 1;
+}
+
+int SfxMixer::soundFrames(int sound) const {
+    if (sound < 0 || sound >= (int)sounds.size()) return 0;
+    return sounds[sound].frames;
+}
+
+// ==================== 命令队列（UI 线程） ====================
+
+bool SfxMixer::push(const Command& command) {
+    const uint32_t tail = queueTail.load(std::memory_order_relaxed);
+    const uint32_t head = queueHead.load(std::memory_order_acquire);
+    if (tail - head >= (uint32_t)kQueueCapacity) {
+        droppedCommands.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    queue[tail & (kQueueCapacity - 1)] = command;
+    queueTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool SfxMixer::play(int sound, float gain) {
+    if (sound < 0 || sound >= (int)sounds.size()) return false;
+    Command command;
+    command.type = CommandType::Play;
+    command.sound = sound;
+    command.value = gain;
+    command.enqueuedNs = nowNs();
+    return push(command);
+}
+
+bool SfxMixer::setSoundVolume(int sound, float volume) {
+    if (sound < 0 || sound >= (int)sounds.size()) return false;
+    Command command;
+    command.type = CommandType::SoundVolume;
+    command.sound = sound;
+    command.value = volume;
+    return push(command);
+}
+
+bool SfxMixer::setMasterVolume(float volume) {
+    Command command;
+    command.type = CommandType::MasterVolume;
+    command.value = volume;
+    return push(command);
+}
+
+bool SfxMixer::stopAll() {
+    Command command;
+    command.type = CommandType::StopAll;
+    return push(command);
+}
+
+// ==================== 音频线程 ====================
+
+void SfxMixer::drainCommands() {
+    const uint32_t tail = queueTail.load(std::memory_order_acquire);
+    uint32_t head = queueHead.load(std::memory_order_relaxed);
+    for (; head != tail; ++head) {
+        const Command& command = queue[head & (kQueueCapacity - 1)];
+        switch (command.type) {
+        case CommandType::Play:
+            startVoice(command);
+            break;
+        case CommandType::SoundVolume:
+            soundVolumes[command.sound] = command.value;
+            break;
+        case CommandType::MasterVolume:
+            masterVolume = command.value;
+            break;
+        case CommandType::StopAll:
+            for (int i = 0; i < kMaxVoices; ++i) {
+                if (voices[i].sound < 0) continue;
+                fading[i] = voices[i];
+                fading[i].fadeRemaining = kStealFadeFrames;
+                voices[i].sound = -1;
+            }
+            break;
+        }
+    }
+    queueHead.store(head, std::memory_order_release);
+}
+
+int SfxMixer::pickVoice(int sound) {
+    // 同一音效超出复音数：抢占它自己最早开始的声部
+    int sameCount = 0;
+    int oldestSame = -1;
+    int oldestAny = 0;
+    int freeSlot = -1;
+    for (int i = 0; i < kMaxVoices; ++i) {
+        const Voice& voice = voices[i];
+        if (voice.sound < 0) {
+            if (freeSlot < 0) freeSlot = i;
+            continue;
+        }
+        if (voice.serial < voices[oldestAny].serial || voices[oldestAny].sound < 0) oldestAny = i;
+        if (voice.sound == sound) {
+            ++sameCount;
+            if (oldestSame < 0 || voice.serial < voices[oldestSame].serial) oldestSame = i;
+        }
+    }
+    if (sameCount >= sounds[sound].maxPolyphony) return oldestSame;
+    if (freeSlot >= 0) return freeSlot;
+    return oldestAny;
+}
+
+void SfxMixer::startVoice(const Command& command) {
+    int slot = pickVoice(command.sound);
+    Voice& voice = voices[slot];
+    if (voice.sound >= 0) {
+        fading[slot] = voice;
+        fading[slot].fadeRemaining = kStealFadeFrames;
+        ++renderStats.stolen;
+    }
+    voice.sound = command.sound;
+    voice.position = 0;
+    voice.gain = command.value;
+    voice.fadeRemaining = 0;
+    voice.serial = nextSerial++;
+
+    uint64_t latency = (uint64_t)std::max<int64_t>(0, nowNs() - command.enqueuedNs);
+    ++renderStats.triggers;
+    renderStats.latencyTotalNs += latency;
+    renderStats.latencyMaxNs = std::max(renderStats.latencyMaxNs, latency);
+}
+
+void SfxMixer::render(int16_t* out, int frames) {
+    drainCommands();
+    int done = 0;
+    while (done < frames) {
+        int n = std::min(kChunkFrames, frames - done);
+        mixChunk(out + (size_t)done * kChannels, n);
+        done += n;
+    }
+    renderStats.renderedFrames += (uint64_t)frames;
+
+    int active = 0;
+    for (const Voice& voice : voices) {
+        if (voice.sound >= 0) ++active;
+    }
+    activeVoices.store(active, std::memory_order_relaxed);
+    statTriggers.store(renderStats.triggers, std::memory_order_relaxed);
+    statStolen.store(renderStats.stolen, std::memory_order_relaxed);
+    statLatencyMax.store(renderStats.latencyMaxNs, std::memory_order_relaxed);
+    statLatencyTotal.store(renderStats.latencyTotalNs, std::memory_order_relaxed);
+    statFrames.store(renderStats.renderedFrames, std::memory_order_relaxed);
+}
+
+void SfxMixer::mixChunk(int16_t* out, int frames) {
+    float* acc = accumulator.data();
+    std::fill(acc, acc + (size_t)frames * kChannels, 0.0f);
+
+    auto mixVoice = [&](Voice& voice, bool fadeOut) {
+        const Sound& sound = sounds[voice.sound];
+        const float gain = voice.gain * soundVolumes[voice.sound] * masterVolume * (1.0f / 32768.0f);
+        int n = std::min(frames, sound.frames - voice.position);
+        if (fadeOut) n = std::min(n, voice.fadeRemaining);
+        const int16_t* src = sound.pcm.data() + (size_t)voice.position * kChannels;
+        if (!fadeOut) {
+            for (int i = 0; i < n * kChannels; ++i) acc[i] += (float)src[i] * gain;
+        } else {
+            const float step = 1.0f / (float)kStealFadeFrames;
+            float ramp = (float)voice.fadeRemaining * step;
+            for (int f = 0; f < n; ++f, ramp -= step) {
+                acc[f * 2] += (float)src[f * 2] * gain * ramp;
+                acc[f * 2 + 1] += (float)src[f * 2 + 1] * gain * ramp;
+            }
+            voice.fadeRemaining -= n;
+        }
+        voice.position += n;
+        if (voice.position >= sound.frames || (fadeOut && voice.fadeRemaining <= 0)) voice.sound = -1;
+    };
+
+    for (int i = 0; i < kMaxVoices; ++i) {
+        if (voices[i].sound >= 0) mixVoice(voices[i], false);
+        if (fading[i].sound >= 0) mixVoice(fading[i], true);
+    }
+
+    for (int i = 0; i < frames * kChannels; ++i) {
+        float s = std::clamp(acc[i], -1.0f, 1.0f);
+        out[i] = (int16_t)std::lrint(s * 32767.0f);
+    }
+}
+
+SfxMixer::Stats SfxMixer::getStats() const {
+    Stats stats;
+    stats.triggers = statTriggers.load(std::memory_order_relaxed);
+    stats.dropped = droppedCommands.load(std::memory_order_relaxed);
+    stats.stolen = statStolen.load(std::memory_order_relaxed);
+    stats.latencyMaxNs = statLatencyMax.load(std::memory_order_relaxed);
+    stats.latencyTotalNs = statLatencyTotal.load(std::memory_order_relaxed);
+    stats.renderedFrames = statFrames.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,123 @@
+#ifndef SFX_MIXER_H
+#define SFX_MIXER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * SfxMixer - 音效软件混音器（不依赖 Qt）
+ *
+ * 所有音效在开始混音前解码成交错立体声 int16 PCM 注册进来，之后只读。
+ * UI 线程通过 play / setSoundVolume 等接口把命令写进单生产者单消费者的无锁环形队列，
+ * 音频线程在每次 render 开头取出命令，再把活跃声部叠加混成一块输出，全程不加锁、不分配内存。
+ *
+ * 声部数固定为 kMaxVoices。每个音效另有最大复音数，超出时抢占该音效最早开始的声部；
+ * 声部全满时抢占全局最早开始的声部。被抢占的声部在一个短淡出后停止，避免爆音。
+ *
+ * 线程约定：addSound 只能在音频线程开始 render 之前调用；命令接口只能由同一个线程调用。
+ */
+class SfxMixer {
+public:
+    static constexpr int kChannels = 2;
+    static constexpr int kMaxVoices = 24;
+    static constexpr int kQueueCapacity = 256;   // 必须是 2 的幂
+    static constexpr int kChunkFrames = 256;     // 内部混音块大小
+    static constexpr int kStealFadeFrames = 64;  // 被抢占声部的淡出长度
+
+    struct Stats {
+        uint64_t triggers = 0;         // 已开始播放的次数
+        uint64_t dropped = 0;          // 队列满被丢弃的命令
+        uint64_t stolen = 0;           // 抢占次数
+        uint64_t latencyMaxNs = 0;     // 命令入队到开始混音的最大延迟
+        uint64_t latencyTotalNs = 0;   // 同上累计，用于求平均
+        uint64_t renderedFrames = 0;
+    };
+
+    explicit SfxMixer(int sampleRate = 44100);
+
+    int getSampleRate() const { return sampleRate; }
+
+    // 注册一段交错立体声 PCM，返回音效编号。volume 为该音效的默认音量
+    int addSound(std::vector<int16_t> pcm, float volume = 1.0f, int maxPolyphony = 4);
+    int soundCount() const { return (int)sounds.size(); }
+    int soundFrames(int sound) const;
+
+    // ---- 命令接口（UI 线程）。队列满时丢弃并返回 false ----
+    bool play(int sound, float gain = 1.0f);
+    bool setSoundVolume(int sound, float volume);
+    bool setMasterVolume(float volume);
+    bool stopAll();
+
+    // ---- 音频线程 ----
+    // 处理队列中的命令后混出 frames 帧交错 int16
+    void render(int16_t* out, int frames);
+
+    // 任意线程读取；数值是音频线程最近一次 render 后的快照
+    Stats getStats() const;
+    int getActiveVoices() const { return activeVoices.load(std::memory_order_relaxed); }
+
+    // 单调时钟（纳秒），命令入队时打时间戳
+    static int64_t nowNs();
+
+private:
+    enum class CommandType : uint8_t { Play, SoundVolume, MasterVolume, StopAll };
+
+    struct Command {
+        CommandType type = CommandType::Play;
+        int sound = -1;
+        float value = 0.0f;
+        int64_t enqueuedNs = 0;
+    };
+
+    struct Sound {
+        std::vector<int16_t> pcm;
+        int frames = 0;
+        float volume = 1.0f;
+        int maxPolyphony = 4;
+    };
+
+    struct Voice {
+        int sound = -1;          // -1 表示空闲
+        int position = 0;        // 已播放的帧数
+        float gain = 1.0f;
+        int fadeRemaining = 0;   // > 0 表示正在淡出
+        uint64_t serial = 0;     // 开始顺序，越小越早
+    };
+
+    bool push(const Command& command);
+    void drainCommands();
+    void startVoice(const Command& command);
+    int pickVoice(int sound);
+    void mixChunk(int16_t* out, int frames);
+
+    int sampleRate;
+    std::vector<Sound> sounds;
+
+    // 无锁环形队列：tail 只由生产者写，head 只由音频线程写
+    std::array<Command, kQueueCapacity> queue;
+    std::atomic<uint32_t> queueHead{0};
+    std::atomic<uint32_t> queueTail{0};
+    std::atomic<uint64_t> droppedCommands{0};
+
+    // 以下只在音频线程访问
+    std::array<Voice, kMaxVoices> voices;
+    // 被抢占、正在淡出的旧声部，和新声部分开存放，抢占不会立刻截断
+    std::array<Voice, kMaxVoices> fading;
+    std::vector<float> soundVolumes;
+    float masterVolume = 1.0f;
+    uint64_t nextSerial = 1;
+    std::array<float, kChunkFrames * kChannels> accumulator{};
+    Stats renderStats;
+
+    // 给其他线程看的快照
+    std::atomic<uint64_t> statTriggers{0};
+    std::atomic<uint64_t> statStolen{0};
+    std::atomic<uint64_t> statLatencyMax{0};
+    std::atomic<uint64_t> statLatencyTotal{0};
+    std::atomic<uint64_t> statFrames{0};
+    std::atomic<int> activeVoices{0};
+};
+
+#endif // SFX_MIXER_H
@@ -0,0 +1,133 @@
+#include "WavReader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+constexpr uint16_t kFormatPcm = 1;
+constexpr uint16_t kFormatFloat = 3;
+constexpr uint16_t kFormatExtensible = 0xFFFE;
+
+uint16_t readU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+uint32_t readU32(const uint8_t* p) { return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24); }
+
+bool fail(std::string* error, const char* message) {
+    if (error) *error = message;
+    return false;
+}
+
+// 读取一个采样并归一化到 [-1, 1]
+float readSample(const uint8_t* p, uint16_t format, int bits) {
+    if (format == kFormatFloat) {
+        float value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+    switch (bits) {
+    case 8:
+        return ((float)p[0] - 128.0f) / 128.0f;
+    case 16:
+        return (float)(int16_t)readU16(p) / 32768.0f;
+    case 24: {
+        int32_t value = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 24) >> 8;
+        return (float)value / 8388608.0f;
+    }
+    default:
+        return (float)(int32_t)readU32(p) / 2147483648.0f;
+    }
+}
+
+int16_t toInt16(float value) {
+    return (int16_t)std::lrint(std::clamp(value, -1.0f, 1.0f) * 32767.0f);
+}
+
+} // namespace
+
+namespace WavReader {
+
+bool load(const std::string& path, int targetRate, std::vector<int16_t>& out, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return fail(error, "cannot open file");
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode(data.data(), data.size(), targetRate, out, error);
+}
+
+bool decode(const uint8_t* data, size_t size, int targetRate, std::vector<int16_t>& out, std::string* error) {
+    if (size < 12 || std::memcmp(data, "RIFF", 4) != 0 || std::memcmp(data + 8, "WAVE", 4) != 0) {
+        return fail(error, "not a RIFF/WAVE file");
+    }
+
+    uint16_t format = 0;
+    int channels = 0;
+    int rate = 0;
+    int bits = 0;
+    const uint8_t* samples = nullptr;
+    size_t sampleBytes = 0;
+
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint8_t* chunk = data + offset;
+        size_t chunkSize = readU32(chunk + 4);
+        size_t available = std::min(chunkSize, size - offset - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            format = readU16(chunk + 8);
+            channels = readU16(chunk + 10);
+            rate = (int)readU32(chunk + 12);
+            bits = readU16(chunk + 22);
+            if (format == kFormatExtensible && available >= 26) format = readU16(chunk + 32);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            samples = chunk + 8;
+            sampleBytes = available;  // 截断的文件按实际长度读取
+        }
+        offset += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (!samples || channels <= 0 || rate <= 0) return fail(error, "missing fmt or data chunk");
+    bool supported = (format == kFormatPcm && (bits == 8 || bits == 16 || bits == 24 || bits == 32))
+                     || (format == kFormatFloat && bits == 32);
+    if (!supported) return fail(error, "unsupported sample format");
+
+    const int frameBytes = channels * (bits / 8);
+    const size_t frames = sampleBytes / (size_t)frameBytes;
+    const int bytesPerSample = bits / 8;
+
+    auto frameAt = [&](size_t frame, float& left, float& right) {
+        const uint8_t* p = samples + frame * (size_t)frameBytes;
+        left = readSample(p, format, bits);
+        right = channels > 1 ? readSample(p + bytesPerSample, format, bits) : left;
+    };
+
+    out.clear();
+    if (targetRate <= 0 || targetRate == rate) {
+        out.resize(frames * 2);
+        for (size_t f = 0; f < frames; ++f) {
+            float left, right;
+            frameAt(f, left, right);
+            out[f * 2] = toInt16(left);
+            out[f * 2 + 1] = toInt16(right);
+        }
+        return true;
+    }
+
+    // 线性插值重采样
+    const double ratio = (double)rate / (double)targetRate;
+    const size_t outFrames = frames == 0 ? 0 : (size_t)((double)(frames - 1) / ratio) + 1;
+    out.resize(outFrames * 2);
+    for (size_t f = 0; f < outFrames; ++f) {
+        double position = (double)f * ratio;
+        size_t i = (size_t)position;
+        float t = (float)(position - (double)i);
+        float l0, r0, l1, r1;
+        frameAt(i, l0, r0);
+        frameAt(std::min(i + 1, frames - 1), l1, r1);
+        out[f * 2] = toInt16(l0 + (l1 - l0) * t);
+        out[f * 2 + 1] = toInt16(r0 + (r1 - r0) * t);
+    }
+    return true;
+}
+
+} // namespace WavReader
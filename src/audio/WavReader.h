@@ -0,0 +1,23 @@
+#ifndef WAV_READER_H
+#define WAV_READER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * WavReader - 把 WAV 文件解码成 SfxMixer 使用的交错立体声 int16 PCM（不依赖 Qt）
+ *
+ * 支持 8/16/24/32 位整数 PCM 和 32 位浮点，单声道复制到两个声道，多于两个声道只取前两个；
+ * 采样率和目标不一致时线性插值重采样。音效都很短，一次性读入内存即可。
+ */
+namespace WavReader {
+
+bool load(const std::string& path, int targetRate, std::vector<int16_t>& out, std::string* error = nullptr);
+
+// 已读入内存的 WAV 数据
+bool decode(const uint8_t* data, size_t size, int targetRate, std::vector<int16_t>& out, std::string* error = nullptr);
+
+} // namespace WavReader
+
+#endif // WAV_READER_H
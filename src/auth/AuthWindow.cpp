@@ -19,17 +19,104 @@
 #include <QFile>
 #include <QNetworkProxy>
 #include "../utils/ResourceUtils.h"
+#include "../utils/BootProfiler.h"
 #include <openssl/conf.h>
 #include <openssl/evp.h>
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/rsa.h>
 
-AuthWindow::AuthWindow(QWidget *parent) : QWidget(parent), socket(new QTcpSocket(this)) {
+namespace {
+
+// RSA-OAEP(SHA-256) 加密后转 Base64，失败抛出 std::runtime_error
+std::string rsaEncryptBase64(const std::string& plaintext, const std::string& publicKeyPem) {
+    BIO* bio = BIO_new_mem_buf(publicKeyPem.data(), (int)publicKeyPem.size());
+    if (!bio) throw std::runtime_error("加密初始化失败");
+    EVP_PKEY* pkey = PEM_read_bio_PUBKEY(bio, nullptr, nullptr, nullptr);
+    if (!pkey) {
+        BIO_free(bio);
+        BIO* bio2 = BIO_new_mem_buf(publicKeyPem.data(), (int)publicKeyPem.size());
+        if (!bio2) throw std::runtime_error("加密初始化失败");
+        RSA* rsa = PEM_read_bio_RSA_PUBKEY(bio2, nullptr, nullptr, nullptr);
+        BIO_free(bio2);
+        if (!rsa) throw std::runtime_error("公钥解析失败");
+        pkey = EVP_PKEY_new();
+        if (!pkey) {
+            RSA_free(rsa);
+            throw std::runtime_error("加密初始化失败");
+        }
+        if (EVP_PKEY_assign_RSA(pkey, rsa) != 1) {
+            RSA_free(rsa);
+            EVP_PKEY_free(pkey);
+            throw std::runtime_error("公钥解析失败");
+        }
+    }
+    EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new(pkey, nullptr);
+    if (!ctx) {
+        EVP_PKEY_free(pkey);
+        throw std::runtime_error("加密初始化失败");
+    }
+    if (EVP_PKEY_encrypt_init(ctx) <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        EVP_PKEY_free(pkey);
+        throw std::runtime_error("加密初始化失败");
+    }
+    if (EVP_PKEY_CTX_set_rsa_padding(ctx, RSA_PKCS1_OAEP_PADDING) <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        EVP_PKEY_free(pkey);
+        throw std::runtime_error("加密初始化失败");
+    }
+    if (EVP_PKEY_CTX_set_rsa_oaep_md(ctx, EVP_sha256()) <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        EVP_PKEY_free(pkey);
+        throw std::runtime_error("加密初始化失败");
+    }
+    if (EVP_PKEY_CTX_set_rsa_mgf1_md(ctx, EVP_sha256()) <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        EVP_PKEY_free(pkey);
+        throw std::runtime_error("加密初始化失败");
+    }
+    size_t outlen = 0;
+    if (EVP_PKEY_encrypt(ctx, nullptr, &outlen, reinterpret_cast<const unsigned char*>(plaintext.data()), plaintext.size()) <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        EVP_PKEY_free(pkey);
+        throw std::runtime_error("加密失败");
+    }
+    std::string out;
+    out.resize(outlen);
+    if (EVP_PKEY_encrypt(ctx, reinterpret_cast<unsigned char*>(&out[0]), &outlen, reinterpret_cast<const unsigned char*>(plaintext.data()), plaintext.size()) <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        EVP_PKEY_free(pkey);
+        throw std::runtime_error("加密失败");
+    }
+    out.resize(outlen);
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(pkey);
+    QByteArray b = QByteArray::fromRawData(out.data(), (int)out.size());
+    return b.toBase64().toStdString();
+}
+
+// 各请求阶段在启动耗时 trace 里的区间名（下标同 AuthWindow::AuthStage）
+const char* stageSpanName(int stage) {
+    switch (stage) {
+        case 1: return "AuthWindow::request/connect";
+        case 2: return "AuthWindow::request/keyRequest";
+        case 3: return "AuthWindow::request/send";
+        case 4: return "AuthWindow::request/response";
+        default: return "AuthWindow::request";
+    }
+}
+
+} // namespace
+
+AuthWindow::AuthWindow(QWidget *parent) : QWidget(parent), socket(new QTcpSocket(this)), stageTimer(new QTimer(this)) {
+    PROFILE_SCOPE("AuthWindow::ctor");
     resize(1600, 1000);
     setWindowTitle("登录注册");
 
     // Load background image
+    BootProfiler& profiler = BootProfiler::instance();
+    int64_t bgStart = profiler.nowUs();
     QString bgPath = QString::fromStdString(ResourceUtils::getPath("images/auth_bg.png"));
     std::cout << "[AuthWindow] Attempting to load background from: " << bgPath.toStdString() << std::endl;
     
@@ -55,6 +142,7 @@ AuthWindow::AuthWindow(QWidget *parent) : QWidget(parent), socket(new QTcpSocket
     } else {
         std::cout << "[AuthWindow] Successfully loaded background image." << std::endl;
     }
+    profiler.addSpan("AuthWindow::ctor/loadBackground", bgStart, profiler.nowUs() - bgStart);
 
     // 初始化子界面
     loginWidget = new LoginWidget(this);
@@ -75,39 +163,43 @@ AuthWindow::AuthWindow(QWidget *parent) : QWidget(parent), socket(new QTcpSocket
         switchWidget(loginWidget);
     });
 
+    // 请求状态机：socket 信号推进阶段，stageTimer 负责单阶段超时
+    stageTimer->setSingleShot(true);
+    connect(stageTimer, &QTimer::timeout, this, &AuthWindow::onStageTimeout);
+    connect(socket, &QTcpSocket::connected, this, &AuthWindow::onSocketConnected);
+    connect(socket, &QTcpSocket::bytesWritten, this, &AuthWindow::onSocketBytesWritten);
+    connect(socket, &QTcpSocket::readyRead, this, &AuthWindow::onSocketReadyRead);
+    connect(socket, &QAbstractSocket::errorOccurred, this, &AuthWindow::onSocketError);
+    connect(loginWidget, &LoginWidget::cancelClicked, this, &AuthWindow::cancelRequest);
+    connect(registerWidget, &RegisterWidget::cancelClicked, this, &AuthWindow::cancelRequest);
+
     // 连接登录信号，处理登录数据
     connect(loginWidget, &LoginWidget::loginClicked, this,
             [=](const QString& id, const QString& password) {
-        const QString idCopy = id;
         AuthNetData authData;
         authData.setType(1);
         authData.setId(id.toStdString());
         authData.setPassword(password.toStdString());
-        
-        // 连接登录结果信号，处理登录结果
-        QMetaObject::Connection* conn = new QMetaObject::Connection;
-        *conn = 
-        connect(this, &AuthWindow::loginResult, this, [=](bool success, const QString& msg) {
-            if (success) {// 登录成功
-                GameWindow* mainUI = new GameWindow(nullptr, idCopy.toStdString());
-                mainUI->show();
-                
-                // Show TestWindow
-                // TestWindow* testWindow = new TestWindow();
-                // testWindow->show();
-
-                this->hide();
-            } else {// 登录失败弹窗
-                AuthNoticeDialog* dlg = new AuthNoticeDialog("登录失败", msg, 3, this);
-                dlg->exec();
-                delete dlg;
-            }
-            disconnect(*conn);
-            delete conn;
-        });
-
         handleLoginRequest(authData);
     });
+
+    // 登录结果：请求是异步的，结果信号只连接一次
+    connect(this, &AuthWindow::loginResult, this, [=](bool success, const QString& msg) {
+        if (success) {// 登录成功
+            GameWindow* mainUI = new GameWindow(nullptr, pendingData.getId());
+            mainUI->show();
+
+            // Show TestWindow
+            // TestWindow* testWindow = new TestWindow();
+            // testWindow->show();
+
+            this->hide();
+        } else {// 登录失败弹窗
+            AuthNoticeDialog* dlg = new AuthNoticeDialog("登录失败", msg, 3, this);
+            dlg->exec();
+            delete dlg;
+        }
+    });
     
     // 连接注册信号，处理注册数据
     connect(registerWidget, &RegisterWidget::registerClicked, this,
@@ -122,27 +214,24 @@ AuthWindow::AuthWindow(QWidget *parent) : QWidget(parent), socket(new QTcpSocket
         authData.setType(2);
         authData.setId(id.toStdString());
         authData.setPassword(password.toStdString());
-        
-        QMetaObject::Connection* conn = new QMetaObject::Connection;
-        *conn = connect(this, &AuthWindow::registerResult, this, [=](bool success, const QString& msg) {
-            if (success) {
-                AuthNoticeDialog* dlg = new AuthNoticeDialog("注册成功", msg, 1, this);
-                dlg->exec();
-                delete dlg;
-            } else {
-                AuthNoticeDialog* dlg = new AuthNoticeDialog("注册失败", msg, 3, this);
-                dlg->exec();
-                delete dlg;
-            }
-            disconnect(*conn);
-            delete conn;
-        });
-
         handleRegisterRequest(authData);
     });
 
+    connect(this, &AuthWindow::registerResult, this, [=](bool success, const QString& msg) {
+        if (success) {
+            AuthNoticeDialog* dlg = new AuthNoticeDialog("注册成功", msg, 1, this);
+            dlg->exec();
+            delete dlg;
+        } else {
+            AuthNoticeDialog* dlg = new AuthNoticeDialog("注册失败", msg, 3, this);
+            dlg->exec();
+            delete dlg;
+        }
+    });
+
     // 离线登录处理
     connect(loginWidget, &LoginWidget::oflLoginClicked, this, [=]() {
+        cancelRequest();
         GameWindow* mainUI = new GameWindow(nullptr, "$#SINGLE#$");
         mainUI->show();
         
@@ -155,14 +244,14 @@ AuthWindow::AuthWindow(QWidget *parent) : QWidget(parent), socket(new QTcpSocket
 }
 
 AuthWindow::~AuthWindow() {
-    if (socket->isOpen()) {
-        socket->disconnectFromHost();
-        socket->waitForDisconnected(1000);
-    }
+    // 不再等待断开，直接关闭连接
+    stageTimer->stop();
+    socket->abort();
 }
 
-// 切换界面实现
+// 切换界面实现（进行中的请求随之取消）
 void AuthWindow::switchWidget(QWidget* widget) {
+    cancelRequest();
     loginWidget->hide();
     registerWidget->hide();
     if (widget) {
@@ -215,21 +304,7 @@ void AuthWindow::handleLoginRequest(AuthNetData& data) {
         emit loginResult(false, "账号密码格式错误（账号6-20位字母数字，密码8-20位含字母和数字）");
         return;
     }
-
-    try {
-        netDataSender(data);
-        AuthNetData response_data = AuthDataReceiver();
-
-        if (response_data.getData() == "LOGIN_SUCCESS") {
-            emit loginResult(true, "登录成功");
-        } else if (response_data.getData() == "LOGIN_FAIL") {
-            emit loginResult(false, "账号或密码错误");
-        } else {
-            emit loginResult(false, "未知登录错误");
-        }
-    } catch (const std::exception& e) {
-        emit loginResult(false, QString("登录异常: ") + e.what());
-    }
+    startRequest(data);
 }
 
 // 处理注册请求
@@ -237,166 +312,223 @@ void AuthWindow::handleRegisterRequest(AuthNetData& data) {
     if (!validate(data)) {
         emit registerResult(false, "注册信息格式错误（检查账号、密码、邮箱及验证码）");
         return;
-    } 
-    
-    try {
-        netDataSender(data);
-        AuthNetData response_data = AuthDataReceiver();
-        std::string res = response_data.getData();
-
-        if (res == "REGISTER_SUCCESS") {
-            emit registerResult(true, "注册成功");
-        } else if (res == "REGISTER_FAIL_EMAILCODE") {
-            emit registerResult(false, "邮箱验证码错误");
-        } else if (res == "REGISTER_FAIL_ACCOUNT") {
-            emit registerResult(false, "账号已存在");
-        } else if (res == "REGISTER_FAIL_EMAIL") {
-            emit registerResult(false, "邮箱已存在");
-        } else if (res == "REGISTER_FAIL_UNKNOWN") {
-            emit registerResult(false, "注册失败：服务器内部错误");
-        } else {
-            emit registerResult(false, "注册失败：" + QString::fromStdString(res));
-        }
-    } catch (const std::exception& e) {
-        emit registerResult(false, QString("注册异常: ") + e.what());
     }
+    startRequest(data);
 }
 
+// 开始一次请求：连接 → 获取公钥 → 发送密文 → 等待结果
+void AuthWindow::startRequest(const AuthNetData& data) {
+    if (stage != AuthStage::Idle) return;
+    pendingData = data;
+    receiveBuffer.clear();
+    pendingWriteBytes = 0;
 
-
-// 网络发送封装
-void AuthWindow::netDataSender(AuthNetData data) {
-    auto rsaEncryptBase64 = [](const std::string& plaintext, const std::string& publicKeyPem) -> std::string {
-        BIO* bio = BIO_new_mem_buf(publicKeyPem.data(), (int)publicKeyPem.size());
-        if (!bio) throw std::runtime_error("加密初始化失败");
-        EVP_PKEY* pkey = PEM_read_bio_PUBKEY(bio, nullptr, nullptr, nullptr);
-        if (!pkey) {
-            BIO_free(bio);
-            BIO* bio2 = BIO_new_mem_buf(publicKeyPem.data(), (int)publicKeyPem.size());
-            if (!bio2) throw std::runtime_error("加密初始化失败");
-            RSA* rsa = PEM_read_bio_RSA_PUBKEY(bio2, nullptr, nullptr, nullptr);
-            BIO_free(bio2);
-            if (!rsa) throw std::runtime_error("公钥解析失败");
-            pkey = EVP_PKEY_new();
-            if (!pkey) {
-                RSA_free(rsa);
-                throw std::runtime_error("加密初始化失败");
-            }
-            if (EVP_PKEY_assign_RSA(pkey, rsa) != 1) {
-                RSA_free(rsa);
-                EVP_PKEY_free(pkey);
-                throw std::runtime_error("公钥解析失败");
-            }
-        }
-        EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new(pkey, nullptr);
-        if (!ctx) {
-            EVP_PKEY_free(pkey);
-            throw std::runtime_error("加密初始化失败");
-        }
-        if (EVP_PKEY_encrypt_init(ctx) <= 0) {
-            EVP_PKEY_CTX_free(ctx);
-            EVP_PKEY_free(pkey);
-            throw std::runtime_error("加密初始化失败");
-        }
-        if (EVP_PKEY_CTX_set_rsa_padding(ctx, RSA_PKCS1_OAEP_PADDING) <= 0) {
-            EVP_PKEY_CTX_free(ctx);
-            EVP_PKEY_free(pkey);
-            throw std::runtime_error("加密初始化失败");
-        }
-        if (EVP_PKEY_CTX_set_rsa_oaep_md(ctx, EVP_sha256()) <= 0) {
-            EVP_PKEY_CTX_free(ctx);
-            EVP_PKEY_free(pkey);
-            throw std::runtime_error("加密初始化失败");
-        }
-        if (EVP_PKEY_CTX_set_rsa_mgf1_md(ctx, EVP_sha256()) <= 0) {
-            EVP_PKEY_CTX_free(ctx);
-            EVP_PKEY_free(pkey);
-            throw std::runtime_error("加密初始化失败");
-        }
-        size_t outlen = 0;
-        if (EVP_PKEY_encrypt(ctx, nullptr, &outlen, reinterpret_cast<const unsigned char*>(plaintext.data()), plaintext.size()) <= 0) {
-            EVP_PKEY_CTX_free(ctx);
-            EVP_PKEY_free(pkey);
-            throw std::runtime_error("加密失败");
-        }
-        std::string out;
-        out.resize(outlen);
-        if (EVP_PKEY_encrypt(ctx, reinterpret_cast<unsigned char*>(&out[0]), &outlen, reinterpret_cast<const unsigned char*>(plaintext.data()), plaintext.size()) <= 0) {
-            EVP_PKEY_CTX_free(ctx);
-            EVP_PKEY_free(pkey);
-            throw std::runtime_error("加密失败");
-        }
-        out.resize(outlen);
-        EVP_PKEY_CTX_free(ctx);
-        EVP_PKEY_free(pkey);
-        QByteArray b = QByteArray::fromRawData(out.data(), (int)out.size());
-        return b.toBase64().toStdString();
-    };
-    if (socket->state() == QAbstractSocket::ConnectedState) {
-        socket->disconnectFromHost();
-    }
-    
-    // 强制禁用代理并绑定 IPv6
+    socket->abort();
+    // 强制禁用代理
     socket->setProxy(QNetworkProxy::NoProxy);
-    
+
     // 尝试显式绑定到 IPv4
     if (!socket->bind(QHostAddress::AnyIPv4)) {
         std::cerr << "[AuthWindow] Warning: Failed to bind to AnyIPv4: " << socket->errorString().toStdString() << std::endl;
     }
 
     std::cout << "[AuthWindow] Connecting to server..." << std::endl;
-    std::cout << "[AuthWindow] Proxy type: " << socket->proxy().type() << " (0=NoProxy)" << std::endl;
-
+    enterStage(AuthStage::Connecting, kConnectTimeoutMs);
     socket->connectToHost(QHostAddress(QString::fromStdString(Config::getServerIp())), Config::getAuthPort());
-    if (!socket->waitForConnected(3000)) {
-        std::string errorDetails = socket->errorString().toStdString();
-        std::cerr << "[AuthWindow] Connection failed. Error: " << socket->error() << ", Msg: " << errorDetails << std::endl;
-        throw std::runtime_error("无法连接到服务器: " + errorDetails + " (Error Code: " + std::to_string(socket->error()) + ")");
+}
+
+// 用户取消：不弹结果提示，直接恢复表单
+void AuthWindow::cancelRequest() {
+    if (stage == AuthStage::Idle) return;
+    std::cout << "[AuthWindow] Request cancelled" << std::endl;
+    endRequest();
+}
+
+void AuthWindow::enterStage(AuthStage next, int timeoutMs) {
+    BootProfiler& profiler = BootProfiler::instance();
+    if (stage != AuthStage::Idle) {
+        profiler.addSpan(stageSpanName((int)stage), stageStartUs, profiler.nowUs() - stageStartUs);
     }
+    stage = next;
+    stageStartUs = profiler.nowUs();
+    stageTimer->start(timeoutMs);
+    updateProgress();
+}
+
+void AuthWindow::sendPayload(const QByteArray& payload) {
+    pendingWriteBytes += payload.size();
+    if (socket->write(payload) < 0) {
+        failRequest("发送数据失败: " + socket->errorString());
+    }
+}
+
+// 缓冲区里凑齐一个完整的 JSON 才返回 true；格式错误抛出 std::runtime_error
+bool AuthWindow::takeJsonMessage(AuthNetData& message) {
+    if (receiveBuffer.isEmpty()) return false;
+    std::string text = receiveBuffer.toStdString();
+    try {
+        nlohmann::json j = nlohmann::json::parse(text);
+        from_json(j, message);
+    } catch (const nlohmann::json::parse_error& e) {
+        // 出错位置在末尾之后说明数据还没收完
+        if (e.byte > text.size()) return false;
+        throw std::runtime_error(std::string("数据解析失败: ") + e.what());
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string("数据解析失败: ") + e.what());
+    }
+    receiveBuffer.clear();
+    return true;
+}
+
+void AuthWindow::onSocketConnected() {
+    if (stage != AuthStage::Connecting) return;
     std::cout << "[AuthWindow] Connected successfully!" << std::endl;
+
+    enterStage(AuthStage::FetchingKey, kKeyTimeoutMs);
     AuthNetData rsaAuthData;
     rsaAuthData.setType(0);
     rsaAuthData.setData("KEY_REQUEST");
     nlohmann::json j0 = rsaAuthData;
-    socket->write(QByteArray::fromStdString(j0.dump()));
-    if (!socket->waitForBytesWritten(3000)) {
-        throw std::runtime_error("发送数据超时");
+    sendPayload(QByteArray::fromStdString(j0.dump()));
+}
+
+void AuthWindow::onSocketBytesWritten(qint64 bytes) {
+    pendingWriteBytes -= bytes;
+    // 密文全部写出后才开始计算响应超时
+    if (stage == AuthStage::SendingCipher && pendingWriteBytes <= 0) {
+        enterStage(AuthStage::AwaitingResponse, kResponseTimeoutMs);
+    }
+}
+
+void AuthWindow::onSocketReadyRead() {
+    receiveBuffer += socket->readAll();
+    if (stage == AuthStage::Idle || stage == AuthStage::Connecting) {
+        receiveBuffer.clear();
+        return;
     }
-    if (!socket->waitForReadyRead(5000)) {
-        throw std::runtime_error("服务器响应超时");
+
+    try {
+        AuthNetData message;
+        if (!takeJsonMessage(message)) return;
+
+        if (stage == AuthStage::FetchingKey) {
+            if (message.getType() != 0) {
+                throw std::runtime_error("密钥响应类型错误");
+            }
+            BootProfiler& profiler = BootProfiler::instance();
+            int64_t encryptStart = profiler.nowUs();
+            nlohmann::json j = pendingData;
+            std::string cipher = rsaEncryptBase64(j.dump(), message.getData());
+            profiler.addSpan("AuthWindow::request/rsaEncrypt", encryptStart, profiler.nowUs() - encryptStart);
+
+            enterStage(AuthStage::SendingCipher, kSendTimeoutMs);
+            sendPayload(QByteArray::fromStdString(cipher));
+        } else {
+            // 发送阶段也可能先收到结果（bytesWritten 尚未派发）
+            finishRequest(message);
+        }
+    } catch (const std::exception& e) {
+        failRequest(QString::fromStdString(e.what()));
     }
-    QByteArray keyResp = socket->readAll();
-    nlohmann::json jk = nlohmann::json::parse(keyResp.toStdString());
-    AuthNetData keyResponse;
-    from_json(jk, keyResponse);
-    if (keyResponse.getType() != 0) {
-        throw std::runtime_error("密钥响应类型错误");
+}
+
+void AuthWindow::onSocketError(QAbstractSocket::SocketError error) {
+    if (stage == AuthStage::Idle) return;
+    std::string errorDetails = socket->errorString().toStdString();
+    std::cerr << "[AuthWindow] Socket error: " << error << ", Msg: " << errorDetails << std::endl;
+    if (stage == AuthStage::Connecting) {
+        failRequest(QString::fromStdString("无法连接到服务器: " + errorDetails + " (Error Code: " + std::to_string(error) + ")"));
+    } else {
+        failRequest(QString::fromStdString("连接中断: " + errorDetails));
     }
-    std::string publicKey = keyResponse.getData();
-    nlohmann::json j = data;
-    std::string cipher = rsaEncryptBase64(j.dump(), publicKey);
-    socket->write(QByteArray::fromStdString(cipher));
-    if (!socket->waitForBytesWritten(3000)) {
-        throw std::runtime_error("发送数据超时");
+}
+
+void AuthWindow::onStageTimeout() {
+    switch (stage) {
+        case AuthStage::Connecting: failRequest("连接服务器超时"); break;
+        case AuthStage::FetchingKey: failRequest("获取密钥超时"); break;
+        case AuthStage::SendingCipher: failRequest("发送数据超时"); break;
+        case AuthStage::AwaitingResponse: failRequest("服务器响应超时"); break;
+        case AuthStage::Idle: break;
     }
 }
 
-// 网络接收封装
-AuthNetData AuthWindow::AuthDataReceiver() {
-    if (!socket->waitForReadyRead(5000)) {
-        throw std::runtime_error("服务器响应超时");
+void AuthWindow::finishRequest(const AuthNetData& response) {
+    AuthNetData responseData = response;
+    int type = pendingData.getType();
+    endRequest();
+
+    std::string res = responseData.getData();
+    if (type == 1) {
+        if (res == "LOGIN_SUCCESS") {
+            emit loginResult(true, "登录成功");
+        } else if (res == "LOGIN_FAIL") {
+            emit loginResult(false, "账号或密码错误");
+        } else {
+            emit loginResult(false, "未知登录错误");
+        }
+        return;
     }
 
-    QByteArray responseData = socket->readAll();
-    socket->disconnectFromHost();
-    
-    try {
-        std::string responseStr = responseData.toStdString();
-        nlohmann::json j = nlohmann::json::parse(responseStr);
-        AuthNetData response_data;
-        from_json(j, response_data);
-        return response_data;
-    } catch (const std::exception& e) {
-        throw std::runtime_error(std::string("数据解析失败: ") + e.what());
+    if (res == "REGISTER_SUCCESS") {
+        emit registerResult(true, "注册成功");
+    } else if (res == "REGISTER_FAIL_EMAILCODE") {
+        emit registerResult(false, "邮箱验证码错误");
+    } else if (res == "REGISTER_FAIL_ACCOUNT") {
+        emit registerResult(false, "账号已存在");
+    } else if (res == "REGISTER_FAIL_EMAIL") {
+        emit registerResult(false, "邮箱已存在");
+    } else if (res == "REGISTER_FAIL_UNKNOWN") {
+        emit registerResult(false, "注册失败：服务器内部错误");
+    } else {
+        emit registerResult(false, "注册失败：" + QString::fromStdString(res));
+    }
+}
+
+void AuthWindow::failRequest(const QString& reason) {
+    if (stage == AuthStage::Idle) return;
+    int type = pendingData.getType();
+    endRequest();
+    if (type == 1) {
+        emit loginResult(false, QString("登录异常: ") + reason);
+    } else {
+        emit registerResult(false, QString("注册异常: ") + reason);
+    }
+}
+
+// 结束当前请求（成功、失败或取消），恢复表单
+void AuthWindow::endRequest() {
+    if (stage != AuthStage::Idle) {
+        BootProfiler& profiler = BootProfiler::instance();
+        profiler.addSpan(stageSpanName((int)stage), stageStartUs, profiler.nowUs() - stageStartUs);
+    }
+    stage = AuthStage::Idle;
+    stageTimer->stop();
+    receiveBuffer.clear();
+    pendingWriteBytes = 0;
+    if (socket->state() == QAbstractSocket::ConnectedState) {
+        socket->disconnectFromHost();
+    } else {
+        socket->abort();
+    }
+    loginWidget->clearRequestProgress();
+    registerWidget->clearRequestProgress();
+}
+
+void AuthWindow::updateProgress() {
+    const int totalSteps = 4;
+    int step = 0;
+    QString status;
+    switch (stage) {
+        case AuthStage::Connecting: step = 1; status = "正在连接服务器…"; break;
+        case AuthStage::FetchingKey: step = 2; status = "正在获取加密公钥…"; break;
+        case AuthStage::SendingCipher: step = 3; status = "正在发送加密数据…"; break;
+        case AuthStage::AwaitingResponse: step = 4; status = "等待服务器响应…"; break;
+        case AuthStage::Idle: return;
+    }
+    if (pendingData.getType() == 1) {
+        loginWidget->setRequestProgress(step, totalSteps, status);
+    } else {
+        registerWidget->setRequestProgress(step, totalSteps, status);
     }
 }
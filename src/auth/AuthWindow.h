@@ -4,10 +4,20 @@
 #include <QWidget>
 #include <QTcpSocket>
 #include <QAbstractSocket>
+#include <QTimer>
 #include "authWidgets/LoginWidget.h"
 #include "authWidgets/RegisterWidget.h"
 #include "AuthNetData.h"
 
+/**
+ * AuthWindow - 登录注册窗口
+ *
+ * 登录/注册请求是一个由 QTcpSocket 信号驱动的状态机，全程不阻塞 UI 线程：
+ *   Connecting → FetchingKey（发送 KEY_REQUEST，等待公钥）→ SendingCipher（RSA 加密后发送）
+ *   → AwaitingResponse → Idle
+ * 每个阶段单独计时，超时或出错都结束请求并给出对应提示；请求期间表单显示进度面板，
+ * 可随时取消（切换界面、离线登录也会取消）。
+ */
 class AuthWindow : public QWidget {
     Q_OBJECT
 
@@ -27,18 +37,51 @@ signals:
     void registerResult(bool success, const QString& msg);
 
 private:
+    enum class AuthStage {
+        Idle,
+        Connecting,
+        FetchingKey,
+        SendingCipher,
+        AwaitingResponse
+    };
+
+    // 各阶段超时（毫秒），与原先阻塞等待的上限一致
+    static constexpr int kConnectTimeoutMs = 3000;
+    static constexpr int kKeyTimeoutMs = 5000;
+    static constexpr int kSendTimeoutMs = 3000;
+    static constexpr int kResponseTimeoutMs = 5000;
+
     LoginWidget* loginWidget;    // 登录界面
     RegisterWidget* registerWidget; // 注册界面
     QTcpSocket* socket; // 从AuthNetData迁移过来的socket
     QPixmap backgroundPixmap;
 
+    AuthStage stage = AuthStage::Idle;
+    AuthNetData pendingData;     // 当前请求（登录或注册）
+    QTimer* stageTimer;          // 当前阶段的超时
+    QByteArray receiveBuffer;    // 累积到完整 JSON 为止
+    qint64 pendingWriteBytes = 0;
+    int64_t stageStartUs = 0;
+
     bool validate(AuthNetData& data) const;
     void handleLoginRequest(AuthNetData& data);
     void handleRegisterRequest(AuthNetData& data);
-    
-    // 网络收发封装
-    void netDataSender(AuthNetData data);
-    AuthNetData AuthDataReceiver();
+
+    // 请求状态机
+    void startRequest(const AuthNetData& data);
+    void cancelRequest();
+    void enterStage(AuthStage next, int timeoutMs);
+    void sendPayload(const QByteArray& payload);
+    bool takeJsonMessage(AuthNetData& message);
+    void onSocketConnected();
+    void onSocketBytesWritten(qint64 bytes);
+    void onSocketReadyRead();
+    void onSocketError(QAbstractSocket::SocketError error);
+    void onStageTimeout();
+    void finishRequest(const AuthNetData& response);
+    void failRequest(const QString& reason);
+    void endRequest();
+    void updateProgress();
 
 };
 
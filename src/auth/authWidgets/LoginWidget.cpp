@@ -129,6 +129,9 @@ LoginWidget::LoginWidget(QWidget* parent) : QWidget(parent) {
         }
     )");
 
+    // 请求进度（登录进行中替换登录按钮）
+    progressPanel = new AuthProgressPanel(cardWidget);
+
     // 离线登录标签说明
     oflHintLabel = new QLabel("", cardWidget);
     oflHintLabel->setAlignment(Qt::AlignCenter);
@@ -222,6 +225,7 @@ LoginWidget::LoginWidget(QWidget* parent) : QWidget(parent) {
     
     // 登录按钮
     cardLayout->addWidget(loginBtn);
+    cardLayout->addWidget(progressPanel);
     cardLayout->addSpacing(10);  // 从12减小到10
     
     // 分隔线
@@ -256,5 +260,20 @@ LoginWidget::LoginWidget(QWidget* parent) : QWidget(parent) {
     connect(oflLoginBtn, &QPushButton::clicked, this, [=]() {
         emit oflLoginClicked();
     });
+    connect(progressPanel, &AuthProgressPanel::cancelClicked, this, &LoginWidget::cancelClicked);
+}
+
+void LoginWidget::setRequestProgress(int step, int totalSteps, const QString& status) {
+    loginBtn->hide();
+    idEdit->setEnabled(false);
+    passwordEdit->setEnabled(false);
+    progressPanel->setProgress(step, totalSteps, status);
+}
+
+void LoginWidget::clearRequestProgress() {
+    progressPanel->finish();
+    loginBtn->show();
+    idEdit->setEnabled(true);
+    passwordEdit->setEnabled(true);
 }
 
@@ -5,6 +5,7 @@
 #include <QLabel>
 #include "../components/AuthLineEdit.h"
 #include "../components/AuthButton.h"
+#include "../components/AuthProgressPanel.h"
 
 class LoginWidget : public QWidget {
     Q_OBJECT
@@ -15,15 +16,22 @@ signals:
     void loginClicked(const QString& id, const QString& password);
     //离线登录按钮点击信号 (直接进入游戏)
     void oflLoginClicked();
+    // 取消进行中的登录请求
+    void cancelClicked();
 public:
     explicit LoginWidget(QWidget* parent = nullptr);
 
+    // 登录请求进行中：用进度面板替换登录按钮，锁定输入框
+    void setRequestProgress(int step, int totalSteps, const QString& status);
+    void clearRequestProgress();
+
 private:
     AuthLineEdit* idEdit;      // 账号输入框
     AuthLineEdit* passwordEdit;// 密码输入框
     AuthButton* loginBtn;      // 登录按钮
     AuthButton* oflLoginBtn;   // 离线登录按钮
     AuthButton* toRegisterBtn; // 切换注册按钮
+    AuthProgressPanel* progressPanel; // 请求进度面板
 
     QLabel* idHintLabel;       // 账号提示标签
     QLabel* oflHintLabel;      // 离线登录提示标签
@@ -145,6 +145,9 @@ RegisterWidget::RegisterWidget(QWidget* parent) : QWidget(parent) {
         }
     )");
 
+    // 请求进度（注册进行中替换注册按钮）
+    progressPanel = new AuthProgressPanel(cardWidget);
+
     // 返回登录按钮
     toLoginBtn = new AuthButton("已有账号？点击登录 →", cardWidget);
     toLoginBtn->setMinimumHeight(45);
@@ -206,6 +209,7 @@ RegisterWidget::RegisterWidget(QWidget* parent) : QWidget(parent) {
     cardLayout->addWidget(separator);
     cardLayout->addSpacing(10);  // 从12减小到10
     cardLayout->addWidget(registerBtn);
+    cardLayout->addWidget(progressPanel);
     cardLayout->addSpacing(10);  // 从12减小到10
     cardLayout->addWidget(toLoginBtn);
     cardLayout->addSpacing(15);  // 从25减小到15
@@ -225,5 +229,22 @@ RegisterWidget::RegisterWidget(QWidget* parent) : QWidget(parent) {
         emit registerClicked(idEdit->text(), passwordEdit->text(),
                             confirmPwdEdit->text());
     });
+    connect(progressPanel, &AuthProgressPanel::cancelClicked, this, &RegisterWidget::cancelClicked);
+}
+
+void RegisterWidget::setRequestProgress(int step, int totalSteps, const QString& status) {
+    registerBtn->hide();
+    idEdit->setEnabled(false);
+    passwordEdit->setEnabled(false);
+    confirmPwdEdit->setEnabled(false);
+    progressPanel->setProgress(step, totalSteps, status);
+}
+
+void RegisterWidget::clearRequestProgress() {
+    progressPanel->finish();
+    registerBtn->show();
+    idEdit->setEnabled(true);
+    passwordEdit->setEnabled(true);
+    confirmPwdEdit->setEnabled(true);
 }
 
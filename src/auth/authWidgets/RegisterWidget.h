@@ -5,6 +5,7 @@
 #include <QLabel>
 #include "../components/AuthLineEdit.h"
 #include "../components/AuthButton.h"
+#include "../components/AuthProgressPanel.h"
 
 class RegisterWidget : public QWidget {
     Q_OBJECT
@@ -14,16 +15,23 @@ signals:
     // 注册按钮点击信号（传递注册信息）
     void registerClicked(const QString& id, const QString& password, 
                          const QString& confirmPwd);
+    // 取消进行中的注册请求
+    void cancelClicked();
 
 public:
     explicit RegisterWidget(QWidget* parent = nullptr);
 
+    // 注册请求进行中：用进度面板替换注册按钮，锁定输入框
+    void setRequestProgress(int step, int totalSteps, const QString& status);
+    void clearRequestProgress();
+
 private:
     AuthLineEdit* idEdit;         // 账号输入框
     AuthLineEdit* passwordEdit;   // 密码输入框
     AuthLineEdit* confirmPwdEdit; // 确认密码输入框
     AuthButton* registerBtn;      // 注册按钮
     AuthButton* toLoginBtn;       // 切换登录按钮
+    AuthProgressPanel* progressPanel; // 请求进度面板
 
     QLabel* idHintLabel;          // 账号提示标签
     QLabel* passwordHintLabel;    // 密码提示标签
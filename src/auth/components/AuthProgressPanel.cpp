@@ -0,0 +1,86 @@
+#include "AuthProgressPanel.h"
+#include "AuthButton.h"
+#include <QLabel>
+#include <QProgressBar>
+#include <QTimer>
+#include <QVBoxLayout>
+
+AuthProgressPanel::AuthProgressPanel(QWidget* parent) : QWidget(parent) {
+    setStyleSheet("background: transparent;");
+
+    statusLabel = new QLabel("", this);
+    statusLabel->setAlignment(Qt::AlignCenter);
+    statusLabel->setStyleSheet("color: #4a5568; font-size: 12px; background: transparent; padding: 2px;");
+
+    progressBar = new QProgressBar(this);
+    progressBar->setTextVisible(false);
+    progressBar->setFixedHeight(8);
+    progressBar->setStyleSheet(R"(
+        QProgressBar {
+            background-color: #e2e8f0;
+            border: none;
+            border-radius: 4px;
+        }
+        QProgressBar::chunk {
+            background: qlineargradient(x1:0, y1:0, x2:1, y2:0,
+                stop:0 #667eea, stop:1 #764ba2);
+            border-radius: 4px;
+        }
+    )");
+
+    cancelBtn = new AuthButton("取消", this);
+    cancelBtn->setMinimumHeight(40);
+    cancelBtn->setStyleSheet(R"(
+        QPushButton {
+            background-color: #f7fafc;
+            color: #e53e3e;
+            border: 2px solid #feb2b2;
+            border-radius: 10px;
+            padding: 8px;
+            font-size: 13px;
+            font-weight: bold;
+        }
+        QPushButton:hover {
+            background-color: #fff5f5;
+            border-color: #fc8181;
+        }
+        QPushButton:pressed {
+            background-color: #fed7d7;
+        }
+    )");
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(6);
+    layout->addWidget(statusLabel);
+    layout->addWidget(progressBar);
+    layout->addWidget(cancelBtn);
+
+    tickTimer = new QTimer(this);
+    tickTimer->setInterval(100);
+    connect(tickTimer, &QTimer::timeout, this, &AuthProgressPanel::refreshStatus);
+    connect(cancelBtn, &QPushButton::clicked, this, &AuthProgressPanel::cancelClicked);
+
+    hide();
+}
+
+void AuthProgressPanel::setProgress(int step, int totalSteps, const QString& text) {
+    if (!tickTimer->isActive()) {
+        elapsed.start();
+        tickTimer->start();
+    }
+    status = text;
+    progressBar->setRange(0, totalSteps);
+    progressBar->setValue(step);
+    refreshStatus();
+    show();
+}
+
+void AuthProgressPanel::finish() {
+    tickTimer->stop();
+    hide();
+}
+
+void AuthProgressPanel::refreshStatus() {
+    statusLabel->setText(QString("%1  %2s").arg(status).arg(elapsed.elapsed() / 1000.0, 0, 'f', 1));
+}
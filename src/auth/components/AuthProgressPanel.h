@@ -0,0 +1,37 @@
+#ifndef AUTH_PROGRESS_PANEL_H
+#define AUTH_PROGRESS_PANEL_H
+
+#include <QWidget>
+#include <QElapsedTimer>
+
+class QLabel;
+class QProgressBar;
+class QTimer;
+class AuthButton;
+
+// 登录注册请求进行中的进度面板：阶段进度条、状态文字（带已用时间）和取消按钮
+class AuthProgressPanel : public QWidget {
+    Q_OBJECT
+signals:
+    void cancelClicked();
+
+public:
+    explicit AuthProgressPanel(QWidget* parent = nullptr);
+
+    // step 从 1 开始；第一次调用时开始计时
+    void setProgress(int step, int totalSteps, const QString& status);
+    // 隐藏面板并停止计时
+    void finish();
+
+private:
+    void refreshStatus();
+
+    QProgressBar* progressBar;
+    QLabel* statusLabel;
+    AuthButton* cancelBtn;
+    QTimer* tickTimer;       // 刷新已用时间
+    QElapsedTimer elapsed;
+    QString status;
+};
+
+#endif // AUTH_PROGRESS_PANEL_H
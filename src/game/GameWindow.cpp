@@ -16,18 +16,26 @@
 #include "data/AchievementSystem.h"
 #include "data/CoinSystem.h"
 #include "data/ItemSystem.h"
+#include "data/ReplaySystem.h"
 #include <QMainWindow>
 #include <QVBoxLayout>
 #include <QString>
 #include <QDateTime>
+#include <QSettings>
+#include <QTimer>
+#include <functional>
 #include <string>
 #include "../utils/BGMManager.h"
 #include "../utils/ResourceUtils.h"
+#include "../utils/BackgroundCache.h"
 #include "../utils/LogWindow.h"
+#include "../utils/BootProfiler.h"
+#include "../utils/AnimationScheduler.h"
 #include "data/OtherNetDataIO.h"
 #include "../Config.h"
 
 GameWindow::GameWindow(QWidget* parent, std::string userID) : QMainWindow(parent) {
+    PROFILE_SCOPE("GameWindow::ctor");
     this->userID = userID;
     this->ip = Config::getServerIp();
     this->port = Config::getGameNetDataPort();
@@ -36,150 +44,111 @@ GameWindow::GameWindow(QWidget* parent, std::string userID) : QMainWindow(parent
     otherNetDataIO = std::make_unique<OtherNetDataIO>(this);
 
     // 初始化金币系统
-    CoinSystem::instance().initialize(userID);
-
-    // 设置网络IO并从服务器加载金币（仅在非离线模式下）
-    if (userID != "$#SINGLE#$") {
-        CoinSystem::instance().setNetworkIO(otherNetDataIO.get());
-
-        // 从服务器加载金币数量
-        int coins = otherNetDataIO->getMoney(userID);
-        if (coins >= 0) {
-            // 设置金币数量到CoinSystem (不自动保存，避免重复写入)
-            CoinSystem::instance().setCoins(coins, false);
-            qDebug() << "[GameWindow] Loaded coins from server:" << coins;
+    {
+        PROFILE_SCOPE("GameWindow::ctor/CoinSystem.load");
+        CoinSystem::instance().initialize(userID);
+
+        // 设置网络IO并从服务器加载金币（仅在非离线模式下）
+        if (userID != "$#SINGLE#$") {
+            CoinSystem::instance().setNetworkIO(otherNetDataIO.get());
+
+            // 从服务器加载金币数量
+            int coins = otherNetDataIO->getMoney(userID);
+            if (coins >= 0) {
+                // 设置金币数量到CoinSystem (不自动保存，避免重复写入)
+                CoinSystem::instance().setCoins(coins, false);
+                qDebug() << "[GameWindow] Loaded coins from server:" << coins;
+            } else {
+                qDebug() << "[GameWindow] Failed to load coins from server, using local data";
+            }
+
+            qDebug() << "[GameWindow] CoinSystem network sync enabled";
         } else {
-            qDebug() << "[GameWindow] Failed to load coins from server, using local data";
+            qDebug() << "[GameWindow] CoinSystem running in offline mode";
         }
-
-        qDebug() << "[GameWindow] CoinSystem network sync enabled";
-    } else {
-        qDebug() << "[GameWindow] CoinSystem running in offline mode";
+        qDebug() << "[GameWindow] CoinSystem initialized for user:" << QString::fromStdString(userID);
     }
-    qDebug() << "[GameWindow] CoinSystem initialized for user:" << QString::fromStdString(userID);
 
     // 初始化道具系统
-    ItemSystem::instance().initialize(userID);
-
-    // 设置网络IO并从服务器加载道具数量（仅在非离线模式下）
-    if (userID != "$#SINGLE#$") {
-        ItemSystem::instance().setNetworkIO(otherNetDataIO.get());
-
-        // 从服务器加载道具数量
-        std::vector<int> props = otherNetDataIO->getPropNums(userID);
-        if (props.size() == 4) {
-            // 设置道具数量到ItemSystem
-            ItemSystem::instance().setItemCounts(props);
-            qDebug() << "[GameWindow] Loaded props from server:"
-                     << props[0] << props[1] << props[2] << props[3];
+    {
+        PROFILE_SCOPE("GameWindow::ctor/ItemSystem.load");
+        ItemSystem::instance().initialize(userID);
+
+        // 设置网络IO并从服务器加载道具数量（仅在非离线模式下）
+        if (userID != "$#SINGLE#$") {
+            ItemSystem::instance().setNetworkIO(otherNetDataIO.get());
+
+            // 从服务器加载道具数量
+            std::vector<int> props = otherNetDataIO->getPropNums(userID);
+            if (props.size() == 4) {
+                // 设置道具数量到ItemSystem
+                ItemSystem::instance().setItemCounts(props);
+                qDebug() << "[GameWindow] Loaded props from server:"
+                         << props[0] << props[1] << props[2] << props[3];
+            } else {
+                qDebug() << "[GameWindow] Failed to load props from server, using local data";
+            }
+
+            qDebug() << "[GameWindow] ItemSystem network sync enabled";
         } else {
-            qDebug() << "[GameWindow] Failed to load props from server, using local data";
+            qDebug() << "[GameWindow] ItemSystem running in offline mode";
         }
-
-        qDebug() << "[GameWindow] ItemSystem network sync enabled";
-    } else {
-        qDebug() << "[GameWindow] ItemSystem running in offline mode";
+        qDebug() << "[GameWindow] ItemSystem initialized for user:" << QString::fromStdString(userID);
     }
-    qDebug() << "[GameWindow] ItemSystem initialized for user:" << QString::fromStdString(userID);
 
     logWindow = new LogWindow();
     // logWindow->show();
-        // ===== 初始化成就系统 =====
-    AchievementSystem::instance().initialize(this, userID);
-    qDebug() << "[GameWindow] AchievementSystem initialized";
-
-
-    achievementsWidget = new AchievementsWidget(this, this);
-    menuWidget = new MenuWidget(this, this);
-    connect(menuWidget, &MenuWidget::openAchievements, this, [this]() { this->switchWidget(achievementsWidget); });
-    connect(achievementsWidget, &AchievementsWidget::backToMenu, this, [this]() { this->switchWidget(menuWidget); });
-    playMenuWidget = new PlayMenuWidget(this, this);
-    settingWidget = new SettingWidget(this, this);
-    storeWidget = new StoreWidget(this, this);
-    rankListWidget = new RankListWidget(this, this);
-    singleModeGameWidget = new SingleModeGameWidget(this, this);
-    whirlwindModeGameWidget = new WhirlwindModeGameWidget(this, this);
-    multiplayerModeGameWidget = new MultiplayerModeGameWidget(this, this, userID);
-    puzzleModeGameWidget = new PuzzleModeGameWidget(this, this);
-    finalWidget = new FinalWidget(this, this);
-    multiGameWaitWidget = new MultiGameWaitWidget(this, this);
-    aboutWidget = new AboutWidget(this, this);
+    // ===== 初始化成就系统 =====
+    {
+        PROFILE_SCOPE("GameWindow::ctor/AchievementSystem.init");
+        AchievementSystem::instance().initialize(this, userID);
+        qDebug() << "[GameWindow] AchievementSystem initialized";
+    }
+
+    // 只构造启动后第一个显示的菜单，其余界面在第一次进入时才构造
+    {
+        PROFILE_SCOPE("GameWindow::ctor/MenuWidget");
+        menuWidget = new MenuWidget(this, this);
+    }
+    BootProfiler::instance().watchFirstFrame(menuWidget, "MenuWidget first frame");
+    connect(menuWidget, &MenuWidget::openAchievements, this, [this]() { this->switchWidget(getAchievementsWidget()); });
 
     // 连接排行榜信号
     connect(menuWidget, &MenuWidget::openLeaderboard, this, [this]() { 
-        // 获取排行榜数据
+        RankListWidget* rankList = getRankListWidget();
+        // 获取排行榜数据（只拉取首页，其余按滚动分页加载）
         if (otherNetDataIO) {
-            auto ranks = otherNetDataIO->getRanks();
-            // 确保有足够的数据
-            if (ranks.size() >= 1) {
-                rankListWidget->setNormalModeRecords(ranks[0]);
-            }
-            if (ranks.size() >= 2) {
-                rankListWidget->setRotateModeRecords(ranks[1]);
-            }
-            if (ranks.size() >= 3) {
-                rankListWidget->setMultiplayerRecords(ranks[2]);
-            }
+            rankList->reloadFromServer();
         }
-        this->switchWidget(rankListWidget); 
+        this->switchWidget(rankList); 
     });
-    connect(rankListWidget, &RankListWidget::backToMenu, this, [this]() { this->switchWidget(menuWidget); });
-    connect(aboutWidget, &AboutWidget::backToMenu, this, [this]() { this->switchWidget(menuWidget); });
-
-    achievementsWidget->hide();
-    playMenuWidget->hide();
-    settingWidget->hide();
-    storeWidget->hide();
-    rankListWidget->hide();
-    singleModeGameWidget->hide();
-    whirlwindModeGameWidget->hide();
-    multiplayerModeGameWidget->hide();
-    puzzleModeGameWidget->hide();
-    finalWidget->hide();
-    multiGameWaitWidget->hide();
-    aboutWidget->hide();
 
     connect(menuWidget, &MenuWidget::startGame, [this]() {
-        switchWidget(playMenuWidget);
+        switchWidget(getPlayMenuWidget());
     });
 
-    connect(playMenuWidget, &PlayMenuWidget::backToMenu, [this]() {
-        switchWidget(menuWidget);
-    });
-
-    // 连接 PlayMenuWidget 信号到 SingleModeGameWidget
-    connect(playMenuWidget, &PlayMenuWidget::startNormalMode, [this]() {
-        singleModeGameWidget->reset(1);
-        switchWidget(singleModeGameWidget);
-    });
-
-    // GameWindow.cpp 构造函数中
-    connect(settingWidget, &SettingWidget::backgroundImageChanged, [this](const QString& imagePath) {
-        menuWidget->setBackgroundImage(QPixmap(imagePath));
-    });
      // 初始化菜单背景图（从设置中读取）
     QString initBgPath = SettingWidget::getMenuBackgroundImage();
-    menuWidget->setBackgroundImage(QPixmap(initBgPath));
+    menuWidget->setBackgroundImage(BackgroundCache::instance().load(initBgPath));
+
+    // 应用保存的分辨率（原先由 SettingWidget 构造时加载设置顺带完成）
+    {
+        QSettings settings("GemMatch", "Settings");
+        QStringList parts = settings.value("Image/Resolution", "1600x1000").toString().split("x");
+        if (parts.size() == 2 && parts[0].toInt() > 0 && parts[1].toInt() > 0) {
+            resize(parts[0].toInt(), parts[1].toInt());
+        }
+    }
     
     connect(menuWidget, &MenuWidget::openSettings, this, [this]() {
-    switchWidget(settingWidget); // 点击设置时切换到设置界面
+    switchWidget(getSettingWidget()); // 点击设置时切换到设置界面
     });
 
     connect(menuWidget, &MenuWidget::openAbout, this, [this]() {
-        switchWidget(aboutWidget);
+        switchWidget(getAboutWidget());
     });
     connect(menuWidget, &MenuWidget::openStore, this, [this]() {
-        switchWidget(storeWidget); // 点击商店时切换到商店界面
-    });
-    
-    connect(playMenuWidget, &PlayMenuWidget::startRotateMode, [this]() {
-        whirlwindModeGameWidget->reset(2);
-        switchWidget(whirlwindModeGameWidget);
-    });
-
-    connect(playMenuWidget, &PlayMenuWidget::startPuzzleMode, [this]() {
-        puzzleModeGameWidget->reset(1);
-        switchWidget(puzzleModeGameWidget);
+        switchWidget(getStoreWidget()); // 点击商店时切换到商店界面
     });
 
         // ===== 连接成就解锁信号（可选，用于显示通知）=====
@@ -258,12 +227,182 @@ GameWindow::GameWindow(QWidget* parent, std::string userID) : QMainWindow(parent
         }
     }
 
-    // 刷新成就界面
-    if (achievementsWidget) achievementsWidget->updateView();
+    switchWidget(menuWidget);
+}
 
+// ==================== 子界面按需构造 ====================
+
+AchievementsWidget* GameWindow::getAchievementsWidget() {
+    if (!achievementsWidget) {
+        PROFILE_SCOPE("GameWindow::getAchievementsWidget/construct");
+        achievementsWidget = new AchievementsWidget(this, this);
+        achievementsWidget->hide();
+        connect(achievementsWidget, &AchievementsWidget::backToMenu, this, [this]() { this->switchWidget(menuWidget); });
+        // 构造前解锁的成就只写入了 achievementsContainer，这里补一次刷新
+        achievementsWidget->updateView();
+        qDebug() << "[GameWindow] AchievementsWidget constructed on demand";
+    }
+    return achievementsWidget;
+}
 
+PlayMenuWidget* GameWindow::getPlayMenuWidget() {
+    if (!playMenuWidget) {
+        PROFILE_SCOPE("GameWindow::getPlayMenuWidget/construct");
+        playMenuWidget = new PlayMenuWidget(this, this);
+        playMenuWidget->hide();
+
+        connect(playMenuWidget, &PlayMenuWidget::backToMenu, [this]() {
+            switchWidget(menuWidget);
+        });
+
+        // 连接 PlayMenuWidget 信号到 SingleModeGameWidget
+        connect(playMenuWidget, &PlayMenuWidget::startNormalMode, [this]() {
+            SingleModeGameWidget* widget = getSingleModeGameWidget();
+            widget->reset(1);
+            switchWidget(widget);
+        });
+
+        connect(playMenuWidget, &PlayMenuWidget::startRotateMode, [this]() {
+            WhirlwindModeGameWidget* widget = getWhirlwindModeGameWidget();
+            widget->reset(2);
+            switchWidget(widget);
+        });
+
+        connect(playMenuWidget, &PlayMenuWidget::startPuzzleMode, [this]() {
+            PuzzleModeGameWidget* widget = getPuzzleModeGameWidget();
+            widget->reset(1);
+            switchWidget(widget);
+        });
+        qDebug() << "[GameWindow] PlayMenuWidget constructed on demand";
+    }
+    return playMenuWidget;
+}
 
-    switchWidget(menuWidget);
+SettingWidget* GameWindow::getSettingWidget() {
+    if (!settingWidget) {
+        PROFILE_SCOPE("GameWindow::getSettingWidget/construct");
+        settingWidget = new SettingWidget(this, this);
+        settingWidget->hide();
+        connect(settingWidget, &SettingWidget::backgroundImageChanged, [this](const QString& imagePath) {
+            menuWidget->setBackgroundImage(BackgroundCache::instance().load(imagePath));
+        });
+        qDebug() << "[GameWindow] SettingWidget constructed on demand";
+    }
+    return settingWidget;
+}
+
+StoreWidget* GameWindow::getStoreWidget() {
+    if (!storeWidget) {
+        PROFILE_SCOPE("GameWindow::getStoreWidget/construct");
+        storeWidget = new StoreWidget(this, this);
+        storeWidget->hide();
+        qDebug() << "[GameWindow] StoreWidget constructed on demand";
+    }
+    return storeWidget;
+}
+
+RankListWidget* GameWindow::getRankListWidget() {
+    if (!rankListWidget) {
+        PROFILE_SCOPE("GameWindow::getRankListWidget/construct");
+        rankListWidget = new RankListWidget(this, this);
+        rankListWidget->hide();
+        connect(rankListWidget, &RankListWidget::backToMenu, this, [this]() { this->switchWidget(menuWidget); });
+        qDebug() << "[GameWindow] RankListWidget constructed on demand";
+    }
+    return rankListWidget;
+}
+
+SingleModeGameWidget* GameWindow::getSingleModeGameWidget() {
+    if (!singleModeGameWidget) {
+        PROFILE_SCOPE("GameWindow::getSingleModeGameWidget/construct");
+        singleModeGameWidget = new SingleModeGameWidget(this, this);
+        singleModeGameWidget->hide();
+        qDebug() << "[GameWindow] SingleModeGameWidget constructed on demand";
+    }
+    return singleModeGameWidget;
+}
+
+WhirlwindModeGameWidget* GameWindow::getWhirlwindModeGameWidget() {
+    if (!whirlwindModeGameWidget) {
+        PROFILE_SCOPE("GameWindow::getWhirlwindModeGameWidget/construct");
+        whirlwindModeGameWidget = new WhirlwindModeGameWidget(this, this);
+        whirlwindModeGameWidget->hide();
+        qDebug() << "[GameWindow] WhirlwindModeGameWidget constructed on demand";
+    }
+    return whirlwindModeGameWidget;
+}
+
+MultiplayerModeGameWidget* GameWindow::getMultiplayerModeGameWidget() {
+    if (!multiplayerModeGameWidget) {
+        PROFILE_SCOPE("GameWindow::getMultiplayerModeGameWidget/construct");
+        multiplayerModeGameWidget = new MultiplayerModeGameWidget(this, this, userID);
+        multiplayerModeGameWidget->hide();
+        qDebug() << "[GameWindow] MultiplayerModeGameWidget constructed on demand";
+    }
+    return multiplayerModeGameWidget;
+}
+
+PuzzleModeGameWidget* GameWindow::getPuzzleModeGameWidget() {
+    if (!puzzleModeGameWidget) {
+        PROFILE_SCOPE("GameWindow::getPuzzleModeGameWidget/construct");
+        puzzleModeGameWidget = new PuzzleModeGameWidget(this, this);
+        puzzleModeGameWidget->hide();
+        qDebug() << "[GameWindow] PuzzleModeGameWidget constructed on demand";
+    }
+    return puzzleModeGameWidget;
+}
+
+FinalWidget* GameWindow::getFinalWidget() {
+    if (!finalWidget) {
+        PROFILE_SCOPE("GameWindow::getFinalWidget/construct");
+        finalWidget = new FinalWidget(this, this);
+        finalWidget->hide();
+        qDebug() << "[GameWindow] FinalWidget constructed on demand";
+    }
+    return finalWidget;
+}
+
+MultiGameWaitWidget* GameWindow::getMultiGameWaitWidget() {
+    if (!multiGameWaitWidget) {
+        PROFILE_SCOPE("GameWindow::getMultiGameWaitWidget/construct");
+        multiGameWaitWidget = new MultiGameWaitWidget(this, this);
+        multiGameWaitWidget->hide();
+        qDebug() << "[GameWindow] MultiGameWaitWidget constructed on demand";
+    }
+    return multiGameWaitWidget;
+}
+
+AboutWidget* GameWindow::getAboutWidget() {
+    if (!aboutWidget) {
+        PROFILE_SCOPE("GameWindow::getAboutWidget/construct");
+        aboutWidget = new AboutWidget(this, this);
+        aboutWidget->hide();
+        connect(aboutWidget, &AboutWidget::backToMenu, this, [this]() { this->switchWidget(menuWidget); });
+        qDebug() << "[GameWindow] AboutWidget constructed on demand";
+    }
+    return aboutWidget;
+}
+
+// 在当前界面空闲时预先构造下一个最可能进入的界面，每个空闲片只构造一个，避免菜单卡顿
+void GameWindow::schedulePrewarm(QWidget* shownWidget) {
+    if (!prewarmEnabled) return;
+
+    std::function<QWidget*()> next;
+    if (shownWidget == menuWidget && !playMenuWidget) {
+        next = [this]() -> QWidget* { return getPlayMenuWidget(); };
+    } else if ((shownWidget == menuWidget || shownWidget == playMenuWidget) && !singleModeGameWidget) {
+        next = [this]() -> QWidget* { return getSingleModeGameWidget(); };
+    }
+    if (!next) return;
+
+    QTimer::singleShot(300, this, [this, shownWidget, next]() {
+        // 玩家已经离开了触发预热的界面，不再继续
+        if (currentWidget != shownWidget) return;
+        next();
+        // 预热出来的界面不可见，构造时启动的动画立即挂起
+        AnimationScheduler::instance().setActiveScreen(currentWidget);
+        schedulePrewarm(shownWidget);
+    });
 }
 
 GameWindow::~GameWindow() {
@@ -301,7 +440,6 @@ void GameWindow::setPort(const std::string& port) {
 
 void GameWindow::switchWidget(QWidget* widget)
 {
-    BGMManager::instance().stop();
     // 防止 QMainWindow 删除之前的中央部件
     if (centralWidget()) {
         QWidget* oldWidget = takeCentralWidget();
@@ -319,6 +457,8 @@ void GameWindow::switchWidget(QWidget* widget)
     
     setCentralWidget(widget);
     widget->show();
+    // 隐藏界面的定时器、循环动画和 3D 渲染全部挂起，新界面的恢复
+    AnimationScheduler::instance().setActiveScreen(widget);
     QString bgmPath;
     if (widget == menuWidget) {
         bgmPath = QString::fromStdString(ResourceUtils::getPath("sounds/menu_bgm.mp3"));
@@ -337,9 +477,54 @@ void GameWindow::switchWidget(QWidget* widget)
         bgmPath = QString::fromStdString(ResourceUtils::getPath("sounds/game_bgm.mp3"));
     }
     
+    // 新曲目在另一路加载好之后交叉淡入，没有曲目的界面淡出当前音乐
     if (!bgmPath.isEmpty()) {
         BGMManager::instance().play(bgmPath);
+    } else {
+        BGMManager::instance().stop(BGMManager::kDefaultCrossfadeMs);
+    }
+    // 提前把下一个最可能进入的界面的曲目放进空闲的一路
+    if (widget == menuWidget) {
+        BGMManager::instance().preload(QString::fromStdString(ResourceUtils::getPath("sounds/playmenu_bgm.mp3")));
+    } else if (widget == playMenuWidget) {
+        BGMManager::instance().preload(QString::fromStdString(ResourceUtils::getPath("sounds/game_bgm.mp3")));
     }
     currentWidget = widget;
+    schedulePrewarm(widget);
+
+}
+
+bool GameWindow::startReplay(const QString& path, ReplayPlayer::Speed speed) {
+    Replay replay;
+    if (!ReplaySystem::loadReplay(path, replay)) return false;
+
+    // 先 reset 再切换界面，与从菜单开始游戏的顺序一致（showEvent 里启动计时器）
+    QWidget* target = nullptr;
+    switch (replay.mode) {
+        case BoardMode::Classic: {
+            SingleModeGameWidget* widget = getSingleModeGameWidget();
+            widget->startReplay(replay, speed);
+            target = widget;
+            break;
+        }
+        case BoardMode::Whirlwind: {
+            WhirlwindModeGameWidget* widget = getWhirlwindModeGameWidget();
+            widget->startReplay(replay, speed);
+            target = widget;
+            break;
+        }
+        case BoardMode::Puzzle: {
+            PuzzleModeGameWidget* widget = getPuzzleModeGameWidget();
+            widget->startReplay(replay, speed);
+            target = widget;
+            break;
+        }
+        case BoardMode::Multiplayer:
+            qWarning() << "[GameWindow] Multiplayer replay needs the server, use --replay-headless instead:" << path;
+            return false;
+    }
 
+    qDebug() << "[GameWindow] Replay started:" << path << "actions:" << replay.actions.size();
+    if (target != currentWidget) switchWidget(target);
+    return true;
 }
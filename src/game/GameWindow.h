@@ -24,6 +24,7 @@ class OtherNetDataIO;
 
 #include <vector>
 #include "data/AchievementData.h"
+#include "data/ReplayPlayer.h"
 
 class GameWindow : public QMainWindow {
     Q_OBJECT
@@ -34,17 +35,29 @@ public:
     void setUserID(std::string userID);
     void switchWidget(QWidget* widget);
     
-    // Public getter for singleModeGameWidget if needed, or just make it public/accessible via switch
-    SingleModeGameWidget* getSingleModeGameWidget() const { return singleModeGameWidget; }
-    WhirlwindModeGameWidget* getWhirlwindModeGameWidget() const { return whirlwindModeGameWidget; }
-    MultiplayerModeGameWidget* getMultiplayerModeGameWidget() const { return multiplayerModeGameWidget; }
-    PuzzleModeGameWidget* getPuzzleModeGameWidget() const { return puzzleModeGameWidget; }
-    PlayMenuWidget* getPlayMenuWidget() const { return playMenuWidget; }
-    FinalWidget* getFinalWidget() const { return finalWidget; }
-    MultiGameWaitWidget* getMultiGameWaitWidget() const { return multiGameWaitWidget; }
+    // 子界面按需构造：第一次获取时才创建（MenuWidget 除外，启动时即创建）
+    SingleModeGameWidget* getSingleModeGameWidget();
+    WhirlwindModeGameWidget* getWhirlwindModeGameWidget();
+    MultiplayerModeGameWidget* getMultiplayerModeGameWidget();
+    PuzzleModeGameWidget* getPuzzleModeGameWidget();
+    PlayMenuWidget* getPlayMenuWidget();
+    FinalWidget* getFinalWidget();
+    MultiGameWaitWidget* getMultiGameWaitWidget();
     void setMultiGameWaitWidget(MultiGameWaitWidget* widget) { multiGameWaitWidget = widget; }
-    AboutWidget* getAboutWidget() const { return aboutWidget; }
-    AchievementsWidget* getAchievementsWidget() { return achievementsWidget; }
+    AboutWidget* getAboutWidget();
+    AchievementsWidget* getAchievementsWidget();
+    SettingWidget* getSettingWidget();
+    StoreWidget* getStoreWidget();
+    RankListWidget* getRankListWidget();
+    // 只返回已构造的成就界面，不触发构造（用于刷新类调用）
+    AchievementsWidget* peekAchievementsWidget() const { return achievementsWidget; }
+
+    // 回放录像：按录像的模式进入对应的游戏界面；联机模式的录像只能无界面回放
+    bool startReplay(const QString& path, ReplayPlayer::Speed speed);
+
+    // 空闲时预先构造下一个可能进入的界面
+    void setPrewarmEnabled(bool enabled) { prewarmEnabled = enabled; }
+    bool isPrewarmEnabled() const { return prewarmEnabled; }
 
     // NetDataIO access
     NetDataIO* getNetDataIO() const { return netDataIO; }
@@ -82,6 +95,8 @@ public:
     std::vector<std::vector<std::pair<std::string, int>>> getRankLists() const;
     void setRankLists(const std::vector<std::vector<std::pair<std::string, int>>>& ranks);
 private:
+    void schedulePrewarm(QWidget* shownWidget);
+
     std::string userID;
     std::string ip;
     std::string port;
@@ -111,6 +126,8 @@ private:
     std::string achievementStr = "0000000000";
     std::vector<std::vector<std::pair<std::string, int>>> achievements;
 
+    bool prewarmEnabled = true;
+
 };
 
 #endif // GAME_WINDOW_H
@@ -0,0 +1,46 @@
+#include "BoardReshuffler.h"
+#include "Gemstone.h"
+#include "../../utils/PerfStats.h"
+#include <QParallelAnimationGroup>
+#include <QPropertyAnimation>
+#include <Qt3DCore/QTransform>
+
+namespace BoardReshuffler {
+
+int reshuffle(BoardMode mode, int difficulty, GameRng& rng, std::vector<std::vector<Gemstone*>>& container,
+              const PositionFn& position, QObject* context, std::function<void()> onFinished) {
+    Board board(mode, difficulty);
+    std::array<int8_t, Board::kCells> types;
+    for (int row = 0; row < Board::kSize; ++row) {
+        for (int col = 0; col < Board::kSize; ++col) {
+            Gemstone* gem = container[row][col];
+            types[row * Board::kSize + col] = gem ? (int8_t)gem->getType() : -1;
+        }
+    }
+    board.loadTypes(types);
+    Board::ReshufflePlan plan = board.planReshuffle(rng);
+
+    std::vector<std::vector<Gemstone*>> oldContainer = container;
+    QParallelAnimationGroup* shuffleAnimGroup = new QParallelAnimationGroup();
+    for (int cell = 0; cell < Board::kCells; ++cell) {
+        int row = cell / Board::kSize;
+        int col = cell % Board::kSize;
+        Gemstone* gem = oldContainer[plan.source[cell] / Board::kSize][plan.source[cell] % Board::kSize];
+        container[row][col] = gem;
+        gem->setType(plan.types[cell]);
+
+        QPropertyAnimation* shuffleAnim = new QPropertyAnimation(gem->transform(), "translation");
+        PerfStats::instance().trackAnimation(shuffleAnim);
+        shuffleAnim->setDuration(600);
+        shuffleAnim->setStartValue(gem->transform()->translation());
+        shuffleAnim->setEndValue(position(row, col));
+        shuffleAnim->setEasingCurve(QEasingCurve::InOutCubic);
+        shuffleAnimGroup->addAnimation(shuffleAnim);
+    }
+
+    QObject::connect(shuffleAnimGroup, &QParallelAnimationGroup::finished, context, std::move(onFinished));
+    shuffleAnimGroup->start(QAbstractAnimation::DeleteWhenStopped);
+    return plan.recolored;
+}
+
+}  // namespace BoardReshuffler
@@ -0,0 +1,30 @@
+#ifndef BOARD_RESHUFFLER_H
+#define BOARD_RESHUFFLER_H
+
+#include <QVector3D>
+#include <functional>
+#include <vector>
+#include "../logic/Board.h"
+
+class Gemstone;
+class QObject;
+
+/**
+ * BoardReshuffler - 各模式界面共用的死局重排
+ *
+ * 从宝石容器取出当前类型交给 Board::planReshuffle（保证没有三连且至少有一步可走），
+ * 按方案把现有宝石整体移动到新位置，必要时改色，不销毁重建，分数、金币、计时都不受影响。
+ * 清理选中状态、日志和录像记录仍由各界面自己做，动画结束后的收尾通过 onFinished 传入。
+ */
+namespace BoardReshuffler {
+
+using PositionFn = std::function<QVector3D(int row, int col)>;
+
+// 立即更新 container 并启动 600ms 的位移动画，返回改色的宝石数。
+// 动画结束时在 context 上调用 onFinished
+int reshuffle(BoardMode mode, int difficulty, GameRng& rng, std::vector<std::vector<Gemstone*>>& container,
+              const PositionFn& position, QObject* context, std::function<void()> onFinished);
+
+}  // namespace BoardReshuffler
+
+#endif // BOARD_RESHUFFLER_H
@@ -0,0 +1,239 @@
+#include "GemMeshLibrary.h"
+#include "../../mesh/MeshBinary.h"
+#include "../../mesh/ObjParser.h"
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QBuffer>
+#include <Qt3DCore/QGeometry>
+#include <Qt3DRender/QGeometryRenderer>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QThreadPool>
+#include <algorithm>
+
+GemMeshLibrary& GemMeshLibrary::instance() {
+    static GemMeshLibrary library;
+    return library;
+}
+
+GemMeshLibrary::GemMeshLibrary() : QObject(nullptr) {
+    // 切到已经解析过的风格时宝石会立即换网格，其他风格的渲染器在本轮事件结束后释放；
+    // 还没解析完的风格等 onStyleParsed 再释放，期间宝石仍在用旧网格
+    connect(&GemstoneModelManager::instance(), &GemstoneModelManager::styleChanged, this,
+            [this](GemstoneStyle style) {
+        if (isReady(style) || style == GemstoneStyle::Builtin) dropRenderersExcept(style);
+    });
+}
+
+bool GemMeshLibrary::isReady(GemstoneStyle style) const {
+    auto it = styles.constFind(style);
+    return it != styles.constEnd() && it->ready;
+}
+
+bool GemMeshLibrary::canParse(const QString& path) {
+    return path.endsWith(".obj", Qt::CaseInsensitive) || path.endsWith(".gmsh", Qt::CaseInsensitive);
+}
+
+bool GemMeshLibrary::loadBaked(const QString& path, ParsedMesh& mesh, QString* error) {
+    auto file = std::make_shared<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        if (error) *error = file->errorString();
+        return false;
+    }
+    const uchar* data = file->map(0, file->size());
+    if (!data) {
+        if (error) *error = file->errorString();
+        return false;
+    }
+    MeshBinary::View view;
+    std::string viewError;
+    if (!view.open(data, (size_t)file->size(), &viewError)) {
+        if (error) *error = QString::fromStdString(viewError);
+        return false;
+    }
+
+    mesh.positionData = QByteArray((qsizetype)view.vertexCount() * 3 * sizeof(float), Qt::Uninitialized);
+    view.decodePositions(reinterpret_cast<float*>(mesh.positionData.data()));
+    mesh.normalData = QByteArray::fromRawData(reinterpret_cast<const char*>(view.normals()),
+                                              (qsizetype)view.normalBytes());
+    mesh.indexData = QByteArray::fromRawData(reinterpret_cast<const char*>(view.indexData(0)),
+                                             (qsizetype)view.indexBytes(0));
+    mesh.interleaved = false;
+    mesh.shortIndices = !view.hasIndex32();
+    mesh.vertexCount = (int)view.vertexCount();
+    mesh.indexCount = (int)view.indexCount(0);
+    // 映射随 ParsedMesh 保留，QFile 交给主线程，避免在线程池线程上留下对象
+    file->moveToThread(QCoreApplication::instance()->thread());
+    mesh.mapping = file;
+    mesh.valid = true;
+    return true;
+}
+
+bool GemMeshLibrary::loadObj(const QString& path, ParsedMesh& mesh, QString* error) {
+    MeshData data;
+    std::string parseError;
+    if (!ObjParser::load(path.toStdString(), data, &parseError)) {
+        if (error) *error = QString::fromStdString(parseError);
+        return false;
+    }
+    mesh.positionData = QByteArray(reinterpret_cast<const char*>(data.vertices.data()),
+                                   (qsizetype)(data.vertices.size() * sizeof(float)));
+    mesh.indexData = QByteArray(reinterpret_cast<const char*>(data.indices.data()),
+                                (qsizetype)(data.indices.size() * sizeof(uint32_t)));
+    mesh.interleaved = true;
+    mesh.shortIndices = false;
+    mesh.vertexCount = data.vertexCount();
+    mesh.indexCount = data.indexCount();
+    mesh.valid = true;
+    return true;
+}
+
+void GemMeshLibrary::request(GemstoneStyle style) {
+    if (style == GemstoneStyle::Builtin) return;
+    StyleMeshes& entry = styles[style];
+    if (entry.ready || entry.loading) return;
+    entry.loading = true;
+
+    // 路径在主线程取好，工作线程只碰文件和纯 C++ 解析器
+    std::array<QString, 8> paths;
+    for (int type = 0; type < 8; ++type) {
+        QString path = GemstoneModelManager::instance().getModelPath(style, type);
+        if (canParse(path)) paths[type] = path;
+    }
+
+    QThreadPool::globalInstance()->start([this, style, paths]() {
+        QElapsedTimer timer;
+        timer.start();
+        std::array<ParsedMesh, 8> meshes;
+        for (int type = 0; type < 8; ++type) {
+            const QString& path = paths[type];
+            if (path.isEmpty()) continue;
+            QString error;
+            if (!path.endsWith(".gmsh", Qt::CaseInsensitive)) {
+                if (!loadObj(path, meshes[type], &error)) {
+                    qWarning() << "[GemMeshLibrary] Failed to parse" << path << ":" << error;
+                }
+                continue;
+            }
+            if (loadBaked(path, meshes[type], &error)) continue;
+
+            // 预处理文件损坏或版本不符时退回同名 OBJ
+            QString objPath = path.left(path.size() - 5) + ".obj";
+            qWarning() << "[GemMeshLibrary] Failed to map" << path << ":" << error << "- falling back to" << objPath;
+            meshes[type] = ParsedMesh();
+            if (QFile::exists(objPath) && !loadObj(objPath, meshes[type], &error)) {
+                qWarning() << "[GemMeshLibrary] Failed to parse" << objPath << ":" << error;
+            }
+        }
+        qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+        QMetaObject::invokeMethod(this, [this, style, meshes, elapsedUs]() {
+            onStyleParsed(style, meshes, elapsedUs);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void GemMeshLibrary::onStyleParsed(GemstoneStyle style, const std::array<ParsedMesh, 8>& meshes, qint64 elapsedUs) {
+    StyleMeshes& entry = styles[style];
+    entry.meshes = meshes;
+    entry.loading = false;
+    entry.ready = true;
+
+    int validCount = (int)std::count_if(meshes.begin(), meshes.end(), [](const ParsedMesh& m) { return m.valid; });
+    qDebug() << "[GemMeshLibrary] Loaded" << GemstoneModelManager::styleToName(style) << validCount << "/ 8 models in"
+             << elapsedUs << "us (worker thread)";
+
+    // 所有宝石在这一次信号里同步切换
+    emit styleReady(style);
+
+    if (style == GemstoneModelManager::instance().getCurrentStyle()) dropRenderersExcept(style);
+}
+
+Qt3DRender::QGeometryRenderer* GemMeshLibrary::rendererFor(Qt3DCore::QNode* sceneRoot, GemstoneStyle style, int type) {
+    auto it = styles.constFind(style);
+    if (it == styles.constEnd() || !it->ready || type < 0 || type >= 8) return nullptr;
+    const ParsedMesh& mesh = it->meshes[type];
+    if (!mesh.valid || !sceneRoot) return nullptr;
+
+    sceneRenderers.erase(std::remove_if(sceneRenderers.begin(), sceneRenderers.end(),
+                                        [](const SceneRenderer& s) { return s.root.isNull() || s.renderer.isNull(); }),
+                         sceneRenderers.end());
+    for (const SceneRenderer& s : sceneRenderers) {
+        if (s.root == sceneRoot && s.style == style && s.type == type) return s.renderer;
+    }
+
+    SceneRenderer s;
+    s.root = sceneRoot;
+    s.style = style;
+    s.type = type;
+    s.renderer = buildRenderer(sceneRoot, mesh);
+    sceneRenderers.push_back(s);
+    return s.renderer;
+}
+
+Qt3DRender::QGeometryRenderer* GemMeshLibrary::buildRenderer(Qt3DCore::QNode* sceneRoot, const ParsedMesh& mesh) {
+    // 挂在场景根下，多个宝石实体共享同一个组件；QByteArray 隐式共享，不复制数据
+    auto* renderer = new Qt3DRender::QGeometryRenderer(sceneRoot);
+    auto* geometry = new Qt3DCore::QGeometry(renderer);
+
+    auto* vertexBuffer = new Qt3DCore::QBuffer(geometry);
+    vertexBuffer->setData(mesh.positionData);
+    auto* indexBuffer = new Qt3DCore::QBuffer(geometry);
+    indexBuffer->setData(mesh.indexData);
+
+    auto addVertexAttribute = [&](Qt3DCore::QBuffer* buffer, const QString& name, Qt3DCore::QAttribute::VertexBaseType baseType,
+                                  uint size, uint offset, uint stride) {
+        auto* attribute = new Qt3DCore::QAttribute(geometry);
+        attribute->setName(name);
+        attribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+        attribute->setBuffer(buffer);
+        attribute->setVertexBaseType(baseType);
+        attribute->setVertexSize(size);
+        attribute->setByteOffset(offset);
+        attribute->setByteStride(stride);
+        attribute->setCount(mesh.vertexCount);
+        geometry->addAttribute(attribute);
+        return attribute;
+    };
+    Qt3DCore::QAttribute* position = nullptr;
+    if (mesh.interleaved) {
+        const uint stride = MeshData::kStride * sizeof(float);
+        position = addVertexAttribute(vertexBuffer, Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                                      Qt3DCore::QAttribute::Float, 3, MeshData::kPositionOffset * sizeof(float), stride);
+        addVertexAttribute(vertexBuffer, Qt3DCore::QAttribute::defaultNormalAttributeName(), Qt3DCore::QAttribute::Float, 3,
+                           MeshData::kNormalOffset * sizeof(float), stride);
+        addVertexAttribute(vertexBuffer, Qt3DCore::QAttribute::defaultTextureCoordinateAttributeName(),
+                           Qt3DCore::QAttribute::Float, 2, MeshData::kTexCoordOffset * sizeof(float), stride);
+    } else {
+        // 量化法线不做归一化标记，Phong 着色器会重新 normalize，方向不变
+        auto* normalBuffer = new Qt3DCore::QBuffer(geometry);
+        normalBuffer->setData(mesh.normalData);
+        position = addVertexAttribute(vertexBuffer, Qt3DCore::QAttribute::defaultPositionAttributeName(),
+                                      Qt3DCore::QAttribute::Float, 3, 0, 3 * sizeof(float));
+        addVertexAttribute(normalBuffer, Qt3DCore::QAttribute::defaultNormalAttributeName(), Qt3DCore::QAttribute::Byte, 3,
+                           0, MeshBinary::kNormalStride);
+    }
+
+    auto* indexAttribute = new Qt3DCore::QAttribute(geometry);
+    indexAttribute->setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+    indexAttribute->setBuffer(indexBuffer);
+    indexAttribute->setVertexBaseType(mesh.shortIndices ? Qt3DCore::QAttribute::UnsignedShort
+                                                        : Qt3DCore::QAttribute::UnsignedInt);
+    indexAttribute->setCount(mesh.indexCount);
+    geometry->addAttribute(indexAttribute);
+    geometry->setBoundingVolumePositionAttribute(position);
+
+    renderer->setGeometry(geometry);
+    renderer->setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+    return renderer;
+}
+
+void GemMeshLibrary::dropRenderersExcept(GemstoneStyle style) {
+    // 宝石已经切到新风格，旧风格的几何体不再有实体引用
+    for (SceneRenderer& s : sceneRenderers) {
+        if (s.style != style && s.renderer) s.renderer->deleteLater();
+    }
+    sceneRenderers.erase(std::remove_if(sceneRenderers.begin(), sceneRenderers.end(),
+                                        [style](const SceneRenderer& s) { return s.style != style; }),
+                         sceneRenderers.end());
+}
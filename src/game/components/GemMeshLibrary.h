@@ -0,0 +1,91 @@
+#ifndef GEM_MESH_LIBRARY_H
+#define GEM_MESH_LIBRARY_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <array>
+#include <memory>
+#include <vector>
+#include "Gemstone.h"
+
+class QFile;
+namespace Qt3DCore { class QNode; }
+namespace Qt3DRender { class QGeometryRenderer; }
+
+/**
+ * GemMeshLibrary - 宝石外部模型的后台加载与共享
+ *
+ * request(style) 在线程池里一次加载该风格全部 8 个模型，生成可直接上传的顶点/索引缓冲，
+ * 完成后回到主线程发出 styleReady。这段时间宝石保持原来的网格（首次加载时是内置几何体），
+ * 所有宝石在同一次信号处理中切换，新几何体在同一帧出现。
+ *
+ * 每个 3D 场景（以根实体区分）的每种宝石只建一个 QGeometryRenderer，挂在场景根下，
+ * 同一棋盘上的宝石共享这个组件，换类型时也不再重新解析文件。
+ * 构建时预处理出的 .gmsh（见 MeshBinary）整体内存映射：法线和索引段直接交给 GPU 缓冲，
+ * 只有量化的位置要还原成 float；映射在程序退出前一直保留。.gmsh 损坏时退回同名 OBJ。
+ * 处理 .gmsh 和 .obj；其他格式仍由 Gemstone 用 QMesh 加载。
+ */
+class GemMeshLibrary : public QObject {
+    Q_OBJECT
+public:
+    static GemMeshLibrary& instance();
+
+    // 已解析完成（失败的类型也算完成，使用内置几何体）
+    bool isReady(GemstoneStyle style) const;
+    // 在后台解析该风格；已就绪或正在解析时直接返回
+    void request(GemstoneStyle style);
+
+    static bool canParse(const QString& path);
+
+    // 返回 sceneRoot 场景内共享的渲染器，模型不存在或解析失败返回 nullptr。只能在 isReady 之后调用
+    Qt3DRender::QGeometryRenderer* rendererFor(Qt3DCore::QNode* sceneRoot, GemstoneStyle style, int type);
+
+signals:
+    void styleReady(GemstoneStyle style);
+
+private:
+    GemMeshLibrary();
+    GemMeshLibrary(const GemMeshLibrary&) = delete;
+    GemMeshLibrary& operator=(const GemMeshLibrary&) = delete;
+
+    struct ParsedMesh {
+        // OBJ：positionData 为交错的 MeshData 顶点，法线在同一缓冲里；
+        // .gmsh：positionData 为还原后的 float3，normalData 为映射内存里的 int8x4
+        QByteArray positionData;
+        QByteArray normalData;
+        QByteArray indexData;
+        bool interleaved = false;
+        bool shortIndices = false;
+        int vertexCount = 0;
+        int indexCount = 0;
+        bool valid = false;
+        std::shared_ptr<QFile> mapping;  // normalData/indexData 引用的映射文件
+    };
+
+    struct StyleMeshes {
+        bool loading = false;
+        bool ready = false;
+        std::array<ParsedMesh, 8> meshes;
+    };
+
+    struct SceneRenderer {
+        QPointer<Qt3DCore::QNode> root;
+        GemstoneStyle style;
+        int type;
+        QPointer<Qt3DRender::QGeometryRenderer> renderer;
+    };
+
+    static bool loadBaked(const QString& path, ParsedMesh& mesh, QString* error);
+    static bool loadObj(const QString& path, ParsedMesh& mesh, QString* error);
+    void onStyleParsed(GemstoneStyle style, const std::array<ParsedMesh, 8>& meshes, qint64 elapsedUs);
+    Qt3DRender::QGeometryRenderer* buildRenderer(Qt3DCore::QNode* sceneRoot, const ParsedMesh& mesh);
+    void dropRenderersExcept(GemstoneStyle style);
+
+    QMap<GemstoneStyle, StyleMeshes> styles;
+    std::vector<SceneRenderer> sceneRenderers;
+};
+
+#endif // GEM_MESH_LIBRARY_H
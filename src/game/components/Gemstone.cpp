@@ -15,6 +15,9 @@
 #include <QStandardPaths>
 #include <QCoreApplication>
 #include <QSettings>
+#include "../../utils/BootProfiler.h"
+#include "../../utils/PerfStats.h"
+#include "GemMeshLibrary.h"
 
 // ============================================================================
 // GemstoneModelManager 实现
@@ -116,6 +119,9 @@ void GemstoneModelManager::setCurrentStyle(GemstoneStyle style) {
         settings.setValue("Game/GemStyle", styleToName(style));
         
         qDebug() << "[GemstoneModelManager] Style changed to:" << styleToName(style);
+
+        // 先在后台开始解析新风格的模型，宝石在解析完成后统一切换
+        GemMeshLibrary::instance().request(style);
         
         emit styleChanged(style);
     }
@@ -258,6 +264,7 @@ QString GemstoneModelManager::getModelFilePattern() const {
 }
 
 void GemstoneModelManager::scanAllStyles() {
+    PROFILE_SCOPE("GemstoneModelManager::scanAllStyles");
     m_modelCache.clear();
     
     // 扫描每个风格目录
@@ -275,6 +282,7 @@ void GemstoneModelManager::scanAllStyles() {
 }
 
 void GemstoneModelManager::scanStyleDirectory(GemstoneStyle style) {
+    PROFILE_SCOPE("GemstoneModelManager::scanStyleDirectory");
     QString styleDir = getStyleDirectory(style);
     
     if (styleDir.isEmpty()) {
@@ -288,7 +296,7 @@ void GemstoneModelManager::scanStyleDirectory(GemstoneStyle style) {
     }
     
     QStringList filters;
-    filters << "gem_type_*.obj" << "gem_type_*.gltf" << "gem_type_*.glb";
+    filters << "gem_type_*.obj" << "gem_type_*.gltf" << "gem_type_*.glb" << "gem_type_*.gmsh";
     
     QFileInfoList files = dir.entryInfoList(filters, QDir::Files);
     
@@ -301,7 +309,9 @@ void GemstoneModelManager::scanStyleDirectory(GemstoneStyle style) {
             QString numStr = filename.mid(9);
             bool ok;
             int type = numStr.toInt(&ok);
-            if (ok && type >= 0 && type < 8) {
+            // 构建时预处理出的 .gmsh 与 OBJ 放在一起，同一类型优先用它
+            bool baked = typeCache.value(type).endsWith(".gmsh");
+            if (ok && type >= 0 && type < 8 && !baked) {
                 typeCache[type] = fileInfo.absoluteFilePath();
                 qDebug() << "[GemstoneModelManager] Found" << styleToName(style) 
                          << "model for type" << type << ":" << fileInfo.absoluteFilePath();
@@ -322,7 +332,8 @@ void GemstoneModelManager::scanStyleDirectory(GemstoneStyle style) {
 
 Gemstone::Gemstone(int type, std::string style, Qt3DCore::QNode* parent) 
     : Qt3DCore::QEntity(parent), type(type), style(style), m_externalMesh(nullptr) {
-    
+    PerfStats::instance().gemstoneCreated();
+
     m_transform = new Qt3DCore::QTransform(this);
     addComponent(m_transform);
 
@@ -334,11 +345,14 @@ Gemstone::Gemstone(int type, std::string style, Qt3DCore::QNode* parent)
     // 连接全局风格变化信号
     connect(&GemstoneModelManager::instance(), &GemstoneModelManager::styleChanged,
             this, &Gemstone::onGlobalStyleChanged);
+    connect(&GemMeshLibrary::instance(), &GemMeshLibrary::styleReady,
+            this, &Gemstone::onStyleMeshesReady);
 
     updateAppearance();
 
     // 设置旋转动画
     m_rotationAnimation = new QPropertyAnimation(m_transform, "rotationY", this);
+    PerfStats::instance().trackAnimation(m_rotationAnimation);
     m_rotationAnimation->setStartValue(0.0f);
     m_rotationAnimation->setEndValue(360.0f);
     m_rotationAnimation->setDuration(3000 + QRandomGenerator::global()->bounded(2000));
@@ -373,6 +387,7 @@ Gemstone::Gemstone(int type, std::string style, Qt3DCore::QNode* parent)
 }
 
 Gemstone::~Gemstone() {
+    PerfStats::instance().gemstoneDestroyed();
     // 清理金币图标
     clearCoinIndicator();
     // Qt3D 节点会自动清理
@@ -380,19 +395,33 @@ Gemstone::~Gemstone() {
     if (m_mesh) {
         delete m_mesh;
     }
+    // m_sharedMesh 归场景根所有，不在这里删除
     if (m_externalMesh) {
         delete m_externalMesh;
     }
 }
 
 void Gemstone::onGlobalStyleChanged(GemstoneStyle newStyle) {
-    Q_UNUSED(newStyle);
-    // 风格变化时重新加载模型
-    reloadModel();
+    // 新风格的模型已经解析过（或是内置几何体）就立即切换，否则保持当前网格，等 onStyleMeshesReady
+    if (newStyle == GemstoneStyle::Builtin || GemMeshLibrary::instance().isReady(newStyle)) {
+        reloadModel();
+    }
     clearSpecialEffects();
     clearHintEffects();
 }
 
+void Gemstone::onStyleMeshesReady(GemstoneStyle style) {
+    if (style == GemstoneModelManager::instance().getCurrentStyle()) {
+        reloadModel();
+    }
+}
+
+Qt3DCore::QNode* Gemstone::sceneRoot() const {
+    Qt3DCore::QNode* node = parentNode();
+    while (node && node->parentNode()) node = node->parentNode();
+    return node;
+}
+
 int Gemstone::getType() const {
     return type;
 }
@@ -445,6 +474,11 @@ void Gemstone::setupMesh() {
         delete m_externalMesh;
         m_externalMesh = nullptr;
     }
+
+    if (m_sharedMesh) {
+        removeComponent(m_sharedMesh);
+    }
+    m_sharedMesh = nullptr;
     
     m_usingExternalModel = false;
 
@@ -456,8 +490,20 @@ void Gemstone::setupMesh() {
         return;
     }
     
-    // 尝试使用外部模型
-    if (GemstoneModelManager::instance().hasExternalModel(type % 8)) {
+    // 尝试使用外部模型：OBJ 走后台解析的共享几何体，解析完成前先显示内置几何体
+    QString modelPath = GemstoneModelManager::instance().getModelPath(type % 8);
+    if (GemMeshLibrary::canParse(modelPath)) {
+        GemMeshLibrary& library = GemMeshLibrary::instance();
+        if (library.isReady(currentStyle)) {
+            m_sharedMesh = library.rendererFor(sceneRoot(), currentStyle, type % 8);
+            if (m_sharedMesh) {
+                addComponent(m_sharedMesh);
+                m_usingExternalModel = true;
+            }
+        } else {
+            library.request(currentStyle);
+        }
+    } else if (!modelPath.isEmpty()) {
         setupExternalMesh();
     }
     
@@ -790,6 +836,7 @@ void Gemstone::updateSpecialEffects() {
     m_haloEntity->addComponent(haloTransform);
 
     m_haloScaleAnimation = new QPropertyAnimation(haloTransform, "scale3D");
+    PerfStats::instance().trackAnimation(m_haloScaleAnimation);
     m_haloScaleAnimation->setStartValue(QVector3D(1.0f, 1.0f, 1.0f));
     m_haloScaleAnimation->setEndValue(QVector3D(1.2f, 1.2f, 1.2f));
     m_haloScaleAnimation->setDuration(1000);
@@ -828,6 +875,7 @@ void Gemstone::updateSpecialEffects() {
         pTransform->setTranslation(QVector3D(0.9f, 0.0f, 0.0f));
         
         QPropertyAnimation* orbitAnim = new QPropertyAnimation(pivotTransform, "rotationY");
+        PerfStats::instance().trackAnimation(orbitAnim);
         orbitAnim->setStartValue(0.0f);
         orbitAnim->setEndValue(360.0f);
         int duration = 1500 + QRandomGenerator::global()->bounded(1500);
@@ -893,6 +941,7 @@ void Gemstone::updateHintEffects() {
         pTransform->setTranslation(QVector3D(0.9f, 0.0f, 0.0f));
         
         QPropertyAnimation* orbitAnim = new QPropertyAnimation(pivotTransform, "rotationY");
+        PerfStats::instance().trackAnimation(orbitAnim);
         orbitAnim->setStartValue(0.0f);
         orbitAnim->setEndValue(360.0f);
         int duration = 1500 + QRandomGenerator::global()->bounded(1500);
@@ -1095,6 +1144,7 @@ void Gemstone::setupCoinIndicator() {
 
     // === 添加旋转动画 ===
     m_coinRotationAnimation = new QPropertyAnimation(coinIndicatorTransform, "rotationY");
+    PerfStats::instance().trackAnimation(m_coinRotationAnimation);
     m_coinRotationAnimation->setStartValue(15.0f);      // 从15度开始
     m_coinRotationAnimation->setEndValue(375.0f);       // 转到375度（360+15）
     m_coinRotationAnimation->setDuration(3000);         // 3秒转一圈，更慢更优雅
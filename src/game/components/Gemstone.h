@@ -13,6 +13,7 @@
 #include <QFileInfo>
 #include <QMap>
 #include <QObject>
+#include <QPointer>
 
 /**
  * @brief 宝石风格枚举
@@ -160,6 +161,8 @@ signals:
 private slots:
     // 响应全局风格变化
     void onGlobalStyleChanged(GemstoneStyle newStyle);
+    // 后台解析的模型就绪
+    void onStyleMeshesReady(GemstoneStyle style);
 
 private:
     int type;
@@ -177,6 +180,8 @@ private:
     Qt3DExtras::QPhongMaterial* m_material;
     Qt3DRender::QGeometryRenderer* m_mesh;
     Qt3DRender::QMesh* m_externalMesh;
+    // GemMeshLibrary 提供的共享几何体，挂在场景根下
+    QPointer<Qt3DRender::QGeometryRenderer> m_sharedMesh;
     Qt3DRender::QObjectPicker* m_picker;
     QPropertyAnimation* m_rotationAnimation;
 
@@ -200,6 +205,7 @@ private:
     void setupMesh();
     void setupExternalMesh();
     void setupBuiltinMesh();
+    Qt3DCore::QNode* sceneRoot() const;
     void setupMaterial();
     void updateSpecialEffects();
     void clearSpecialEffects();
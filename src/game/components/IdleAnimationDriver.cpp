@@ -0,0 +1,79 @@
+#include "IdleAnimationDriver.h"
+#include "../../utils/AnimationScheduler.h"
+#include <QAbstractAnimation>
+#include <QDebug>
+#include <QTimer>
+#include <QWidget>
+#include <Qt3DCore/QEntity>
+#include <Qt3DExtras/Qt3DWindow>
+#include <Qt3DRender/QRenderSettings>
+#include <algorithm>
+
+namespace {
+constexpr qint64 kMaxStepMs = 200;  // 界面恢复后的第一帧不让宝石一下转过头
+}
+
+IdleAnimationDriver::IdleAnimationDriver(QWidget* owner, Qt3DExtras::Qt3DWindow* window, RootGetter root)
+    : QObject(owner), owner(owner), window(window), root(std::move(root)) {
+    // 只在场景变化时出帧
+    window->renderSettings()->setRenderPolicy(Qt3DRender::QRenderSettings::OnDemand);
+
+    timer = new QTimer(this);
+    timer->setInterval(kReducedIntervalMs);
+    connect(timer, &QTimer::timeout, this, &IdleAnimationDriver::onTick);
+    AnimationScheduler::instance().registerTimer(owner, timer);
+}
+
+void IdleAnimationDriver::setMode(Mode mode) {
+    if (mode == this->mode) return;
+    this->mode = mode;
+    qDebug() << "[IdleAnimationDriver] Mode:" << (int)mode;
+
+    if (mode == Mode::Smooth) {
+        timer->stop();
+        releaseAll();
+        return;
+    }
+    adoptRunningLoops();
+    elapsed.start();
+    // 关闭模式下定时器只用来暂停新生成宝石的自转
+    timer->start();
+}
+
+void IdleAnimationDriver::onTick() {
+    // 界面恢复时 AnimationScheduler 可能重启了已不需要的定时器
+    if (mode == Mode::Smooth) {
+        timer->stop();
+        return;
+    }
+    adoptRunningLoops();
+    if (mode != Mode::Reduced) return;
+
+    qint64 step = std::min(elapsed.restart(), kMaxStepMs);
+    held.removeAll(QPointer<QAbstractAnimation>());
+    for (const QPointer<QAbstractAnimation>& animation : held) {
+        if (animation->state() != QAbstractAnimation::Paused) continue;
+        int duration = animation->duration();
+        if (duration <= 0) continue;
+        animation->setCurrentTime((int)((animation->currentLoopTime() + step) % duration));
+    }
+}
+
+void IdleAnimationDriver::adoptRunningLoops() {
+    Qt3DCore::QEntity* scene = root ? root() : nullptr;
+    if (!scene) return;
+    const QList<QAbstractAnimation*> animations = scene->findChildren<QAbstractAnimation*>();
+    for (QAbstractAnimation* animation : animations) {
+        if (animation->loopCount() >= 0 || animation->group()) continue;
+        if (animation->state() != QAbstractAnimation::Running) continue;
+        animation->pause();
+        if (!held.contains(animation)) held.append(animation);
+    }
+}
+
+void IdleAnimationDriver::releaseAll() {
+    for (const QPointer<QAbstractAnimation>& animation : held) {
+        if (animation && animation->state() == QAbstractAnimation::Paused) animation->resume();
+    }
+    held.clear();
+}
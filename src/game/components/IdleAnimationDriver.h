@@ -0,0 +1,56 @@
+#ifndef IDLE_ANIMATION_DRIVER_H
+#define IDLE_ANIMATION_DRIVER_H
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QElapsedTimer>
+#include <functional>
+
+class QAbstractAnimation;
+class QTimer;
+class QWidget;
+namespace Qt3DCore { class QEntity; }
+namespace Qt3DExtras { class Qt3DWindow; }
+
+/**
+ * IdleAnimationDriver - 游戏 3D 窗口的按需渲染与待机动画降频
+ *
+ * 构造时把 3D 窗口切到 OnDemand 渲染：场景里有属性变化（连锁、交换、旋转动画，
+ * 悬停高亮等输入反馈）时 Qt3D 才出帧，棋盘静止时不再每帧重绘。
+ *
+ * 此时唯一持续改动场景的是宝石的待机自转等无限循环动画，按设置分三档：
+ *   Smooth  - 交给 Qt 动画系统，约 60Hz 更新；
+ *   Reduced - 动画保持暂停，由本对象的 20Hz 定时器推进进度，帧率随之降到 20Hz；
+ *   Off     - 动画暂停在当前姿态，棋盘静止时完全不出帧。
+ * 所属界面在每次显示时按设置调用 setMode。定时器登记到 AnimationScheduler，界面隐藏时一起停下。
+ */
+class IdleAnimationDriver : public QObject {
+    Q_OBJECT
+public:
+    enum class Mode { Smooth = 0, Reduced = 1, Off = 2 };
+    using RootGetter = std::function<Qt3DCore::QEntity*()>;
+
+    static constexpr int kReducedIntervalMs = 50;  // 20Hz
+
+    IdleAnimationDriver(QWidget* owner, Qt3DExtras::Qt3DWindow* window, RootGetter root);
+
+    void setMode(Mode mode);
+    Mode getMode() const { return mode; }
+
+private:
+    void onTick();
+    // 接管场景里正在运行的无限循环动画（新生成的宝石会带着运行中的自转动画）
+    void adoptRunningLoops();
+    void releaseAll();
+
+    QPointer<QWidget> owner;
+    QPointer<Qt3DExtras::Qt3DWindow> window;
+    RootGetter root;
+    Mode mode = Mode::Smooth;
+    QTimer* timer = nullptr;
+    QElapsedTimer elapsed;
+    QList<QPointer<QAbstractAnimation>> held;  // 由本对象暂停、手动推进的动画
+};
+
+#endif // IDLE_ANIMATION_DRIVER_H
@@ -0,0 +1,328 @@
+#include "ParticleSystem.h"
+#include "../../utils/FrameClock.h"
+#include <QDebug>
+#include <QEvent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int kAtlasPadding = 2;  // 精灵之间留空，避免缩放采样时串色
+}
+
+ParticleSystem::ParticleSystem(QWidget* owner)
+    : QObject(owner), owner(owner) {
+    owner->installEventFilter(this);
+    setActive(owner->isVisible());
+}
+
+ParticleSystem::~ParticleSystem() {
+    setActive(false);
+}
+
+int ParticleSystem::addSprite(const QImage& image) {
+    spriteImages.push_back(image.convertToFormat(QImage::Format_ARGB32_Premultiplied));
+    spriteRects.push_back(QRectF());
+    atlasDirty = true;
+    return (int)spriteImages.size() - 1;
+}
+
+QSizeF ParticleSystem::spriteSize(int sprite) const {
+    if (sprite < 0 || sprite >= (int)spriteImages.size()) return QSizeF();
+    return spriteImages[sprite].size();
+}
+
+void ParticleSystem::setBounds(Bounds mode, const QMarginsF& margins) {
+    bounds = mode;
+    boundsMargins = margins;
+}
+
+void ParticleSystem::setTwinkle(float alphaDepth, float scaleDepth) {
+    twinkleAlpha = alphaDepth;
+    twinkleScale = scaleDepth;
+}
+
+void ParticleSystem::setOrbit(float radius, float keepPerSecond, float strength) {
+    orbitRadius = radius;
+    orbitKeep = keepPerSecond;
+    orbitStrength = strength;
+}
+
+void ParticleSystem::clear() {
+    for (std::vector<float>* field : {&x, &y, &vx, &vy, &rotation, &spin, &scaleX, &scaleY, &alpha,
+                                      &life, &decay, &twinklePhase, &twinkleSpeed, &targetX, &targetY}) {
+        field->clear();
+    }
+    sprite.clear();
+}
+
+void ParticleSystem::reserve(int count) {
+    for (std::vector<float>* field : {&x, &y, &vx, &vy, &rotation, &spin, &scaleX, &scaleY, &alpha,
+                                      &life, &decay, &twinklePhase, &twinkleSpeed, &targetX, &targetY}) {
+        field->reserve(count);
+    }
+    sprite.reserve(count);
+    fragments.reserve(count);
+}
+
+int ParticleSystem::spawn(const Particle& p) {
+    x.push_back(p.x);
+    y.push_back(p.y);
+    vx.push_back(p.vx);
+    vy.push_back(p.vy);
+    rotation.push_back(p.rotation);
+    spin.push_back(p.spin);
+    scaleX.push_back(p.scaleX);
+    scaleY.push_back(p.scaleY);
+    alpha.push_back(p.alpha);
+    life.push_back(p.life);
+    decay.push_back(p.decay);
+    twinklePhase.push_back(p.twinklePhase);
+    twinkleSpeed.push_back(p.twinkleSpeed);
+    targetX.push_back(p.targetX);
+    targetY.push_back(p.targetY);
+    sprite.push_back(p.sprite);
+    return size() - 1;
+}
+
+ParticleSystem::Particle ParticleSystem::read(int i) const {
+    Particle p;
+    p.x = x[i];
+    p.y = y[i];
+    p.vx = vx[i];
+    p.vy = vy[i];
+    p.rotation = rotation[i];
+    p.spin = spin[i];
+    p.scaleX = scaleX[i];
+    p.scaleY = scaleY[i];
+    p.alpha = alpha[i];
+    p.life = life[i];
+    p.decay = decay[i];
+    p.twinklePhase = twinklePhase[i];
+    p.twinkleSpeed = twinkleSpeed[i];
+    p.targetX = targetX[i];
+    p.targetY = targetY[i];
+    p.sprite = sprite[i];
+    return p;
+}
+
+void ParticleSystem::write(int i, const Particle& p) {
+    x[i] = p.x;
+    y[i] = p.y;
+    vx[i] = p.vx;
+    vy[i] = p.vy;
+    rotation[i] = p.rotation;
+    spin[i] = p.spin;
+    scaleX[i] = p.scaleX;
+    scaleY[i] = p.scaleY;
+    alpha[i] = p.alpha;
+    life[i] = p.life;
+    decay[i] = p.decay;
+    twinklePhase[i] = p.twinklePhase;
+    twinkleSpeed[i] = p.twinkleSpeed;
+    targetX[i] = p.targetX;
+    targetY[i] = p.targetY;
+    sprite[i] = p.sprite;
+}
+
+// ==================== 可见性与时钟 ====================
+
+void ParticleSystem::setPaused(bool paused) {
+    this->paused = paused;
+    setActive(!paused && owner && owner->isVisible());
+}
+
+void ParticleSystem::setActive(bool on) {
+    if (on == active) return;
+    active = on;
+    if (on) {
+        connect(&FrameClock::instance(), &FrameClock::tick, this, &ParticleSystem::onTick);
+        FrameClock::instance().acquire();
+    } else {
+        disconnect(&FrameClock::instance(), &FrameClock::tick, this, &ParticleSystem::onTick);
+        FrameClock::instance().release();
+    }
+}
+
+bool ParticleSystem::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == owner) {
+        // 祖先隐藏时子控件同样会收到 Hide 事件，切换界面时不需要逐个通知
+        if (event->type() == QEvent::Show) {
+            setActive(!paused);
+        } else if (event->type() == QEvent::Hide) {
+            setActive(false);
+        }
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void ParticleSystem::onTick(float dt) {
+    step(dt);
+    emit advanced(dt);
+    if (owner) owner->update();
+}
+
+// ==================== 更新 ====================
+
+QRectF ParticleSystem::boundsRect() const {
+    QRectF box = space == Space::Normalized ? QRectF(0.0, 0.0, 1.0, 1.0)
+                                            : (owner ? QRectF(owner->rect()) : QRectF());
+    return box.marginsAdded(boundsMargins);
+}
+
+void ParticleSystem::step(float dt) {
+    clockTime += dt;
+    integrate(dt);
+    if (orbitRadius > 0.0f) applyOrbit(dt);
+
+    QRectF box = boundsRect();
+    if (bounds == Bounds::Wrap) applyWrap(box);
+    if (respawn) collectRespawns(box);
+}
+
+void ParticleSystem::integrate(float dt) {
+    const int n = size();
+    float* px = x.data();
+    float* py = y.data();
+    const float* pvx = vx.data();
+    const float* pvy = vy.data();
+    for (int i = 0; i < n; ++i) {
+        px[i] += pvx[i] * dt;
+        py[i] += pvy[i] * dt;
+    }
+
+    float* prot = rotation.data();
+    const float* pspin = spin.data();
+    for (int i = 0; i < n; ++i) {
+        prot[i] += pspin[i] * dt;
+    }
+
+    float* plife = life.data();
+    const float* pdecay = decay.data();
+    for (int i = 0; i < n; ++i) {
+        plife[i] -= pdecay[i] * dt;
+    }
+}
+
+void ParticleSystem::applyOrbit(float dt) {
+    const int n = size();
+    const float keep = std::pow(orbitKeep, dt);
+    const float pull = orbitStrength * dt;
+    const float radius2 = orbitRadius * orbitRadius;
+    const float* px = x.data();
+    const float* py = y.data();
+    const float* ptx = targetX.data();
+    const float* pty = targetY.data();
+    float* pvx = vx.data();
+    float* pvy = vy.data();
+    for (int i = 0; i < n; ++i) {
+        float dx = ptx[i] - px[i];
+        float dy = pty[i] - py[i];
+        bool inside = dx * dx + dy * dy < radius2;
+        float k = inside ? keep : 1.0f;
+        float s = inside ? pull : 0.0f;
+        // 速度衰减后加上垂直于目标方向的分量
+        float nvx = pvx[i] * k - dy * s;
+        float nvy = pvy[i] * k + dx * s;
+        pvx[i] = nvx;
+        pvy[i] = nvy;
+    }
+}
+
+void ParticleSystem::applyWrap(const QRectF& box) {
+    const int n = size();
+    const float left = (float)box.left();
+    const float right = (float)box.right();
+    const float top = (float)box.top();
+    const float bottom = (float)box.bottom();
+    float* px = x.data();
+    float* py = y.data();
+    for (int i = 0; i < n; ++i) {
+        float v = px[i];
+        px[i] = v < left ? right : (v > right ? left : v);
+    }
+    for (int i = 0; i < n; ++i) {
+        float v = py[i];
+        py[i] = v < top ? bottom : (v > bottom ? top : v);
+    }
+}
+
+void ParticleSystem::collectRespawns(const QRectF& box) {
+    const int n = size();
+    const bool checkBounds = bounds == Bounds::Respawn;
+    const float left = (float)box.left();
+    const float right = (float)box.right();
+    const float top = (float)box.top();
+    const float bottom = (float)box.bottom();
+
+    pendingRespawn.clear();
+    for (int i = 0; i < n; ++i) {
+        bool dead = decay[i] > 0.0f && life[i] <= 0.0f;
+        bool outside = x[i] < left || x[i] > right || y[i] < top || y[i] > bottom;
+        if (dead || (checkBounds && outside)) pendingRespawn.push_back(i);
+    }
+    for (int i : pendingRespawn) {
+        Particle p = read(i);
+        respawn(p);
+        write(i, p);
+    }
+}
+
+// ==================== 绘制 ====================
+
+void ParticleSystem::rebuildAtlas() {
+    int width = 0;
+    int height = 0;
+    for (const QImage& image : spriteImages) {
+        width += image.width() + kAtlasPadding;
+        height = std::max(height, image.height());
+    }
+
+    QImage sheet(std::max(1, width), std::max(1, height), QImage::Format_ARGB32_Premultiplied);
+    sheet.fill(Qt::transparent);
+    QPainter painter(&sheet);
+    int cursor = 0;
+    for (size_t i = 0; i < spriteImages.size(); ++i) {
+        const QImage& image = spriteImages[i];
+        painter.drawImage(cursor, 0, image);
+        spriteRects[i] = QRectF(cursor, 0, image.width(), image.height());
+        cursor += image.width() + kAtlasPadding;
+    }
+    painter.end();
+
+    atlas = QPixmap::fromImage(sheet);
+    atlasDirty = false;
+    qDebug() << "[ParticleSystem] Atlas rebuilt:" << spriteImages.size() << "sprites," << atlas.size();
+}
+
+void ParticleSystem::draw(QPainter& painter) {
+    if (atlasDirty) rebuildAtlas();
+    if (atlas.isNull() || size() == 0) return;
+
+    const int n = size();
+    const float sx = space == Space::Normalized && owner ? (float)owner->width() : 1.0f;
+    const float sy = space == Space::Normalized && owner ? (float)owner->height() : 1.0f;
+    const int spriteCount = (int)spriteRects.size();
+
+    fragments.clear();
+    for (int i = 0; i < n; ++i) {
+        float a = alpha[i];
+        float scale = 1.0f;
+        if (twinkleAlpha != 0.0f || twinkleScale != 0.0f) {
+            float w = 0.5f + 0.5f * std::sin(clockTime * twinkleSpeed[i] + twinklePhase[i]);
+            a *= 1.0f - twinkleAlpha + twinkleAlpha * w;
+            scale = 1.0f - twinkleScale + 2.0f * twinkleScale * w;
+        }
+        if (fadeWithLife) a *= std::clamp(life[i], 0.0f, 1.0f);
+        if (a <= 0.004f || sprite[i] < 0 || sprite[i] >= spriteCount) continue;
+
+        fragments.push_back(QPainter::PixmapFragment::create(
+            QPointF(x[i] * sx, y[i] * sy), spriteRects[sprite[i]],
+            scaleX[i] * scale, scaleY[i] * scale, rotation[i], std::min(a, 1.0f)));
+    }
+    if (fragments.empty()) return;
+
+    painter.save();
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.drawPixmapFragments(fragments.data(), (int)fragments.size(), atlas);
+    painter.restore();
+}
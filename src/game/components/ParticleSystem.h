@@ -0,0 +1,143 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <QObject>
+#include <QImage>
+#include <QMarginsF>
+#include <QPainter>
+#include <QPixmap>
+#include <QPointer>
+#include <QRectF>
+#include <QWidget>
+#include <functional>
+#include <vector>
+
+/**
+ * ParticleSystem - 2D 界面共用的粒子引擎
+ *
+ * 数据按字段分数组存放（x、y、vx、vy……各一个连续的 float 数组），逐帧更新是几条
+ * 没有分支的线性循环，编译器可以直接向量化；边界环绕和靠近目标时的环绕运动也写成
+ * 条件选择而不是跳转。
+ *
+ * 粒子的外观事先画进精灵图集（addSprite），绘制时整批交给一次 drawPixmapFragments，
+ * 每个粒子只带位置、缩放、旋转和透明度，不再逐个构造 QPainterPath 和渐变。
+ *
+ * 时间由共享的 FrameClock 驱动。粒子系统监听所属控件的显示/隐藏事件，控件（或它的
+ * 任一祖先）隐藏时自动从时钟上断开，不再更新也不再触发重绘。
+ */
+class ParticleSystem : public QObject {
+    Q_OBJECT
+public:
+    // 坐标空间：像素，或相对控件宽高的 0~1 比例（控件缩放时粒子跟着铺开）
+    enum class Space { Pixels, Normalized };
+    // 越界处理：不管、从对边绕回、交给 respawn 回调重新生成
+    enum class Bounds { None, Wrap, Respawn };
+
+    // 单个粒子的完整状态，只用于生成和 respawn 回调，内部按字段分数组存放
+    struct Particle {
+        float x = 0.0f, y = 0.0f;
+        float vx = 0.0f, vy = 0.0f;        // 每秒位移
+        float rotation = 0.0f;             // 角度
+        float spin = 0.0f;                 // 每秒旋转角度
+        float scaleX = 1.0f, scaleY = 1.0f; // 相对精灵原始尺寸
+        float alpha = 1.0f;
+        float life = 1.0f;
+        float decay = 0.0f;                // 每秒减少的 life，0 表示不会死亡
+        float twinklePhase = 0.0f;
+        float twinkleSpeed = 0.0f;         // 弧度/秒
+        float targetX = 0.0f, targetY = 0.0f; // 环绕运动的中心
+        int sprite = 0;
+    };
+    // 粒子寿命耗尽或越界（Bounds::Respawn）时调用，p 为当前状态，改写后写回
+    using RespawnFunc = std::function<void(Particle& p)>;
+
+    explicit ParticleSystem(QWidget* owner);
+    ~ParticleSystem() override;
+
+    // 添加一个精灵，返回编号；图集在下次绘制时重新拼接
+    int addSprite(const QImage& image);
+    QSizeF spriteSize(int sprite) const;
+
+    void setSpace(Space space) { this->space = space; }
+    // margins 向外扩展边界矩形（像素空间为控件矩形，比例空间为单位矩形）
+    void setBounds(Bounds mode, const QMarginsF& margins = QMarginsF());
+    void setRespawn(RespawnFunc func) { respawn = std::move(func); }
+    // 闪烁：w = 0.5 + 0.5 * sin(time * twinkleSpeed + twinklePhase)
+    //   透明度乘 (1 - alphaDepth + alphaDepth * w)，缩放乘 (1 - scaleDepth + 2 * scaleDepth * w)
+    void setTwinkle(float alphaDepth, float scaleDepth);
+    // 透明度再乘上剩余寿命
+    void setFadeWithLife(bool fade) { fadeWithLife = fade; }
+    // 距目标 radius 以内时减速（每秒保留 keepPerSecond 的速度）并绕目标转动
+    void setOrbit(float radius, float keepPerSecond, float strength);
+
+    void clear();
+    void reserve(int count);
+    int spawn(const Particle& p);
+    int size() const { return (int)x.size(); }
+
+    // 手动暂停，与控件可见性叠加：暂停或不可见时都不更新
+    void setPaused(bool paused);
+    bool isActive() const { return active; }
+    // 粒子系统累计运行的秒数（暂停期间不增长）
+    float elapsedSeconds() const { return clockTime; }
+
+    // 推进 dt 秒，通常由 FrameClock 调用
+    void step(float dt);
+    void draw(QPainter& painter);
+
+signals:
+    // 每帧更新粒子之后、请求重绘之前发出，控件在这里推进自己的其他动画状态
+    void advanced(float dt);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    void setActive(bool on);
+    void onTick(float dt);
+    void integrate(float dt);
+    void applyOrbit(float dt);
+    void applyWrap(const QRectF& box);
+    void collectRespawns(const QRectF& box);
+    QRectF boundsRect() const;
+    void rebuildAtlas();
+
+    Particle read(int i) const;
+    void write(int i, const Particle& p);
+
+    QPointer<QWidget> owner;
+    bool active = false;
+    bool paused = false;
+    float clockTime = 0.0f;
+
+    Space space = Space::Pixels;
+    Bounds bounds = Bounds::None;
+    QMarginsF boundsMargins;
+    RespawnFunc respawn;
+    float twinkleAlpha = 0.0f;
+    float twinkleScale = 0.0f;
+    bool fadeWithLife = false;
+    float orbitRadius = 0.0f;
+    float orbitKeep = 1.0f;
+    float orbitStrength = 0.0f;
+
+    // 按字段分开存放的粒子数据
+    std::vector<float> x, y, vx, vy;
+    std::vector<float> rotation, spin;
+    std::vector<float> scaleX, scaleY, alpha;
+    std::vector<float> life, decay;
+    std::vector<float> twinklePhase, twinkleSpeed;
+    std::vector<float> targetX, targetY;
+    std::vector<int> sprite;
+
+    // 精灵图集：所有精灵横向拼成一张 QPixmap
+    std::vector<QImage> spriteImages;
+    std::vector<QRectF> spriteRects;
+    QPixmap atlas;
+    bool atlasDirty = false;
+
+    std::vector<int> pendingRespawn;
+    std::vector<QPainter::PixmapFragment> fragments;
+};
+
+#endif // PARTICLE_SYSTEM_H
@@ -0,0 +1,164 @@
+#include "PerfHud.h"
+#include "../../utils/PerfStats.h"
+#include <QEvent>
+#include <QKeyEvent>
+#include <QShortcut>
+#include <QTimer>
+#include <Qt3DCore/QEntity>
+#include <Qt3DExtras/Qt3DWindow>
+#include <Qt3DLogic/QFrameAction>
+#include <algorithm>
+
+bool PerfHud::hudEnabled = false;
+
+namespace {
+constexpr int kRefreshIntervalMs = 250;
+constexpr int kHudMargin = 12;
+
+QString formatMs(double ms) {
+    return ms < 10.0 ? QString::number(ms, 'f', 2) : QString::number(ms, 'f', 1);
+}
+}
+
+PerfHud::PerfHud(QWidget* host, Qt3DExtras::Qt3DWindow* window, Qt3DCore::QEntity* rootEntity)
+    : QLabel(host, Qt::ToolTip | Qt::FramelessWindowHint | Qt::WindowTransparentForInput),
+      host(host), window(window) {
+    setAttribute(Qt::WA_ShowWithoutActivating);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+    setTextFormat(Qt::RichText);
+    setStyleSheet(R"(
+        QLabel {
+            color: rgb(220, 235, 255);
+            background: rgba(10, 14, 24, 190);
+            border: 1px solid rgba(120, 200, 255, 90);
+            border-radius: 6px;
+            padding: 6px 10px;
+            font-family: 'Consolas';
+            font-size: 12px;
+        }
+    )");
+    hide();
+
+    // QFrameAction 每个逻辑帧触发一次，dt 为距上一帧的秒数
+    if (rootEntity) {
+        frameAction = new Qt3DLogic::QFrameAction(rootEntity);
+        frameAction->setEnabled(false);
+        rootEntity->addComponent(frameAction);
+        connect(frameAction, &Qt3DLogic::QFrameAction::triggered, this, &PerfHud::onFrame);
+    }
+
+    refreshTimer = new QTimer(this);
+    refreshTimer->setInterval(kRefreshIntervalMs);
+    connect(refreshTimer, &QTimer::timeout, this, &PerfHud::refresh);
+
+    // 焦点在普通控件上时走快捷键；焦点在 3D 窗口里时按键不经过控件，由事件过滤器处理
+    QShortcut* shortcut = new QShortcut(QKeySequence(Qt::Key_F3), host);
+    shortcut->setContext(Qt::WidgetWithChildrenShortcut);
+    connect(shortcut, &QShortcut::activated, this, &PerfHud::toggle);
+
+    host->installEventFilter(this);
+    if (window) window->installEventFilter(this);
+}
+
+void PerfHud::toggle() {
+    hudEnabled = !hudEnabled;
+    if (hudEnabled) PerfStats::instance().resetPeaks();
+    updateVisibility();
+}
+
+bool PerfHud::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == window && event->type() == QEvent::KeyPress) {
+        QKeyEvent* keyEvent = static_cast<QKeyEvent*>(event);
+        if (keyEvent->key() == Qt::Key_F3 && !keyEvent->isAutoRepeat()) {
+            toggle();
+            return true;
+        }
+    } else if (watched == host) {
+        switch (event->type()) {
+            case QEvent::Show:
+                // 宿主被放进主窗口后才能拿到顶层窗口，用来跟随窗口移动
+                if (host->window() != host) host->window()->installEventFilter(this);
+                updateVisibility();
+                break;
+            case QEvent::Hide:
+                updateVisibility();
+                break;
+            case QEvent::Move:
+            case QEvent::Resize:
+                if (isVisible()) move(host->mapToGlobal(QPoint(kHudMargin, kHudMargin)));
+                break;
+            default:
+                break;
+        }
+    } else if (host && watched == host->window() && event->type() == QEvent::Move) {
+        if (isVisible()) move(host->mapToGlobal(QPoint(kHudMargin, kHudMargin)));
+    }
+    return QLabel::eventFilter(watched, event);
+}
+
+void PerfHud::updateVisibility() {
+    bool shouldShow = hudEnabled && host && host->isVisible();
+    if (frameAction) frameAction->setEnabled(shouldShow);
+    if (shouldShow) {
+        frameSumMs = 0.0;
+        frameMaxMs = 0.0;
+        frameCount = 0;
+        refresh();
+        show();
+        raise();
+        refreshTimer->start();
+    } else {
+        refreshTimer->stop();
+        hide();
+    }
+}
+
+void PerfHud::onFrame(float dt) {
+    double ms = dt * 1000.0;
+    frameSumMs += ms;
+    frameMaxMs = std::max(frameMaxMs, ms);
+    ++frameCount;
+}
+
+void PerfHud::refresh() {
+    PerfStats& stats = PerfStats::instance();
+
+    QString frameLine;
+    if (frameCount > 0) {
+        double avgMs = frameSumMs / frameCount;
+        double fps = avgMs > 0.0 ? 1000.0 / avgMs : 0.0;
+        // 超过两帧预算（33ms）的峰值标红，说明这段时间里出现了掉帧
+        QString peakColor = frameMaxMs > 33.4 ? "#ff6b6b" : "#9fe0a0";
+        frameLine = QString("帧时间 %1 ms (%2 FPS) 峰值 <span style='color:%3'>%4 ms</span>")
+            .arg(formatMs(avgMs)).arg(qRound(fps)).arg(peakColor).arg(formatMs(frameMaxMs));
+    } else {
+        frameLine = "帧时间 -- (画面未刷新)";
+    }
+    frameSumMs = 0.0;
+    frameMaxMs = 0.0;
+    frameCount = 0;
+
+    const PerfStats::PhaseStat& elim = stats.getPhase(PerfStats::Eliminate);
+    const PerfStats::PhaseStat& drop = stats.getPhase(PerfStats::Drop);
+    const PerfStats::PhaseStat& refill = stats.getPhase(PerfStats::Refill);
+
+    QString cascadeLine = stats.isCascadeActive()
+        ? QString("连锁 进行中 (上次 %1 ms / %2 步)").arg(qRound(stats.getLastCascadeMs())).arg(stats.getLastCascadeSteps())
+        : QString("连锁 %1 ms / %2 步").arg(qRound(stats.getLastCascadeMs())).arg(stats.getLastCascadeSteps());
+
+    int rtt = stats.getNetworkRtt();
+    QString rttLine = rtt >= 0 ? QString("网络 RTT %1 ms").arg(rtt) : QString("网络 RTT --");
+
+    setText(QString("<b>性能 (F3)</b><br>%1<br>宝石 %2　动画 %3 (运行 %4)<br>"
+                    "消除 %5/%6　下落 %7/%8　填充 %9/%10 ms<br>%11<br>%12")
+        .arg(frameLine)
+        .arg(stats.getLiveGemstones())
+        .arg(stats.getLiveAnimations())
+        .arg(stats.getRunningAnimations())
+        .arg(formatMs(elim.lastMs), formatMs(elim.maxMs),
+             formatMs(drop.lastMs), formatMs(drop.maxMs),
+             formatMs(refill.lastMs), formatMs(refill.maxMs))
+        .arg(cascadeLine, rttLine));
+    adjustSize();
+    if (host) move(host->mapToGlobal(QPoint(kHudMargin, kHudMargin)));
+}
@@ -0,0 +1,49 @@
+#ifndef PERF_HUD_H
+#define PERF_HUD_H
+
+#include <QLabel>
+#include <QPointer>
+
+class QTimer;
+namespace Qt3DCore { class QEntity; }
+namespace Qt3DExtras { class Qt3DWindow; }
+namespace Qt3DLogic { class QFrameAction; }
+
+/**
+ * PerfHud - 游戏界面左上角的性能浮层，按 F3 开关
+ *
+ * 显示帧时间（来自 Qt3D 的 QFrameAction）、存活宝石与动画数量、
+ * 连锁各阶段逻辑耗时和网络 RTT，用来区分卡顿来自渲染、逻辑还是网络。
+ * 3D 画面是原生窗口，普通子控件会被盖住，所以浮层本身是一个无边框的置顶小窗口，
+ * 跟随宿主控件的位置。关闭或宿主不可见时不统计帧时间、不刷新。
+ */
+class PerfHud : public QLabel {
+    Q_OBJECT
+public:
+    PerfHud(QWidget* host, Qt3DExtras::Qt3DWindow* window, Qt3DCore::QEntity* rootEntity);
+
+    // 开关状态在所有游戏界面间共享，切换模式后保持
+    void toggle();
+    static bool isHudEnabled() { return hudEnabled; }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private:
+    void onFrame(float dt);
+    void refresh();
+    void updateVisibility();
+
+    QPointer<QWidget> host;
+    QPointer<Qt3DExtras::Qt3DWindow> window;
+    QPointer<Qt3DLogic::QFrameAction> frameAction;
+    QTimer* refreshTimer = nullptr;
+    static bool hudEnabled;
+
+    // 本刷新周期内的帧统计
+    double frameSumMs = 0.0;
+    double frameMaxMs = 0.0;
+    int frameCount = 0;
+};
+
+#endif // PERF_HUD_H
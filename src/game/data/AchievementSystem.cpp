@@ -4,6 +4,7 @@
 #include "../gameWidgets/SingleModeGameWidget.h"
 #include "OtherNetDataIO.h"
 #include "AchievementData.h"
+#include "ReplaySystem.h"
 #include <QDebug>
 #include <QDateTime>
 #include <QMessageBox>  // 临时调试用
@@ -114,6 +115,7 @@ bool AchievementSystem::isUnlocked(AchievementIndex index) const {
 void AchievementSystem::unlock(AchievementIndex index) {
     int idx = static_cast<int>(index);
     if (idx < 0 || idx >= 10) return;
+    if (ReplaySystem::instance().isPlayingBack()) return;  // 回放不解锁成就
     
     bool wasUnlocked = achievements[idx];
     
@@ -279,7 +281,7 @@ void AchievementSystem::updateGameWindowAchievement(int index, bool unlocked) {
         qDebug() << "[AchievementSystem] Updated GameWindow achievement:" << index;
         
         // 刷新成就界面
-        auto* achievementsWidget = gameWindow->getAchievementsWidget();
+        auto* achievementsWidget = gameWindow->peekAchievementsWidget();
         if (achievementsWidget) {
             achievementsWidget->updateView();
         }
@@ -12,6 +12,11 @@ const std::string& OtherNetData::getData() const { return data; }
 const std::vector<int>& OtherNetData::getPropNums() const { return propNums; }
 int OtherNetData::getNormalTime() const { return normalTime; }
 int OtherNetData::getWhirlTime() const { return whirlTime; }
+int OtherNetData::getRankMode() const { return rankMode; }
+int OtherNetData::getRankOffset() const { return rankOffset; }
+int OtherNetData::getRankLimit() const { return rankLimit; }
+int OtherNetData::getRankTotal() const { return rankTotal; }
+const std::vector<std::pair<std::string, int>>& OtherNetData::getRankPage() const { return rankPage; }
 
 // Implement Setters
 void OtherNetData::setId(const std::string& id) { this->id = id; }
@@ -25,6 +30,11 @@ void OtherNetData::setData(const std::string& data) { this->data = data; }
 void OtherNetData::setPropNums(const std::vector<int>& propNums) { this->propNums = propNums; }
 void OtherNetData::setNormalTime(int normalTime) { this->normalTime = normalTime; }
 void OtherNetData::setWhirlTime(int whirlTime) { this->whirlTime = whirlTime; }
+void OtherNetData::setRankMode(int rankMode) { this->rankMode = rankMode; }
+void OtherNetData::setRankOffset(int rankOffset) { this->rankOffset = rankOffset; }
+void OtherNetData::setRankLimit(int rankLimit) { this->rankLimit = rankLimit; }
+void OtherNetData::setRankTotal(int rankTotal) { this->rankTotal = rankTotal; }
+void OtherNetData::setRankPage(const std::vector<std::pair<std::string, int>>& rankPage) { this->rankPage = rankPage; }
 
 // Implement JSON functions
 void to_json(nlohmann::json& j, const OtherNetData& p) {
@@ -39,7 +49,12 @@ void to_json(nlohmann::json& j, const OtherNetData& p) {
         {"multiRank", p.multiRank},
         {"propNums", p.propNums},
         {"normalTime", p.normalTime},
-        {"whirlTime", p.whirlTime}
+        {"whirlTime", p.whirlTime},
+        {"rankMode", p.rankMode},
+        {"rankOffset", p.rankOffset},
+        {"rankLimit", p.rankLimit},
+        {"rankTotal", p.rankTotal},
+        {"rankPage", p.rankPage}
     };
 }
 
@@ -55,4 +70,9 @@ void from_json(const nlohmann::json& j, OtherNetData& p) {
     if(j.contains("propNums")) j.at("propNums").get_to(p.propNums);
     if(j.contains("normalTime")) j.at("normalTime").get_to(p.normalTime);
     if(j.contains("whirlTime")) j.at("whirlTime").get_to(p.whirlTime);
+    if(j.contains("rankMode")) j.at("rankMode").get_to(p.rankMode);
+    if(j.contains("rankOffset")) j.at("rankOffset").get_to(p.rankOffset);
+    if(j.contains("rankLimit")) j.at("rankLimit").get_to(p.rankLimit);
+    if(j.contains("rankTotal")) j.at("rankTotal").get_to(p.rankTotal);
+    if(j.contains("rankPage")) j.at("rankPage").get_to(p.rankPage);
 }
@@ -5,6 +5,14 @@
 #include <vector>
 #include "json.hpp"
 
+// 排行榜分页结果（type 31 按 offset/limit 取页，type 32 取包含某用户的那一页）
+struct RankPage {
+    int mode = 0;   // 0 普通模式 1 旋风模式 2 多人对战
+    int start = 0;  // 本页第一条记录的全局名次（从0开始）
+    int total = 0;  // 榜单总人数
+    std::vector<std::pair<std::string, int>> entries;
+};
+
 class OtherNetData
 {
 public:
@@ -22,6 +30,11 @@ public:
     const std::vector<int>& getPropNums() const;
     int getNormalTime() const;
     int getWhirlTime() const;
+    int getRankMode() const;
+    int getRankOffset() const;
+    int getRankLimit() const;
+    int getRankTotal() const;
+    const std::vector<std::pair<std::string, int>>& getRankPage() const;
 
     
     void setId(const std::string& id);
@@ -35,6 +48,11 @@ public:
     void setPropNums(const std::vector<int>& propNums);
     void setNormalTime(int normalTime);
     void setWhirlTime(int whirlTime);
+    void setRankMode(int rankMode);
+    void setRankOffset(int rankOffset);
+    void setRankLimit(int rankLimit);
+    void setRankTotal(int rankTotal);
+    void setRankPage(const std::vector<std::pair<std::string, int>>& rankPage);
 
 private:
     int type;
@@ -50,6 +68,12 @@ private:
     friend void from_json(const nlohmann::json& j, OtherNetData& p);
     int normalTime;
     int whirlTime;
+    // 分页排行榜字段
+    int rankMode = 0;
+    int rankOffset = 0;
+    int rankLimit = 0;
+    int rankTotal = 0;
+    std::vector<std::pair<std::string, int>> rankPage;
 };
 
 #endif // OTHER_NET_DATA_H
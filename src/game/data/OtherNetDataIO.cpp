@@ -2,9 +2,19 @@
 #include "OtherNetData.h"
 #include "../GameWindow.h"
 #include "../../Config.h"
+#include "../../utils/BootProfiler.h"
+#include "../../utils/PerfStats.h"
 #include <boost/asio.hpp>
 #include <iostream>
 
+namespace {
+// 从发起连接到收到响应的耗时，供性能浮层显示
+void recordRtt(std::chrono::steady_clock::time_point start) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    PerfStats::instance().recordNetworkRtt((int)elapsed.count());
+}
+}
+
 OtherNetDataIO::OtherNetDataIO(GameWindow* gameWindow) {
     this->gameWindow = gameWindow;
 }
@@ -67,6 +77,7 @@ bool OtherNetDataIO::setMoney(std::string id, int money) {
 }
 
 int OtherNetDataIO::getMoney(std::string id) {
+    PROFILE_SCOPE("OtherNetDataIO::getMoney");
     if (!gameWindow) return 0;
 
     OtherNetData dataRequest;
@@ -99,6 +110,7 @@ int OtherNetDataIO::getMoney(std::string id) {
 
         auto responseBuffer = std::make_shared<boost::asio::streambuf>();
 
+        auto requestStart = std::chrono::steady_clock::now();
         boost::asio::async_connect(socket, endpoints,
             [&](const boost::system::error_code& ec, const boost::asio::ip::tcp::endpoint&) {
                 if (!ec) {
@@ -108,6 +120,7 @@ int OtherNetDataIO::getMoney(std::string id) {
                                 boost::asio::async_read(socket, *responseBuffer, boost::asio::transfer_at_least(1),
                                     [&, responseBuffer](const boost::system::error_code& ec, std::size_t bytes_transferred) {
                                         if (!ec || ec == boost::asio::error::eof) {
+                                            recordRtt(requestStart);
                                             try {
                                                 std::string responseStr((std::istreambuf_iterator<char>(responseBuffer.get())), std::istreambuf_iterator<char>());
                                                 if (!responseStr.empty()) {
@@ -186,6 +199,7 @@ bool OtherNetDataIO::setAchievementStr(std::string id, std::string achievementSt
 }
 
 std::string OtherNetDataIO::getAchievementStr(std::string id) {
+    PROFILE_SCOPE("OtherNetDataIO::getAchievementStr");
     if (!gameWindow) return "";
 
     OtherNetData dataRequest;
@@ -216,6 +230,7 @@ std::string OtherNetDataIO::getAchievementStr(std::string id) {
 
         auto responseBuffer = std::make_shared<boost::asio::streambuf>();
 
+        auto requestStart = std::chrono::steady_clock::now();
         boost::asio::async_connect(socket, endpoints,
             [&](const boost::system::error_code& ec, const boost::asio::ip::tcp::endpoint&) {
                 if (!ec) {
@@ -225,6 +240,7 @@ std::string OtherNetDataIO::getAchievementStr(std::string id) {
                                 boost::asio::async_read(socket, *responseBuffer, boost::asio::transfer_at_least(1),
                                     [&, responseBuffer](const boost::system::error_code& ec, std::size_t bytes_transferred) {
                                         if (!ec || ec == boost::asio::error::eof) {
+                                            recordRtt(requestStart);
                                             try {
                                                 std::string responseStr((std::istreambuf_iterator<char>(responseBuffer.get())), std::istreambuf_iterator<char>());
                                                 if (!responseStr.empty()) {
@@ -252,6 +268,7 @@ std::string OtherNetDataIO::getAchievementStr(std::string id) {
 }
 
 std::vector<std::vector<std::pair<std::string, int>>> OtherNetDataIO::getRanks() {
+    PROFILE_SCOPE("OtherNetDataIO::getRanks");
     std::vector<std::vector<std::pair<std::string, int>>> ranks;
     if (!gameWindow) return std::vector<std::vector<std::pair<std::string, int>>>(3);
 
@@ -281,6 +298,7 @@ std::vector<std::vector<std::pair<std::string, int>>> OtherNetDataIO::getRanks()
 
         auto responseBuffer = std::make_shared<boost::asio::streambuf>();
 
+        auto requestStart = std::chrono::steady_clock::now();
         boost::asio::async_connect(socket, endpoints,
             [&](const boost::system::error_code& ec, const boost::asio::ip::tcp::endpoint&) {
                 if (!ec) {
@@ -290,6 +308,7 @@ std::vector<std::vector<std::pair<std::string, int>>> OtherNetDataIO::getRanks()
                                 boost::asio::async_read(socket, *responseBuffer, boost::asio::transfer_at_least(1),
                                     [&, responseBuffer](const boost::system::error_code& ec, std::size_t bytes_transferred) {
                                         if (!ec || ec == boost::asio::error::eof) {
+                                            recordRtt(requestStart);
                                             try {
                                                 std::string responseStr((std::istreambuf_iterator<char>(responseBuffer.get())), std::istreambuf_iterator<char>());
                                                 if (!responseStr.empty()) {
@@ -319,6 +338,97 @@ std::vector<std::vector<std::pair<std::string, int>>> OtherNetDataIO::getRanks()
     return success ? ranks : std::vector<std::vector<std::pair<std::string, int>>>(3);
 }
 
+bool OtherNetDataIO::requestRankPage(const OtherNetData& request, RankPage& page) {
+    PROFILE_SCOPE("OtherNetDataIO::requestRankPage");
+    std::string ip = Config::getServerIp();
+    int port = Config::getOtherNetDataPort();
+
+    bool success = false;
+
+    try {
+        boost::asio::io_context io_context;
+        boost::asio::ip::tcp::socket socket(io_context);
+        boost::asio::steady_timer timer(io_context);
+
+        timer.expires_after(std::chrono::milliseconds(500));
+        timer.async_wait([&](const boost::system::error_code& ec) {
+            if (!ec) socket.close();
+        });
+
+        boost::asio::ip::tcp::resolver resolver(io_context);
+        auto endpoints = resolver.resolve(boost::asio::ip::tcp::v4(), ip, std::to_string(port));
+
+        nlohmann::json j;
+        to_json(j, request);
+        std::string jsonStr = j.dump();
+
+        auto responseBuffer = std::make_shared<boost::asio::streambuf>();
+
+        auto requestStart = std::chrono::steady_clock::now();
+        boost::asio::async_connect(socket, endpoints,
+            [&](const boost::system::error_code& ec, const boost::asio::ip::tcp::endpoint&) {
+                if (!ec) {
+                    boost::asio::async_write(socket, boost::asio::buffer(jsonStr),
+                        [&](const boost::system::error_code& ec, std::size_t) {
+                            if (!ec) {
+                                boost::asio::async_read(socket, *responseBuffer, boost::asio::transfer_at_least(1),
+                                    [&, responseBuffer](const boost::system::error_code& ec, std::size_t bytes_transferred) {
+                                        if (!ec || ec == boost::asio::error::eof) {
+                                            recordRtt(requestStart);
+                                            try {
+                                                std::string responseStr((std::istreambuf_iterator<char>(responseBuffer.get())), std::istreambuf_iterator<char>());
+                                                if (!responseStr.empty()) {
+                                                    nlohmann::json respJ = nlohmann::json::parse(responseStr);
+                                                    // 旧版服务器不认识分页请求，没有 rankTotal 字段时视为失败，由调用方回退到 type 30
+                                                    if (respJ.contains("rankTotal")) {
+                                                        OtherNetData responseData;
+                                                        from_json(respJ, responseData);
+                                                        page.mode = request.getRankMode();
+                                                        page.start = responseData.getRankOffset();
+                                                        page.total = responseData.getRankTotal();
+                                                        page.entries = responseData.getRankPage();
+                                                        success = true;
+                                                    }
+                                                }
+                                            } catch (...) {}
+                                            timer.cancel();
+                                        }
+                                    });
+                            }
+                        });
+                }
+            });
+
+        io_context.run();
+    } catch (std::exception& e) {
+        std::cerr << "OtherNetDataIO::requestRankPage failed: " << e.what() << std::endl;
+        return false;
+    }
+    return success;
+}
+
+bool OtherNetDataIO::getRankPage(int mode, int offset, int limit, RankPage& page) {
+    if (!gameWindow) return false;
+
+    OtherNetData dataRequest;
+    dataRequest.setType(31);
+    dataRequest.setRankMode(mode);
+    dataRequest.setRankOffset(offset);
+    dataRequest.setRankLimit(limit);
+    return requestRankPage(dataRequest, page);
+}
+
+bool OtherNetDataIO::getRankAroundMe(int mode, std::string id, int limit, RankPage& page) {
+    if (!gameWindow) return false;
+
+    OtherNetData dataRequest;
+    dataRequest.setType(32);
+    dataRequest.setId(id);
+    dataRequest.setRankMode(mode);
+    dataRequest.setRankLimit(limit);
+    return requestRankPage(dataRequest, page);
+}
+
 bool OtherNetDataIO::setPropNums(std::string id, std::vector<int> propNums) {
     if (!gameWindow) return false;
 
@@ -370,6 +480,7 @@ bool OtherNetDataIO::setPropNums(std::string id, std::vector<int> propNums) {
 }
 
 std::vector<int> OtherNetDataIO::getPropNums(std::string id) {
+    PROFILE_SCOPE("OtherNetDataIO::getPropNums");
     if (!gameWindow) return std::vector<int>();
 
     OtherNetData dataRequest;
@@ -400,6 +511,7 @@ std::vector<int> OtherNetDataIO::getPropNums(std::string id) {
 
         auto responseBuffer = std::make_shared<boost::asio::streambuf>();
 
+        auto requestStart = std::chrono::steady_clock::now();
         boost::asio::async_connect(socket, endpoints,
             [&](const boost::system::error_code& ec, const boost::asio::ip::tcp::endpoint&) {
                 if (!ec) {
@@ -409,6 +521,7 @@ std::vector<int> OtherNetDataIO::getPropNums(std::string id) {
                                 boost::asio::async_read(socket, *responseBuffer, boost::asio::transfer_at_least(1),
                                     [&, responseBuffer](const boost::system::error_code& ec, std::size_t bytes_transferred) {
                                         if (!ec || ec == boost::asio::error::eof) {
+                                            recordRtt(requestStart);
                                             try {
                                                 std::string responseStr((std::istreambuf_iterator<char>(responseBuffer.get())), std::istreambuf_iterator<char>());
                                                 if (!responseStr.empty()) {
@@ -11,6 +11,9 @@ class GameWindow;
 class OtherNetDataIO {
 private:
     GameWindow* gameWindow = nullptr;;
+
+    // 分页排行榜请求的公共收发流程
+    bool requestRankPage(const OtherNetData& request, RankPage& page);
 public:
     OtherNetDataIO(GameWindow* gameWindow);
     ~OtherNetDataIO();
@@ -23,6 +26,11 @@ public:
 
     std::vector<std::vector<std::pair<std::string, int>>> getRanks();
 
+    // 分页获取排行榜：mode 0 普通 1 旋风 2 多人，offset 从0开始
+    bool getRankPage(int mode, int offset, int limit, RankPage& page);
+    // 获取包含 id 的那一页（页大小为 limit，起点按 limit 对齐）
+    bool getRankAroundMe(int mode, std::string id, int limit, RankPage& page);
+
     bool setPropNums(std::string id, std::vector<int> propNums);
     std::vector<int> getPropNums(std::string id);
 
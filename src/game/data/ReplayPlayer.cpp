@@ -0,0 +1,68 @@
+#include "ReplayPlayer.h"
+#include <QDebug>
+#include <QTimer>
+#include <algorithm>
+
+namespace {
+constexpr int kBusyRetryMs = 16;      // 界面忙时大约一帧后重试
+constexpr int kFastForwardFactor = 4;
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& replay, Speed speed, ApplyFunc apply, QObject* parent)
+    : QObject(parent), replay(replay), speed(speed), apply(std::move(apply)) {
+    stepTimer = new QTimer(this);
+    stepTimer->setSingleShot(true);
+    connect(stepTimer, &QTimer::timeout, this, &ReplayPlayer::step);
+}
+
+void ReplayPlayer::start() {
+    nextIndex = 0;
+    lastActionTime = 0;
+    qDebug() << "[ReplayPlayer] Start, actions:" << replay.actions.size() << "speed:" << (int)speed;
+    scheduleNext();
+}
+
+void ReplayPlayer::stop() {
+    stepTimer->stop();
+}
+
+bool ReplayPlayer::isRunning() const {
+    return stepTimer->isActive();
+}
+
+ReplayPlayer::Speed ReplayPlayer::parseSpeed(const QString& text) {
+    QString value = text.trimmed().toLower();
+    if (value == "ff" || value == "fast" || value == "4x") return Speed::FastForward;
+    if (value == "max") return Speed::Max;
+    return Speed::RealTime;
+}
+
+void ReplayPlayer::scheduleNext() {
+    if (nextIndex >= (int)replay.actions.size()) {
+        qDebug() << "[ReplayPlayer] Finished";
+        emit finished();
+        return;
+    }
+
+    // 等待的是与上一条操作的间隔，而不是绝对时间，界面忙时的重试不会让后面的操作挤在一起
+    uint32_t gap = replay.actions[nextIndex].timeMs - std::min(replay.actions[nextIndex].timeMs, lastActionTime);
+    int delay = 0;
+    switch (speed) {
+        case Speed::RealTime: delay = (int)gap; break;
+        case Speed::FastForward: delay = (int)(gap / kFastForwardFactor); break;
+        case Speed::Max: delay = 0; break;
+    }
+    stepTimer->start(delay);
+}
+
+void ReplayPlayer::step() {
+    const ReplayAction& action = replay.actions[nextIndex];
+    if (!apply(action)) {
+        stepTimer->start(kBusyRetryMs);
+        return;
+    }
+    lastActionTime = action.timeMs;
+    ++nextIndex;
+    emit progress(nextIndex, (int)replay.actions.size());
+    scheduleNext();
+}
@@ -0,0 +1,59 @@
+#ifndef REPLAY_PLAYER_H
+#define REPLAY_PLAYER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QString>
+#include <functional>
+#include "../logic/Replay.h"
+
+class QTimer;
+
+/**
+ * @brief 录像回放驱动
+ * 按录像中的时间戳把操作逐条交给游戏界面执行。界面正在播放动画（不可操作）时
+ * apply 返回 false，驱动器稍后重试同一条操作，因此回放不会因为动画时长不同而错位。
+ * 纯逻辑的最快速度回放见 runReplayHeadless。
+ */
+class ReplayPlayer : public QObject {
+    Q_OBJECT
+
+public:
+    enum class Speed {
+        RealTime,     // 按录制时的节奏
+        FastForward,  // 操作间隔缩短为 1/4
+        Max           // 不等待，界面可操作就立刻执行下一条
+    };
+
+    // 执行一条操作；返回 false 表示界面暂时不能操作，需要稍后重试
+    using ApplyFunc = std::function<bool(const ReplayAction&)>;
+
+    ReplayPlayer(const Replay& replay, Speed speed, ApplyFunc apply, QObject* parent = nullptr);
+
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    int getAppliedCount() const { return nextIndex; }
+    int getTotalCount() const { return (int)replay.actions.size(); }
+
+    // "1x" / "ff" / "max"，无法识别时返回 RealTime
+    static Speed parseSpeed(const QString& text);
+
+signals:
+    void progress(int applied, int total);
+    void finished();
+
+private:
+    void scheduleNext();
+    void step();
+
+    Replay replay;
+    Speed speed;
+    ApplyFunc apply;
+    QTimer* stepTimer;
+    int nextIndex = 0;
+    uint32_t lastActionTime = 0;  // 上一条操作在录像中的时间戳
+};
+
+#endif // REPLAY_PLAYER_H
@@ -0,0 +1,120 @@
+#include "ReplaySystem.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+
+namespace {
+constexpr int kMaxReplayFiles = 20;  // 只保留最近的 20 局
+const char* kReplaySuffix = ".bjr";
+
+const char* modeName(BoardMode mode) {
+    switch (mode) {
+        case BoardMode::Classic: return "classic";
+        case BoardMode::Whirlwind: return "whirlwind";
+        case BoardMode::Puzzle: return "puzzle";
+        case BoardMode::Multiplayer: return "multiplayer";
+    }
+    return "unknown";
+}
+}
+
+ReplaySystem& ReplaySystem::instance() {
+    static ReplaySystem instance;
+    return instance;
+}
+
+void ReplaySystem::beginRecording(BoardMode mode, int difficulty, uint64_t seed, int level, int baseScore) {
+    if (playingBack) return;
+
+    current = Replay();
+    current.mode = mode;
+    current.difficulty = difficulty;
+    current.seed = seed;
+    current.level = level;
+    this->baseScore = baseScore;
+    recording = true;
+    clock.start();
+    qDebug() << "[ReplaySystem] Recording started, mode:" << modeName(mode) << "seed:" << seed;
+}
+
+void ReplaySystem::setInitialBoard(const std::array<int8_t, Board::kCells>& types) {
+    if (!recording) return;
+    current.hasInitialBoard = true;
+    current.initialBoard = types;
+}
+
+void ReplaySystem::recordAction(ReplayAction::Kind kind, int row1, int col1, int row2, int col2) {
+    if (!recording) return;
+
+    ReplayAction action;
+    action.timeMs = (uint32_t)clock.elapsed();
+    action.kind = kind;
+    action.row1 = (uint8_t)row1;
+    action.col1 = (uint8_t)col1;
+    action.row2 = (uint8_t)row2;
+    action.col2 = (uint8_t)col2;
+    current.actions.push_back(action);
+}
+
+QString ReplaySystem::finishRecording(int score, int coins) {
+    if (!recording) return QString();
+    recording = false;
+
+    current.finalScore = score - baseScore;
+    current.finalCoins = coins;
+
+    QDir dir(getReplayDir());
+    if (!dir.exists() && !dir.mkpath(".")) {
+        qWarning() << "[ReplaySystem] Failed to create replay dir:" << dir.path();
+        return QString();
+    }
+
+    QString fileName = QString("%1_%2%3")
+        .arg(QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss"))
+        .arg(modeName(current.mode))
+        .arg(kReplaySuffix);
+    QString path = dir.filePath(fileName);
+
+    if (!current.saveToFile(QFile::encodeName(path).toStdString())) {
+        qWarning() << "[ReplaySystem] Failed to save replay:" << path;
+        return QString();
+    }
+    qDebug() << "[ReplaySystem] Replay saved:" << path << "actions:" << current.actions.size()
+             << "score:" << current.finalScore;
+
+    pruneOldReplays();
+    return path;
+}
+
+void ReplaySystem::cancelRecording() {
+    recording = false;
+    current.actions.clear();
+}
+
+QString ReplaySystem::getReplayDir() const {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/replays";
+}
+
+QStringList ReplaySystem::listReplays() const {
+    QDir dir(getReplayDir());
+    QStringList files = dir.entryList({QString("*") + kReplaySuffix}, QDir::Files, QDir::Time);
+    for (QString& file : files) file = dir.filePath(file);
+    return files;
+}
+
+bool ReplaySystem::loadReplay(const QString& path, Replay& replay) {
+    if (!replay.loadFromFile(QFile::encodeName(path).toStdString())) {
+        qWarning() << "[ReplaySystem] Invalid replay file:" << path;
+        return false;
+    }
+    return true;
+}
+
+void ReplaySystem::pruneOldReplays() {
+    QStringList files = listReplays();
+    for (int i = kMaxReplayFiles; i < files.size(); ++i) {
+        QFile::remove(files[i]);
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef REPLAY_SYSTEM_H
+#define REPLAY_SYSTEM_H
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include "../logic/Replay.h"
+
+/**
+ * @brief 录像系统
+ * 负责录制当前对局的玩家操作并在对局结束时写入录像文件，
+ * 同时标记是否处于回放中（回放时不扣道具、不加金币、不上传成绩）
+ * 单例模式，全局访问
+ */
+class ReplaySystem {
+public:
+    /**
+     * @brief 获取单例实例
+     */
+    static ReplaySystem& instance();
+
+    /**
+     * @brief 开始录制新的一局，回放中调用时忽略
+     * @param mode 游戏模式
+     * @param difficulty 难度（宝石种类数）
+     * @param seed 本局的随机种子
+     * @param level 解谜模式的关卡
+     * @param baseScore 开局时已有的分数（解谜模式跨关卡累计）
+     */
+    void beginRecording(BoardMode mode, int difficulty, uint64_t seed, int level = 1, int baseScore = 0);
+
+    /**
+     * @brief 保存初始棋盘（解谜模式的题目）
+     */
+    void setInitialBoard(const std::array<int8_t, Board::kCells>& types);
+
+    /**
+     * @brief 记录一条玩家操作，时间戳取自开局起的毫秒数
+     */
+    void recordAction(ReplayAction::Kind kind, int row1 = 0, int col1 = 0, int row2 = 0, int col2 = 0);
+
+    /**
+     * @brief 结束录制并写入录像目录
+     * @param score 本局最终分数
+     * @param coins 本局获得的金币
+     * @return 录像文件路径，未在录制或写入失败时为空
+     */
+    QString finishRecording(int score, int coins);
+
+    /**
+     * @brief 放弃当前录制（中途退出的对局不保存）
+     */
+    void cancelRecording();
+
+    bool isRecording() const { return recording; }
+
+    /**
+     * @brief 回放状态
+     */
+    void setPlayingBack(bool playing) { playingBack = playing; }
+    bool isPlayingBack() const { return playingBack; }
+
+    /**
+     * @brief 录像目录与已保存的录像（按时间从新到旧）
+     */
+    QString getReplayDir() const;
+    QStringList listReplays() const;
+
+    /**
+     * @brief 读取录像文件
+     */
+    static bool loadReplay(const QString& path, Replay& replay);
+
+private:
+    ReplaySystem() = default;
+    ReplaySystem(const ReplaySystem&) = delete;
+    ReplaySystem& operator=(const ReplaySystem&) = delete;
+
+    void pruneOldReplays();
+
+    Replay current;
+    QElapsedTimer clock;
+    int baseScore = 0;
+    bool recording = false;
+    bool playingBack = false;
+};
+
+#endif // REPLAY_SYSTEM_H
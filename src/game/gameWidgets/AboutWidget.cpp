@@ -14,11 +14,11 @@ AboutWidget::AboutWidget(QWidget *parent, GameWindow *gameWindow)
     setupAnimations();
     
     // Load background image
-    std::string bgPath = ResourceUtils::getPath("images/about_bg.png");
-    if (!backgroundPixmap.load(QString::fromStdString(bgPath))) {
+    backgroundPixmap.setSource(BackgroundCache::instance().loadResource("images/about_bg.png"));
+    if (backgroundPixmap.isNull()) {
         // Fallback or log error if needed, though usually ResourceUtils ensures path correctness
         // Try absolute path if resource utils fails or just for safety as per user request
-        backgroundPixmap.load("h:/CODE/Trae/Bejeweled/resources/images/about_bg.png");
+        backgroundPixmap.setSource(BackgroundCache::instance().load("h:/CODE/Trae/Bejeweled/resources/images/about_bg.png"));
     }
 
     // Background animation timer (only for border hue now)
@@ -189,7 +189,7 @@ void AboutWidget::paintEvent(QPaintEvent *event) {
         
         // Draw slightly larger than rect to cover edges during rotation
         QRect targetRect = rect().adjusted(-50, -50, 50, 50);
-        p.drawPixmap(targetRect, backgroundPixmap.scaled(targetRect.size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
+        p.drawPixmap(targetRect.topLeft(), backgroundPixmap.scaled(targetRect.size(), Qt::IgnoreAspectRatio));
         
         p.restore();
     } else {
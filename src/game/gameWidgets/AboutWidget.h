@@ -9,6 +9,7 @@
 #include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
 #include <QVector>
+#include "../../utils/BackgroundCache.h"
 
 class GameWindow;
 
@@ -35,7 +36,7 @@ private:
     QGraphicsOpacityEffect *opacityEffect;
     float bgHue = 0.0f;
     
-    QPixmap backgroundPixmap;
+    ScaledBackground backgroundPixmap;
 
     // Wind & Sakura Animation
     struct SakuraParticle {
@@ -2,6 +2,8 @@
 #include "../GameWindow.h"
 #include "../../utils/BackgroundManager.h"
 #include "../../utils/ResourceUtils.h"
+#include "../components/ParticleSystem.h"
+#include "../../utils/AnimationScheduler.h"
 #include <QVBoxLayout>
 #include <QGridLayout>
 #include <QFile>
@@ -69,6 +71,7 @@ public:
                 update();
             });
             timer->start(30);
+            AnimationScheduler::instance().registerTimer(this, timer);
         } else {
             timer = nullptr;
         }
@@ -397,6 +400,7 @@ void AchievementsWidget::refresh() {
 
 #include <random>
 #include <cmath>
+#include <cstring>
 #include <QMouseEvent>
 
 AchievementsBackgroundDecoration::AchievementsBackgroundDecoration(QWidget* parent)
@@ -408,17 +412,13 @@ AchievementsBackgroundDecoration::AchievementsBackgroundDecoration(QWidget* pare
         ResourceUtils::getPath(BackgroundManager::instance().getAchievementBackground())
     );
     if (QFile::exists(bgPath)) {
-        bgImage.load(bgPath);
+        bgImage.setSource(BackgroundCache::instance().load(bgPath));
     }
     setMouseTracking(true);
     
-    // 初始化动态星星粒子
+    // 初始化动态星星粒子，背景的云朵/海浪动画也跟着粒子系统的帧时钟走
     initParticles();
-    
-    // 启动动画定时器
-    animTimer = new QTimer(this);
-    connect(animTimer, &QTimer::timeout, this, &AchievementsBackgroundDecoration::updateAnimation);
-    animTimer->start(33); // ~30fps
+    connect(stars, &ParticleSystem::advanced, this, [this](float dt) { animTime += dt; });
 }
 
 void AchievementsBackgroundDecoration::mouseMoveEvent(QMouseEvent* event) {
@@ -446,6 +446,30 @@ void AchievementsBackgroundDecoration::leaveEvent(QEvent* event) {
     QWidget::leaveEvent(event);
 }
 
+// 星星精灵：外圈光晕 + 白色核心，核心半径 kStarCoreRadius，光晕为核心的 3 倍
+static constexpr int kStarCoreRadius = 16;
+
+static QImage renderStarSprite() {
+    const int glowRadius = kStarCoreRadius * 3;
+    QImage image(glowRadius * 2, glowRadius * 2, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(Qt::NoPen);
+    QPointF center(glowRadius, glowRadius);
+
+    QRadialGradient starGlow(center, glowRadius);
+    starGlow.setColorAt(0.0, QColor(255, 255, 255, 255));
+    starGlow.setColorAt(0.3, QColor(200, 220, 255, 128));
+    starGlow.setColorAt(1.0, QColor(150, 180, 255, 0));
+    p.setBrush(starGlow);
+    p.drawEllipse(center, glowRadius, glowRadius);
+
+    p.setBrush(QColor(255, 255, 255));
+    p.drawEllipse(center, kStarCoreRadius, kStarCoreRadius);
+    return image;
+}
+
 void AchievementsBackgroundDecoration::initParticles() {
     std::random_device rd;
     std::mt19937 gen(rd());
@@ -453,41 +477,114 @@ void AchievementsBackgroundDecoration::initParticles() {
     std::uniform_real_distribution<float> sizeDist(1.5f, 4.0f);
     std::uniform_real_distribution<float> phaseDist(0.0f, 6.28f);
     std::uniform_real_distribution<float> speedDist(0.5f, 2.0f);
-    std::uniform_real_distribution<float> driftDist(-0.0003f, 0.0003f);
-    
-    particles.clear();
+    std::uniform_real_distribution<float> driftDist(-0.009f, 0.009f); // 每秒飘动（比例坐标）
+
+    stars = new ParticleSystem(this);
+    stars->setSpace(ParticleSystem::Space::Normalized);
+    stars->setBounds(ParticleSystem::Bounds::Wrap);
+    // 亮度 0.5 + 0.5 * sin(...)，大小在 0.8 ~ 1.2 倍之间随亮度变化
+    stars->setTwinkle(1.0f, 0.2f);
+    int sprite = stars->addSprite(renderStarSprite());
+
     int numParticles = 60; // 星星数量
+    stars->reserve(numParticles);
     for (int i = 0; i < numParticles; ++i) {
-        StarParticle p;
+        ParticleSystem::Particle p;
         p.x = posDist(gen);
         p.y = posDist(gen);
-        p.size = sizeDist(gen);
-        p.alpha = posDist(gen);
+        p.scaleX = p.scaleY = sizeDist(gen) / kStarCoreRadius;
         p.twinklePhase = phaseDist(gen);
         p.twinkleSpeed = speedDist(gen);
-        p.driftX = driftDist(gen);
-        p.driftY = driftDist(gen);
-        particles.push_back(p);
+        p.vx = driftDist(gen);
+        p.vy = driftDist(gen);
+        p.sprite = sprite;
+        stars->spawn(p);
     }
 }
 
-void AchievementsBackgroundDecoration::updateAnimation() {
-    animTime += 0.033f;
-    
-    // 更新每个粒子
-    for (auto& p : particles) {
-        // 位置飘动
-        p.x += p.driftX;
-        p.y += p.driftY;
-        
-        // 边界环绕
-        if (p.x < 0) p.x = 1.0f;
-        if (p.x > 1) p.x = 0.0f;
-        if (p.y < 0) p.y = 1.0f;
-        if (p.y > 1) p.y = 0.0f;
+void AchievementsBackgroundDecoration::renderDisplacedBackground() {
+    if (width() <= 0 || height() <= 0) return;
+    const QPixmap& scaled = bgImage.scaled(size());
+    if (scaled.cacheKey() != sourceKey) {
+        sourceImage = scaled.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        sourceKey = scaled.cacheKey();
+    }
+    if (sourceImage.isNull()) return;
+    if (frame.size() != size()) {
+        frame = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+    }
+
+    const int w = width();
+    const int srcWidth = sourceImage.width();
+    // 居中裁剪偏移
+    int offsetX = (srcWidth - w) / 2;
+    int offsetY = (sourceImage.height() - height()) / 2;
+
+    // 区域划分：
+    // 云朵区域：画面上方25%有云飘动效果
+    int cloudEndY = static_cast<int>(height() * 0.25f);
+    // 云过渡区域：25%-35%之间平滑过渡
+    int cloudTransitionEndY = static_cast<int>(height() * 0.35f);
+    // 35%-80%：静止区域（椰树、房子、沙滩主体）
+    // 海浪区域：80%-98%（只有海水部分有波动）
+    int waveStartY = static_cast<int>(height() * 0.80f);
+    int waveEndY = static_cast<int>(height() * 0.98f);
+
+    float globalDrift = animTime * 8.0f; // 云朵向右飘动速度
+
+    // 逐行拷贝整个画面：每行是一段（云区域循环时两段）连续像素，memcpy 即可
+    for (int row = 0; row < height(); ++row) {
+        float totalOffset = 0.0f;
+        bool needWrap = false; // 是否需要循环处理（只有云区域需要）
+
+        if (row < cloudEndY) {
+            // 纯云区域：完整的飘动效果
+            float cloudHeight = 1.0f - (float)row / cloudEndY; // 越高飘得越快
+            totalOffset = std::fmod(globalDrift * (0.5f + cloudHeight * 0.5f), (float)srcWidth);
+            totalOffset += std::sin(animTime * 0.5f + row * 0.008f) * 3.0f * cloudHeight;
+            needWrap = true;
+        } else if (row < cloudTransitionEndY) {
+            // 云过渡区域：云飘动效果逐渐减弱到0
+            float transitionProgress = (float)(row - cloudEndY) / (cloudTransitionEndY - cloudEndY);
+            float fadeOut = 1.0f - transitionProgress;
+            fadeOut = fadeOut * fadeOut;
+            totalOffset = std::fmod(globalDrift * 0.5f * fadeOut, (float)srcWidth);
+            totalOffset += std::sin(animTime * 0.5f + row * 0.008f) * 3.0f * fadeOut;
+            needWrap = (totalOffset > 1.0f);
+        } else if (row >= waveStartY && row < waveEndY) {
+            // 海浪效果：上部海面轻柔波动，越靠近沙滩波动越强
+            float waveProgress = (float)(row - waveStartY) / (waveEndY - waveStartY);
+            // 从上到下逐渐增强：上部0.3，底部1.0
+            float waveIntensity = 0.3f + waveProgress * 0.7f;
+            // 多层波浪叠加
+            float wave1 = std::sin(animTime * 1.8f + row * 0.04f) * 8.0f;
+            float wave2 = std::sin(animTime * 2.5f + row * 0.06f) * 5.0f;
+            float wave3 = std::sin(animTime * 1.0f + row * 0.025f) * 6.0f;
+            totalOffset = (wave1 + wave2 + wave3) * waveIntensity;
+        }
+        // 其他区域（cloudTransitionEndY到waveStartY，以及waveEndY以下）：静止
+
+        int srcX = offsetX + static_cast<int>(totalOffset);
+        const QRgb* src = reinterpret_cast<const QRgb*>(sourceImage.constScanLine(offsetY + row));
+        QRgb* dst = reinterpret_cast<QRgb*>(frame.scanLine(row));
+
+        if (needWrap) {
+            // 云区域需要循环处理
+            srcX = ((srcX % srcWidth) + srcWidth) % srcWidth;
+
+            int remainWidth = srcWidth - srcX;
+            if (remainWidth >= w) {
+                std::memcpy(dst, src + srcX, w * sizeof(QRgb));
+            } else {
+                std::memcpy(dst, src + srcX, remainWidth * sizeof(QRgb));
+                std::memcpy(dst + remainWidth, src, (w - remainWidth) * sizeof(QRgb));
+            }
+        } else {
+            // 非云区域：限制偏移范围，不循环
+            srcX = qBound(0, srcX, srcWidth - w);
+            std::memcpy(dst, src + srcX, w * sizeof(QRgb));
+        }
     }
-    
-    update(); // 触发重绘
 }
 
 void AchievementsBackgroundDecoration::paintEvent(QPaintEvent*) {
@@ -497,74 +594,8 @@ void AchievementsBackgroundDecoration::paintEvent(QPaintEvent*) {
 
     // 1. 先绘制背景图片（整体动画效果）
     if (!bgImage.isNull()) {
-        QPixmap scaled = bgImage.scaled(size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-        // 居中裁剪偏移
-        int offsetX = (scaled.width() - width()) / 2;
-        int offsetY = (scaled.height() - height()) / 2;
-        
-        // 区域划分：
-        // 云朵区域：画面上方25%有云飘动效果
-        int cloudEndY = static_cast<int>(height() * 0.25f);
-        // 云过渡区域：25%-35%之间平滑过渡
-        int cloudTransitionEndY = static_cast<int>(height() * 0.35f);
-        // 35%-80%：静止区域（椰树、房子、沙滩主体）
-        // 海浪区域：80%-98%（只有海水部分有波动）
-        int waveStartY = static_cast<int>(height() * 0.80f);
-        int waveEndY = static_cast<int>(height() * 0.98f);
-        
-        float globalDrift = animTime * 8.0f; // 云朵向右飘动速度
-        
-        // 逐行绘制整个画面
-        for (int row = 0; row < height(); ++row) {
-            float totalOffset = 0.0f;
-            bool needWrap = false; // 是否需要循环处理（只有云区域需要）
-            
-            if (row < cloudEndY) {
-                // 纯云区域：完整的飘动效果
-                float cloudHeight = 1.0f - (float)row / cloudEndY; // 越高飘得越快
-                totalOffset = std::fmod(globalDrift * (0.5f + cloudHeight * 0.5f), (float)scaled.width());
-                totalOffset += std::sin(animTime * 0.5f + row * 0.008f) * 3.0f * cloudHeight;
-                needWrap = true;
-            } else if (row < cloudTransitionEndY) {
-                // 云过渡区域：云飘动效果逐渐减弱到0
-                float transitionProgress = (float)(row - cloudEndY) / (cloudTransitionEndY - cloudEndY);
-                float fadeOut = 1.0f - transitionProgress;
-                fadeOut = fadeOut * fadeOut;
-                totalOffset = std::fmod(globalDrift * 0.5f * fadeOut, (float)scaled.width());
-                totalOffset += std::sin(animTime * 0.5f + row * 0.008f) * 3.0f * fadeOut;
-                needWrap = (totalOffset > 1.0f);
-            } else if (row >= waveStartY && row < waveEndY) {
-                // 海浪效果：上部海面轻柔波动，越靠近沙滩波动越强
-                float waveProgress = (float)(row - waveStartY) / (waveEndY - waveStartY);
-                // 从上到下逐渐增强：上部0.3，底部1.0
-                float waveIntensity = 0.3f + waveProgress * 0.7f;
-                // 多层波浪叠加
-                float wave1 = std::sin(animTime * 1.8f + row * 0.04f) * 8.0f;
-                float wave2 = std::sin(animTime * 2.5f + row * 0.06f) * 5.0f;
-                float wave3 = std::sin(animTime * 1.0f + row * 0.025f) * 6.0f;
-                totalOffset = (wave1 + wave2 + wave3) * waveIntensity;
-            }
-            // 其他区域（cloudTransitionEndY到waveStartY，以及waveEndY以下）：静止
-            
-            int srcX = offsetX + static_cast<int>(totalOffset);
-            
-            if (needWrap) {
-                // 云区域需要循环处理
-                srcX = ((srcX % scaled.width()) + scaled.width()) % scaled.width();
-                
-                int remainWidth = scaled.width() - srcX;
-                if (remainWidth >= width()) {
-                    p.drawPixmap(0, row, scaled, srcX, offsetY + row, width(), 1);
-                } else {
-                    p.drawPixmap(0, row, scaled, srcX, offsetY + row, remainWidth, 1);
-                    p.drawPixmap(remainWidth, row, scaled, 0, offsetY + row, width() - remainWidth, 1);
-                }
-            } else {
-                // 非云区域：限制偏移范围，不循环
-                srcX = qBound(0, srcX, scaled.width() - width());
-                p.drawPixmap(0, row, scaled, srcX, offsetY + row, width(), 1);
-            }
-        }
+        renderDisplacedBackground();
+        p.drawImage(0, 0, frame);
     } else {
         // 如果没有背景图片，使用蓝紫渐变背景
         QLinearGradient grad(rect().topLeft(), rect().bottomRight());
@@ -574,27 +605,8 @@ void AchievementsBackgroundDecoration::paintEvent(QPaintEvent*) {
         p.fillRect(rect(), grad);
     }
 
-    // 2. 绘制动态闪烁星星粒子
-    for (const auto& star : particles) {
-        float twinkle = 0.5f + 0.5f * std::sin(animTime * star.twinkleSpeed + star.twinklePhase);
-        int alpha = static_cast<int>(twinkle * 255);
-        int px = static_cast<int>(star.x * width());
-        int py = static_cast<int>(star.y * height());
-        int sz = static_cast<int>(star.size * (0.8f + 0.4f * twinkle));
-        
-        // 星星发光
-        QRadialGradient starGlow(px, py, sz * 3);
-        starGlow.setColorAt(0.0, QColor(255, 255, 255, alpha));
-        starGlow.setColorAt(0.3, QColor(200, 220, 255, alpha / 2));
-        starGlow.setColorAt(1.0, QColor(150, 180, 255, 0));
-        p.setBrush(starGlow);
-        p.setPen(Qt::NoPen);
-        p.drawEllipse(QPoint(px, py), sz * 3, sz * 3);
-        
-        // 星星核心
-        p.setBrush(QColor(255, 255, 255, alpha));
-        p.drawEllipse(QPoint(px, py), sz, sz);
-    }
+    // 2. 绘制动态闪烁星星粒子（整批一次绘制）
+    stars->draw(p);
 
     // 星星人偶参数
     int starSize = 64;
@@ -1,19 +1,13 @@
 #include <QPainter>
+#include <QImage>
 #include <random>
 #include <QWidget>
 #include <QPaintEvent>
 #include <QTimer>
 #include <vector>
+#include "../../utils/BackgroundCache.h"
 
-// 动态星星粒子
-struct StarParticle {
-    float x, y;           // 位置 (0-1 归一化)
-    float size;           // 大小
-    float alpha;          // 透明度
-    float twinklePhase;   // 闪烁相位
-    float twinkleSpeed;   // 闪烁速度
-    float driftX, driftY; // 飘动速度
-};
+class ParticleSystem;
 
 // 背景装饰层：绘制星星和宝石
 class AchievementsBackgroundDecoration : public QWidget {
@@ -25,18 +19,20 @@ class AchievementsBackgroundDecoration : public QWidget {
 public:
     explicit AchievementsBackgroundDecoration(QWidget* parent = nullptr);
     void setContentMargin(int margin) { contentMargin = margin; }
-private slots:
-    void updateAnimation();
 private:
     void initParticles();
+    // 云朵 / 海浪的逐行位移：在常驻的 frame 缓冲里按行拷贝，整帧只需一次 drawImage
+    void renderDisplacedBackground();
     int contentMargin = 0;
     QPixmap userBg;
-    QPixmap bgImage; // 背景图片
+    ScaledBackground bgImage; // 背景图片，按控件尺寸缓存缩放结果
+    QImage sourceImage;       // 缩放后的背景转成的 ARGB32 图，逐行取像素用
+    qint64 sourceKey = 0;     // sourceImage 对应的缩放结果
+    QImage frame;             // 每帧写入位移后的背景，尺寸不变时复用
     bool starShy = false;
     QRect starRectCache;
-    // 动画系统
-    QTimer* animTimer = nullptr;
-    std::vector<StarParticle> particles;
+    // 动画系统：闪烁星星由粒子系统绘制，animTime 跟随它的帧时钟推进（控件隐藏时停止）
+    ParticleSystem* stars = nullptr;
     float animTime = 0;
 };
 #ifndef ACHIEVEMENTS_WIDGET_H
@@ -119,12 +119,7 @@ void FinalWidget::loadBackground() {
     QString bgPath = QString::fromStdString(
         ResourceUtils::getPath(BackgroundManager::instance().getFinalWidgetBackground())
     );
-    if (QFile::exists(bgPath)) {
-        backgroundPixmap.load(bgPath);
-        hasBackground = !backgroundPixmap.isNull();
-    } else {
-        hasBackground = false;
-    }
+    background.setSource(QFile::exists(bgPath) ? BackgroundCache::instance().load(bgPath) : QPixmap());
     update();
 }
 
@@ -133,9 +128,8 @@ void FinalWidget::paintEvent(QPaintEvent* event) {
     QPainter p(this);
     p.setRenderHint(QPainter::SmoothPixmapTransform, true);
 
-    if (hasBackground) {
-        QPixmap scaled = backgroundPixmap.scaled(size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-        p.drawPixmap(0, 0, scaled);
+    if (!background.isNull()) {
+        p.drawPixmap(0, 0, background.scaled(size()));
     } else {
         p.fillRect(rect(), QColor(8, 10, 18));
     }
@@ -145,5 +139,6 @@ void FinalWidget::paintEvent(QPaintEvent* event) {
 
 void FinalWidget::resizeEvent(QResizeEvent* event) {
     QWidget::resizeEvent(event);
+    background.invalidate();
     update();
 }
@@ -3,6 +3,7 @@
 
 #include <QWidget>
 #include <QPixmap>
+#include "../../utils/BackgroundCache.h"
 #include <string>
 
 class GameWindow;
@@ -30,8 +31,7 @@ private:
 
     GameWindow* gameWindow = nullptr;
 
-    QPixmap backgroundPixmap;
-    bool hasBackground = false;
+    ScaledBackground background;
 
     QVBoxLayout* mainLayout = nullptr;
     QWidget* panelWidget = nullptr;
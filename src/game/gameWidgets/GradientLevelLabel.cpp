@@ -1,4 +1,5 @@
 #include "GradientLevelLabel.h"
+#include "../../utils/AnimationScheduler.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QLinearGradient>
@@ -26,6 +27,7 @@ GradientLevelLabel::GradientLevelLabel(QWidget* parent)
     if (m_animationEnabled) {
         m_highlightTimer->start();
     }
+    AnimationScheduler::instance().registerTimer(this, m_highlightTimer);
 }
 
 GradientLevelLabel::~GradientLevelLabel() {
@@ -1,6 +1,7 @@
 #include "MenuWidget.h"
 #include "../GameWindow.h"
 #include "../components/MenuButton.h"
+#include "../../utils/AnimationScheduler.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QPainter>
@@ -40,6 +41,8 @@ MenuWidget::MenuWidget(QWidget* parent, GameWindow* gameWindow)
     : QWidget(parent), gameWindow(gameWindow) {
     setupUI();
     setup3DView();
+    // 背景 3D 场景的循环动画在离开本界面时暂停
+    AnimationScheduler::instance().registerScene(this, view3D, [this]() { return rootEntity; });
 }
 
 MenuWidget::~MenuWidget() {
@@ -491,6 +494,7 @@ void MenuWidget::setup3DView() {
 
 void MenuWidget::resizeEvent(QResizeEvent* event) {
     QWidget::resizeEvent(event);
+    background.invalidate();
     if (view3DContainer) {
         view3DContainer->setGeometry(rect());
         view3DContainer->lower(); // Ensure it stays behind
@@ -498,19 +502,17 @@ void MenuWidget::resizeEvent(QResizeEvent* event) {
 }
 
 void MenuWidget::setBackgroundImage(const QPixmap& pixmap) {
-    backgroundPixmap = pixmap;
-    hasBackground = !backgroundPixmap.isNull();
+    background.setSource(pixmap);
     update();
 }
 
 void MenuWidget::paintEvent(QPaintEvent* event) {
     Q_UNUSED(event);
     QPainter p(this);
-    if (hasBackground) {
+    if (!background.isNull()) {
         // 背景图自适应拉伸，保持透明度
-        QPixmap scaled = backgroundPixmap.scaled(size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
         p.setOpacity(0.8); // 背景图透明度，避免遮挡3D元素
-        p.drawPixmap(0, 0, scaled);
+        p.drawPixmap(0, 0, background.scaled(size()));
         p.setOpacity(1.0);
     }
 }
@@ -3,6 +3,7 @@
 #include <QWidget>
 #include <QPixmap>
 #include <QColor>
+#include "../../utils/BackgroundCache.h"
 
 class GameWindow;
 class QVBoxLayout;
@@ -64,8 +65,7 @@ private:
     QVBoxLayout* leftLayout = nullptr;
     QWidget* view3DContainer = nullptr;
 
-    QPixmap backgroundPixmap;
-    bool hasBackground = false;
+    ScaledBackground background;
 
     Qt3DExtras::Qt3DWindow* view3D = nullptr;
     Qt3DCore::QEntity* rootEntity = nullptr;
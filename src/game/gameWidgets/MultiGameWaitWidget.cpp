@@ -5,6 +5,7 @@
 #include "../GameWindow.h"
 #include "../data/GameNetData.h"
 #include "../components/MenuButton.h"
+#include "../../utils/AnimationScheduler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QResizeEvent>
@@ -34,6 +35,8 @@ MultiGameWaitWidget::MultiGameWaitWidget(QWidget* parent, GameWindow* gameWindow
     : QWidget(parent), gameWindow(gameWindow), isInRoom(false), roomPeopleHave(0) {
     setupUI();
     setup3DView();
+    // 背景 3D 场景的循环动画在离开本界面时暂停
+    AnimationScheduler::instance().registerScene(this, view3D, [this]() { return rootEntity; });
 }
 
 void MultiGameWaitWidget::enterRoom() {
@@ -4,11 +4,19 @@
 #include "MenuWidget.h"
 #include "../GameWindow.h"
 #include "../components/Gemstone.h"
+#include "../components/BoardReshuffler.h"
+#include "../components/PerfHud.h"
+#include "../components/IdleAnimationDriver.h"
+#include "SettingWidget.h"
 #include "../components/SelectedCircle.h"
 #include "../data/GameNetData.h"
 #include "../../utils/LogWindow.h"
 #include "../../utils/AudioManager.h"
+#include "../../utils/PerfStats.h"
+#include "../../utils/AnimationScheduler.h"
 #include "../data/AchievementSystem.h"
+#include "../data/ReplaySystem.h"
+#include "../logic/Board.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QPushButton>
@@ -189,6 +197,10 @@ MultiplayerModeGameWidget::MultiplayerModeGameWidget(QWidget* parent, GameWindow
     
     // 创建3D窗口容器
     container3d = QWidget::createWindowContainer(game3dWindow);
+    // 离开本界面时停掉计时器、暂停宝石待机动画并让 3D 窗口停止出帧
+    idleDriver = new IdleAnimationDriver(this, game3dWindow, [this]() { return rootEntity; });
+    AnimationScheduler::instance().registerTimer(this, timer);
+    AnimationScheduler::instance().registerScene(this, game3dWindow, [this]() { return rootEntity; });
     // container3d->setFixedSize(1000, 1000); // 移除固定大小
     container3d->setMinimumSize(600, 600); // 设置最小大小
     container3d->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -349,6 +361,10 @@ MultiplayerModeGameWidget::MultiplayerModeGameWidget(QWidget* parent, GameWindow
     player2Window = new Qt3DExtras::Qt3DWindow();
     setupSmall3DWindow(player2Window, &player2RootEntity, &player2Camera);
     player2Container = QWidget::createWindowContainer(player2Window);
+    player1IdleDriver = new IdleAnimationDriver(this, player1Window, [this]() { return player1RootEntity; });
+    player2IdleDriver = new IdleAnimationDriver(this, player2Window, [this]() { return player2RootEntity; });
+    AnimationScheduler::instance().registerScene(this, player1Window, [this]() { return player1RootEntity; });
+    AnimationScheduler::instance().registerScene(this, player2Window, [this]() { return player2RootEntity; });
     // player2Container->setFixedSize(400, 400); // 移除固定大小
     player2Container->setMinimumSize(200, 200); // 设置最小大小
     player2Container->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -386,6 +402,9 @@ MultiplayerModeGameWidget::MultiplayerModeGameWidget(QWidget* parent, GameWindow
     container3d->installEventFilter(this);
     game3dWindow->installEventFilter(this); // 关键：在3D窗口上安装事件过滤器
 
+    // 性能浮层（F3 开关）
+    perfHud = new PerfHud(this, game3dWindow, rootEntity);
+
     // 初始化无操作计时器
     inactivityTimer = new QTimer(this);
     inactivityTimer->setInterval(inactivityTimeout);
@@ -482,6 +501,8 @@ void MultiplayerModeGameWidget::finishToFinalWidget() {
     isFinishing = true;
     canOpe = false;
 
+    ReplaySystem::instance().finishRecording(gameScore, 0);
+
     if (timer && timer->isActive()) timer->stop();
     gameTimeKeeper.pause();
     if (inactivityTimer) inactivityTimer->stop();
@@ -768,11 +789,13 @@ void MultiplayerModeGameWidget::remove3x3AreaChain(int centerRow, int centerCol)
 
 
 void MultiplayerModeGameWidget::eliminate() {
+    PhaseTimer phaseTimer(PerfStats::Eliminate);
     if (isStop) return;
     if (isFinishing) return;
     // 查找所有匹配
     std::vector<std::pair<int, int>> matches = findMatches(-1,-1,-1);
     if (!matches.empty()) {
+        PerfStats::instance().cascadeStep();
         // //DEBUG
         // QDialog* dialog = new QDialog(this);
         // dialog->setWindowTitle("匹配消除");
@@ -798,7 +821,13 @@ void MultiplayerModeGameWidget::eliminate() {
             drop();
         });
     } else {
+        PerfStats::instance().cascadeFinished();
         comboCount = 0;
+        // 连锁结束时用提示查找的结果判断死局，重排后再同步棋盘
+        if (findPossibleMatches().empty()) {
+            reshuffleDeadBoard();
+            return;
+        }
         // 没有匹配了，恢复操作
         canOpe = true;
         resetInactivityTimer();
@@ -811,6 +840,7 @@ void MultiplayerModeGameWidget::eliminate() {
 }
 
 void MultiplayerModeGameWidget::drop() {
+    PhaseTimer phaseTimer(PerfStats::Drop);
     if (isStop) return;
     if (isFinishing) return;
     appendDebug("Starting drop animation");
@@ -829,6 +859,7 @@ void MultiplayerModeGameWidget::drop() {
 
                     QVector3D targetPos = getPosition(writePos, col);
                     QPropertyAnimation* dropAnim = new QPropertyAnimation(gem->transform(), "translation");
+                    PerfStats::instance().trackAnimation(dropAnim);
                     dropAnim->setDuration(500);
                     dropAnim->setStartValue(gem->transform()->translation());
                     dropAnim->setEndValue(targetPos);
@@ -858,6 +889,7 @@ void MultiplayerModeGameWidget::drop() {
 }
 
 void MultiplayerModeGameWidget::resetGemstoneTable() {
+    PhaseTimer phaseTimer(PerfStats::Refill);
     if (isStop) return;
     if (isFinishing) return;
     appendDebug("Filling empty positions with new gemstones");
@@ -871,7 +903,7 @@ void MultiplayerModeGameWidget::resetGemstoneTable() {
         for (int row = 0; row < 8; ++row) {
             if (gemstoneContainer[row][col] == nullptr) {
                 // 创建新宝石，避免立即形成三连
-                int type = QRandomGenerator::global()->bounded(difficulty);
+                int type = rng.bounded(difficulty);
 
                 // 检查左边两个
                 if (col >= 2 && gemstoneContainer[row][col-1] && gemstoneContainer[row][col-2]) {
@@ -912,6 +944,7 @@ void MultiplayerModeGameWidget::resetGemstoneTable() {
 
                 // 创建下落动画
                 QPropertyAnimation* fillAnim = new QPropertyAnimation(gem->transform(), "translation");
+                PerfStats::instance().trackAnimation(fillAnim);
                 fillAnim->setDuration(500);
                 fillAnim->setStartValue(startPos);
                 fillAnim->setEndValue(targetPos);
@@ -963,6 +996,7 @@ void MultiplayerModeGameWidget::eliminateAnime(Gemstone* gemstone) {
     
     // Parent animation to gemstone so it dies when gemstone dies
     QPropertyAnimation* animation = new QPropertyAnimation(gemstone->transform(), "scale", gemstone);
+    PerfStats::instance().trackAnimation(animation);
     animation->setDuration(500); // 持续缩小直到不见
     animation->setStartValue(gemstone->transform()->scale());
     animation->setEndValue(0.0f);
@@ -989,11 +1023,13 @@ void MultiplayerModeGameWidget::switchGemstoneAnime(Gemstone* gemstone1, Gemston
     QParallelAnimationGroup* group = new QParallelAnimationGroup(this);
     
     QPropertyAnimation* anim1 = new QPropertyAnimation(gemstone1->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim1);
     anim1->setDuration(500); // 0.5s
     anim1->setStartValue(pos1);
     anim1->setEndValue(pos2);
     
     QPropertyAnimation* anim2 = new QPropertyAnimation(gemstone2->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim2);
     anim2->setDuration(500); // 0.5s
     anim2->setStartValue(pos2);
     anim2->setEndValue(pos1);
@@ -1116,6 +1152,11 @@ void MultiplayerModeGameWidget::mouseReleaseEvent(QMouseEvent* event) {
 
 void MultiplayerModeGameWidget::showEvent(QShowEvent* event) {
     QWidget::showEvent(event);
+    // 待机动画模式可能在设置界面里改过
+    IdleAnimationDriver::Mode idleMode = static_cast<IdleAnimationDriver::Mode>(SettingWidget::getIdleSpinMode());
+    if (idleDriver) idleDriver->setMode(idleMode);
+    if (player1IdleDriver) player1IdleDriver->setMode(idleMode);
+    if (player2IdleDriver) player2IdleDriver->setMode(idleMode);
     if (container3d) {
         container3d->setFocus(Qt::OtherFocusReason);
         container3d->raise();
@@ -1406,6 +1447,9 @@ void MultiplayerModeGameWidget::setMode(int mode) {
 }
 
 void MultiplayerModeGameWidget::reset(int mode) {
+    // 每局一个独立的随机数流
+    rng.reseed(GameRng::makeSeed());
+    ReplaySystem::instance().beginRecording(BoardMode::Multiplayer, difficulty, rng.seed());
     this->isStop = false;
     this->mode = mode;
     this->canOpe = true;
@@ -1432,31 +1476,12 @@ void MultiplayerModeGameWidget::reset(int mode) {
     // 重建8x8网格
     gemstoneContainer.resize(8);
 
+    // 一次生成整盘类型：没有现成三连，并保证有可走步
+    std::array<int8_t, Board::kCells> types = Board::generateTypes(difficulty, rng, Board::defaultGenerateOptions(BoardMode::Multiplayer));
     for (int i = 0; i < 8; ++i) {
         gemstoneContainer[i].resize(8);
         for (int j = 0; j < 8; ++j) {
-            int type = QRandomGenerator::global()->bounded(difficulty);
-
-            // 避免在初始化时创建三连
-            // 检查左边两个
-            if (j >= 2 && gemstoneContainer[i][j-1] && gemstoneContainer[i][j-2]) {
-                int type1 = gemstoneContainer[i][j-1]->getType();
-                int type2 = gemstoneContainer[i][j-2]->getType();
-                if (type1 == type2 && type == type1) {
-                    // 会形成三连，换一个类型
-                    type = (type + 1) % difficulty;
-                }
-            }
-
-            // 检查上边两个
-            if (i >= 2 && gemstoneContainer[i-1][j] && gemstoneContainer[i-2][j]) {
-                int type1 = gemstoneContainer[i-1][j]->getType();
-                int type2 = gemstoneContainer[i-2][j]->getType();
-                if (type1 == type2 && type == type1) {
-                    // 会形成三连，换一个类型
-                    type = (type + 1) % difficulty;
-                }
-            }
+            int type = types[i * 8 + j];
 
             Gemstone* gem = new Gemstone(type, "default", rootEntity);
 
@@ -1525,6 +1550,7 @@ bool MultiplayerModeGameWidget::areAdjacent(int row1, int col1, int row2, int co
 void MultiplayerModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1, int col1, int row2, int col2) {
     if (isStop) return;
     if (!gem1 || !gem2) return;
+    ReplaySystem::instance().recordAction(ReplayAction::Swap, row1, col1, row2, col2);
 
     // Send swap message to server (type=1)
     GameNetData swapData;
@@ -1546,11 +1572,13 @@ void MultiplayerModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int
     QParallelAnimationGroup* group = new QParallelAnimationGroup();
 
     QPropertyAnimation* anim1 = new QPropertyAnimation(gem1->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim1);
     anim1->setDuration(500);
     anim1->setStartValue(pos1);
     anim1->setEndValue(pos2);
 
     QPropertyAnimation* anim2 = new QPropertyAnimation(gem2->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim2);
     anim2->setDuration(500);
     anim2->setStartValue(pos2);
     anim2->setEndValue(pos1);
@@ -1583,11 +1611,13 @@ void MultiplayerModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int
             QParallelAnimationGroup* swapBackGroup = new QParallelAnimationGroup();
 
             QPropertyAnimation* backAnim1 = new QPropertyAnimation(gem1->transform(), "translation");
+            PerfStats::instance().trackAnimation(backAnim1);
             backAnim1->setDuration(500);
             backAnim1->setStartValue(pos1);
             backAnim1->setEndValue(pos2);
 
             QPropertyAnimation* backAnim2 = new QPropertyAnimation(gem2->transform(), "translation");
+            PerfStats::instance().trackAnimation(backAnim2);
             backAnim2->setDuration(500);
             backAnim2->setStartValue(pos2);
             backAnim2->setEndValue(pos1);
@@ -1787,11 +1817,8 @@ void MultiplayerModeGameWidget::highlightMatches() {
     // 找到所有可消除的宝石
     std::vector<std::pair<int, int>> matches = findPossibleMatches();
     if (matches.empty()) {
-        appendDebug("No possible matches found,resetting the game");
-        int TmpScore = gameScore;
-        reset(1);
-        gameScore = TmpScore;
-        updateScoreBoard();
+        // 开局棋盘就是死局时走到这里；连锁结束后的死局在 eliminate() 中已经处理
+        reshuffleDeadBoard();
         return ;
     }
     
@@ -1855,6 +1882,10 @@ int MultiplayerModeGameWidget::getDifficulty() const {
     return difficulty;
 }
 
+uint64_t MultiplayerModeGameWidget::getSeed() const {
+    return rng.seed();
+}
+
 // ==================== Network Functions ====================
 
 void MultiplayerModeGameWidget::sendNetData(const GameNetData& data) {
@@ -2064,6 +2095,32 @@ std::vector<std::vector<int>> MultiplayerModeGameWidget::getCurrentBoardState()
     return boardState;
 }
 
+// 死局重排：与单人模式相同交给 BoardReshuffler，动画结束后同步棋盘
+void MultiplayerModeGameWidget::reshuffleDeadBoard() {
+    if (isStop || isFinishing) return;
+
+    clearHighlights();
+    firstSelectedGemstone = nullptr;
+    secondSelectedGemstone = nullptr;
+    selectedNum = 0;
+    selectionRing1->setVisible(false);
+    selectionRing2->setVisible(false);
+    canOpe = false;
+
+    int recolored = BoardReshuffler::reshuffle(
+        BoardMode::Multiplayer, difficulty, rng, gemstoneContainer,
+        [this](int row, int col) { return getPosition(row, col); }, this, [this]() {
+            if (isStop || isFinishing) return;
+            canOpe = true;
+            resetInactivityTimer();
+            sendNowBoard();
+            appendDebug("Reshuffle animation finished");
+        });
+
+    appendDebug(QString("No possible matches found, reshuffling the board (recolored %1)").arg(recolored));
+    ReplaySystem::instance().recordAction(ReplayAction::Reshuffle);
+}
+
 void MultiplayerModeGameWidget::sendBoardSyncMessage() {
     if (isStop) return;
 
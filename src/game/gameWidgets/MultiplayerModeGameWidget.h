@@ -7,6 +7,7 @@
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QString>
+#include "../logic/GameRng.h"
 #include <QVBoxLayout>
 #include <Qt3DExtras/Qt3DWindow>
 #include <Qt3DCore/QEntity>
@@ -19,6 +20,8 @@
 class QTextEdit;
 class QLabel;
 class QPushButton;
+class PerfHud;
+class IdleAnimationDriver;
 class QShowEvent;
 class QEvent;
 class QHideEvent;
@@ -75,6 +78,10 @@ public:
     void setDifficulty(int diff);
     int getDifficulty() const;
 
+    // 本局随机种子（写进录像）。联机对局每个客户端各自取种子，棋盘仍靠 type 4 消息同步：
+    // 开局消息由服务器下发，协议里没有种子字段
+    uint64_t getSeed() const;
+
     // Network-related methods
     void sendNetData(const GameNetData& data);
     void handleReceivedData(const GameNetData& data);
@@ -110,6 +117,7 @@ private:
 
     void clearHighlights();
     void highlightMatches();
+    void reshuffleDeadBoard();
     void resetInactivityTimer();
 
     void updateScoreBoard();
@@ -152,6 +160,7 @@ private:
     int comboCount = 0; 
     
     int difficulty = 4;
+    GameRng rng; // 本局的棋盘随机数流
     bool isDragging;
 
     GameWindow* gameWindow;
@@ -208,6 +217,10 @@ private:
     // Debug UI
     QTextEdit* debugText;
     QLabel* focusInfoLabel;
+    PerfHud* perfHud = nullptr;
+    IdleAnimationDriver* idleDriver = nullptr;  // 按需渲染与待机动画降频
+    IdleAnimationDriver* player1IdleDriver = nullptr;
+    IdleAnimationDriver* player2IdleDriver = nullptr;
     QTimer* debugTimer;
 
     QWidget* rightPanel = nullptr;
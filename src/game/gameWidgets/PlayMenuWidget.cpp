@@ -5,6 +5,7 @@
 #include "MultiGameWaitWidget.h"
 #include "PuzzleModeGameWidget.h"
 #include "../components/MenuButton.h"
+#include "../../utils/AnimationScheduler.h"
 #include "../data/GameNetData.h"
 #include "../../auth/components/AuthNoticeDialog.h"
 #include "../data/NetDataIO.h"
@@ -42,6 +43,8 @@ PlayMenuWidget::PlayMenuWidget(QWidget* parent, GameWindow* gameWindow)
     : QWidget(parent), gameWindow(gameWindow) {
     setupUI();
     setup3DView();
+    // 背景 3D 场景的循环动画在离开本界面时暂停
+    AnimationScheduler::instance().registerScene(this, view3D, [this]() { return rootEntity; });
 }
 
 void PlayMenuWidget::setupUI() {
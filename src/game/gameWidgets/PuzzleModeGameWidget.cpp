@@ -3,11 +3,19 @@
 #include "MenuWidget.h"
 #include "../GameWindow.h"
 #include "../components/Gemstone.h"
+#include "../components/PerfHud.h"
+#include "../components/IdleAnimationDriver.h"
+#include "SettingWidget.h"
 #include "../components/SelectedCircle.h"
 #include "../../utils/AudioManager.h"
+#include "../../utils/PerfStats.h"
+#include "../../utils/AnimationScheduler.h"
 #include "../../utils/ResourceUtils.h"
 #include "GradientLevelLabel.h"
 #include "../data/AchievementSystem.h"
+#include "../data/ReplaySystem.h"
+#include "../logic/PuzzleGenerator.h"
+#include "../logic/PuzzleSolver.h"
 #include "VictoryBanner.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -33,6 +41,9 @@
 #include <QPainterPath>
 #include <QDateTime>
 #include <QApplication>
+#include <QCoreApplication>
+#include <QFile>
+#include <QDebug>
 #include <cmath>
 #include <limits>
 #include <iostream>
@@ -46,6 +57,11 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+// 倒推生成偶尔会留下悬空宝石导致无解，最多重新生成这么多次
+constexpr int kMaxPuzzleAttempts = 16;
+}
+
 class GameBackDialog : public QDialog {
 public:
     explicit GameBackDialog(QWidget* parent = nullptr) : QDialog(parent) {
@@ -191,6 +207,10 @@ PuzzleModeGameWidget::PuzzleModeGameWidget(QWidget* parent, GameWindow* gameWind
     
     // 创建3D窗口容器
     container3d = QWidget::createWindowContainer(game3dWindow);
+    // 离开本界面时停掉计时器、暂停宝石待机动画并让 3D 窗口停止出帧
+    idleDriver = new IdleAnimationDriver(this, game3dWindow, [this]() { return rootEntity; });
+    AnimationScheduler::instance().registerTimer(this, timer);
+    AnimationScheduler::instance().registerScene(this, game3dWindow, [this]() { return rootEntity; });
     // container3d->setFixedSize(960, 960); // 移除固定大小
     container3d->setMinimumSize(600, 600); // 设置最小大小
     container3d->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -355,6 +375,9 @@ PuzzleModeGameWidget::PuzzleModeGameWidget(QWidget* parent, GameWindow* gameWind
     mainLayout->addWidget(rightPanel, 0, Qt::AlignRight | Qt::AlignVCenter);
     container3d->installEventFilter(this);
     game3dWindow->installEventFilter(this); // 关键：在3D窗口上安装事件过滤器
+
+    // 性能浮层（F3 开关）
+    perfHud = new PerfHud(this, game3dWindow, rootEntity);
     rightPanel->installEventFilter(this); // 为右侧面板安装事件过滤器
 
     // 初始化无操作计时器
@@ -369,6 +392,8 @@ PuzzleModeGameWidget::PuzzleModeGameWidget(QWidget* parent, GameWindow* gameWind
 
     inactivityTimer->stop();
 
+    openLevelPack();
+
     updateScoreBoard();
     updateTimeBoard();
     appendDebug("SingleModeGameWidget initialized - EventFilter installed on both container and 3D window");
@@ -417,6 +442,7 @@ void PuzzleModeGameWidget::finishToNextLevel() {
     canOpe = false;
     
     AchievementSystem::instance().triggerPuzzleModeComplete();
+    ReplaySystem::instance().finishRecording(gameScore, 0);
     
     if (timer && timer->isActive()) timer->stop();
     if (inactivityTimer) inactivityTimer->stop();
@@ -740,10 +766,12 @@ void PuzzleModeGameWidget::remove3x3AreaChain(int centerRow, int centerCol) {
 
 
 void PuzzleModeGameWidget::eliminate() {
+    PhaseTimer phaseTimer(PerfStats::Eliminate);
     if (isFinishing) return;
     // 查找所有匹配
     std::vector<std::pair<int, int>> matches = findMatches(-1,-1,-1);
     if (!matches.empty()) {
+        PerfStats::instance().cascadeStep();
 
         comboCount++; // 增加连续消除计数
         appendDebug(QString("Found %1 matches to eliminate").arg(matches.size()));
@@ -763,6 +791,7 @@ void PuzzleModeGameWidget::eliminate() {
             drop();
         });
     } else {
+        PerfStats::instance().cascadeFinished();
         pushInLastStateQueue();
         comboCount = 0;
         // 没有匹配了，恢复操作
@@ -777,6 +806,7 @@ void PuzzleModeGameWidget::eliminate() {
 }
 
 void PuzzleModeGameWidget::drop() {
+    PhaseTimer phaseTimer(PerfStats::Drop);
     if (isFinishing) return;
     appendDebug("Starting drop animation");
 
@@ -794,6 +824,7 @@ void PuzzleModeGameWidget::drop() {
 
                     QVector3D targetPos = getPosition(writePos, col);
                     QPropertyAnimation* dropAnim = new QPropertyAnimation(gem->transform(), "translation");
+                    PerfStats::instance().trackAnimation(dropAnim);
                     dropAnim->setDuration(500);
                     dropAnim->setStartValue(gem->transform()->translation());
                     dropAnim->setEndValue(targetPos);
@@ -824,6 +855,7 @@ void PuzzleModeGameWidget::eliminateAnime(Gemstone* gemstone) {
     if (!gemstone) return;
     
     QPropertyAnimation* animation = new QPropertyAnimation(gemstone->transform(), "scale");
+    PerfStats::instance().trackAnimation(animation);
     animation->setDuration(500); // 持续缩小直到不见
     animation->setStartValue(gemstone->transform()->scale());
     animation->setEndValue(0.0f);
@@ -845,11 +877,13 @@ void PuzzleModeGameWidget::switchGemstoneAnime(Gemstone* gemstone1, Gemstone* ge
     QParallelAnimationGroup* group = new QParallelAnimationGroup(this);
     
     QPropertyAnimation* anim1 = new QPropertyAnimation(gemstone1->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim1);
     anim1->setDuration(500); // 0.5s
     anim1->setStartValue(pos1);
     anim1->setEndValue(pos2);
     
     QPropertyAnimation* anim2 = new QPropertyAnimation(gemstone2->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim2);
     anim2->setDuration(500); // 0.5s
     anim2->setStartValue(pos2);
     anim2->setEndValue(pos1);
@@ -976,6 +1010,9 @@ void PuzzleModeGameWidget::mouseReleaseEvent(QMouseEvent* event) {
 
 void PuzzleModeGameWidget::showEvent(QShowEvent* event) {
     QWidget::showEvent(event);
+    // 待机动画模式可能在设置界面里改过
+    IdleAnimationDriver::Mode idleMode = static_cast<IdleAnimationDriver::Mode>(SettingWidget::getIdleSpinMode());
+    if (idleDriver) idleDriver->setMode(idleMode);
     if (container3d) {
         container3d->setFocus(Qt::OtherFocusReason);
         container3d->raise();
@@ -992,6 +1029,8 @@ void PuzzleModeGameWidget::showEvent(QShowEvent* event) {
 
 void PuzzleModeGameWidget::hideEvent(QHideEvent* event) {
     QWidget::hideEvent(event);
+    // 离开游戏界面（非最小化）时结束回放
+    if (!event->spontaneous()) stopReplay();
     if (timer && timer->isActive()) {
         timer->stop();
     }
@@ -1235,161 +1274,27 @@ void PuzzleModeGameWidget::setMode(int mode) {
     this->mode = mode;
 }
 
-bool PuzzleModeGameWidget::checkConflict(int x,int y,int type) {
-    int dx[4] = {0,0,1,-1};
-    int dy[4] = {1,-1,0,0};
-    for(int i=0;i<4;i++) {
-        if(x+dx[i] >= 0&& x+dx[i] < 8&& y+dy[i] >= 0&& y+dy[i] < 8) {
-            if(TempGemState[x+dx[i]][y+dy[i]] == type + '0') return true;
-        }
-    }
-    return false;
-}
-
-void PuzzleModeGameWidget::changeIndex(int a,int b,int c,int d,int e,int f) {
-    int type = QRandomGenerator::global()->bounded(difficulty);
-    TempGemState[a][b] = TempGemState[c][d] = TempGemState[e][f] = '-';
-    //清空要放当前这一匹配的位置
-    while(checkConflict(a,b,type) ||
-        checkConflict(c,d,type) || checkConflict(e,f,type)) type = (type + 1)% 8;
-    TempGemState[a][b] = TempGemState[c][d] = TempGemState[e][f] = type + '0';
-}
-
-void PuzzleModeGameWidget::threeColumnOrVeticalBuild() {
-
-    return ;
-}
-
-void PuzzleModeGameWidget::checkLenthT() {
-    for(int i=0;i<8;i++) {
-        lenthT[i] = 0;
-        for(int j=0;j<8;j++) {
-            if(TempGemState[i][j] == '-') break;
-            lenthT[i] ++;
-        }
+void PuzzleModeGameWidget::openLevelPack() {
+    // 关卡包随 resources/levels 发布（regenerate_level_pack 目标重新生成）
+    const QString path = QString::fromStdString(ResourceUtils::getPath("levels/puzzle_levels.bjlp"));
+    levelPackFile.setFileName(path);
+    if (!levelPackFile.open(QIODevice::ReadOnly)) {
+        qDebug() << "[PuzzleMode] No level pack found, puzzles are generated at runtime";
+        return;
     }
-}
-
-void PuzzleModeGameWidget::generateSimpleMatch() {//Tem是 列 行 存储
-    appendDebug(QString("generateSimpleMatch called, GemNumber=%1").arg(GemNumber));
-    bool CrossOrVertical = QRandomGenerator::global()->bounded(2);
-    int StartPos = QRandomGenerator::global()->bounded(6);
-    appendDebug(QString("CrossOrVertical=%1, StartPos=%2").arg(CrossOrVertical).arg(StartPos));
-    
-    appendDebug(QString("%1  %2").arg(midX).arg(ConstChange));
-    if(ConstChange) {
-        if(lenthT[midX - 1] < 8&&lenthT[midX] < 8&&lenthT[midX + 1] < 8) {
-            for(int i=-1;i<=1;i++) {
-                for(int j = 7;j > midY;j--) 
-                    TempGemState[midX + i][j] = TempGemState[midX + i][j-1];
-            }
-            TempGemState[midX][midY+1] = TempGemState[midX][midY];
-            changeIndex( midX-1,midY , midX,midY+1 ,midX+1,midY);
-            GemNumber += 3;
-        } else if(lenthT[midX] <= 5) {
-            for(int i=1;i<=3;i++) {
-                for(int j = 7;j > midY + i;j --) 
-                    TempGemState[midX][j] = TempGemState[midX][j-1];
-            }
-            TempGemState[midX][midY + 1] = TempGemState[midX][midY];
-            changeIndex(midX,midY,midX,midY+2,midX,midY+3);
-            GemNumber += 3;
-        } else {
-            ConstChange = 0;
-            generateSimpleMatch();
-        }
-        ConstChange = 0;
-        midX = midY = 0;
-    } else if(CrossOrVertical || GemNumber == 0 || !CrossOrVertical) { // Cross
-        int VertBound = 10;
-        for(int i=0;i<3;i++) {
-            VertBound = std::min(VertBound , lenthT[StartPos + i]);
-        }
-
-        int Choice_01 = QRandomGenerator::global()->bounded(4);
-        if(Choice_01 == 30 && VertBound >= 1) {//横着的上下交换，前提是当前三列都有宝石
-            Choice_01 = QRandomGenerator::global()->bounded(3);
-            int type = QRandomGenerator::global()->bounded(difficulty);
-            
-        } else { 
-            VertBound = 10;
-            StartPos = QRandomGenerator::global()->bounded(5);
-            for(int i=1;i<=7;i++) {
-                StartPos = (StartPos + 1) % 5 , VertBound = 10;
-                for(int i=0;i<=3;i++) {
-                    VertBound = std::min(VertBound , lenthT[StartPos + i]);
-                    if(lenthT[StartPos + i] == 8) {
-                        VertBound = 10;
-                        break;
-                    }
-                }
-                if(VertBound < 8) break;
-            }
-            if(VertBound >= 8) ;
-            VertBound = 0;
-            int type = QRandomGenerator::global()->bounded(difficulty);
-            
-            //中间两列的上移
-            for(int i = 7;i>VertBound;i--) 
-                TempGemState[StartPos+2][i] = TempGemState[StartPos+2][i-1] ,
-                TempGemState[StartPos+1][i] = TempGemState[StartPos+1][i-1];
-
-            if(StartPos >= 3) {//XXOX形式
-
-                //第一列上移
-                for(int i = 7;i>VertBound;i--) 
-                    TempGemState[StartPos][i] = TempGemState[StartPos][i-1];
-                
-                //第三列变成第四列的，交换当前这个后恢复原样
-                if(TempGemState[StartPos+2][VertBound] != '-' && TempGemState[StartPos+3][VertBound] == '-') {//这时交换会出现悬空，不正确
-                    if(VertBound > 0) {//与下面交换 减少开局出错概率
-                        TempGemState[StartPos+2][VertBound] = TempGemState[StartPos+2][VertBound-1];
-                        changeIndex(StartPos,VertBound,StartPos+1,VertBound,StartPos+2,VertBound-1);
-                    } else {
-                        // TempGemState[StartPos+2][VertBound] = TempGemState[StartPos+2][VertBound+1];
-                        changeIndex(StartPos,VertBound,StartPos+1,VertBound,StartPos+2,VertBound+1);
-                    }
-                    midX = StartPos + 1; midY = VertBound;
-                    ConstChange = 1;
-                } else {
-                    TempGemState[StartPos+2][VertBound] = TempGemState[StartPos+3][VertBound];
-
-                    changeIndex(StartPos,VertBound,StartPos+1,VertBound,StartPos+3,VertBound);
-                    //替换0 1 3
-                }
-
-            } else {//XOXX形式
-                for(int i = 7;i>VertBound;i--) 
-                     TempGemState[StartPos+3][i] = TempGemState[StartPos+3][i-1];
-
-                //第二列变成第一列的，交换当前这个后恢复原样
-                if(TempGemState[StartPos+1][VertBound] != '-' && TempGemState[StartPos][VertBound] == '-') {//这时交换会出现悬空，不正确
-                    if(VertBound > 0) {
-                        TempGemState[StartPos+1][VertBound] = TempGemState[StartPos+1][VertBound-1];
-                        changeIndex(StartPos+1,VertBound-1,StartPos+2,VertBound,StartPos+3,VertBound);
-                    } else {
-                        // TempGemState[StartPos+1][VertBound] = TempGemState[StartPos+1][VertBound+1];
-                        changeIndex(StartPos+1,VertBound+1,StartPos+2,VertBound,StartPos+3,VertBound);
-                    }
-                    midX = StartPos + 1; midY = VertBound;
-                    ConstChange = 1;
-                } else {
-                    TempGemState[StartPos+1][VertBound] = TempGemState[StartPos][VertBound];
-
-                    changeIndex(StartPos,VertBound,StartPos+2,VertBound,StartPos+3,VertBound);
-                    //替换0 2 3
-                }
-            }
-
-        }
-        GemNumber += 3;
-    } else { // Vertical
-        
+    const uchar* data = levelPackFile.map(0, levelPackFile.size());
+    if (data && levelPack.open(data, static_cast<size_t>(levelPackFile.size()))) {
+        qDebug() << "[PuzzleMode] Level pack mapped:" << path << "levels:" << levelPack.levelCount(difficulty);
+        return;
     }
-    checkLenthT();
+    qWarning() << "[PuzzleMode] Invalid level pack:" << path << ", puzzles are generated at runtime";
+    levelPackFile.close();
 }
 
 void PuzzleModeGameWidget::reset(int mode) {
+    // 每局一个独立的随机数流；回放或联机指定了种子时使用指定值
+    rng.reseed(hasPendingSeed ? pendingSeed : GameRng::makeSeed());
+    hasPendingSeed = false;
     AchievementSystem::instance().resetSessionStats();
     this->mode = mode;
     this->canOpe = true;
@@ -1410,49 +1315,62 @@ void PuzzleModeGameWidget::reset(int mode) {
     }
     gemstoneContainer.clear();
     
-   
-    ConstChange = 0;
     // 重建8x8网格
     gemstoneContainer.resize(8);
     for(int i=0; i<8; i++) {
         gemstoneContainer[i].resize(8);
-        TempGemState[i] = "--------";
-        lenthT[i] = 0;
     }
-    GemNumber = 0;
-    midX = midY = 0;
 
     debugText->setText(QString("Start\n")); // 刷新显示
     //目前关闭debug窗口
-    
-    int MemberNum = std::max(5 , std::min(8,3*Level));
-    bool SpecialComplete = false;
-    while(MemberNum) {
-        if(Level >= 2 && !SpecialComplete) {//可能 生成一个残缺匹配，需要特殊宝石来消除
-            if(QRandomGenerator::global()->bounded(2) == 20) {//暂时不写
-                GemNumber += 5;
-            } else {
-                generateSimpleMatch();
-            }
-            SpecialComplete = true;
-        } 
-        generateSimpleMatch();
-        MemberNum --;
+
+    std::array<int8_t, Board::kCells> types;
+    if (const LevelPack::LevelRecord* record = levelPack.level(difficulty, Level)) {
+        // 关卡包里的题目已离线验证过，直接取用
+        types = record->types();
+        GemNumber = record->gemCount;
+        optimalMoves = record->optimalMoves;
+        qDebug() << "[PuzzleMode] Level" << Level << "loaded from pack, optimal moves:" << optimalMoves
+                 << "grade:" << record->grade;
+        showFloatingMessage(QString("本关最少 %1 步即可清空").arg(optimalMoves), true);
+    } else {
+        // 没有关卡包或关卡号超出范围：运行时生成，用求解器验证能在倒推的步数内清空，无解的直接丢弃重新生成
+        PuzzleGenerator generator(difficulty, rng);
+        PuzzleSolver solver;
+        PuzzleSolver::Result solveResult;
+        for (int attempt = 1; attempt <= kMaxPuzzleAttempts; ++attempt) {
+            int moveBudget = generator.generate(Level);
+            solveResult = solver.solve(generator.getTypes(), difficulty, moveBudget);
+            if (solveResult.status == PuzzleSolver::Status::Solved) break;
+            appendDebug(QString("Puzzle attempt %1 rejected (status %2, nodes %3)")
+                        .arg(attempt).arg(static_cast<int>(solveResult.status)).arg(solveResult.nodes));
+        }
+        types = generator.getTypes();
+        GemNumber = generator.getGemCount();
+        optimalMoves = solveResult.status == PuzzleSolver::Status::Solved ? solveResult.moves : 0;
+        if (solveResult.status == PuzzleSolver::Status::Solved) {
+            qDebug() << "[PuzzleMode] Level" << Level << "verified, optimal moves:" << optimalMoves
+                     << "nodes:" << solveResult.nodes;
+            appendDebug(QString("Puzzle verified: optimal %1 moves, %2 nodes").arg(optimalMoves).arg(solveResult.nodes));
+            showFloatingMessage(QString("本关最少 %1 步即可清空").arg(optimalMoves), true);
+        } else {
+            qWarning() << "[PuzzleMode] Level" << Level << "could not be verified after" << kMaxPuzzleAttempts << "attempts";
+        }
     }
 
-    for (int i = 0; i < 8; ++i) {
-        for (int j = 0; j < 8; ++j) {
-            if(TempGemState[j][i] < '0' || TempGemState[j][i] > '9') continue;
-            int type = TempGemState[j][i] - '0';
+    for (int row = 0; row < 8; ++row) {
+        for (int col = 0; col < 8; ++col) {
+            int type = types[row * Board::kSize + col];
+            if (type < 0) continue;
             Gemstone* gem = new Gemstone(type, "default", rootEntity);
 
-            gem->transform()->setTranslation(getPosition(7-i, j));
+            gem->transform()->setTranslation(getPosition(row, col));
 
             // 连接点击信号
             connect(gem, &Gemstone::clicked, this, &PuzzleModeGameWidget::handleGemstoneClicked);
             connect(gem, &Gemstone::pickEvent, this, [this](const QString& info) { appendDebug(QString("Gemstone %1").arg(info)); });
 
-            gemstoneContainer[7-i][j] = gem;
+            gemstoneContainer[row][col] = gem;
         }
     }
     appendDebug(QString("created puzzle gemstones with no initial matches,%1").arg(GemNumber));
@@ -1462,9 +1380,20 @@ void PuzzleModeGameWidget::reset(int mode) {
     firstSelectedGemstone = nullptr;
     secondSelectedGemstone = nullptr;
     // drop();
-    while(!lastGemStateStack.empty()) lastGemStateStack.pop();
+    undoRing.clear();
     updateLevelDisplay();
     pushInLastStateQueue();
+
+    // 题目不由 Board 生成，录像里直接保存初始棋盘
+    ReplaySystem::instance().beginRecording(BoardMode::Puzzle, difficulty, rng.seed(), Level, gameScore);
+    std::array<int8_t, Board::kCells> initialTypes;
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            Gemstone* gem = gemstoneContainer[i][j];
+            initialTypes[i * Board::kSize + j] = gem ? static_cast<int8_t>(gem->getType()) : -1;
+        }
+    }
+    ReplaySystem::instance().setInitialBoard(initialTypes);
     // 重置定时器
     if (timer->isActive()) {
         timer->stop();
@@ -1513,6 +1442,7 @@ bool PuzzleModeGameWidget::areAdjacent(int row1, int col1, int row2, int col2) c
 void PuzzleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1, int col1, int row2, int col2) {
     // gem1 不能为空，但 gem2 可以为空（nullptr表示空位）
     if (!gem1) return;
+    ReplaySystem::instance().recordAction(ReplayAction::Swap, row1, col1, row2, col2);
 
     canOpe = false;//封锁按键
     // 先在逻辑容器中交换
@@ -1528,11 +1458,13 @@ void PuzzleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1,
         QParallelAnimationGroup* group = new QParallelAnimationGroup();
 
         QPropertyAnimation* anim1 = new QPropertyAnimation(gem1->transform(), "translation");
+        PerfStats::instance().trackAnimation(anim1);
         anim1->setDuration(500);
         anim1->setStartValue(pos1);
         anim1->setEndValue(pos2);
 
         QPropertyAnimation* anim2 = new QPropertyAnimation(gem2->transform(), "translation");
+        PerfStats::instance().trackAnimation(anim2);
         anim2->setDuration(500);
         anim2->setStartValue(gem2->transform()->translation());
         anim2->setEndValue(pos1);
@@ -1580,11 +1512,13 @@ void PuzzleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1,
                 QParallelAnimationGroup* swapBackGroup = new QParallelAnimationGroup();
 
                 QPropertyAnimation* backAnim1 = new QPropertyAnimation(gem1->transform(), "translation");
+                PerfStats::instance().trackAnimation(backAnim1);
                 backAnim1->setDuration(500);
                 backAnim1->setStartValue(pos1);
                 backAnim1->setEndValue(pos2);
 
                 QPropertyAnimation* backAnim2 = new QPropertyAnimation(gem2->transform(), "translation");
+                PerfStats::instance().trackAnimation(backAnim2);
                 backAnim2->setDuration(500);
                 backAnim2->setStartValue(pos2);
                 backAnim2->setEndValue(pos1);
@@ -1606,6 +1540,7 @@ void PuzzleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1,
     } else {
         // 宝石移动到空位（也需要检查匹配！）
         QPropertyAnimation* anim = new QPropertyAnimation(gem1->transform(), "translation");
+        PerfStats::instance().trackAnimation(anim);
         anim->setDuration(500);
         anim->setStartValue(pos1);
         anim->setEndValue(pos2);
@@ -1648,6 +1583,7 @@ void PuzzleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1,
                 QVector3D originalPos = getPosition(row1, col1);
 
                 QPropertyAnimation* moveBackAnim = new QPropertyAnimation(gem1->transform(), "translation");
+                PerfStats::instance().trackAnimation(moveBackAnim);
                 moveBackAnim->setDuration(500);
                 moveBackAnim->setStartValue(currentPos);
                 moveBackAnim->setEndValue(originalPos);
@@ -1684,6 +1620,7 @@ void PuzzleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1,
 
 // 手动处理鼠标点击 - 将屏幕坐标转换为世界坐标并找到最近的宝石
 void PuzzleModeGameWidget::handleManualClick(const QPoint& screenPos , int kind) {
+    if(replayPlayer) return ; // 回放中不接受玩家输入
     if(kind == 2 && selectedNum == 0) {
         appendDebug("Startale says : release gem could not be the first selected.");
         return ;
@@ -1865,6 +1802,7 @@ void PuzzleModeGameWidget::showFloatingMessage(const QString& text, bool isSucce
         auto* opacityEffect = new QGraphicsOpacityEffect(msgLabel);
         msgLabel->setGraphicsEffect(opacityEffect);
         auto* animation = new QPropertyAnimation(opacityEffect, "opacity");
+        PerfStats::instance().trackAnimation(animation);
         animation->setDuration(500);
         animation->setStartValue(1.0);
         animation->setEndValue(0.0);
@@ -1891,49 +1829,109 @@ int PuzzleModeGameWidget::getDifficulty() const {
     return difficulty;
 }
 
-void PuzzleModeGameWidget::backToLastGemstoneState(std::string LastState) {
-    if (isFinishing) return ;
+void PuzzleModeGameWidget::setNextSeed(uint64_t seed) {
+    pendingSeed = seed;
+    hasPendingSeed = true;
+}
 
-    appendDebug("Reverting to last gemstone state");
+uint64_t PuzzleModeGameWidget::getSeed() const {
+    return rng.seed();
+}
 
-    // 清除当前宝石
-    for (auto& row : gemstoneContainer) {
-        for (auto* gem : row) {
-            if (gem) {
-                gem->setParent((Qt3DCore::QNode*)nullptr); // 从场景中分离
-                delete gem;
+void PuzzleModeGameWidget::startReplay(const Replay& replay, ReplayPlayer::Speed speed) {
+    stopReplay();
+    ReplaySystem::instance().setPlayingBack(true);
+    // 同一种子和关卡生成同一道题
+    Level = std::max(1, replay.level);
+    setNextSeed(replay.seed);
+    reset(1);
+
+    replayPlayer = new ReplayPlayer(replay, speed, [this](const ReplayAction& action) {
+        return applyReplayAction(action);
+    }, this);
+    replayPlayer->start();
+    appendDebug(QString("Replay started: level=%1 seed=%2 actions=%3")
+        .arg(Level).arg(replay.seed).arg(replay.actions.size()));
+}
+
+void PuzzleModeGameWidget::stopReplay() {
+    if (!replayPlayer) return;
+    replayPlayer->stop();
+    replayPlayer->deleteLater();
+    replayPlayer = nullptr;
+    ReplaySystem::instance().setPlayingBack(false);
+}
+
+bool PuzzleModeGameWidget::applyReplayAction(const ReplayAction& action) {
+    if (isFinishing) return true;  // 本关已结束，剩余操作直接跳过
+    if (!canOpe) return false;
+
+    switch (action.kind) {
+        case ReplayAction::Swap: {
+            if (action.row1 >= 8 || action.col1 >= 8 || action.row2 >= 8 || action.col2 >= 8) break;
+            // 解谜模式允许和空位交换，gem2 可以为空
+            Gemstone* gem1 = gemstoneContainer[action.row1][action.col1];
+            Gemstone* gem2 = gemstoneContainer[action.row2][action.col2];
+            if (gem1 && areAdjacent(action.row1, action.col1, action.row2, action.col2)) {
+                performSwap(gem1, gem2, action.row1, action.col1, action.row2, action.col2);
             }
+            break;
         }
+        case ReplayAction::Undo:
+            checkLastGemState();
+            break;
+        default:
+            qWarning() << "[PuzzleMode] Unsupported replay action:" << static_cast<int>(action.kind);
+            break;
     }
-    gemstoneContainer.clear();
+    return true;
+}
+
+void PuzzleModeGameWidget::backToLastGemstoneState(const UndoRing::Snapshot& snapshot) {
+    if (isFinishing) return ;
+
+    appendDebug("Reverting to last gemstone state");
 
+    // 撤销前的选中宝石可能被删除，先清掉选择状态
+    firstSelectedGemstone = nullptr;
+    secondSelectedGemstone = nullptr;
+    selectedNum = 0;
+    selectionRing1->setVisible(false);
+    selectionRing2->setVisible(false);
+
+    int changed = 0;
     GemNumber = 0;
-    gemstoneContainer.resize(8);
     for (int i = 0; i < 8; ++i) {
-        gemstoneContainer[i].resize(8);
         for (int j = 0; j < 8; ++j) {
-            if(LastState[i * 8 + j] == '-') {
-                continue;
-            }
-            GemNumber ++;
-            int type = LastState[i * 8 + j] - '0'; // 假设LastState是一个长度为64的字符串，每个字符表示一个宝石类型
+            int type = UndoRing::cellType(snapshot, i * 8 + j);
+            Gemstone*& gem = gemstoneContainer[i][j];
+            if (type >= 0) GemNumber ++;
 
-            Gemstone* gem = new Gemstone(type, "default", rootEntity);
-
-            gem->transform()->setTranslation(getPosition(i, j));
-
-            // 连接点击信号
-            connect(gem, &Gemstone::clicked, this, &PuzzleModeGameWidget::handleGemstoneClicked);
-            connect(gem, &Gemstone::pickEvent, this, [this](const QString& info) { appendDebug(QString("Gemstone %1").arg(info)); });
+            if (type < 0) {
+                if (!gem) continue;
+                gem->setParent((Qt3DCore::QNode*)nullptr); // 从场景中分离
+                delete gem;
+                gem = nullptr;
+            } else if (!gem) {
+                gem = new Gemstone(type, "default", rootEntity);
+                gem->transform()->setTranslation(getPosition(i, j));
 
-            gemstoneContainer[i][j] = gem;
+                // 连接点击信号
+                connect(gem, &Gemstone::clicked, this, &PuzzleModeGameWidget::handleGemstoneClicked);
+                connect(gem, &Gemstone::pickEvent, this, [this](const QString& info) { appendDebug(QString("Gemstone %1").arg(info)); });
+            } else if (gem->getType() != type || gem->isSpecial()) {
+                // 快照不保存特殊宝石，与 Board::undo 一致，撤销后都是普通宝石
+                gem->setSpecial(false);
+                gem->setType(type);
+                gem->transform()->setTranslation(getPosition(i, j));
+            } else {
+                continue;
+            }
+            ++changed;
         }
     }
 
-    // 重新设置宝石的位置
-    // syncGemstonePositions();
-
-    appendDebug("Reverted to last gemstone state");
+    appendDebug(QString("Reverted to last gemstone state, %1 cells changed").arg(changed));
 
     return ;
 }
@@ -1941,12 +1939,13 @@ void PuzzleModeGameWidget::backToLastGemstoneState(std::string LastState) {
 void PuzzleModeGameWidget::checkLastGemState() {
     if (isFinishing) return;
     appendDebug("Checking for last gemstone state to revert to");
-    if (lastGemStateStack.size() == 1) {
+    if (undoRing.size() <= 1) {
         appendDebug("No last gemstone state found");
         return;
     }
-    lastGemStateStack.pop();
-    backToLastGemstoneState(lastGemStateStack.top());
+    ReplaySystem::instance().recordAction(ReplayAction::Undo);
+    undoRing.pop();
+    backToLastGemstoneState(undoRing.top());
     return ;
 }
 
@@ -2017,19 +2016,14 @@ bool PuzzleModeGameWidget::hasSpecialGem(const std::vector<std::pair<int, int>>&
     return false;
 }
 void PuzzleModeGameWidget::pushInLastStateQueue() {
-    std::string GemState = "";
-
+    UndoRing::Types types;
     for(int i=0; i<8; i++){
         for(int j=0; j<8; j++){
-            if(gemstoneContainer[i][j] != nullptr) {
-                GemState += std::to_string(gemstoneContainer[i][j]->getType());
-            }
-            else {
-                GemState += "-";
-            }
+            Gemstone* gem = gemstoneContainer[i][j];
+            types[i * 8 + j] = gem ? static_cast<int8_t>(gem->getType()) : -1;
         }
     }
-    lastGemStateStack.push(GemState);
+    undoRing.push(types);
     return ;
 }
 
@@ -3,10 +3,15 @@
 
 #include <QWidget>
 #include <vector>
-#include <stack>
 #include <string>
 #include <QTimer>
 #include <QString>
+#include <QFile>
+#include "../logic/Board.h"
+#include "../logic/GameRng.h"
+#include "../logic/LevelPack.h"
+#include "../logic/UndoRing.h"
+#include "../data/ReplayPlayer.h"
 #include <Qt3DExtras/Qt3DWindow>
 #include <Qt3DCore/QEntity>
 #include <Qt3DRender/QCamera>
@@ -16,6 +21,8 @@
 class QTextEdit;
 class QLabel;
 class QPushButton;
+class PerfHud;
+class IdleAnimationDriver;
 class QShowEvent;
 class QEvent;
 class QHideEvent;
@@ -72,7 +79,18 @@ public:
     void setDifficulty(int diff);
     int getDifficulty() const;
 
-    void backToLastGemstoneState(std::string LastState);
+    // 本局随机种子：setNextSeed 指定下一次 reset 使用的种子，getSeed 返回当前局的种子
+    void setNextSeed(uint64_t seed);
+    uint64_t getSeed() const;
+
+    // 录像回放：按录像的种子和关卡重新出题，操作由 applyReplayAction 逐条执行
+    void startReplay(const Replay& replay, ReplayPlayer::Speed speed);
+    void stopReplay();
+    // 执行一条录像操作；正在播放动画时返回 false，由回放驱动稍后重试
+    bool applyReplayAction(const ReplayAction& action);
+
+    // 撤销到快照：只改动与当前棋盘不同的格子，其余宝石实体原样保留
+    void backToLastGemstoneState(const UndoRing::Snapshot& snapshot);
     void checkLastGemState();  // 新增
 
     void updateLevelDisplay();
@@ -98,11 +116,7 @@ private:
     void finishToNextLevel();
 
     void pushInLastStateQueue();
-    void generateSimpleMatch();
-    bool checkConflict(int x,int y,int type);
-    void changeIndex(int a,int b,int c,int d,int e,int f);
-    void threeColumnOrVeticalBuild();
-    void checkLenthT();
+    void openLevelPack();  // 映射 resources/levels 下预生成的关卡包，找不到时回退到运行时生成
     
     void showFloatingMessage(const QString& text, bool isSuccess);
     void removeFloatingMessage(QLabel* label);
@@ -137,13 +151,16 @@ private:
     int comboCount = 0;
     
     int difficulty = 8;
+    GameRng rng; // 本局的棋盘随机数流
+    uint64_t pendingSeed = 0;
+    bool hasPendingSeed = false;
+    ReplayPlayer* replayPlayer = nullptr;
     int GemNumber = 0;
     int Level = 1;
-    std::string TempGemState[8];
-    int lenthT[8];
-    std::stack<std::string> lastGemStateStack;
-    bool ConstChange = 0;
-    int midX , midY;
+    int optimalMoves = 0;  // 求解器给出的本关最少步数
+    UndoRing undoRing;  // 与 Board 共用，撤销深度一致
+    QFile levelPackFile;   // 保持打开，映射的内存在文件关闭前一直有效
+    LevelPack levelPack;
 
     GameWindow* gameWindow;
 
@@ -193,6 +210,8 @@ private:
     // Debug UI
     QTextEdit* debugText;
     QLabel* focusInfoLabel;
+    PerfHud* perfHud = nullptr;
+    IdleAnimationDriver* idleDriver = nullptr;  // 按需渲染与待机动画降频
     QTimer* debugTimer;
 
     QWidget* rightPanel = nullptr;
@@ -1,12 +1,15 @@
 #include "RankListWidget.h"
 #include "../GameWindow.h"
+#include "../data/OtherNetDataIO.h"
 #include "../../utils/ResourceUtils.h"
+#include "../components/ParticleSystem.h"
+#include "../../utils/AnimationScheduler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QPushButton>
 #include <QTabWidget>
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
 #include <QGraphicsDropShadowEffect>
 #include <QPainter>
@@ -16,11 +19,38 @@
 #include <QFile>
 #include <QDebug>
 #include <QCoreApplication>
+#include <QPointer>
+#include <QThreadPool>
 #include <QTimer>
 #include <QUrl>
 #include <algorithm>
 #include <cmath>
 
+namespace {
+// 浮动粒子精灵：光晕半径 kGlowRadius，核心为光晕的 1/4
+constexpr int kGlowRadius = 32;
+
+QImage renderGlowSprite() {
+    QImage image(kGlowRadius * 2, kGlowRadius * 2, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    p.setPen(Qt::NoPen);
+    QPointF center(kGlowRadius, kGlowRadius);
+
+    QRadialGradient glow(center, kGlowRadius);
+    glow.setColorAt(0, QColor(255, 255, 255, 255));
+    glow.setColorAt(0.5, QColor(200, 220, 255, 128));
+    glow.setColorAt(1, QColor(150, 180, 255, 0));
+    p.setBrush(glow);
+    p.drawEllipse(center, kGlowRadius, kGlowRadius);
+
+    p.setBrush(QColor(255, 255, 255));
+    p.drawEllipse(center, kGlowRadius / 4.0, kGlowRadius / 4.0);
+    return image;
+}
+}
+
 RankListWidget::RankListWidget(QWidget* parent, GameWindow* gameWindow)
     : QWidget(parent), gameWindow(gameWindow) {
     // 加载背景图片 - 尝试多个可能的路径
@@ -36,7 +66,8 @@ RankListWidget::RankListWidget(QWidget* parent, GameWindow* gameWindow)
     for (const QString& path : possiblePaths) {
         qDebug() << "Trying rank_bg path:" << path << "exists:" << QFile::exists(path);
         if (QFile::exists(path)) {
-            if (bgImage.load(path)) {
+            bgImage.setSource(BackgroundCache::instance().load(path));
+            if (!bgImage.isNull()) {
                 qDebug() << "Successfully loaded rank_bg from:" << path;
                 break;
             }
@@ -57,25 +88,39 @@ RankListWidget::RankListWidget(QWidget* parent, GameWindow* gameWindow)
     goldenAnimTimer = new QTimer(this);
     connect(goldenAnimTimer, &QTimer::timeout, this, &RankListWidget::updateGoldenAnimation);
     goldenAnimTimer->start(50);  // 20fps动画
+    AnimationScheduler::instance().registerTimer(this, goldenAnimTimer);
     
-    // 初始化背景动画定时器
-    bgAnimTimer = new QTimer(this);
-    connect(bgAnimTimer, &QTimer::timeout, this, &RankListWidget::updateBackgroundAnimation);
-    bgAnimTimer->start(30);  // 约33fps动画
-    
-    // 初始化浮动粒子
+    // 初始化浮动粒子（光晕 + 核心预先画成一个精灵）
     std::srand(static_cast<unsigned>(time(nullptr)));
+    particles = new ParticleSystem(this);
+    particles->setBounds(ParticleSystem::Bounds::Respawn, QMarginsF(20, 20, 20, 20));
+    // 呼吸效果：亮度在 0.4 ~ 1.0 之间变化
+    particles->setTwinkle(0.6f, 0.0f);
+    particles->setRespawn([this](ParticleSystem::Particle& p) {
+        // 飘出上下边界时从另一侧重新进入，左右越界则绕回
+        if (p.y < -20 || p.y > height() + 20) {
+            p.y = p.vy < 0 ? height() + 20 : -20;
+            p.x = std::rand() % std::max(1, width());
+        } else {
+            p.x = p.x < -20 ? width() + 20 : -20;
+        }
+    });
+    int sprite = particles->addSprite(renderGlowSprite());
+    particles->reserve(30);
     for (int i = 0; i < 30; ++i) {
-        Particle p;
+        ParticleSystem::Particle p;
         p.x = std::rand() % 1600;
         p.y = std::rand() % 1000;
-        p.speedX = (std::rand() % 100 - 50) / 100.0f;  // -0.5 到 0.5
-        p.speedY = (std::rand() % 100 - 70) / 100.0f;  // 主要向上飘
-        p.size = 2 + std::rand() % 6;
-        p.alpha = 50 + std::rand() % 150;
-        p.phase = (std::rand() % 628) / 100.0f;  // 随机初始相位
-        particles.push_back(p);
+        p.vx = (std::rand() % 100 - 50) / 3.0f;  // 每秒 -16 到 16 像素
+        p.vy = (std::rand() % 100 - 70) / 3.0f;  // 主要向上飘
+        p.scaleX = p.scaleY = (2 + std::rand() % 6) * 2.0f / kGlowRadius;
+        p.alpha = (50 + std::rand() % 150) / 255.0f;
+        p.twinklePhase = (std::rand() % 628) / 100.0f;  // 随机初始相位
+        p.twinkleSpeed = 0.05f / 0.03f;
+        p.sprite = sprite;
+        particles->spawn(p);
     }
+    connect(particles, &ParticleSystem::advanced, this, &RankListWidget::updateBackgroundAnimation);
     
     // 初始化海鸥
     for (int i = 0; i < 5; ++i) {
@@ -172,14 +217,36 @@ void RankListWidget::setupUI() {
         }
     )");
     
-    // 创建三个表格
-    normalModeTable = new QTableWidget(this);
-    rotateModeTable = new QTableWidget(this);
-    multiplayerTable = new QTableWidget(this);
+    // 创建三个表格及其虚拟化模型
+    normalModeModel = new RankTableModel({"排名", "用户", "时间(秒)"}, this);
+    rotateModeModel = new RankTableModel({"排名", "用户", "分数"}, this);
+    multiplayerModel = new RankTableModel({"排名", "用户", "分数"}, this);
+
+    RankTableModel* models[3] = {normalModeModel, rotateModeModel, multiplayerModel};
+    for (int mode = 0; mode < 3; ++mode) {
+        // 两个 fetcher 都在工作线程中执行，只访问 OtherNetDataIO
+        models[mode]->setFetchers(
+            [this, mode](int offset, int limit, RankPage& page) {
+                OtherNetDataIO* io = gameWindow ? gameWindow->getOtherNetDataIO() : nullptr;
+                return io && io->getRankPage(mode, offset, limit, page);
+            },
+            [this, mode](const std::string& id, int limit, RankPage& page) {
+                OtherNetDataIO* io = gameWindow ? gameWindow->getOtherNetDataIO() : nullptr;
+                return io && io->getRankAroundMe(mode, id, limit, page);
+            });
+        if (gameWindow) models[mode]->setHighlightId(gameWindow->getUserID());
+        connect(models[mode], &RankTableModel::remoteLoaded, this, [this, mode](bool ok) {
+            if (!ok) loadFullRanks(mode);
+        });
+    }
+
+    normalModeTable = new QTableView(this);
+    rotateModeTable = new QTableView(this);
+    multiplayerTable = new QTableView(this);
     
-    setupTab(normalModeTable, {"排名", "用户", "时间(秒)"});
-    setupTab(rotateModeTable, {"排名", "用户", "分数"});
-    setupTab(multiplayerTable, {"排名", "用户", "分数"});
+    setupTab(normalModeTable, normalModeModel);
+    setupTab(rotateModeTable, rotateModeModel);
+    setupTab(multiplayerTable, multiplayerModel);
     
     tabWidget->addTab(normalModeTable, "🎮 普通模式");
     tabWidget->addTab(rotateModeTable, "🌀 旋风模式");
@@ -187,21 +254,39 @@ void RankListWidget::setupUI() {
     
     mainLayout->addWidget(tabWidget, 1);
     
-    // 底部说明
-    QLabel* infoLabel = new QLabel("* 排行榜记录您的历史最佳前10名成绩", this);
+    // 底部说明 + 定位按钮
+    QHBoxLayout* bottomLayout = new QHBoxLayout();
+    QLabel* infoLabel = new QLabel("* 排行榜按需分页加载，滚动即可查看更多名次", this);
     infoLabel->setStyleSheet("color: rgba(255, 255, 255, 150); background: transparent;");
     infoLabel->setAlignment(Qt::AlignCenter);
     QFont infoFont = infoLabel->font();
     infoFont.setPointSize(10);
     infoLabel->setFont(infoFont);
-    mainLayout->addWidget(infoLabel);
+
+    locateButton = new QPushButton("📍 我的排名", this);
+    locateButton->setFixedSize(130, 36);
+    locateButton->setStyleSheet(backButton->styleSheet());
+    connect(locateButton, &QPushButton::clicked, this, &RankListWidget::onLocateMeClicked);
+
+    bottomLayout->addSpacing(130);
+    bottomLayout->addStretch(1);
+    bottomLayout->addWidget(infoLabel);
+    bottomLayout->addStretch(1);
+    bottomLayout->addWidget(locateButton);
+    mainLayout->addLayout(bottomLayout);
 }
 
-void RankListWidget::setupTab(QTableWidget* table, const QStringList& headers) {
-    table->setColumnCount(headers.size());
-    table->setHorizontalHeaderLabels(headers);
+void RankListWidget::setupTab(QTableView* table, RankTableModel* model) {
+    table->setModel(model);
+    connect(model, &RankTableModel::userLocated, this, [table, model](int row) {
+        if (row < 0) {
+            qDebug() << "[RankListWidget] Current user not found in leaderboard";
+            return;
+        }
+        table->scrollTo(model->index(row, 0), QAbstractItemView::PositionAtCenter);
+        table->selectRow(row);
+    });
     
-    table->setRowCount(10);
     table->setEditTriggers(QAbstractItemView::NoEditTriggers);
     table->setSelectionBehavior(QAbstractItemView::SelectRows);
     table->setSelectionMode(QAbstractItemView::SingleSelection);
@@ -212,22 +297,23 @@ void RankListWidget::setupTab(QTableWidget* table, const QStringList& headers) {
     table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     table->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     
-    // 设置行高
+    // 设置行高（固定行高，视图无需逐行测量即可定位可见行）
+    table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     table->verticalHeader()->setDefaultSectionSize(60);
     
     // 表格样式
     table->setStyleSheet(R"(
-        QTableWidget {
+        QTableView {
             background: transparent;
             border: none;
             color: white;
             font-size: 14px;
         }
-        QTableWidget::item {
+        QTableView::item {
             padding: 10px;
             border-bottom: 1px solid rgba(255, 255, 255, 20);
         }
-        QTableWidget::item:selected {
+        QTableView::item:selected {
             background: rgba(100, 180, 255, 100);
         }
         QHeaderView::section {
@@ -243,124 +329,11 @@ void RankListWidget::setupTab(QTableWidget* table, const QStringList& headers) {
     )");
 }
 
-void RankListWidget::updateTable(QTableWidget* table, const std::vector<RankRecord>& records) {
-    // 移除goldenItems中属于当前table的项，防止野指针
-    auto it = std::remove_if(goldenItems.begin(), goldenItems.end(), 
-        [table](QTableWidgetItem* item) {
-            // 检查item是否属于当前正在更新的table
-            return item && item->tableWidget() == table;
-        });
-    goldenItems.erase(it, goldenItems.end());
-
-    table->clearContents();
-    
-    // 排名图标/奖牌
-    QStringList rankIcons = {"🥇", "🥈", "🥉", "4", "5", "6", "7", "8", "9", "10"};
-    
-    // 非前三名的颜色
-    QColor dimColor(200, 210, 230);  // 亮白蓝色
-    
-    for (int i = 0; i < 10; ++i) {
-        if (i < (int)records.size()) {
-            const RankRecord& rec = records[i];
-            
-            // 排名
-            QTableWidgetItem* rankItem = new QTableWidgetItem(rankIcons[i]);
-            rankItem->setTextAlignment(Qt::AlignCenter);
-            rankItem->setFont(QFont("Segoe UI Emoji", 16));
-            if (i < 3) applyGoldenGlowEffect(rankItem, i);
-            else rankItem->setForeground(dimColor);
-            table->setItem(i, 0, rankItem);
-
-            // 用户ID
-            QTableWidgetItem* idItem = new QTableWidgetItem(QString::fromStdString(rec.id));
-            idItem->setTextAlignment(Qt::AlignCenter);
-            QFont idFont = idItem->font();
-            idFont.setPointSize(12);
-            idItem->setFont(idFont);
-            if (i < 3) applyGoldenGlowEffect(idItem, i);
-            else idItem->setForeground(dimColor);
-            table->setItem(i, 1, idItem);
-            
-            // 分数
-            QTableWidgetItem* scoreItem = new QTableWidgetItem(QString::number(rec.score));
-            scoreItem->setTextAlignment(Qt::AlignCenter);
-            QFont scoreFont = scoreItem->font();
-            scoreFont.setBold(true);
-            scoreFont.setPointSize(14);
-            scoreItem->setFont(scoreFont);
-            if (i < 3) applyGoldenGlowEffect(scoreItem, i);
-            else scoreItem->setForeground(dimColor);
-            table->setItem(i, 2, scoreItem);
-        } else {
-            // 空行显示 "--"
-            for (int j = 0; j < 3; ++j) {
-                QTableWidgetItem* emptyItem = new QTableWidgetItem(j == 0 ? QString::number(i + 1) : "--");
-                emptyItem->setTextAlignment(Qt::AlignCenter);
-                emptyItem->setForeground(QColor(100, 100, 100));
-                table->setItem(i, j, emptyItem);
-            }
-        }
-    }
-}
-
-void RankListWidget::sortAndKeepTop10(std::vector<RankRecord>& records, bool ascending) {
-    // 排序
+void RankListWidget::sortRecords(std::vector<RankRecord>& records, bool ascending) {
     std::sort(records.begin(), records.end(), [ascending](const RankRecord& a, const RankRecord& b) {
         if (ascending) return a.score < b.score;
         return a.score > b.score;
     });
-    // 只保留前10条
-    if (records.size() > 10) {
-        records.resize(10);
-    }
-}
-
-void RankListWidget::applyGoldenGlowEffect(QTableWidgetItem* item, int rank) {
-    // 将item添加到动画列表
-    goldenItems.push_back(item);
-    
-    // 存储rank信息到item的data中
-    item->setData(Qt::UserRole, rank);
-    
-    // 设置初始颜色
-    QColor color = getAnimatedGoldColor(rank, goldenAnimPhase);
-    item->setForeground(color);
-    
-    // 设置粗体字体
-    QFont font = item->font();
-    font.setBold(true);
-    item->setFont(font);
-}
-
-QColor RankListWidget::getAnimatedGoldColor(int rank, float phase) {
-    // 使用正弦波创建闪烁效果，不同排名有不同的相位偏移
-    float offset = rank * 0.5f;
-    float wave = 0.5f + 0.5f * std::sin(phase + offset);
-    
-    switch (rank) {
-        case 0: {
-            // 第一名 - 金色闪光：从深金色到亮金色
-            int r = 200 + (int)(55 * wave);   // 200-255
-            int g = 160 + (int)(95 * wave);   // 160-255 
-            int b = (int)(100 * wave);        // 0-100
-            return QColor(r, g, b);
-        }
-        case 1: {
-            // 第二名 - 银色闪光：从灰银到亮白
-            int base = 170 + (int)(85 * wave); // 170-255
-            return QColor(base, base, std::min(255, base + 20));
-        }
-        case 2: {
-            // 第三名 - 铜色闪光：从暗铜到亮铜
-            int r = 180 + (int)(75 * wave);   // 180-255
-            int g = 100 + (int)(80 * wave);   // 100-180
-            int b = 50 + (int)(50 * wave);    // 50-100
-            return QColor(r, g, b);
-        }
-        default:
-            return QColor(255, 255, 255);
-    }
 }
 
 void RankListWidget::updateGoldenAnimation() {
@@ -370,41 +343,20 @@ void RankListWidget::updateGoldenAnimation() {
         goldenAnimPhase -= 6.28f;
     }
     
-    // 更新所有鎏金item的颜色
-    for (QTableWidgetItem* item : goldenItems) {
-        if (item) {
-            int rank = item->data(Qt::UserRole).toInt();
-            QColor color = getAnimatedGoldColor(rank, goldenAnimPhase);
-            item->setForeground(color);
-        }
-    }
+    // 只通知前三行的前景色变化，视图只会重绘可见的单元格
+    normalModeModel->setGoldenPhase(goldenAnimPhase);
+    rotateModeModel->setGoldenPhase(goldenAnimPhase);
+    multiplayerModel->setGoldenPhase(goldenAnimPhase);
 }
 
-void RankListWidget::updateBackgroundAnimation() {
-    // 更新背景动画相位
-    bgAnimPhase += 0.05f;
-    if (bgAnimPhase > 628.0f) {
-        bgAnimPhase -= 628.0f;
-    }
-    
-    // 更新粒子位置
-    for (auto& particle : particles) {
-        particle.x += particle.speedX;
-        particle.y += particle.speedY;
-        
-        // 粒子超出边界时重新生成
-        if (particle.y < -20) {
-            particle.y = height() + 20;
-            particle.x = std::rand() % width();
-        }
-        if (particle.x < -20) particle.x = width() + 20;
-        if (particle.x > width() + 20) particle.x = -20;
-    }
+void RankListWidget::updateBackgroundAnimation(float dt) {
+    // 海鸥的速度按原先 30ms 一帧的步长换算
+    const float ticks = dt / 0.03f;
     
     // 更新海鸥位置
     for (auto& seagull : seagulls) {
-        seagull.x += seagull.speed;
-        seagull.wingPhase += 0.2f;  // 翅膀扇动速度
+        seagull.x += seagull.speed * ticks;
+        seagull.wingPhase += 0.2f * ticks;  // 翅膀扇动速度
         
         // 海鸥飞出屏幕右侧时从左侧重新进入
         if (seagull.x > width() + 50) {
@@ -412,9 +364,6 @@ void RankListWidget::updateBackgroundAnimation() {
             seagull.y = 50 + std::rand() % 200;
         }
     }
-    
-    // 触发重绘
-    update();
 }
 
 void RankListWidget::setNormalModeRecords(const std::vector<std::pair<std::string, int>>& records) {
@@ -422,8 +371,8 @@ void RankListWidget::setNormalModeRecords(const std::vector<std::pair<std::strin
     for (const auto& p : records) {
         normalModeRecords.emplace_back(p.first, p.second);
     }
-    sortAndKeepTop10(normalModeRecords, true); // Ascending
-    updateTable(normalModeTable, normalModeRecords);
+    sortRecords(normalModeRecords, true); // Ascending
+    normalModeModel->setLocalRecords(normalModeRecords);
 }
 
 void RankListWidget::setRotateModeRecords(const std::vector<std::pair<std::string, int>>& records) {
@@ -431,8 +380,8 @@ void RankListWidget::setRotateModeRecords(const std::vector<std::pair<std::strin
     for (const auto& p : records) {
         rotateModeRecords.emplace_back(p.first, p.second);
     }
-    sortAndKeepTop10(rotateModeRecords, false); // Descending
-    updateTable(rotateModeTable, rotateModeRecords);
+    sortRecords(rotateModeRecords, false); // Descending
+    rotateModeModel->setLocalRecords(rotateModeRecords);
 }
 
 void RankListWidget::setMultiplayerRecords(const std::vector<std::pair<std::string, int>>& records) {
@@ -440,15 +389,61 @@ void RankListWidget::setMultiplayerRecords(const std::vector<std::pair<std::stri
     for (const auto& p : records) {
         multiplayerRecords.emplace_back(p.first, p.second);
     }
-    sortAndKeepTop10(multiplayerRecords, false); // Descending
-    updateTable(multiplayerTable, multiplayerRecords);
+    sortRecords(multiplayerRecords, false); // Descending
+    multiplayerModel->setLocalRecords(multiplayerRecords);
 }
 
 void RankListWidget::refreshDisplay() {
-    goldenItems.clear();  // 清空以便重新收集
-    updateTable(normalModeTable, normalModeRecords);
-    updateTable(rotateModeTable, rotateModeRecords);
-    updateTable(multiplayerTable, multiplayerRecords);
+    normalModeModel->setLocalRecords(normalModeRecords);
+    rotateModeModel->setLocalRecords(rotateModeRecords);
+    multiplayerModel->setLocalRecords(multiplayerRecords);
+}
+
+void RankListWidget::reloadFromServer() {
+    // 三个榜单各自在后台拉取首页，失败的榜单由 remoteLoaded 触发整表回退
+    fallbackModes.clear();
+    normalModeModel->resetRemote();
+    rotateModeModel->resetRemote();
+    multiplayerModel->resetRemote();
+
+    normalModeTable->scrollToTop();
+    rotateModeTable->scrollToTop();
+    multiplayerTable->scrollToTop();
+}
+
+void RankListWidget::loadFullRanks(int mode) {
+    // 服务器不支持分页（或离线），回退到一次性拉取整表；多个榜单同时失败时只请求一次
+    fallbackModes.insert(mode);
+    if (fullRanksLoading) return;
+    OtherNetDataIO* io = gameWindow ? gameWindow->getOtherNetDataIO() : nullptr;
+    if (!io) return;
+
+    qDebug() << "[RankListWidget] Paged rank request failed, falling back to full rank list";
+    fullRanksLoading = true;
+    QPointer<RankListWidget> self(this);
+    QThreadPool::globalInstance()->start([self, io]() {
+        auto ranks = io->getRanks();
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [self, ranks]() {
+            if (self) self->onFullRanksLoaded(ranks);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void RankListWidget::onFullRanksLoaded(const std::vector<std::vector<std::pair<std::string, int>>>& ranks) {
+    fullRanksLoading = false;
+    // 只覆盖分页失败的榜单，期间重新加载过的榜单 fallbackModes 已被清掉
+    if (fallbackModes.count(0) && ranks.size() >= 1) setNormalModeRecords(ranks[0]);
+    if (fallbackModes.count(1) && ranks.size() >= 2) setRotateModeRecords(ranks[1]);
+    if (fallbackModes.count(2) && ranks.size() >= 3) setMultiplayerRecords(ranks[2]);
+    fallbackModes.clear();
+}
+
+void RankListWidget::onLocateMeClicked() {
+    if (!gameWindow) return;
+    QTableView* table = qobject_cast<QTableView*>(tabWidget->currentWidget());
+    if (!table) return;
+    // 结果由 setupTab 里连接的 userLocated 处理
+    static_cast<RankTableModel*>(table->model())->locateUser(gameWindow->getUserID());
 }
 
 void RankListWidget::onBackClicked() {
@@ -463,7 +458,7 @@ void RankListWidget::paintEvent(QPaintEvent* event) {
     
     // 绘制背景图片（静态，不移动）
     if (!bgImage.isNull()) {
-        QPixmap scaled = bgImage.scaled(size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        const QPixmap& scaled = bgImage.scaled(size());
         int offsetX = (scaled.width() - width()) / 2;
         int offsetY = (scaled.height() - height()) / 2;
         p.drawPixmap(0, 0, scaled, offsetX, offsetY, width(), height());
@@ -508,27 +503,11 @@ void RankListWidget::paintEvent(QPaintEvent* event) {
     }
     
     // 绘制浮动粒子（发光效果）
-    p.setPen(Qt::NoPen);
-    for (const auto& particle : particles) {
-        // 粒子呼吸效果
-        float breathe = 0.7f + 0.3f * std::sin(bgAnimPhase + particle.phase);
-        int alpha = static_cast<int>(particle.alpha * breathe);
-        
-        // 绘制光晕
-        QRadialGradient glow(particle.x, particle.y, particle.size * 2);
-        glow.setColorAt(0, QColor(255, 255, 255, alpha));
-        glow.setColorAt(0.5, QColor(200, 220, 255, alpha / 2));
-        glow.setColorAt(1, QColor(150, 180, 255, 0));
-        p.setBrush(glow);
-        p.drawEllipse(QPointF(particle.x, particle.y), particle.size * 2, particle.size * 2);
-        
-        // 绘制粒子核心
-        p.setBrush(QColor(255, 255, 255, alpha));
-        p.drawEllipse(QPointF(particle.x, particle.y), particle.size * 0.5, particle.size * 0.5);
-    }
+    particles->draw(p);
 }
 
 void RankListWidget::resizeEvent(QResizeEvent* event) {
     QWidget::resizeEvent(event);
+    bgImage.invalidate();
     update(); // 重绘背景
 }
@@ -2,8 +2,13 @@
 #define RANK_LIST_WIDGET_H
 #include <QWidget>
 #include <QPixmap>
+#include "../../utils/BackgroundCache.h"
+#include <set>
 #include <vector>
 #include <QString>
+#include "RankTableModel.h"
+
+class ParticleSystem;
 
 class GameWindow;
 class QVBoxLayout;
@@ -11,17 +16,7 @@ class QHBoxLayout;
 class QLabel;
 class QPushButton;
 class QTabWidget;
-class QTableWidget;
-class QTableWidgetItem;
-
-// 单条排行记录
-struct RankRecord {
-    std::string id;
-    int score;
-    
-    RankRecord() : score(0) {}
-    RankRecord(std::string id, int s) : id(id), score(s) {}
-};
+class QTableView;
 
 class RankListWidget : public QWidget {
     Q_OBJECT
@@ -36,6 +31,9 @@ public:
     // 刷新显示
     void refreshDisplay();
 
+    // 从服务器分页加载三个榜单，服务器不支持分页时回退到整表接口
+    void reloadFromServer();
+
 signals:
     void backToMenu();
 
@@ -45,27 +43,36 @@ protected:
 
 private slots:
     void onBackClicked();
+    void onLocateMeClicked();  // 定位到自己的名次
     void updateGoldenAnimation();  // 鎏金动画更新
-    void updateBackgroundAnimation();  // 背景动画更新
+    void updateBackgroundAnimation(float dt);  // 背景动画更新（海鸥），由粒子系统的帧时钟驱动
 
 private:
     void setupUI();
-    void setupTab(QTableWidget* table, const QStringList& headers);
-    void updateTable(QTableWidget* table, const std::vector<RankRecord>& records);
-    void sortAndKeepTop10(std::vector<RankRecord>& records, bool ascending = false);
-    void applyGoldenGlowEffect(QTableWidgetItem* item, int rank);
-    QColor getAnimatedGoldColor(int rank, float phase);
+    void setupTab(QTableView* table, RankTableModel* model);
+    void sortRecords(std::vector<RankRecord>& records, bool ascending = false);
+    // 分页失败时在后台拉取整表，mode 为失败的榜单
+    void loadFullRanks(int mode);
+    void onFullRanksLoaded(const std::vector<std::vector<std::pair<std::string, int>>>& ranks);
     
     GameWindow* gameWindow = nullptr;
     
     QVBoxLayout* mainLayout = nullptr;
     QPushButton* backButton = nullptr;
+    QPushButton* locateButton = nullptr;
     QLabel* titleLabel = nullptr;
     QTabWidget* tabWidget = nullptr;
     
-    QTableWidget* normalModeTable = nullptr;
-    QTableWidget* rotateModeTable = nullptr;
-    QTableWidget* multiplayerTable = nullptr;
+    QTableView* normalModeTable = nullptr;
+    QTableView* rotateModeTable = nullptr;
+    QTableView* multiplayerTable = nullptr;
+
+    // 虚拟化模型：只缓存若干页，视图只绘制可见行
+    RankTableModel* normalModeModel = nullptr;
+    RankTableModel* rotateModeModel = nullptr;
+    RankTableModel* multiplayerModel = nullptr;
+    std::set<int> fallbackModes;     // 等待整表回退数据的榜单
+    bool fullRanksLoading = false;   // 整表请求进行中
     
     // 数据存储
     std::vector<RankRecord> normalModeRecords;
@@ -73,21 +80,10 @@ private:
     std::vector<RankRecord> multiplayerRecords;
     
     // 背景图片
-    QPixmap bgImage;
-    
-    // 背景动画
-    float bgAnimPhase = 0.0f;  // 背景动画相位
-    QTimer* bgAnimTimer = nullptr;  // 背景动画定时器
+    ScaledBackground bgImage;
     
-    // 浮动粒子
-    struct Particle {
-        float x, y;
-        float speedX, speedY;
-        float size;
-        float alpha;
-        float phase;
-    };
-    std::vector<Particle> particles;
+    // 浮动粒子：控件隐藏时连同海鸥动画一起停下
+    ParticleSystem* particles = nullptr;
     
     // 海鸥
     struct Seagull {
@@ -101,7 +97,6 @@ private:
     // 鎏金动画
     QTimer* goldenAnimTimer = nullptr;
     float goldenAnimPhase = 0.0f;
-    std::vector<QTableWidgetItem*> goldenItems;  // 存储需要动画的item
 };
 
 #endif // RANK_LIST_WIDGET_H
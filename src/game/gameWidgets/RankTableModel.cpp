@@ -0,0 +1,317 @@
+#include "RankTableModel.h"
+#include <QCoreApplication>
+#include <QFont>
+#include <QDebug>
+#include <QPointer>
+#include <QThreadPool>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+// 榜单不足时仍显示的占位行数，与旧版固定10行的外观保持一致
+constexpr int kMinDisplayRows = 10;
+}
+
+RankTableModel::RankTableModel(const QStringList& headers, QObject* parent)
+    : QAbstractTableModel(parent), headers(headers) {
+    connect(this, &RankTableModel::pageRequested, this, &RankTableModel::fetchPage, Qt::QueuedConnection);
+}
+
+int RankTableModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return std::max(total, kMinDisplayRows);
+}
+
+int RankTableModel::columnCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return headers.size();
+}
+
+const RankRecord* RankTableModel::recordAt(int row) const {
+    if (row < 0 || row >= total) return nullptr;
+    auto it = pages.find(row / kPageSize);
+    if (it == pages.end()) return nullptr;
+    int idx = row % kPageSize;
+    if (idx >= (int)it->second.size()) return nullptr;
+    const RankRecord& rec = it->second[idx];
+    // id 为空表示该行所在页只收到了一部分
+    return rec.id.empty() ? nullptr : &rec;
+}
+
+QVariant RankTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) return QVariant();
+    int row = index.row();
+    int col = index.column();
+
+    const RankRecord* rec = recordAt(row);
+    bool loading = !rec && row < total;
+    if (loading && remote) {
+        requestPage(row / kPageSize);
+    }
+
+    switch (role) {
+        case Qt::DisplayRole: {
+            if (col == 0) {
+                static const QStringList medals = {"🥇", "🥈", "🥉"};
+                if (rec && row < 3) return medals[row];
+                return QString::number(row + 1);
+            }
+            if (!rec) return loading ? QString("…") : QString("--");
+            if (col == 1) return QString::fromStdString(rec->id);
+            return QString::number(rec->score);
+        }
+        case Qt::TextAlignmentRole:
+            return int(Qt::AlignCenter);
+        case Qt::FontRole: {
+            if (!rec) return QVariant();
+            QFont font;
+            if (col == 0) {
+                font = QFont("Segoe UI Emoji", 16);
+            } else if (col == 1) {
+                font.setPointSize(12);
+            } else {
+                font.setPointSize(14);
+                font.setBold(true);
+            }
+            if (row < 3) font.setBold(true);
+            return font;
+        }
+        case Qt::ForegroundRole: {
+            if (!rec) return QColor(100, 100, 100);
+            if (row < 3) return getAnimatedGoldColor(row, goldenPhase);
+            return QColor(200, 210, 230);  // 亮白蓝色
+        }
+        case Qt::BackgroundRole: {
+            if (rec && !highlightId.empty() && rec->id == highlightId) {
+                return QColor(100, 180, 255, 60);
+            }
+            return QVariant();
+        }
+        default:
+            return QVariant();
+    }
+}
+
+QVariant RankTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < headers.size()) {
+        return headers[section];
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+void RankTableModel::setFetchers(PageFetcher pageFetcher, AroundFetcher aroundFetcher) {
+    this->pageFetcher = std::move(pageFetcher);
+    this->aroundFetcher = std::move(aroundFetcher);
+}
+
+void RankTableModel::resetRemote() {
+    beginResetModel();
+    ++generation;
+    pages.clear();
+    pendingPages.clear();
+    failedPages.clear();
+    total = 0;
+    remote = false;
+    endResetModel();
+
+    if (!pageFetcher) {
+        emit remoteLoaded(false);
+        return;
+    }
+
+    runFetch([fetcher = pageFetcher](RankPage& page) { return fetcher(0, kPageSize, page); },
+             [this](bool ok, const RankPage& page) {
+                 if (ok) {
+                     remote = true;
+                     storePage(page);
+                 }
+                 emit remoteLoaded(ok);
+             });
+}
+
+void RankTableModel::setLocalRecords(const std::vector<RankRecord>& records) {
+    beginResetModel();
+    ++generation;
+    remote = false;
+    pages.clear();
+    pendingPages.clear();
+    failedPages.clear();
+    total = (int)records.size();
+    for (int i = 0; i < total; ++i) {
+        pages[i / kPageSize].push_back(records[i]);
+    }
+    endResetModel();
+}
+
+void RankTableModel::locateUser(const std::string& id) {
+    if (id.empty()) {
+        emit userLocated(-1);
+        return;
+    }
+
+    if (!remote) {
+        for (const auto& kv : pages) {
+            for (size_t i = 0; i < kv.second.size(); ++i) {
+                if (kv.second[i].id == id) {
+                    emit userLocated(kv.first * kPageSize + (int)i);
+                    return;
+                }
+            }
+        }
+        emit userLocated(-1);
+        return;
+    }
+
+    if (!aroundFetcher) {
+        emit userLocated(-1);
+        return;
+    }
+    runFetch([fetcher = aroundFetcher, id](RankPage& page) { return fetcher(id, kPageSize, page); },
+             [this, id](bool ok, const RankPage& page) {
+                 if (!ok) {
+                     emit userLocated(-1);
+                     return;
+                 }
+                 storePage(page);
+                 for (size_t i = 0; i < page.entries.size(); ++i) {
+                     if (page.entries[i].first == id) {
+                         emit userLocated(page.start + (int)i);
+                         return;
+                     }
+                 }
+                 emit userLocated(-1);
+             });
+}
+
+void RankTableModel::setGoldenPhase(float phase) {
+    goldenPhase = phase;
+    int rows = std::min(3, total);
+    if (rows > 0) {
+        emit dataChanged(index(0, 0), index(rows - 1, columnCount() - 1), {Qt::ForegroundRole});
+    }
+}
+
+QColor RankTableModel::getAnimatedGoldColor(int rank, float phase) {
+    // 使用正弦波创建闪烁效果，不同排名有不同的相位偏移
+    float offset = rank * 0.5f;
+    float wave = 0.5f + 0.5f * std::sin(phase + offset);
+
+    switch (rank) {
+        case 0: {
+            // 第一名 - 金色闪光：从深金色到亮金色
+            int r = 200 + (int)(55 * wave);   // 200-255
+            int g = 160 + (int)(95 * wave);   // 160-255
+            int b = (int)(100 * wave);        // 0-100
+            return QColor(r, g, b);
+        }
+        case 1: {
+            // 第二名 - 银色闪光：从灰银到亮白
+            int base = 170 + (int)(85 * wave); // 170-255
+            return QColor(base, base, std::min(255, base + 20));
+        }
+        case 2: {
+            // 第三名 - 铜色闪光：从暗铜到亮铜
+            int r = 180 + (int)(75 * wave);   // 180-255
+            int g = 100 + (int)(80 * wave);   // 100-180
+            int b = 50 + (int)(50 * wave);    // 50-100
+            return QColor(r, g, b);
+        }
+        default:
+            return QColor(255, 255, 255);
+    }
+}
+
+void RankTableModel::requestPage(int page) const {
+    // data() 在绘制过程中被调用，只登记页号并排队，请求在 fetchPage 里发出
+    if (pendingPages.count(page) || failedPages.count(page)) return;
+    pendingPages.insert(page);
+    emit pageRequested(page);
+}
+
+void RankTableModel::fetchPage(int page) {
+    if (!remote || !pageFetcher) {
+        pendingPages.erase(page);
+        return;
+    }
+
+    runFetch([fetcher = pageFetcher, page](RankPage& result) { return fetcher(page * kPageSize, kPageSize, result); },
+             [this, page](bool ok, const RankPage& result) {
+                 pendingPages.erase(page);
+                 if (!ok) {
+                     // 记录失败页，避免每次重绘都重新发起请求
+                     failedPages.insert(page);
+                     qDebug() << "[RankTableModel] Failed to fetch rank page" << page;
+                     return;
+                 }
+                 storePage(result);
+             });
+}
+
+void RankTableModel::runFetch(std::function<bool(RankPage&)> fetch, FetchDone done) {
+    // 工作线程只调用 fetch，结果排队回主线程；模型已销毁或期间被重置时丢弃结果
+    QPointer<RankTableModel> self(this);
+    int requestGeneration = generation;
+    QThreadPool::globalInstance()->start([self, requestGeneration, fetch, done]() {
+        RankPage page;
+        bool ok = fetch(page);
+        QMetaObject::invokeMethod(QCoreApplication::instance(), [self, requestGeneration, done, ok, page]() {
+            if (!self || self->generation != requestGeneration) return;
+            done(ok, page);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void RankTableModel::storePage(const RankPage& page) {
+    setTotal(page.total);
+    if (page.entries.empty()) return;
+
+    int first = page.start;
+    int last = page.start + (int)page.entries.size() - 1;
+    for (size_t i = 0; i < page.entries.size(); ++i) {
+        int row = page.start + (int)i;
+        std::vector<RankRecord>& slot = pages[row / kPageSize];
+        if ((int)slot.size() < kPageSize) slot.resize(kPageSize);
+        slot[row % kPageSize] = RankRecord(page.entries[i].first, page.entries[i].second);
+    }
+    evictPages(first / kPageSize);
+
+    last = std::min(last, rowCount() - 1);
+    if (first <= last) {
+        emit dataChanged(index(first, 0), index(last, columnCount() - 1));
+    }
+}
+
+void RankTableModel::setTotal(int newTotal) {
+    newTotal = std::max(0, newTotal);
+    if (newTotal == total) return;
+
+    int oldRows = rowCount();
+    int newRows = std::max(newTotal, kMinDisplayRows);
+    if (newRows > oldRows) {
+        beginInsertRows(QModelIndex(), oldRows, newRows - 1);
+        total = newTotal;
+        endInsertRows();
+    } else if (newRows < oldRows) {
+        beginRemoveRows(QModelIndex(), newRows, oldRows - 1);
+        total = newTotal;
+        endRemoveRows();
+    } else {
+        total = newTotal;
+        emit dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+    }
+}
+
+void RankTableModel::evictPages(int keepPage) {
+    if (!remote) return;
+    // 淘汰离当前页最远的缓存页，保证内存上限
+    while ((int)pages.size() > kMaxCachedPages) {
+        auto farthest = pages.begin();
+        for (auto it = pages.begin(); it != pages.end(); ++it) {
+            if (std::abs(it->first - keepPage) > std::abs(farthest->first - keepPage)) {
+                farthest = it;
+            }
+        }
+        pages.erase(farthest);
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef RANK_TABLE_MODEL_H
+#define RANK_TABLE_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QColor>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "../data/OtherNetData.h"
+
+// 单条排行记录
+struct RankRecord {
+    std::string id;
+    int score;
+
+    RankRecord() : score(0) {}
+    RankRecord(std::string id, int s) : id(id), score(s) {}
+};
+
+/**
+ * RankTableModel - 排行榜的虚拟化数据模型
+ *
+ * 配合 QTableView 使用：视图只绘制可见行，模型按页缓存数据，
+ * 滚动到未加载的行时才向服务器请求对应的那一页，
+ * 缓存页数有上限，内存和打开耗时与总人数无关。
+ * 网络请求都在线程池里执行，结果排队回主线程写入缓存，界面线程从不等待服务器。
+ */
+class RankTableModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    static constexpr int kPageSize = 50;       // 每页条数
+    static constexpr int kMaxCachedPages = 6;  // 最多缓存的页数
+
+    // 按 offset/limit 取一页，成功返回 true（在工作线程中调用）
+    using PageFetcher = std::function<bool(int offset, int limit, RankPage& page)>;
+    // 取包含指定用户的那一页（在工作线程中调用）
+    using AroundFetcher = std::function<bool(const std::string& id, int limit, RankPage& page)>;
+
+    explicit RankTableModel(const QStringList& headers, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void setFetchers(PageFetcher pageFetcher, AroundFetcher aroundFetcher);
+
+    // 服务器分页模式：清空缓存并异步拉取第一页，完成后发出 remoteLoaded
+    void resetRemote();
+    // 本地模式：整表数据已在内存中（离线或旧版服务器）
+    void setLocalRecords(const std::vector<RankRecord>& records);
+
+    // 定位指定用户所在行，结果通过 userLocated 发出
+    void locateUser(const std::string& id);
+    void setHighlightId(const std::string& id) { highlightId = id; }
+
+    // 前三名鎏金动画的相位
+    void setGoldenPhase(float phase);
+    static QColor getAnimatedGoldColor(int rank, float phase);
+
+signals:
+    // 第一页请求结束，ok 为 false 表示服务器不支持分页或离线
+    void remoteLoaded(bool ok);
+    // locateUser 的结果，找不到时 row 为 -1
+    void userLocated(int row);
+    // data() 遇到未加载的页时发出，排队交给 fetchPage
+    void pageRequested(int page) const;
+
+private:
+    using FetchDone = std::function<void(bool ok, const RankPage& page)>;
+
+    const RankRecord* recordAt(int row) const;
+    void requestPage(int page) const;
+    void fetchPage(int page);
+    void runFetch(std::function<bool(RankPage&)> fetch, FetchDone done);
+    void storePage(const RankPage& page);
+    void setTotal(int newTotal);
+    void evictPages(int keepPage);
+
+    QStringList headers;
+    PageFetcher pageFetcher;
+    AroundFetcher aroundFetcher;
+    bool remote = false;
+    int total = 0;
+    float goldenPhase = 0.0f;
+    std::string highlightId;
+    int generation = 0;  // 每次重置加一，丢弃重置前发出的请求结果
+
+    // 页号 -> 该页记录（远程模式下稀疏缓存，本地模式下为全表）
+    std::map<int, std::vector<RankRecord>> pages;
+    mutable std::set<int> pendingPages;  // 已请求未返回的页，data() 里登记
+    std::set<int> failedPages;
+};
+
+#endif // RANK_TABLE_MODEL_H
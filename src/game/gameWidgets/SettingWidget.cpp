@@ -3,6 +3,7 @@
 #include "../../utils/BackgroundManager.h"
 #include "../../utils/ResourceUtils.h"
 #include "../../game/components/Gemstone.h"
+#include "../../game/components/ParticleSystem.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFileDialog>
@@ -17,6 +18,7 @@
 #include <QGraphicsDropShadowEffect>
 #include "MenuWidget.h"
 #include "../../utils/BGMManager.h"
+#include "../../utils/AudioManager.h"
 #include <QSettings>
 
 // ==================== 自定义保存成功对话框 ====================
@@ -148,6 +150,11 @@ bool SettingWidget::isEliminateSoundEnabled() {
     return settings.value("Music/EliminateEnable", true).toBool();
 }
 
+QString SettingWidget::getEliminateSoundType() {
+    QSettings settings("GemMatch", "Settings");
+    return settings.value("Music/EliminateType", "Manbo").toString();
+}
+
 QString SettingWidget::getMenuBackgroundImage() {
     QSettings settings("GemMatch", "Settings");
     QString defaultBg = QString::fromStdString(ResourceUtils::getPath("images/default_bg.png"));
@@ -159,12 +166,18 @@ QString SettingWidget::getGemStyle() {
     return settings.value("Game/GemStyle", "几何体").toString();
 }
 
+int SettingWidget::getIdleSpinMode() {
+    QSettings settings("GemMatch", "Settings");
+    return settings.value("Image/IdleSpin", 0).toInt();
+}
+
 // ==================== 构造函数 ====================
 
 SettingWidget::SettingWidget(QWidget* parent, GameWindow* gameWindow)
-    : QWidget(parent), gameWindow(gameWindow), animTime(0) {
+    : QWidget(parent), gameWindow(gameWindow), particles(nullptr) {
     settings = new QSettings("GemMatch", "Settings");
     setWindowTitle("设置");
+    background.setSource(BackgroundCache::instance().loadResource(BackgroundManager::instance().getSettingbackground()));
 
     setMinimumSize(800, 600);
     resize(1600, 1000);
@@ -172,9 +185,6 @@ SettingWidget::SettingWidget(QWidget* parent, GameWindow* gameWindow)
 
     // ====================== 1. 初始化动画 ======================
     initParticles();
-    animTimer = new QTimer(this);
-    connect(animTimer, &QTimer::timeout, this, &SettingWidget::updateAnimation);
-    animTimer->start(10);
 
     // ====================== 2. 初始化控件 ======================
     
@@ -192,9 +202,11 @@ SettingWidget::SettingWidget(QWidget* parent, GameWindow* gameWindow)
 
     // 图像设置控件
     resolutionCombo = new QComboBox(this);
+    idleSpinCombo = new QComboBox(this);
     selectBgBtn = new QPushButton("选择图片", this);
     bgPreviewLabel = new QLabel(this);
     QLabel* resolutionLabel = new QLabel("分辨率", this);
+    QLabel* idleSpinLabel = new QLabel("宝石待机旋转", this);
     QLabel* bgLabel = new QLabel("菜单背景图", this);
 
     // 游戏设置控件
@@ -219,7 +231,7 @@ SettingWidget::SettingWidget(QWidget* parent, GameWindow* gameWindow)
     
     // 标签样式
     QList<QLabel*> labels = {bgMusicLabel, eliminateSoundLabel, bgVolLabel, eliminateVolLabel,
-                             resolutionLabel, bgLabel, gameTipLabel, gemStyleLabel, 
+                             resolutionLabel, idleSpinLabel, bgLabel, gameTipLabel, gemStyleLabel, 
                              eliminateSoundSelectLabel, gemStyleDescLabel, difficultyLabel};
     for (QLabel* label : labels) {
         label->setStyleSheet(R"(
@@ -345,6 +357,7 @@ SettingWidget::SettingWidget(QWidget* parent, GameWindow* gameWindow)
         }
     )";
     resolutionCombo->setStyleSheet(comboStyle);
+    idleSpinCombo->setStyleSheet(comboStyle);
     gemStyleCombo->setStyleSheet(comboStyle);
     eliminateSoundCombo->setStyleSheet(comboStyle);
     difficultyCombo->setStyleSheet(comboStyle);
@@ -360,6 +373,8 @@ SettingWidget::SettingWidget(QWidget* parent, GameWindow* gameWindow)
         "2560x1440"
     });
     eliminateSoundCombo->addItems({"Manbo", "Original"});
+    // 棋盘静止时 3D 窗口只在有动画或输入时出帧，待机自转决定静止时的帧率
+    idleSpinCombo->addItems({"流畅（60Hz）", "节能（20Hz）", "关闭"});
     
     // 更新宝石风格下拉框选项
     updateGemStyleComboItems();
@@ -511,6 +526,12 @@ SettingWidget::SettingWidget(QWidget* parent, GameWindow* gameWindow)
     resolutionLayout->addSpacing(20);
     resolutionLayout->addWidget(resolutionCombo);
     resolutionLayout->addStretch();
+
+    QHBoxLayout* idleSpinLayout = new QHBoxLayout();
+    idleSpinLayout->addWidget(idleSpinLabel);
+    idleSpinLayout->addSpacing(20);
+    idleSpinLayout->addWidget(idleSpinCombo);
+    idleSpinLayout->addStretch();
     
     QVBoxLayout* bgLayout = new QVBoxLayout();
     QHBoxLayout* bgCtrlLayout = new QHBoxLayout();
@@ -522,6 +543,7 @@ SettingWidget::SettingWidget(QWidget* parent, GameWindow* gameWindow)
     bgLayout->addLayout(bgCtrlLayout);
     
     imageLayout->addLayout(resolutionLayout);
+    imageLayout->addLayout(idleSpinLayout);
     imageLayout->addLayout(bgLayout);
     imageLayout->addStretch();
 
@@ -732,8 +754,9 @@ void SettingWidget::loadSettings() {
     QString defaultBg = QString::fromStdString(ResourceUtils::getPath("images/default_bg.png"));
     currentBgPath = settings->value("Image/MenuBg", defaultBg).toString();
     resolutionCombo->setCurrentText(resolution);
+    idleSpinCombo->setCurrentIndex(qBound(0, settings->value("Image/IdleSpin", 0).toInt(), idleSpinCombo->count() - 1));
 
-    QPixmap bgPixmap(currentBgPath);
+    QPixmap bgPixmap = BackgroundCache::instance().load(currentBgPath);
     if (!bgPixmap.isNull()) {
         bgPreviewLabel->setPixmap(bgPixmap.scaled(bgPreviewLabel->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
     }
@@ -768,6 +791,7 @@ void SettingWidget::saveSettings() {
 
     // 保存图像设置
     settings->setValue("Image/Resolution", resolutionCombo->currentText());
+    settings->setValue("Image/IdleSpin", idleSpinCombo->currentIndex());
     settings->setValue("Image/MenuBg", currentBgPath);
 
     // 保存游戏设置 - 宝石风格
@@ -788,6 +812,9 @@ void SettingWidget::saveSettings() {
         BGMManager::instance().pause();
     }
 
+    // 音效设置有缓存，保存后让 AudioManager 重新读取（类型变化时重建音色池）
+    AudioManager::instance().reloadSettings();
+
     emit backgroundImageChanged(currentBgPath);
     
     // ========== 使用自定义美观对话框 ==========
@@ -805,84 +832,99 @@ void SettingWidget::selectMenuBackground() {
     );
     if (!filePath.isEmpty()) {
         currentBgPath = filePath;
-        QPixmap bgPixmap(filePath);
+        QPixmap bgPixmap = BackgroundCache::instance().load(filePath);
         if (!bgPixmap.isNull()) {
             bgPreviewLabel->setPixmap(bgPixmap.scaled(bgPreviewLabel->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
         }
     }
 }
 
+// 粒子精灵：按参考尺寸画一次，绘制时按每个粒子的宽高缩放
+static QImage renderLeafSprite() {
+    QImage image(64, 64, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    QRectF leafRect(1, 1, 62, 62);
+    QLinearGradient leafGrad(leafRect.topLeft(), leafRect.bottomRight());
+    leafGrad.setColorAt(0.0, QColor(255, 160, 60, 220));
+    leafGrad.setColorAt(1.0, QColor(255, 120, 30, 220));
+    p.setBrush(leafGrad);
+    p.setPen(Qt::NoPen);
+    p.drawEllipse(leafRect);
+    return image;
+}
+
+static QImage renderCloudSprite() {
+    QImage image(128, 48, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing);
+    QRectF cloudRect(1, 1, 126, 46);
+    QLinearGradient cloudGrad(cloudRect.topLeft(), cloudRect.bottomRight());
+    cloudGrad.setColorAt(0.0, QColor(255, 245, 230, 120));
+    cloudGrad.setColorAt(1.0, QColor(255, 230, 200, 100));
+    p.setBrush(cloudGrad);
+    p.setPen(Qt::NoPen);
+    p.drawRoundedRect(cloudRect, cloudRect.height() / 2, cloudRect.height() / 2);
+    return image;
+}
+
 void SettingWidget::initParticles() {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_real_distribution<float> posDist(0.0f, 1.0f);
     std::uniform_real_distribution<float> leafSizeDist(0.015f, 0.04f);
     std::uniform_real_distribution<float> cloudSizeDist(0.02f, 0.06f);
-    std::uniform_real_distribution<float> speedDist(0.005f, 0.008f);
+    // 速度均为每秒的位移（比例坐标），对应原先 10ms 一帧的步长
+    std::uniform_real_distribution<float> speedDist(0.5f, 0.8f);
     std::uniform_real_distribution<float> angleDist(0.0f, 360.0f);
-    std::uniform_real_distribution<float> angleSpeedDist(-0.8f, 0.8f);
+    std::uniform_real_distribution<float> angleSpeedDist(-80.0f, 80.0f);
     std::uniform_real_distribution<float> opacityDist(0.4f, 0.7f);
-    std::uniform_real_distribution<float> driftDist(-0.0003f, 0.0003f);
+    std::uniform_real_distribution<float> driftDist(-0.03f, 0.03f);
+
+    particles = new ParticleSystem(this);
+    particles->setSpace(ParticleSystem::Space::Normalized);
+    // 从左侧飘出后回到右侧外面，高度和透明度重新随机
+    particles->setBounds(ParticleSystem::Bounds::Respawn, QMarginsF(0.1, 0.1, 0.2, 0.1));
+    particles->setRespawn([gen, posDist, opacityDist](ParticleSystem::Particle& p) mutable {
+        p.x = 1.1f;
+        p.y = posDist(gen);
+        p.alpha = opacityDist(gen);
+    });
+    int leafSprite = particles->addSprite(renderLeafSprite());
+    int cloudSprite = particles->addSprite(renderCloudSprite());
+    QSizeF leafSize = particles->spriteSize(leafSprite);
+    QSizeF cloudSize = particles->spriteSize(cloudSprite);
 
+    particles->reserve(10);
     for (int i = 0; i < 6; ++i) {
-        Particle p;
-        p.pos = QPointF(posDist(gen), posDist(gen));
-        p.size = QSizeF(leafSizeDist(gen) * width(), leafSizeDist(gen) * height() * 1.5f);
-        p.angle = angleDist(gen);
-        p.speed = speedDist(gen) * 0.9f;
-        p.angleSpeed = angleSpeedDist(gen);
-        p.opacity = opacityDist(gen);
-        p.driftX = driftDist(gen);
-        p.driftY = driftDist(gen);
-        p.type = 0;
-        particles.append(p);
+        ParticleSystem::Particle p;
+        p.x = posDist(gen);
+        p.y = posDist(gen);
+        p.scaleX = leafSizeDist(gen) * width() / leafSize.width();
+        p.scaleY = leafSizeDist(gen) * height() * 1.5f / leafSize.height();
+        p.rotation = angleDist(gen);
+        p.vx = driftDist(gen) - speedDist(gen) * 0.9f;
+        p.vy = driftDist(gen);
+        p.spin = angleSpeedDist(gen);
+        p.alpha = opacityDist(gen);
+        p.sprite = leafSprite;
+        particles->spawn(p);
     }
 
     for (int i = 0; i < 4; ++i) {
-        Particle p;
-        p.pos = QPointF(posDist(gen), posDist(gen) * 0.6f);
-        p.size = QSizeF(cloudSizeDist(gen) * 2 * width(), cloudSizeDist(gen) * 1.2f * height());
-        p.angle = 0;
-        p.speed = speedDist(gen) * 0.8f;
-        p.angleSpeed = 0;
-        p.opacity = opacityDist(gen) * 0.6f;
-        p.driftX = driftDist(gen) * 0.6f;
-        p.driftY = driftDist(gen) * 0.3f;
-        p.type = 1;
-        particles.append(p);
-    }
-}
-
-void SettingWidget::updateAnimation() {
-    animTime += 0.010f;
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> posDist(0.0f, 1.0f);
-    std::uniform_real_distribution<float> opacityDist(0.4f, 0.7f);
-
-    for (auto& p : particles) {
-        p.pos.rx() -= p.speed;
-        p.pos.ry() += p.driftY;
-        p.pos.rx() += p.driftX;
-
-        if (p.type == 0) {
-            p.angle += p.angleSpeed;
-            if (p.angle < 0) p.angle += 360;
-            if (p.angle > 360) p.angle -= 360;
-        }
-
-        if (p.pos.x() < -0.1f) {
-            p.pos.rx() = 1.1f;
-            p.pos.ry() = posDist(gen);
-            p.opacity = opacityDist(gen);
-        }
-
-        if (p.pos.y() < 0) p.pos.ry() = 0;
-        if (p.pos.y() > 1.0f) p.pos.ry() = 1.0f;
+        ParticleSystem::Particle p;
+        p.x = posDist(gen);
+        p.y = posDist(gen) * 0.6f;
+        p.scaleX = cloudSizeDist(gen) * 2 * width() / cloudSize.width();
+        p.scaleY = cloudSizeDist(gen) * 1.2f * height() / cloudSize.height();
+        p.vx = driftDist(gen) * 0.6f - speedDist(gen) * 0.8f;
+        p.vy = driftDist(gen) * 0.3f;
+        p.alpha = opacityDist(gen) * 0.6f;
+        p.sprite = cloudSprite;
+        particles->spawn(p);
     }
-
-    update();
 }
 
 void SettingWidget::paintEvent(QPaintEvent* event) {
@@ -894,50 +936,12 @@ void SettingWidget::paintEvent(QPaintEvent* event) {
     QColor bgColor(255, 160, 60, 80);
     p.fillRect(rect(), bgColor);
 
-    QString bgPath = QString::fromStdString(ResourceUtils::getPath("images/setting_bg.png"));
-    QPixmap bgPixmap(bgPath);
-    if (!bgPixmap.isNull()) {
-        p.drawPixmap(rect(), bgPixmap.scaled(rect().size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation));
+    if (!background.isNull()) {
+        // 拉伸铺满窗口
+        p.drawPixmap(0, 0, background.scaled(size(), Qt::IgnoreAspectRatio));
     }
 
-    p.setRenderHint(QPainter::Antialiasing);
-    for (const auto& paticle : particles) {
-        QPointF drawPos(paticle.pos.x() * width(), paticle.pos.y() * height());
-        p.save();
-
-        p.translate(drawPos);
-        if (paticle.type == 0) {
-            p.rotate(paticle.angle);
-        }
-
-        p.setOpacity(paticle.opacity);
-
-        if (paticle.type == 0) {
-            QPainterPath leafPath;
-            QRectF leafRect(-paticle.size.width()/2, -paticle.size.height()/2, paticle.size.width(), paticle.size.height());
-            leafPath.addEllipse(leafRect);
-
-            QLinearGradient leafGrad(leafRect.topLeft(), leafRect.bottomRight());
-            leafGrad.setColorAt(0.0, QColor(255, 160, 60, 220));
-            leafGrad.setColorAt(1.0, QColor(255, 120, 30, 220));
-            p.setBrush(leafGrad);
-            p.setPen(Qt::NoPen);
-            p.drawPath(leafPath);
-        } else {
-            QPainterPath cloudPath;
-            QRectF cloudRect(-paticle.size.width()/2, -paticle.size.height()/2, paticle.size.width(), paticle.size.height());
-            cloudPath.addRoundedRect(cloudRect, cloudRect.height()/2, cloudRect.height()/2);
-
-            QLinearGradient cloudGrad(cloudRect.topLeft(), cloudRect.bottomRight());
-            cloudGrad.setColorAt(0.0, QColor(255, 245, 230, 120));
-            cloudGrad.setColorAt(1.0, QColor(255, 230, 200, 100));
-            p.setBrush(cloudGrad);
-            p.setPen(Qt::NoPen);
-            p.drawPath(cloudPath);
-        }
-
-        p.restore();
-    }
+    particles->draw(p);
 
     style()->drawPrimitive(QStyle::PE_Widget, &opt, &p, this);
 }
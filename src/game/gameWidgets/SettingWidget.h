@@ -15,20 +15,10 @@
 #include <QPointF>
 #include <QSizeF>
 #include <QPainterPath>
-
-struct Particle {
-    QPointF pos;       // 位置（相对于窗口比例）
-    QSizeF size;       // 尺寸
-    qreal angle;       // 旋转角度
-    qreal speed;       // 移动速度
-    qreal angleSpeed;  // 旋转速度
-    qreal opacity;     // 透明度
-    qreal driftX;      // X轴漂移系数
-    qreal driftY;      // Y轴漂移系数
-    int type;          // 0=橙叶 1=云絮
-};
+#include "../../utils/BackgroundCache.h"
 
 class GameWindow;
+class ParticleSystem;
 
 class SettingWidget : public QWidget
 {
@@ -41,8 +31,10 @@ public:
     static int getEliminateSoundVolume();
     static bool isBackgroundMusicEnabled();
     static bool isEliminateSoundEnabled();
+    static QString getEliminateSoundType();  // 消除音效类型（Manbo / Original）
     static QString getMenuBackgroundImage();
     static QString getGemStyle();  // 新增：获取宝石风格
+    static int getIdleSpinMode();  // 宝石待机自转：0=流畅 1=节能(20Hz) 2=关闭
 
 protected:
     void paintEvent(QPaintEvent *event) override;
@@ -50,7 +42,6 @@ protected:
 private slots:
     void saveSettings();
     void selectMenuBackground();
-    void updateAnimation();
     void onGemStyleChanged(int index);  // 新增：宝石风格变化槽
 
 private:
@@ -60,10 +51,9 @@ private:
     
     GameWindow *gameWindow;
     QSettings *settings;
-    qreal animTime;
-    QTimer *animTimer;
-    QList<Particle> particles;
+    ParticleSystem *particles;     // 橙叶与云絮，界面隐藏时自动暂停
     QString currentBgPath;
+    ScaledBackground background;  // 粒子每帧重绘一次，背景只在尺寸变化时缩放
     
     // 音乐设置控件
     QSlider *bgMusicSlider;
@@ -77,6 +67,7 @@ private:
     
     // 图像设置控件
     QComboBox *resolutionCombo;
+    QComboBox *idleSpinCombo;     // 宝石待机自转模式
     QPushButton *selectBgBtn;
     QLabel *bgPreviewLabel;
     
@@ -3,11 +3,19 @@
 #include "MenuWidget.h"
 #include "../GameWindow.h"
 #include "../components/Gemstone.h"
+#include "../components/BoardReshuffler.h"
+#include "../components/PerfHud.h"
+#include "../components/IdleAnimationDriver.h"
+#include "SettingWidget.h"
 #include "../components/SelectedCircle.h"
 #include "../data/CoinSystem.h"
 #include "../data/ItemSystem.h"
 #include "../../utils/AudioManager.h"
+#include "../../utils/PerfStats.h"
+#include "../../utils/AnimationScheduler.h"
 #include "../data/AchievementSystem.h"
+#include "../data/ReplaySystem.h"
+#include "../logic/Board.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QPushButton>
@@ -303,6 +311,10 @@ SingleModeGameWidget::SingleModeGameWidget(QWidget* parent, GameWindow* gameWind
     
     // 创建3D窗口容器
     container3d = QWidget::createWindowContainer(game3dWindow);
+    // 离开本界面时停掉计时器、暂停宝石待机动画并让 3D 窗口停止出帧
+    idleDriver = new IdleAnimationDriver(this, game3dWindow, [this]() { return rootEntity; });
+    AnimationScheduler::instance().registerTimer(this, timer);
+    AnimationScheduler::instance().registerScene(this, game3dWindow, [this]() { return rootEntity; });
     // container3d->setFixedSize(960, 960); // 移除固定大小
     container3d->setMinimumSize(600, 600); // 设置最小大小
     container3d->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -503,7 +515,7 @@ SingleModeGameWidget::SingleModeGameWidget(QWidget* parent, GameWindow* gameWind
         // 连接按钮点击事件
         connect(btn, &QPushButton::clicked, this, [this, type]() {
             // 双重检查：确保 canOpe=true 且不在锤子模式
-            if (!canOpe || hammerMode) {
+            if (!canOpe || hammerMode || replayPlayer) {
                 qDebug() << "[ItemButton] Click ignored: canOpe=" << canOpe << "hammerMode=" << hammerMode;
                 return;
             }
@@ -601,6 +613,9 @@ SingleModeGameWidget::SingleModeGameWidget(QWidget* parent, GameWindow* gameWind
     container3d->installEventFilter(this);
     game3dWindow->installEventFilter(this); // 关键：在3D窗口上安装事件过滤器
 
+    // 性能浮层（F3 开关）
+    perfHud = new PerfHud(this, game3dWindow, rootEntity);
+
     // 初始化无操作计时器
     inactivityTimer = new QTimer(this);
     inactivityTimer->setInterval(inactivityTimeout);
@@ -675,7 +690,7 @@ void SingleModeGameWidget::triggerFinishIfNeeded() {
     if (isFinishing) return;
     if (gameScore < targetScore) return;
     finishToFinalWidget();
-    if (gameWindow->getUserID() != "$#SINGLE#$") {
+    if (gameWindow->getUserID() != "$#SINGLE#$" && !replayPlayer) {
         gameWindow->getOtherNetDataIO()->sendNormalTime(gameWindow->getUserID(), gameTimeKeeper.totalSeconds()/60);
     }
 }
@@ -702,6 +717,8 @@ void SingleModeGameWidget::finishToFinalWidget() {
     if (selectionRing1) selectionRing1->setVisible(false);
     if (selectionRing2) selectionRing2->setVisible(false);
 
+    ReplaySystem::instance().finishRecording(gameScore, earnedCoins);
+
     int total = gameTimeKeeper.totalSeconds();
     AchievementSystem::instance().triggerSingleModeComplete(total);
     int m = total / 60;
@@ -1044,10 +1061,12 @@ void SingleModeGameWidget::remove3x3AreaChain(int centerRow, int centerCol) {
 int comboCount = 0;
 
 void SingleModeGameWidget::eliminate() {
+    PhaseTimer phaseTimer(PerfStats::Eliminate);
     if (isFinishing) return;
     // 查找所有匹配
     std::vector<std::pair<int, int>> matches = findMatches(-1,-1,-1);
     if (!matches.empty()) {
+        PerfStats::instance().cascadeStep();
 
         comboCount++; // 增加连续消除计数
         appendDebug(QString("Found %1 matches to eliminate").arg(matches.size()));
@@ -1068,9 +1087,15 @@ void SingleModeGameWidget::eliminate() {
             drop();
         });
     } else {
+        PerfStats::instance().cascadeFinished();
         comboCount = 0;
         // 没有匹配了，恢复操作
         AchievementSystem::instance().sessionComboCount = 0;
+        // 连锁结束时用提示查找的结果判断死局，直接重排，不用等无操作提示
+        if (findPossibleMatches().empty()) {
+            reshuffleDeadBoard();
+            return;
+        }
         canOpe = true;
         updateItemButtons();  // 更新道具按钮状态
         resetInactivityTimer();
@@ -1079,6 +1104,7 @@ void SingleModeGameWidget::eliminate() {
 }
 
 void SingleModeGameWidget::drop() {
+    PhaseTimer phaseTimer(PerfStats::Drop);
     if (isFinishing) return;
     appendDebug("Starting drop animation");
 
@@ -1096,6 +1122,7 @@ void SingleModeGameWidget::drop() {
 
                     QVector3D targetPos = getPosition(writePos, col);
                     QPropertyAnimation* dropAnim = new QPropertyAnimation(gem->transform(), "translation");
+                    PerfStats::instance().trackAnimation(dropAnim);
                     dropAnim->setDuration(500);
                     dropAnim->setStartValue(gem->transform()->translation());
                     dropAnim->setEndValue(targetPos);
@@ -1125,6 +1152,7 @@ void SingleModeGameWidget::drop() {
 }
 
 void SingleModeGameWidget::resetGemstoneTable() {
+    PhaseTimer phaseTimer(PerfStats::Refill);
     if (isFinishing) return;
     appendDebug("Filling empty positions with new gemstones");
 
@@ -1136,7 +1164,7 @@ void SingleModeGameWidget::resetGemstoneTable() {
         for (int row = 0; row < 8; ++row) {
             if (gemstoneContainer[row][col] == nullptr) {
                 // 创建新宝石，避免立即形成三连
-                int type = QRandomGenerator::global()->bounded(difficulty);
+                int type = rng.bounded(difficulty);
 
                 // 检查左边两个
                 if (col >= 2 && gemstoneContainer[row][col-1] && gemstoneContainer[row][col-2]) {
@@ -1174,6 +1202,7 @@ void SingleModeGameWidget::resetGemstoneTable() {
 
                 // 创建下落动画
                 QPropertyAnimation* fillAnim = new QPropertyAnimation(gem->transform(), "translation");
+                PerfStats::instance().trackAnimation(fillAnim);
                 fillAnim->setDuration(500);
                 fillAnim->setStartValue(startPos);
                 fillAnim->setEndValue(targetPos);
@@ -1204,6 +1233,7 @@ void SingleModeGameWidget::eliminateAnime(Gemstone* gemstone) {
     if (!gemstone) return;
 
     QPropertyAnimation* animation = new QPropertyAnimation(gemstone->transform(), "scale");
+    PerfStats::instance().trackAnimation(animation);
     animation->setDuration(500); // 持续缩小直到不见
     animation->setStartValue(gemstone->transform()->scale());
     animation->setEndValue(0.0f);
@@ -1230,11 +1260,13 @@ void SingleModeGameWidget::switchGemstoneAnime(Gemstone* gemstone1, Gemstone* ge
     QParallelAnimationGroup* group = new QParallelAnimationGroup();
     
     QPropertyAnimation* anim1 = new QPropertyAnimation(gemstone1->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim1);
     anim1->setDuration(500); // 0.5s
     anim1->setStartValue(pos1);
     anim1->setEndValue(pos2);
     
     QPropertyAnimation* anim2 = new QPropertyAnimation(gemstone2->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim2);
     anim2->setDuration(500); // 0.5s
     anim2->setStartValue(pos2);
     anim2->setEndValue(pos1);
@@ -1266,6 +1298,7 @@ void SingleModeGameWidget::handleGemstoneClicked(Gemstone* gem) {
         int row = -1, col = -1;
         if (findGemstonePosition(gem, row, col)) {
             appendDebug(QString("🔨 Hammer used on gem at (%1, %2)").arg(row).arg(col));
+            ReplaySystem::instance().recordAction(ReplayAction::Hammer, row, col);
 
             // 禁止操作，防止在动画执行期间重复点击
             canOpe = false;
@@ -1391,6 +1424,9 @@ void SingleModeGameWidget::mouseMoveEvent(QMouseEvent* event) {
 
 void SingleModeGameWidget::showEvent(QShowEvent* event) {
     QWidget::showEvent(event);
+    // 待机动画模式可能在设置界面里改过
+    IdleAnimationDriver::Mode idleMode = static_cast<IdleAnimationDriver::Mode>(SettingWidget::getIdleSpinMode());
+    if (idleDriver) idleDriver->setMode(idleMode);
     if (container3d) {
         container3d->setFocus(Qt::OtherFocusReason);
         container3d->raise();
@@ -1407,6 +1443,8 @@ void SingleModeGameWidget::showEvent(QShowEvent* event) {
 
 void SingleModeGameWidget::hideEvent(QHideEvent* event) {
     QWidget::hideEvent(event);
+    // 离开游戏界面（非最小化）时结束回放
+    if (!event->spontaneous()) stopReplay();
     if (timer && timer->isActive()) {
         timer->stop();
     }
@@ -1656,10 +1694,17 @@ void SingleModeGameWidget::setMode(int mode) {
 }
 
 void SingleModeGameWidget::reset(int mode) {
+    // 每局一个独立的随机数流；回放或联机指定了种子时使用指定值
+    rng.reseed(hasPendingSeed ? pendingSeed : GameRng::makeSeed());
+    hasPendingSeed = false;
     AchievementSystem::instance().resetSessionStats();
-    if (gameWindow) {
+    if (pendingDifficulty > 0) {
+        difficulty = pendingDifficulty;
+        pendingDifficulty = 0;
+    } else if (gameWindow) {
         difficulty = gameWindow->getDifficulty();
     }
+    ReplaySystem::instance().beginRecording(BoardMode::Classic, difficulty, rng.seed());
     this->mode = mode;
     this->canOpe = true;
     updateItemButtons();  // 更新道具按钮状态
@@ -1701,31 +1746,12 @@ void SingleModeGameWidget::reset(int mode) {
     // 重建8x8网格
     gemstoneContainer.resize(8);
 
+    // 一次生成整盘类型：没有现成三连，并保证有可走步
+    std::array<int8_t, Board::kCells> types = Board::generateTypes(difficulty, rng, Board::defaultGenerateOptions(BoardMode::Classic));
     for (int i = 0; i < 8; ++i) {
         gemstoneContainer[i].resize(8);
         for (int j = 0; j < 8; ++j) {
-            int type = QRandomGenerator::global()->bounded(difficulty);
-
-            // 避免在初始化时创建三连
-            // 检查左边两个
-            if (j >= 2 && gemstoneContainer[i][j-1] && gemstoneContainer[i][j-2]) {
-                int type1 = gemstoneContainer[i][j-1]->getType();
-                int type2 = gemstoneContainer[i][j-2]->getType();
-                if (type1 == type2 && type == type1) {
-                    // 会形成三连，换一个类型
-                    type = (type + 1) % difficulty;
-                }
-            }
-
-            // 检查上边两个
-            if (i >= 2 && gemstoneContainer[i-1][j] && gemstoneContainer[i-2][j]) {
-                int type1 = gemstoneContainer[i-1][j]->getType();
-                int type2 = gemstoneContainer[i-2][j]->getType();
-                if (type1 == type2 && type == type1) {
-                    // 会形成三连，换一个类型
-                    type = (type + 1) % difficulty;
-                }
-            }
+            int type = types[i * 8 + j];
 
             Gemstone* gem = new Gemstone(type, "default", rootEntity);
 
@@ -1741,7 +1767,7 @@ void SingleModeGameWidget::reset(int mode) {
     appendDebug("created 8x8 gemstones with no initial matches");
 
     // 生成金币宝石 (随机1-3个)
-    int coinCount = QRandomGenerator::global()->bounded(1, 4);
+    int coinCount = rng.bounded(1, 4);
     generateCoinGems(coinCount);
 
     // 重置选择状态
@@ -1796,6 +1822,7 @@ bool SingleModeGameWidget::areAdjacent(int row1, int col1, int row2, int col2) c
 // 执行交换
 void SingleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1, int col1, int row2, int col2) {
     if (!gem1 || !gem2) return;
+    ReplaySystem::instance().recordAction(ReplayAction::Swap, row1, col1, row2, col2);
     canOpe = false;
     updateItemButtons();  // 更新道具按钮状态
     // 先在逻辑容器中交换
@@ -1809,11 +1836,13 @@ void SingleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1,
     QParallelAnimationGroup* group = new QParallelAnimationGroup();
 
     QPropertyAnimation* anim1 = new QPropertyAnimation(gem1->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim1);
     anim1->setDuration(500);
     anim1->setStartValue(pos1);
     anim1->setEndValue(pos2);
 
     QPropertyAnimation* anim2 = new QPropertyAnimation(gem2->transform(), "translation");
+    PerfStats::instance().trackAnimation(anim2);
     anim2->setDuration(500);
     anim2->setStartValue(pos2);
     anim2->setEndValue(pos1);
@@ -1846,11 +1875,13 @@ void SingleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1,
             QParallelAnimationGroup* swapBackGroup = new QParallelAnimationGroup();
 
             QPropertyAnimation* backAnim1 = new QPropertyAnimation(gem1->transform(), "translation");
+            PerfStats::instance().trackAnimation(backAnim1);
             backAnim1->setDuration(500);
             backAnim1->setStartValue(pos1);
             backAnim1->setEndValue(pos2);
 
             QPropertyAnimation* backAnim2 = new QPropertyAnimation(gem2->transform(), "translation");
+            PerfStats::instance().trackAnimation(backAnim2);
             backAnim2->setDuration(500);
             backAnim2->setStartValue(pos2);
             backAnim2->setEndValue(pos1);
@@ -1884,6 +1915,7 @@ void SingleModeGameWidget::performSwap(Gemstone* gem1, Gemstone* gem2, int row1,
 // 手动处理鼠标点击 - 将屏幕坐标转换为世界坐标并找到最近的宝石
 void SingleModeGameWidget::handleManualClick(const QPoint& screenPos , int kind) {
     if(canOpe == false) return ;
+    if(replayPlayer) return ; // 回放中不接受玩家输入
     if(kind == 2 && selectedNum == 0) {
         appendDebug("Startale says : release gem could not be the first selected.");
         return ;
@@ -2036,6 +2068,34 @@ std::vector<std::pair<int, int>> SingleModeGameWidget::findPossibleMatches() {
     return matches;
 }
 
+// 死局重排：宝石的移动见 BoardReshuffler，这里负责清理选中状态和提示
+void SingleModeGameWidget::reshuffleDeadBoard() {
+    if (isFinishing) return;
+
+    clearHighlights();
+    firstSelectedGemstone = nullptr;
+    secondSelectedGemstone = nullptr;
+    selectedNum = 0;
+    selectionRing1->setVisible(false);
+    selectionRing2->setVisible(false);
+    canOpe = false;
+    updateItemButtons();
+
+    int recolored = BoardReshuffler::reshuffle(
+        BoardMode::Classic, difficulty, rng, gemstoneContainer,
+        [this](int row, int col) { return getPosition(row, col); }, this, [this]() {
+            if (isFinishing) return;
+            canOpe = true;
+            updateItemButtons();
+            resetInactivityTimer();
+            appendDebug("Reshuffle animation finished");
+        });
+
+    appendDebug(QString("No possible matches found, reshuffling the board (recolored %1)").arg(recolored));
+    showFloatingMessage(QString("没有可消除的宝石，重新排列棋盘。"), false);
+    ReplaySystem::instance().recordAction(ReplayAction::Reshuffle);
+}
+
 // 添加弹幕提示实现
 void SingleModeGameWidget::showFloatingMessage(const QString& text, bool isSuccess) {
     // 创建提示标签
@@ -2065,6 +2125,7 @@ void SingleModeGameWidget::showFloatingMessage(const QString& text, bool isSucce
         auto* opacityEffect = new QGraphicsOpacityEffect(msgLabel);
         msgLabel->setGraphicsEffect(opacityEffect);
         auto* animation = new QPropertyAnimation(opacityEffect, "opacity");
+        PerfStats::instance().trackAnimation(animation);
         animation->setDuration(500);
         animation->setStartValue(1.0);
         animation->setEndValue(0.0);
@@ -2097,24 +2158,8 @@ void SingleModeGameWidget::highlightMatches() {
     // 找到所有可消除的宝石
     std::vector<std::pair<int, int>> matches = findPossibleMatches();
     if (matches.empty()) {
-        appendDebug("No possible matches found,resetting the game");
-        showFloatingMessage(QString("没有可消除的宝石，重置棋盘。"), false);
-            // 保存当前状态
-        int savedScore = gameScore;
-        int savedTimeSeconds = gameTimeKeeper.totalSeconds();
-        bool wasTimerActive = timer && timer->isActive();
-        reset(1);
-            // 恢复状态
-        gameScore = savedScore;
-        gameTimeKeeper.setSeconds(savedTimeSeconds);  // 恢复时间
-        nowTimeHave = savedTimeSeconds;
-        updateScoreBoard();
-        updateTimeBoard();
-    
-        // 重新启动计时器
-        if (wasTimerActive && timer && !timer->isActive()) {
-            timer->start();
-        }
+        // 开局棋盘就是死局时走到这里；连锁结束后的死局在 eliminate() 中已经处理
+        reshuffleDeadBoard();
         return ;
     }
     
@@ -2178,6 +2223,88 @@ int SingleModeGameWidget::getDifficulty() const {
     return difficulty;
 }
 
+void SingleModeGameWidget::setNextSeed(uint64_t seed) {
+    pendingSeed = seed;
+    hasPendingSeed = true;
+}
+
+uint64_t SingleModeGameWidget::getSeed() const {
+    return rng.seed();
+}
+
+void SingleModeGameWidget::startReplay(const Replay& replay, ReplayPlayer::Speed speed) {
+    stopReplay();
+    ReplaySystem::instance().setPlayingBack(true);
+    pendingDifficulty = replay.difficulty;
+    setNextSeed(replay.seed);
+    reset(1);
+
+    replayPlayer = new ReplayPlayer(replay, speed, [this](const ReplayAction& action) {
+        return applyReplayAction(action);
+    }, this);
+    connect(replayPlayer, &ReplayPlayer::finished, this, [this]() {
+        showFloatingMessage("录像回放结束", true);
+    });
+    replayPlayer->start();
+    appendDebug(QString("Replay started: seed=%1 actions=%2").arg(replay.seed).arg(replay.actions.size()));
+}
+
+void SingleModeGameWidget::stopReplay() {
+    if (!replayPlayer) return;
+    replayPlayer->stop();
+    replayPlayer->deleteLater();
+    replayPlayer = nullptr;
+    ReplaySystem::instance().setPlayingBack(false);
+}
+
+bool SingleModeGameWidget::applyReplayAction(const ReplayAction& action) {
+    if (isFinishing) return true;  // 对局已结束，剩余操作直接跳过
+    if (!canOpe) return false;
+
+    auto gemAt = [this](int row, int col) -> Gemstone* {
+        if (row < 0 || row >= static_cast<int>(gemstoneContainer.size())) return nullptr;
+        if (col < 0 || col >= static_cast<int>(gemstoneContainer[row].size())) return nullptr;
+        return gemstoneContainer[row][col];
+    };
+
+    switch (action.kind) {
+        case ReplayAction::Swap: {
+            Gemstone* gem1 = gemAt(action.row1, action.col1);
+            Gemstone* gem2 = gemAt(action.row2, action.col2);
+            if (gem1 && gem2 && areAdjacent(action.row1, action.col1, action.row2, action.col2)) {
+                performSwap(gem1, gem2, action.row1, action.col1, action.row2, action.col2);
+            }
+            break;
+        }
+        case ReplayAction::Hammer: {
+            // 直接进入锤子模式敲击，不经过道具按钮和悬停提示
+            Gemstone* gem = gemAt(action.row1, action.col1);
+            if (gem) {
+                hammerMode = true;
+                handleGemstoneClicked(gem);
+            }
+            break;
+        }
+        case ReplayAction::FreezeTime:
+            useItemFreezeTime();
+            break;
+        case ReplayAction::ResetBoard:
+            useItemResetBoard();
+            break;
+        case ReplayAction::ClearAll:
+            useItemClearAll();
+            break;
+        case ReplayAction::Reshuffle:
+            // 连锁结束时通常已经重排过，这里只处理开局就是死局的情况
+            if (findPossibleMatches().empty()) reshuffleDeadBoard();
+            break;
+        default:
+            qWarning() << "[SingleMode] Unsupported replay action:" << static_cast<int>(action.kind);
+            break;
+    }
+    return true;
+}
+
 // ============================================================================
 // 金币系统实现
 // ============================================================================
@@ -2203,7 +2330,7 @@ void SingleModeGameWidget::generateCoinGems(int count) {
 
     // 打乱位置顺序
     for (int i = validPositions.size() - 1; i > 0; --i) {
-        int j = QRandomGenerator::global()->bounded(i + 1);
+        int j = rng.bounded(i + 1);
         std::swap(validPositions[i], validPositions[j]);
     }
 
@@ -2215,7 +2342,7 @@ void SingleModeGameWidget::generateCoinGems(int count) {
 
         if (gem) {
             // 随机金币价值 1-5
-            int coinValue = QRandomGenerator::global()->bounded(1, 6);
+            int coinValue = rng.bounded(1, 6);
             gem->setCoinValue(coinValue);
             gem->setCoinGem(true);
 
@@ -2232,8 +2359,10 @@ void SingleModeGameWidget::collectCoinGem(Gemstone* gem) {
 
     int coinValue = gem->getCoinValue();
 
-    // 添加金币到系统
-    CoinSystem::instance().addCoins(coinValue, true);
+    // 添加金币到系统（回放只统计本局金币，不计入账户）
+    if (!ReplaySystem::instance().isPlayingBack()) {
+        CoinSystem::instance().addCoins(coinValue, true);
+    }
 
 
     // 累加本局获得的金币
@@ -2256,10 +2385,11 @@ int SingleModeGameWidget::getEarnedCoins() const {
 // ========== 道具系统实现 ==========
 
 void SingleModeGameWidget::useItemFreezeTime() {
-    if (!ItemSystem::instance().useItem(ItemType::FREEZE_TIME) || !canOpe) {
+    if (!consumeItem(ItemType::FREEZE_TIME) || !canOpe) {
         qWarning() << "[SingleMode] Failed to use FREEZE_TIME item";
         return;
     }
+    ReplaySystem::instance().recordAction(ReplayAction::FreezeTime);
     showFloatingMessage("正在使用道具 : 冻结时间" , true);
 
     // 暂停游戏计时器10秒
@@ -2309,7 +2439,7 @@ void SingleModeGameWidget::useItemFreezeTime() {
 }
 
 void SingleModeGameWidget::useItemHammer() {
-    if (!ItemSystem::instance().useItem(ItemType::HAMMER) || !canOpe) {
+    if (!consumeItem(ItemType::HAMMER) || !canOpe) {
         qWarning() << "[SingleMode] Failed to use HAMMER item";
         return;
     }
@@ -2322,10 +2452,11 @@ void SingleModeGameWidget::useItemHammer() {
 }
 
 void SingleModeGameWidget::useItemResetBoard() {
-    if (!ItemSystem::instance().useItem(ItemType::RESET_BOARD) || !canOpe) {
+    if (!consumeItem(ItemType::RESET_BOARD) || !canOpe) {
         qWarning() << "[SingleMode] Failed to use RESET_BOARD item";
         return;
     }
+    ReplaySystem::instance().recordAction(ReplayAction::ResetBoard);
     showFloatingMessage("正在使用道具 : 重置棋盘" , true);
 
     // 禁止操作
@@ -2341,6 +2472,7 @@ void SingleModeGameWidget::useItemResetBoard() {
                 gemsToDelete.push_back(gem);
                 // 创建缩小动画
                 QPropertyAnimation* animation = new QPropertyAnimation(gem->transform(), "scale");
+                PerfStats::instance().trackAnimation(animation);
                 animation->setDuration(500);
                 animation->setStartValue(gem->transform()->scale());
                 animation->setEndValue(0.0f);
@@ -2365,29 +2497,11 @@ void SingleModeGameWidget::useItemResetBoard() {
     QTimer::singleShot(600, this, [this]() {
         if (isFinishing) return;
 
-        // 重新生成整个棋盘（类似reset方法中的逻辑）
+        // 重新生成整个棋盘（与 reset() 相同：一次生成，没有三连并保证有可走步）
+        std::array<int8_t, Board::kCells> types = Board::generateTypes(difficulty, rng, Board::defaultGenerateOptions(BoardMode::Classic));
         for (int i = 0; i < 8; ++i) {
             for (int j = 0; j < 8; ++j) {
-                int type = QRandomGenerator::global()->bounded(difficulty);
-
-                // 避免在初始化时创建三连
-                // 检查左边两个
-                if (j >= 2 && gemstoneContainer[i][j-1] && gemstoneContainer[i][j-2]) {
-                    int type1 = gemstoneContainer[i][j-1]->getType();
-                    int type2 = gemstoneContainer[i][j-2]->getType();
-                    if (type1 == type2 && type == type1) {
-                        type = (type + 1) % difficulty;
-                    }
-                }
-
-                // 检查上边两个
-                if (i >= 2 && gemstoneContainer[i-1][j] && gemstoneContainer[i-2][j]) {
-                    int type1 = gemstoneContainer[i-1][j]->getType();
-                    int type2 = gemstoneContainer[i-2][j]->getType();
-                    if (type1 == type2 && type == type1) {
-                        type = (type + 1) % difficulty;
-                    }
-                }
+                int type = types[i * 8 + j];
 
                 Gemstone* gem = new Gemstone(type, "default", rootEntity);
                 gem->transform()->setTranslation(getPosition(i, j));
@@ -2403,7 +2517,7 @@ void SingleModeGameWidget::useItemResetBoard() {
         }
 
         // 生成金币宝石
-        int coinCount = QRandomGenerator::global()->bounded(1, 4);
+        int coinCount = rng.bounded(1, 4);
         generateCoinGems(coinCount);
 
         // 恢复操作
@@ -2417,10 +2531,11 @@ void SingleModeGameWidget::useItemResetBoard() {
 }
 
 void SingleModeGameWidget::useItemClearAll() {
-    if (!ItemSystem::instance().useItem(ItemType::CLEAR_ALL) || !canOpe) {
+    if (!consumeItem(ItemType::CLEAR_ALL) || !canOpe) {
         qWarning() << "[SingleMode] Failed to use CLEAR_ALL item";
         return;
     }
+    ReplaySystem::instance().recordAction(ReplayAction::ClearAll);
     showFloatingMessage("正在使用道具 : 清空棋盘" , true);
 
     canOpe = false;
@@ -2468,6 +2583,11 @@ void SingleModeGameWidget::useItemClearAll() {
 }
 
 
+bool SingleModeGameWidget::consumeItem(ItemType type) {
+    if (replayPlayer) return true;
+    return ItemSystem::instance().useItem(type);
+}
+
 void SingleModeGameWidget::enableHammerMode() {
     hammerMode = true;
     updateItemButtons();  // 禁用其他道具按钮
@@ -6,17 +6,21 @@
 #include <string>
 #include <QTimer>
 #include <QString>
+#include "../logic/GameRng.h"
 #include <Qt3DExtras/Qt3DWindow>
 #include <Qt3DCore/QEntity>
 #include <Qt3DRender/QCamera>
 #include <Qt3DRender/QPointLight>
 #include <Qt3DInput/QInputAspect>
 #include "../data/ItemSystem.h"
+#include "../data/ReplayPlayer.h"
 #include <QPropertyAnimation> // 新增
 
 class QTextEdit;
 class QLabel;
 class QPushButton;
+class PerfHud;
+class IdleAnimationDriver;
 class QShowEvent;
 class QEvent;
 class QHideEvent;
@@ -72,6 +76,16 @@ public:
     void setDifficulty(int diff);
     int getDifficulty() const;
 
+    // 本局随机种子：setNextSeed 指定下一次 reset 使用的种子，getSeed 返回当前局的种子
+    void setNextSeed(uint64_t seed);
+    uint64_t getSeed() const;
+
+    // 录像回放：按录像的种子和难度重开一局，操作由 applyReplayAction 逐条执行
+    void startReplay(const Replay& replay, ReplayPlayer::Speed speed);
+    void stopReplay();
+    // 执行一条录像操作；正在播放动画时返回 false，由回放驱动稍后重试
+    bool applyReplayAction(const ReplayAction& action);
+
     // 金币系统相关
     void generateCoinGems(int count);
     void collectCoinGem(Gemstone* gem);
@@ -84,6 +98,8 @@ public:
     void useItemClearAll();
     void enableHammerMode();
     void disableHammerMode();
+    // 扣除道具库存，回放时不扣
+    bool consumeItem(ItemType type);
 
 protected:
     void mousePressEvent(QMouseEvent* event) override;
@@ -102,6 +118,7 @@ private:
 
     void clearHighlights();
     void highlightMatches();
+    void reshuffleDeadBoard();
     void showFloatingMessage(const QString& text, bool isSuccess);
     void removeFloatingMessage(QLabel* label);
 
@@ -143,6 +160,11 @@ private:
     int comboCount = 0; 
     
     int difficulty = 4;
+    GameRng rng; // 本局的棋盘随机数流
+    uint64_t pendingSeed = 0;
+    bool hasPendingSeed = false;
+    int pendingDifficulty = 0;  // 回放时覆盖设置中的难度
+    ReplayPlayer* replayPlayer = nullptr;
 
     GameWindow* gameWindow;
 
@@ -188,6 +210,8 @@ private:
     // Debug UI
     QTextEdit* debugText;
     QLabel* focusInfoLabel;
+    PerfHud* perfHud = nullptr;
+    IdleAnimationDriver* idleDriver = nullptr;  // 按需渲染与待机动画降频
     QTimer* debugTimer;
 
     QWidget* rightPanel = nullptr;
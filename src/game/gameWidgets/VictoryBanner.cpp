@@ -31,12 +31,16 @@ VictoryBanner::VictoryBanner(QWidget* parent) : QWidget(parent) {
         QColor(150, 200, 255),   // 淡蓝
     };
     
-    // 粒子更新定时器 (60fps)
-    m_particleTimer = new QTimer(this);
-    m_particleTimer->setInterval(16);
-    connect(m_particleTimer, &QTimer::timeout, this, [this]() {
-        updateParticles();
-        update();
+    // 粒子系统：接近目标 100px 内减速并环绕（原先每帧保留 95% 速度、加 0.02 倍的切向分量）
+    m_particles = new ParticleSystem(this);
+    m_particles->setFadeWithLife(true);
+    m_particles->setOrbit(100.0f, std::pow(0.95f, 60.0f), 0.02f * 60.0f * 60.0f);
+    m_particles->setRespawn([this](ParticleSystem::Particle& p) { respawnParticle(p); });
+    initSprites();
+    connect(m_particles, &ParticleSystem::advanced, this, [this](float dt) {
+        // 背景闪光
+        m_frameCount += dt * 60.0f;
+        m_flashOpacity = 0.1 + 0.05 * std::sin(m_frameCount * 0.1);
     });
     
     // 自动关闭定时器
@@ -49,7 +53,6 @@ VictoryBanner::VictoryBanner(QWidget* parent) : QWidget(parent) {
 }
 
 VictoryBanner::~VictoryBanner() {
-    m_particleTimer->stop();
     m_autoCloseTimer->stop();
 }
 
@@ -74,7 +77,6 @@ void VictoryBanner::show(int level, int score, const QString& time) {
     
     initParticles();
     startAnimations();
-    m_particleTimer->start();
     
     m_autoCloseTimer->start(5000);
 }
@@ -87,150 +89,181 @@ void VictoryBanner::showEvent(QShowEvent* event) {
     }
 }
 
+// 精灵按参考尺寸绘制，粒子的 size 换算成相对它的缩放
+static constexpr qreal kSpriteSize = 32;
+
+void VictoryBanner::initSprites() {
+    int extent = int(kSpriteSize * 2) + 4;
+    QPointF center(extent / 2.0, extent / 2.0);
+    auto render = [&](auto&& paint) {
+        QImage image(extent, extent, QImage::Format_ARGB32_Premultiplied);
+        image.fill(Qt::transparent);
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        paint(painter);
+        return image;
+    };
+
+    m_starSprite = m_particles->addSprite(render([&](QPainter& painter) {
+        drawStar(painter, center, kSpriteSize);
+    }));
+    m_diamondSprite = m_particles->addSprite(render([&](QPainter& painter) {
+        drawDiamond(painter, center, kSpriteSize);
+    }));
+    // 圆形光点的渐变带颜色，每种颜色一个精灵
+    for (int i = 0; i < m_colors.size(); ++i) {
+        const QColor c = m_colors[i];
+        int sprite = m_particles->addSprite(render([&](QPainter& painter) {
+            QRadialGradient grad(center, kSpriteSize);
+            grad.setColorAt(0, c);
+            grad.setColorAt(0.5, QColor(c.red(), c.green(), c.blue(), 150));
+            grad.setColorAt(1, Qt::transparent);
+            painter.setBrush(grad);
+            painter.setPen(Qt::NoPen);
+            painter.drawEllipse(center, kSpriteSize, kSpriteSize);
+        }));
+        if (i == 0) m_circleSprite = sprite;
+    }
+}
+
+// 随机选一种粒子外观：0=星星, 1=圆形, 2=菱形
+static int randomSprite(int star, int diamond, int circle, int colorCount) {
+    switch (QRandomGenerator::global()->bounded(3)) {
+        case 0: return star;
+        case 1: return circle + QRandomGenerator::global()->bounded(colorCount);
+        default: return diamond;
+    }
+}
+
 void VictoryBanner::initParticles() {
-    m_particles.clear();
+    m_particles->clear();
+    m_particles->reserve(110);
+    m_frameCount = 0;
     
     int w = width();
     int h = height();
     QPointF center(w / 2.0, h / 2.0);
     
-    // 创建从四周飞入的粒子
+    // 创建从四周飞入的粒子（速度、旋转和寿命衰减都按 60fps 换算成每秒）
     for (int i = 0; i < 80; ++i) {
-        Particle p;
+        ParticleSystem::Particle p;
+        QPointF pos;
         
         // 随机选择边缘位置
         int edge = QRandomGenerator::global()->bounded(4);
         switch (edge) {
             case 0: // 上边
-                p.pos = QPointF(QRandomGenerator::global()->bounded(w), -50);
+                pos = QPointF(QRandomGenerator::global()->bounded(w), -50);
                 break;
             case 1: // 下边
-                p.pos = QPointF(QRandomGenerator::global()->bounded(w), h + 50);
+                pos = QPointF(QRandomGenerator::global()->bounded(w), h + 50);
                 break;
             case 2: // 左边
-                p.pos = QPointF(-50, QRandomGenerator::global()->bounded(h));
+                pos = QPointF(-50, QRandomGenerator::global()->bounded(h));
                 break;
             case 3: // 右边
-                p.pos = QPointF(w + 50, QRandomGenerator::global()->bounded(h));
+                pos = QPointF(w + 50, QRandomGenerator::global()->bounded(h));
                 break;
         }
         
         // 目标位置在屏幕中心区域（有随机偏移）
-        p.target = QPointF(
+        QPointF target(
             center.x() + QRandomGenerator::global()->bounded(-300, 300),
             center.y() + QRandomGenerator::global()->bounded(-200, 200)
         );
         
         // 计算初始速度（朝向目标）
-        QPointF dir = p.target - p.pos;
+        QPointF dir = target - pos;
         qreal dist = std::sqrt(dir.x() * dir.x() + dir.y() * dir.y());
         if (dist > 0) {
             dir /= dist;
         }
-        qreal speed = 8 + QRandomGenerator::global()->bounded(8);
-        p.velocity = dir * speed;
+        qreal speed = (8 + QRandomGenerator::global()->bounded(8)) * 60;
         
-        p.size = 8 + QRandomGenerator::global()->bounded(20);
-        p.opacity = 0.6 + QRandomGenerator::global()->bounded(40) / 100.0;
+        p.x = pos.x();
+        p.y = pos.y();
+        p.targetX = target.x();
+        p.targetY = target.y();
+        p.vx = dir.x() * speed;
+        p.vy = dir.y() * speed;
+        p.scaleX = p.scaleY = (8 + QRandomGenerator::global()->bounded(20)) / kSpriteSize;
+        p.alpha = 0.6 + QRandomGenerator::global()->bounded(40) / 100.0;
         p.rotation = QRandomGenerator::global()->bounded(360);
-        p.rotSpeed = -5 + QRandomGenerator::global()->bounded(10);
-        p.type = QRandomGenerator::global()->bounded(3);
-        p.color = m_colors[QRandomGenerator::global()->bounded(m_colors.size())];
+        p.spin = (-5 + QRandomGenerator::global()->bounded(10)) * 60;
+        p.sprite = randomSprite(m_starSprite, m_diamondSprite, m_circleSprite, m_colors.size());
         p.life = 1.0;
-        p.maxLife = 2.0 + QRandomGenerator::global()->bounded(20) / 10.0;
+        p.decay = 0.008 * 60;
         
-        m_particles.append(p);
+        m_particles->spawn(p);
     }
     
     // 添加一些持续生成的环绕粒子
     for (int i = 0; i < 30; ++i) {
-        Particle p;
+        ParticleSystem::Particle p;
         qreal angle = QRandomGenerator::global()->bounded(360) * M_PI / 180.0;
         qreal radius = 150 + QRandomGenerator::global()->bounded(200);
         
-        p.pos = QPointF(
-            center.x() + std::cos(angle) * radius,
-            center.y() + std::sin(angle) * radius
-        );
-        p.target = center;
-        p.velocity = QPointF(
-            std::cos(angle + M_PI/2) * 2,
-            std::sin(angle + M_PI/2) * 2
-        );
-        p.size = 5 + QRandomGenerator::global()->bounded(10);
-        p.opacity = 0.4 + QRandomGenerator::global()->bounded(40) / 100.0;
+        p.x = center.x() + std::cos(angle) * radius;
+        p.y = center.y() + std::sin(angle) * radius;
+        p.targetX = center.x();
+        p.targetY = center.y();
+        p.vx = std::cos(angle + M_PI/2) * 2 * 60;
+        p.vy = std::sin(angle + M_PI/2) * 2 * 60;
+        p.scaleX = p.scaleY = (5 + QRandomGenerator::global()->bounded(10)) / kSpriteSize;
+        p.alpha = 0.4 + QRandomGenerator::global()->bounded(40) / 100.0;
         p.rotation = 0;
-        p.rotSpeed = 3;
-        p.type = QRandomGenerator::global()->bounded(3);
-        p.color = m_colors[QRandomGenerator::global()->bounded(m_colors.size())];
+        p.spin = 3 * 60;
+        p.sprite = randomSprite(m_starSprite, m_diamondSprite, m_circleSprite, m_colors.size());
         p.life = 0.5 + QRandomGenerator::global()->bounded(50) / 100.0;
-        p.maxLife = 3.0;
+        p.decay = 0.008 * 60;
         
-        m_particles.append(p);
+        m_particles->spawn(p);
     }
 }
 
-void VictoryBanner::updateParticles() {
-    m_frameCount++;
+void VictoryBanner::respawnParticle(ParticleSystem::Particle& p) {
     QPointF center(width() / 2.0, height() / 2.0);
+    QPointF pos;
     
-    for (int i = m_particles.size() - 1; i >= 0; --i) {
-        Particle& p = m_particles[i];
-        
-        // 更新位置
-        p.pos += p.velocity;
-        
-        // 接近目标时减速
-        QPointF toTarget = p.target - p.pos;
-        qreal dist = std::sqrt(toTarget.x() * toTarget.x() + toTarget.y() * toTarget.y());
-        if (dist < 100) {
-            p.velocity *= 0.95;
-            // 添加环绕运动
-            p.velocity += QPointF(-toTarget.y(), toTarget.x()) * 0.02;
-        }
-        
-        // 更新旋转
-        p.rotation += p.rotSpeed;
-        
-        // 更新生命值
-        p.life -= 0.008;
-        
-        // 移除死亡粒子并生成新粒子
-        if (p.life <= 0) {
-            // 在边缘重新生成
-            int edge = QRandomGenerator::global()->bounded(4);
-            switch (edge) {
-                case 0:
-                    p.pos = QPointF(QRandomGenerator::global()->bounded(width()), -30);
-                    break;
-                case 1:
-                    p.pos = QPointF(QRandomGenerator::global()->bounded(width()), height() + 30);
-                    break;
-                case 2:
-                    p.pos = QPointF(-30, QRandomGenerator::global()->bounded(height()));
-                    break;
-                case 3:
-                    p.pos = QPointF(width() + 30, QRandomGenerator::global()->bounded(height()));
-                    break;
-            }
-            
-            p.target = QPointF(
-                center.x() + QRandomGenerator::global()->bounded(-250, 250),
-                center.y() + QRandomGenerator::global()->bounded(-150, 150)
-            );
-            
-            QPointF dir = p.target - p.pos;
-            qreal d = std::sqrt(dir.x() * dir.x() + dir.y() * dir.y());
-            if (d > 0) dir /= d;
-            p.velocity = dir * (6 + QRandomGenerator::global()->bounded(6));
-            p.life = 1.0;
-            p.size = 6 + QRandomGenerator::global()->bounded(18);
-            p.color = m_colors[QRandomGenerator::global()->bounded(m_colors.size())];
-        }
+    // 在边缘重新生成
+    int edge = QRandomGenerator::global()->bounded(4);
+    switch (edge) {
+        case 0:
+            pos = QPointF(QRandomGenerator::global()->bounded(width()), -30);
+            break;
+        case 1:
+            pos = QPointF(QRandomGenerator::global()->bounded(width()), height() + 30);
+            break;
+        case 2:
+            pos = QPointF(-30, QRandomGenerator::global()->bounded(height()));
+            break;
+        case 3:
+            pos = QPointF(width() + 30, QRandomGenerator::global()->bounded(height()));
+            break;
     }
     
-    // 更新背景闪光
-    m_flashOpacity = 0.1 + 0.05 * std::sin(m_frameCount * 0.1);
+    QPointF target(
+        center.x() + QRandomGenerator::global()->bounded(-250, 250),
+        center.y() + QRandomGenerator::global()->bounded(-150, 150)
+    );
+    
+    QPointF dir = target - pos;
+    qreal d = std::sqrt(dir.x() * dir.x() + dir.y() * dir.y());
+    if (d > 0) dir /= d;
+    qreal speed = (6 + QRandomGenerator::global()->bounded(6)) * 60;
+    
+    p.x = pos.x();
+    p.y = pos.y();
+    p.targetX = target.x();
+    p.targetY = target.y();
+    p.vx = dir.x() * speed;
+    p.vy = dir.y() * speed;
+    p.life = 1.0;
+    p.scaleX = p.scaleY = (6 + QRandomGenerator::global()->bounded(18)) / kSpriteSize;
+    // 圆形光点换一种颜色，星星和菱形的配色是固定的
+    if (p.sprite >= m_circleSprite) {
+        p.sprite = m_circleSprite + QRandomGenerator::global()->bounded(m_colors.size());
+    }
 }
 
 void VictoryBanner::startAnimations() {
@@ -304,11 +337,7 @@ void VictoryBanner::paintEvent(QPaintEvent* event) {
     painter.fillRect(rect(), glow);
     
     // 3. 绘制粒子（在图片后面）
-    for (const Particle& p : m_particles) {
-        if (p.life > 0) {
-            drawParticle(painter, p);
-        }
-    }
+    m_particles->draw(painter);
     
     // 4. 绘制胜利图片
     if (!m_victoryImage.isNull() && m_bannerOpacity > 0) {
@@ -398,37 +427,6 @@ void VictoryBanner::paintEvent(QPaintEvent* event) {
     }
 }
 
-void VictoryBanner::drawParticle(QPainter& painter, const Particle& p) {
-    painter.save();
-    painter.translate(p.pos);
-    painter.rotate(p.rotation);
-    painter.setOpacity(p.opacity * p.life);
-    
-    QColor c = p.color;
-    
-    switch (p.type) {
-        case 0: // 星星
-            drawStar(painter, QPointF(0, 0), p.size);
-            break;
-        case 1: // 圆形光点
-            {
-                QRadialGradient grad(0, 0, p.size);
-                grad.setColorAt(0, c);
-                grad.setColorAt(0.5, QColor(c.red(), c.green(), c.blue(), 150));
-                grad.setColorAt(1, Qt::transparent);
-                painter.setBrush(grad);
-                painter.setPen(Qt::NoPen);
-                painter.drawEllipse(QPointF(0, 0), p.size, p.size);
-            }
-            break;
-        case 2: // 菱形
-            drawDiamond(painter, QPointF(0, 0), p.size);
-            break;
-    }
-    
-    painter.restore();
-}
-
 void VictoryBanner::drawStar(QPainter& painter, const QPointF& center, qreal size, int points) {
     QPainterPath path;
     qreal innerRadius = size * 0.4;
@@ -505,7 +503,6 @@ void VictoryBanner::mousePressEvent(QMouseEvent* event) {
     Q_UNUSED(event);
     // 点击任意处跳过
     m_autoCloseTimer->stop();
-    m_particleTimer->stop();
     emit finished();
     close();
 }
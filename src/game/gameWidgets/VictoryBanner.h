@@ -13,6 +13,7 @@
 #include <QPointF>
 #include <QPropertyAnimation>
 #include <QParallelAnimationGroup>
+#include "../components/ParticleSystem.h"
 
 class VictoryBanner : public QWidget {
     Q_OBJECT
@@ -51,33 +52,21 @@ protected:
     void showEvent(QShowEvent* event) override;
 
 private:
-    // 粒子结构
-    struct Particle {
-        QPointF pos;       // 当前位置
-        QPointF velocity;  // 速度
-        QPointF target;    // 目标位置（屏幕中心附近）
-        qreal size;        // 大小
-        qreal opacity;     // 透明度
-        qreal rotation;    // 旋转角度
-        qreal rotSpeed;    // 旋转速度
-        int type;          // 0=星星, 1=圆形, 2=菱形
-        QColor color;      // 颜色
-        qreal life;        // 生命值 0-1
-        qreal maxLife;     // 最大生命
-    };
-
+    void initSprites();
     void initParticles();
-    void updateParticles();
+    void respawnParticle(ParticleSystem::Particle& p);
     void startAnimations();
-    void drawParticle(QPainter& painter, const Particle& p);
     void drawStar(QPainter& painter, const QPointF& center, qreal size, int points = 5);
     void drawDiamond(QPainter& painter, const QPointF& center, qreal size);
     void drawSparkle(QPainter& painter, const QPointF& center, qreal size);
 
     QPixmap m_victoryImage;
-    QTimer* m_particleTimer;
     QTimer* m_autoCloseTimer;
-    QVector<Particle> m_particles;
+    // 星星、菱形和各颜色的光点预先画进图集，整批绘制；横幅关闭（隐藏）后自动停止更新
+    ParticleSystem* m_particles;
+    int m_starSprite = 0;
+    int m_diamondSprite = 0;
+    int m_circleSprite = 0;   // 第一个颜色的光点，后面依次是 m_colors 中的其余颜色
     
     int m_level = 1;
     int m_score = 0;
@@ -91,7 +80,7 @@ private:
     
     // 背景闪光
     qreal m_flashOpacity = 0;
-    int m_frameCount = 0;
+    qreal m_frameCount = 0;   // 按 60fps 换算的帧数，闪光和环绕亮点的相位
     
     // 颜色主题
     QVector<QColor> m_colors;
@@ -3,9 +3,15 @@
 #include "MenuWidget.h"
 #include "../GameWindow.h"
 #include "../components/Gemstone.h"
+#include "../components/BoardReshuffler.h"
+#include "../components/PerfHud.h"
+#include "../components/IdleAnimationDriver.h"
+#include "SettingWidget.h"
 #include "../components/RotationSquare.h"
 #include "../data/CoinSystem.h"
 #include "../../utils/AudioManager.h"
+#include "../../utils/PerfStats.h"
+#include "../../utils/AnimationScheduler.h"
 #include "../data/AchievementSystem.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -40,6 +46,8 @@
 #include <queue>
 #include <set>
 #include "../data/OtherNetDataIO.h"
+#include "../data/ReplaySystem.h"
+#include "../logic/Board.h"
 
 
 #ifndef M_PI
@@ -188,6 +196,10 @@ WhirlwindModeGameWidget::WhirlwindModeGameWidget(QWidget* parent, GameWindow* ga
 
     // 创建3D窗口容器
     container3d = QWidget::createWindowContainer(game3dWindow);
+    // 离开本界面时停掉计时器、暂停宝石待机动画并让 3D 窗口停止出帧
+    idleDriver = new IdleAnimationDriver(this, game3dWindow, [this]() { return rootEntity; });
+    AnimationScheduler::instance().registerTimer(this, timer);
+    AnimationScheduler::instance().registerScene(this, game3dWindow, [this]() { return rootEntity; });
     // container3d->setFixedSize(960, 960); // 移除固定大小
     container3d->setMinimumSize(600, 600); // 设置最小大小
     container3d->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -354,6 +366,9 @@ WhirlwindModeGameWidget::WhirlwindModeGameWidget(QWidget* parent, GameWindow* ga
     container3d->installEventFilter(this);
     game3dWindow->installEventFilter(this);
 
+    // 性能浮层（F3 开关）
+    perfHud = new PerfHud(this, game3dWindow, rootEntity);
+
     // 初始化未消除计时器
     noEliminationTimer = new QTimer(this);
     noEliminationTimer->setInterval(100); // 每100ms更新一次
@@ -363,6 +378,7 @@ WhirlwindModeGameWidget::WhirlwindModeGameWidget(QWidget* parent, GameWindow* ga
             handleNoElimination();
         } else {
             updateNoEliminationProgress();
+            if (noEliminationTimeRemaining <= noEliminationTimeout - hintDelay) showRotationHint();
         }
     });
     noEliminationTimer->stop();
@@ -406,7 +422,7 @@ void WhirlwindModeGameWidget::triggerFinishIfNeeded() {
     if (isFinishing) return;
     if (gameScore < targetScore) return;
     finishToFinalWidget();
-    if (gameWindow->getUserID() != "$#SINGLE#$") {
+    if (gameWindow->getUserID() != "$#SINGLE#$" && !replayPlayer) {
         gameWindow->getOtherNetDataIO()->sendWhirlTime(gameWindow->getUserID(), gameScore);
     }
 }
@@ -420,9 +436,9 @@ void WhirlwindModeGameWidget::finishToFinalWidget() {
     
     // 触发旋风试炼成就（坚持2分钟=120秒）
     AchievementSystem::instance().triggerWhirlwindSurvival(survivalSeconds);
+    ReplaySystem::instance().finishRecording(gameScore, earnedCoins);
 
-
-    if (gameWindow->getUserID() != "$#SINGLE#$") {
+    if (gameWindow->getUserID() != "$#SINGLE#$" && !replayPlayer) {
         gameWindow->getOtherNetDataIO()->sendWhirlTime(gameWindow->getUserID(), gameScore);
     }
     
@@ -760,9 +776,11 @@ void WhirlwindModeGameWidget::remove3x3AreaChain(int centerRow, int centerCol) {
 
 
 void WhirlwindModeGameWidget::eliminate() {
+    PhaseTimer phaseTimer(PerfStats::Eliminate);
     if (isFinishing) return;
     std::vector<std::pair<int, int>> matches = findMatches();
     if (!matches.empty()) {
+        PerfStats::instance().cascadeStep();
         comboCount++;
         appendDebug(QString("Found %1 matches to eliminate").arg(matches.size()));
         AudioManager::instance().playEliminateSound(comboCount);
@@ -779,13 +797,16 @@ void WhirlwindModeGameWidget::eliminate() {
             drop();
         });
     } else {
+        PerfStats::instance().cascadeFinished();
         comboCount = 0;
         canOpe = true;
         appendDebug("No matches found, game can continue");
+        updateRotationHint();
     }
 }
 
 void WhirlwindModeGameWidget::drop() {
+    PhaseTimer phaseTimer(PerfStats::Drop);
     if (isFinishing) return;
     appendDebug("Starting drop animation");
 
@@ -803,6 +824,7 @@ void WhirlwindModeGameWidget::drop() {
 
                     QVector3D targetPos = getPosition(writePos, col);
                     QPropertyAnimation* dropAnim = new QPropertyAnimation(gem->transform(), "translation");
+                    PerfStats::instance().trackAnimation(dropAnim);
                     dropAnim->setDuration(500);
                     dropAnim->setStartValue(gem->transform()->translation());
                     dropAnim->setEndValue(targetPos);
@@ -830,6 +852,7 @@ void WhirlwindModeGameWidget::drop() {
 }
 
 void WhirlwindModeGameWidget::resetGemstoneTable() {
+    PhaseTimer phaseTimer(PerfStats::Refill);
     if (isFinishing) return;
     appendDebug("Filling empty positions with new gemstones");
 
@@ -839,7 +862,7 @@ void WhirlwindModeGameWidget::resetGemstoneTable() {
     for (int col = 0; col < 8; ++col) {
         for (int row = 0; row < 8; ++row) {
             if (gemstoneContainer[row][col] == nullptr) {
-                int type = QRandomGenerator::global()->bounded(difficulty);
+                int type = rng.bounded(difficulty);
 
                 if (col >= 2 && gemstoneContainer[row][col-1] && gemstoneContainer[row][col-2]) {
                     int type1 = gemstoneContainer[row][col-1]->getType();
@@ -872,6 +895,7 @@ void WhirlwindModeGameWidget::resetGemstoneTable() {
                 gemstoneContainer[row][col] = gem;
 
                 QPropertyAnimation* fillAnim = new QPropertyAnimation(gem->transform(), "translation");
+                PerfStats::instance().trackAnimation(fillAnim);
                 fillAnim->setDuration(500);
                 fillAnim->setStartValue(startPos);
                 fillAnim->setEndValue(targetPos);
@@ -900,6 +924,7 @@ void WhirlwindModeGameWidget::eliminateAnime(Gemstone* gemstone) {
     if (!gemstone) return;
 
     QPropertyAnimation* animation = new QPropertyAnimation(gemstone->transform(), "scale");
+    PerfStats::instance().trackAnimation(animation);
     animation->setDuration(500);
     animation->setStartValue(gemstone->transform()->scale());
     animation->setEndValue(0.0f);
@@ -926,21 +951,25 @@ void WhirlwindModeGameWidget::rotateGemstonesAnime(Gemstone* topLeft, Gemstone*
 
     // 顺时针旋转: TL->TR, TR->BR, BR->BL, BL->TL
     QPropertyAnimation* animTL = new QPropertyAnimation(topLeft->transform(), "translation");
+    PerfStats::instance().trackAnimation(animTL);
     animTL->setDuration(500);
     animTL->setStartValue(posTL);
     animTL->setEndValue(posTR);
 
     QPropertyAnimation* animTR = new QPropertyAnimation(topRight->transform(), "translation");
+    PerfStats::instance().trackAnimation(animTR);
     animTR->setDuration(500);
     animTR->setStartValue(posTR);
     animTR->setEndValue(posBR);
 
     QPropertyAnimation* animBR = new QPropertyAnimation(bottomRight->transform(), "translation");
+    PerfStats::instance().trackAnimation(animBR);
     animBR->setDuration(500);
     animBR->setStartValue(posBR);
     animBR->setEndValue(posBL);
 
     QPropertyAnimation* animBL = new QPropertyAnimation(bottomLeft->transform(), "translation");
+    PerfStats::instance().trackAnimation(animBL);
     animBL->setDuration(500);
     animBL->setStartValue(posBL);
     animBL->setEndValue(posTL);
@@ -1028,6 +1057,9 @@ void WhirlwindModeGameWidget::mouseMoveEvent(QMouseEvent* event) {
 
 void WhirlwindModeGameWidget::showEvent(QShowEvent* event) {
     QWidget::showEvent(event);
+    // 待机动画模式可能在设置界面里改过
+    IdleAnimationDriver::Mode idleMode = static_cast<IdleAnimationDriver::Mode>(SettingWidget::getIdleSpinMode());
+    if (idleDriver) idleDriver->setMode(idleMode);
     if (container3d) {
         container3d->setFocus(Qt::OtherFocusReason);
         container3d->raise();
@@ -1044,6 +1076,8 @@ void WhirlwindModeGameWidget::showEvent(QShowEvent* event) {
 
 void WhirlwindModeGameWidget::hideEvent(QHideEvent* event) {
     QWidget::hideEvent(event);
+    // 离开游戏界面（非最小化）时结束回放
+    if (!event->spontaneous()) stopReplay();
     if (timer && timer->isActive()) {
         timer->stop();
     }
@@ -1055,6 +1089,7 @@ void WhirlwindModeGameWidget::hideEvent(QHideEvent* event) {
         hoverRow = -1;
         hoverCol = -1;
     }
+    hideRotationHint();
 }
 
 bool WhirlwindModeGameWidget::eventFilter(QObject* obj, QEvent* event) {
@@ -1143,6 +1178,11 @@ void WhirlwindModeGameWidget::setup3DScene() {
     hoverSquare->setColor(QColor(100, 200, 255, 150));  // 半透明蓝色
     hoverSquare->setVisible(false);
 
+    // 提示框
+    hintSquare = new RotationSquare(rootEntity);
+    hintSquare->setColor(QColor(255, 215, 0, 170));  // 半透明金色
+    hintSquare->setVisible(false);
+
     qDebug() << "[WhirlwindModeGameWidget] 3D Scene setup complete - Rotation mode";
 }
 
@@ -1221,10 +1261,17 @@ void WhirlwindModeGameWidget::setMode(int mode) {
 }
 
 void WhirlwindModeGameWidget::reset(int mode) {
+    // 每局一个独立的随机数流；回放或联机指定了种子时使用指定值
+    rng.reseed(hasPendingSeed ? pendingSeed : GameRng::makeSeed());
+    hasPendingSeed = false;
     AchievementSystem::instance().resetSessionStats();
-    if (gameWindow) {
+    if (pendingDifficulty > 0) {
+        difficulty = pendingDifficulty;
+        pendingDifficulty = 0;
+    } else if (gameWindow) {
         difficulty = gameWindow->getDifficulty();
     }
+    ReplaySystem::instance().beginRecording(BoardMode::Whirlwind, difficulty, rng.seed());
     this->mode = mode;
     this->canOpe = true;
     this->isFinishing = false;
@@ -1258,26 +1305,12 @@ void WhirlwindModeGameWidget::reset(int mode) {
     // 重建8x8网格
     gemstoneContainer.resize(8);
 
+    // 一次生成整盘类型，没有现成三连（旋风模式任何旋转都合法，不需要种可走步）
+    std::array<int8_t, Board::kCells> types = Board::generateTypes(difficulty, rng, Board::defaultGenerateOptions(BoardMode::Whirlwind));
     for (int i = 0; i < 8; ++i) {
         gemstoneContainer[i].resize(8);
         for (int j = 0; j < 8; ++j) {
-            int type = QRandomGenerator::global()->bounded(difficulty);
-
-            if (j >= 2 && gemstoneContainer[i][j-1] && gemstoneContainer[i][j-2]) {
-                int type1 = gemstoneContainer[i][j-1]->getType();
-                int type2 = gemstoneContainer[i][j-2]->getType();
-                if (type1 == type2 && type == type1) {
-                    type = (type + 1) % difficulty;
-                }
-            }
-
-            if (i >= 2 && gemstoneContainer[i-1][j] && gemstoneContainer[i-2][j]) {
-                int type1 = gemstoneContainer[i-1][j]->getType();
-                int type2 = gemstoneContainer[i-2][j]->getType();
-                if (type1 == type2 && type == type1) {
-                    type = (type + 1) % difficulty;
-                }
-            }
+            int type = types[i * 8 + j];
 
             Gemstone* gem = new Gemstone(type, "default", rootEntity);
 
@@ -1294,9 +1327,13 @@ void WhirlwindModeGameWidget::reset(int mode) {
     appendDebug("created 8x8 gemstones with no initial matches");
 
     // 生成金币宝石 (随机1-3个)
-    int coinCount = QRandomGenerator::global()->bounded(1, 4);
+    int coinCount = rng.bounded(1, 4);
     generateCoinGems(coinCount);
 
+    // 开局不种可走步，极少数情况下没有能消除的旋转
+    hideRotationHint();
+    updateRotationHint();
+
     if (timer->isActive()) {
         timer->stop();
     }
@@ -1354,8 +1391,11 @@ void WhirlwindModeGameWidget::performRotation(int topLeftRow, int topLeftCol) {
         return;
     }
 
+    ReplaySystem::instance().recordAction(ReplayAction::Rotate, topLeftRow, topLeftCol);
+
     // 禁止操作，防止旋转过程中再次点击
     canOpe = false;
+    hideRotationHint();
 
     // 获取四个宝石
     Gemstone* topLeft = gemstoneContainer[topLeftRow][topLeftCol];
@@ -1385,6 +1425,7 @@ void WhirlwindModeGameWidget::performRotation(int topLeftRow, int topLeftCol) {
         } else {
             appendDebug("No matches found after rotation");
             canOpe = true;
+            updateRotationHint();
         }
 
         // 隐藏旋转框
@@ -1398,6 +1439,7 @@ void WhirlwindModeGameWidget::performRotation(int topLeftRow, int topLeftCol) {
 }
 
 void WhirlwindModeGameWidget::handleManualClick(const QPoint& screenPos) {
+    if (replayPlayer) return;  // 回放中不接受玩家输入
     // 获取当前容器大小
     float screenWidth = static_cast<float>(container3d->width());
     float screenHeight = static_cast<float>(container3d->height());
@@ -1621,19 +1663,77 @@ void WhirlwindModeGameWidget::updateNoEliminationProgress() {
 }
 
 std::vector<std::pair<int, int>> WhirlwindModeGameWidget::findPossibleMatches() {
-    // 对于旋转模式,找到所有可能通过2x2旋转产生三消的位置
-    // 简化版本:返回所有可以形成2x2方框的左上角位置
+    RotationFinder::MoveList moves;
+    int count = makeRotationFinder().findRankedMoves(moves);
+
     std::vector<std::pair<int, int>> matches;
+    matches.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        matches.push_back({moves[i].row, moves[i].col});
+    }
+    return matches;
+}
 
-    for (int i = 0; i < 7; ++i) {
-        for (int j = 0; j < 7; ++j) {
-            if (canFormSquare(i, j)) {
-                matches.push_back({i, j});
-            }
+RotationFinder WhirlwindModeGameWidget::makeRotationFinder() const {
+    std::array<int8_t, RotationFinder::kCells> types;
+    uint64_t specialMask = 0;
+    for (int row = 0; row < 8; ++row) {
+        for (int col = 0; col < 8; ++col) {
+            Gemstone* gem = gemstoneContainer.size() == 8 ? gemstoneContainer[row][col] : nullptr;
+            types[row * 8 + col] = gem ? (int8_t)gem->getType() : -1;
+            if (gem && gem->isSpecial()) specialMask |= 1ull << (row * 8 + col);
         }
     }
+    return RotationFinder(types, specialMask);
+}
 
-    return matches;
+void WhirlwindModeGameWidget::updateRotationHint() {
+    if (isFinishing) return;
+    RotationFinder::MoveList moves;
+    int count = makeRotationFinder().findRankedMoves(moves);
+    if (count == 0) {
+        hintRow = hintCol = -1;
+        reshuffleDeadBoard();
+        return;
+    }
+    hintRow = moves[0].row;
+    hintCol = moves[0].col;
+    appendDebug(QString("%1 rotations can match, best (%2,%3) clears %4")
+                .arg(count).arg(hintRow).arg(hintCol).arg(moves[0].clearCount));
+}
+
+void WhirlwindModeGameWidget::showRotationHint() {
+    if (!hintSquare || hintRow < 0 || !canOpe) return;
+    hintSquare->setPosition(getPosition(hintRow, hintCol), getPosition(hintRow + 1, hintCol + 1));
+    hintSquare->setVisible(true);
+}
+
+void WhirlwindModeGameWidget::hideRotationHint() {
+    if (hintSquare) hintSquare->setVisible(false);
+}
+
+void WhirlwindModeGameWidget::reshuffleDeadBoard() {
+    if (isFinishing) return;
+
+    hideRotationHint();
+    hasSelection = false;
+    selectedTopLeftRow = -1;
+    selectedTopLeftCol = -1;
+    rotationSquare->setVisible(false);
+    canOpe = false;
+
+    // 倒计时不暂停，重排动画期间照常计时
+    int recolored = BoardReshuffler::reshuffle(
+        BoardMode::Whirlwind, difficulty, rng, gemstoneContainer,
+        [this](int row, int col) { return getPosition(row, col); }, this, [this]() {
+            if (isFinishing) return;
+            canOpe = true;
+            updateRotationHint();
+            appendDebug("Reshuffle animation finished");
+        });
+
+    appendDebug(QString("No rotation can match, reshuffling the board (recolored %1)").arg(recolored));
+    ReplaySystem::instance().recordAction(ReplayAction::Reshuffle);
 }
 
 void WhirlwindModeGameWidget::setDifficulty(int diff) {
@@ -1644,6 +1744,54 @@ int WhirlwindModeGameWidget::getDifficulty() const {
     return difficulty;
 }
 
+void WhirlwindModeGameWidget::setNextSeed(uint64_t seed) {
+    pendingSeed = seed;
+    hasPendingSeed = true;
+}
+
+uint64_t WhirlwindModeGameWidget::getSeed() const {
+    return rng.seed();
+}
+
+void WhirlwindModeGameWidget::startReplay(const Replay& replay, ReplayPlayer::Speed speed) {
+    stopReplay();
+    ReplaySystem::instance().setPlayingBack(true);
+    pendingDifficulty = replay.difficulty;
+    setNextSeed(replay.seed);
+    reset(2);
+
+    replayPlayer = new ReplayPlayer(replay, speed, [this](const ReplayAction& action) {
+        return applyReplayAction(action);
+    }, this);
+    replayPlayer->start();
+    appendDebug(QString("Replay started: seed=%1 actions=%2").arg(replay.seed).arg(replay.actions.size()));
+}
+
+void WhirlwindModeGameWidget::stopReplay() {
+    if (!replayPlayer) return;
+    replayPlayer->stop();
+    replayPlayer->deleteLater();
+    replayPlayer = nullptr;
+    ReplaySystem::instance().setPlayingBack(false);
+}
+
+bool WhirlwindModeGameWidget::applyReplayAction(const ReplayAction& action) {
+    if (isFinishing) return true;  // 对局已结束，剩余操作直接跳过
+    if (!canOpe) return false;
+
+    if (action.kind == ReplayAction::Rotate) {
+        if (canFormSquare(action.row1, action.col1)) {
+            performRotation(action.row1, action.col1);
+        }
+    } else if (action.kind == ReplayAction::Reshuffle) {
+        // 录像里的重排在本地已经自动发生过时跳过，与 Board 的判定一致
+        if (!makeRotationFinder().hasMove()) reshuffleDeadBoard();
+    } else {
+        qWarning() << "[WhirlwindMode] Unsupported replay action:" << static_cast<int>(action.kind);
+    }
+    return true;
+}
+
 // ============================================================================
 // 金币系统实现
 // ============================================================================
@@ -1669,7 +1817,7 @@ void WhirlwindModeGameWidget::generateCoinGems(int count) {
 
     // 打乱位置顺序
     for (int i = validPositions.size() - 1; i > 0; --i) {
-        int j = QRandomGenerator::global()->bounded(i + 1);
+        int j = rng.bounded(i + 1);
         std::swap(validPositions[i], validPositions[j]);
     }
 
@@ -1681,7 +1829,7 @@ void WhirlwindModeGameWidget::generateCoinGems(int count) {
 
         if (gem) {
             // 随机金币价值 1-5
-            int coinValue = QRandomGenerator::global()->bounded(1, 6);
+            int coinValue = rng.bounded(1, 6);
             gem->setCoinValue(coinValue);
             gem->setCoinGem(true);
 
@@ -1698,8 +1846,10 @@ void WhirlwindModeGameWidget::collectCoinGem(Gemstone* gem) {
 
     int coinValue = gem->getCoinValue();
 
-    // 添加金币到系统
-    CoinSystem::instance().addCoins(coinValue, true);
+    // 添加金币到系统（回放只统计本局金币，不计入账户）
+    if (!ReplaySystem::instance().isPlayingBack()) {
+        CoinSystem::instance().addCoins(coinValue, true);
+    }
 
     // 累加本局获得的金币
     earnedCoins += coinValue;
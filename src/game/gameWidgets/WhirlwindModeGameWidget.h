@@ -6,6 +6,9 @@
 #include <string>
 #include <QTimer>
 #include <QString>
+#include "../logic/GameRng.h"
+#include "../logic/RotationFinder.h"
+#include "../data/ReplayPlayer.h"
 #include <Qt3DExtras/Qt3DWindow>
 #include <Qt3DCore/QEntity>
 #include <Qt3DRender/QCamera>
@@ -16,6 +19,8 @@
 class QTextEdit;
 class QLabel;
 class QPushButton;
+class PerfHud;
+class IdleAnimationDriver;
 class QProgressBar;
 class QShowEvent;
 class QEvent;
@@ -64,6 +69,7 @@ public:
 
     // 消除相关的辅助方法
     std::vector<std::pair<int, int>> findMatches();
+    // 所有能形成三连的旋转位置（方框左上角），按预计消除数从多到少排序
     std::vector<std::pair<int, int>> findPossibleMatches();
     void removeMatches(const std::vector<std::pair<int, int>>& matches);
 
@@ -72,6 +78,16 @@ public:
     void setDifficulty(int diff);
     int getDifficulty() const;
 
+    // 本局随机种子：setNextSeed 指定下一次 reset 使用的种子，getSeed 返回当前局的种子
+    void setNextSeed(uint64_t seed);
+    uint64_t getSeed() const;
+
+    // 录像回放：按录像的种子和难度重开一局，操作由 applyReplayAction 逐条执行
+    void startReplay(const Replay& replay, ReplayPlayer::Speed speed);
+    void stopReplay();
+    // 执行一条录像操作；正在播放动画时返回 false，由回放驱动稍后重试
+    bool applyReplayAction(const ReplayAction& action);
+
     // 金币系统相关
     void generateCoinGems(int count);
     void collectCoinGem(Gemstone* gem);
@@ -93,6 +109,12 @@ private:
     void refreshDebugStatus();
 
     void resetNoEliminationTimer();
+    // 每次连锁结束后重新评估可走的旋转：更新提示位置，没有可走的旋转时重排棋盘
+    void updateRotationHint();
+    void showRotationHint();
+    void hideRotationHint();
+    void reshuffleDeadBoard();
+    RotationFinder makeRotationFinder() const;
     void handleNoElimination();
     void updateNoEliminationProgress();
 
@@ -131,6 +153,11 @@ private:
     int comboCount = 0;
 
     int difficulty = 4;
+    GameRng rng; // 本局的棋盘随机数流
+    uint64_t pendingSeed = 0;
+    bool hasPendingSeed = false;
+    int pendingDifficulty = 0;  // 回放时覆盖设置中的难度
+    ReplayPlayer* replayPlayer = nullptr;
 
     GameWindow* gameWindow;
 
@@ -171,11 +198,19 @@ private:
     int noEliminationTimeout = 10000; // 10秒
     int noEliminationTimeRemaining = 10000; // 剩余时间(ms)
 
+    // 旋转提示：倒计时过去 hintDelay 仍未消除时，标出消除最多的旋转
+    RotationSquare* hintSquare = nullptr;
+    int hintDelay = 5000;
+    int hintRow = -1;  // 最佳旋转的左上角，-1 表示没有
+    int hintCol = -1;
+
     void setup3DScene();
 
     // Debug UI
     QTextEdit* debugText;
     QLabel* focusInfoLabel;
+    PerfHud* perfHud = nullptr;
+    IdleAnimationDriver* idleDriver = nullptr;  // 按需渲染与待机动画降频
     QTimer* debugTimer;
 
     QWidget* rightPanel = nullptr;
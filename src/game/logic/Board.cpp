@@ -0,0 +1,772 @@
+#include "Board.h"
+#include "RotationFinder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <queue>
+
+static_assert(RotationFinder::kMaxTypes >= Board::kMaxDifficulty,
+              "RotationFinder would treat gem types >= kMaxTypes as empty cells");
+
+namespace {
+// 与各界面的 targetScore 保持一致
+int targetScoreFor(BoardMode mode) {
+    switch (mode) {
+        case BoardMode::Classic: return 1000;
+        case BoardMode::Whirlwind: return 10000;
+        case BoardMode::Multiplayer: return 10000;
+        case BoardMode::Puzzle: return 0;  // 解谜模式以清空棋盘为目标
+    }
+    return 0;
+}
+
+// (row, col) 所在的横向或纵向连续同色是否达到 3 个
+bool lineThrough(const int8_t* types, int row, int col) {
+    constexpr int n = Board::kSize;
+    int type = types[row * n + col];
+    if (type < 0) return false;
+
+    int run = 1;
+    for (int c = col - 1; c >= 0 && types[row * n + c] == type; --c) ++run;
+    for (int c = col + 1; c < n && types[row * n + c] == type; ++c) ++run;
+    if (run >= 3) return true;
+
+    run = 1;
+    for (int r = row - 1; r >= 0 && types[r * n + col] == type; --r) ++run;
+    for (int r = row + 1; r < n && types[r * n + col] == type; ++r) ++run;
+    return run >= 3;
+}
+}
+
+Board::Board(BoardMode mode, int difficulty)
+    : mode(mode), difficulty(std::clamp(difficulty, kMinDifficulty, kMaxDifficulty)), targetScore(targetScoreFor(mode)) {
+}
+
+void Board::generate(GameRng& rng) {
+    score = 0;
+    earnedCoins = 0;
+    comboCount = 0;
+    finished = false;
+    stats = Stats();
+    undoRing.clear();
+
+    fillRandom(rng);
+    // 生成金币宝石 (随机1-3个)
+    placeCoins(rng);
+    if (mode == BoardMode::Puzzle) pushUndoState();
+}
+
+void Board::loadTypes(const std::array<int8_t, kCells>& types) {
+    score = 0;
+    earnedCoins = 0;
+    comboCount = 0;
+    finished = false;
+    stats = Stats();
+    undoRing.clear();
+
+    for (int i = 0; i < kCells; ++i) {
+        cells[i] = Cell();
+        cells[i].type = types[i];
+    }
+    if (mode == BoardMode::Puzzle) pushUndoState();
+}
+
+std::array<int8_t, Board::kCells> Board::getTypes() const {
+    std::array<int8_t, kCells> types;
+    for (int i = 0; i < kCells; ++i) types[i] = cells[i].type;
+    return types;
+}
+
+int Board::pickType(int row, int col, GameRng& rng) const {
+    int type = rng.bounded(difficulty);
+
+    // 检查左边两个
+    if (col >= 2 && !at(row, col - 1).empty() && !at(row, col - 2).empty()) {
+        int type1 = at(row, col - 1).type;
+        int type2 = at(row, col - 2).type;
+        if (type1 == type2 && type == type1) {
+            type = (type + 1) % difficulty;
+        }
+    }
+
+    // 检查上边两个
+    if (row >= 2 && !at(row - 1, col).empty() && !at(row - 2, col).empty()) {
+        int type1 = at(row - 1, col).type;
+        int type2 = at(row - 2, col).type;
+        if (type1 == type2 && type == type1) {
+            type = (type + 1) % difficulty;
+        }
+    }
+    return type;
+}
+
+void Board::fillRandom(GameRng& rng) {
+    std::array<int8_t, kCells> types = generateTypes(difficulty, rng, defaultGenerateOptions(mode));
+    for (int i = 0; i < kCells; ++i) {
+        cells[i] = Cell();
+        cells[i].type = types[i];
+    }
+}
+
+Board::GenerateOptions Board::defaultGenerateOptions(BoardMode mode) {
+    GenerateOptions options;
+    if (mode == BoardMode::Whirlwind) options.minMoves = 0;
+    return options;
+}
+
+std::array<int8_t, Board::kCells> Board::generateTypes(int difficulty, GameRng& rng, const GenerateOptions& options) {
+    std::array<int8_t, kCells> types;
+    types.fill(-1);
+    difficulty = std::min(std::max(difficulty, 1), 31);
+
+    // 1. 种可走步：棋盘分成 4 行 x 2 列个 2x3 区块（第 3、7 列留空），每个区块放一组
+    //    "同行相邻两颗 + 另一行末端一颗"，把末端那颗换到同一行即成三连。
+    //    所有区块用同一种颜色，这样任何格子被种下的宝石额外禁止的颜色最多一种，
+    //    加上左侧/上方已填的两种，难度 >= 4 时每格总有可选的颜色
+    int planted = std::max(options.minMoves, (int)std::ceil(options.moveDensity * kCells));
+    planted = difficulty >= 4 ? std::min(std::max(planted, 0), kMaxPlantedMoves) : 0;
+    if (planted > 0) {
+        int blocks[kMaxPlantedMoves];
+        for (int i = 0; i < kMaxPlantedMoves; ++i) blocks[i] = i;
+        for (int i = 0; i < planted; ++i) {
+            std::swap(blocks[i], blocks[i + rng.bounded(kMaxPlantedMoves - i)]);
+        }
+        int8_t plantType = (int8_t)rng.bounded(difficulty);
+        for (int i = 0; i < planted; ++i) {
+            int top = (blocks[i] / 2) * 2;
+            int left = (blocks[i] % 2) * 4;
+            // 随机翻转区块的上下、左右，避免种下的图案总是同一个朝向
+            int variant = rng.bounded(4);
+            int pairRow = top + (variant & 1);
+            int loneRow = top + 1 - (variant & 1);
+            int pairCol = left + ((variant & 2) ? 1 : 0);
+            int loneCol = (variant & 2) ? left : left + 2;
+            types[pairRow * kSize + pairCol] = plantType;
+            types[pairRow * kSize + pairCol + 1] = plantType;
+            types[loneRow * kSize + loneCol] = plantType;
+        }
+    }
+
+    // 2. 其余格子按行填充：把会与已定格子（包括右侧、下方种下的宝石）组成三连的颜色放进掩码，
+    //    在剩余颜色里均匀选一个
+    for (int row = 0; row < kSize; ++row) {
+        for (int col = 0; col < kSize; ++col) {
+            int8_t& cell = types[row * kSize + col];
+            if (cell >= 0) continue;
+
+            auto typeAt = [&](int r, int c) -> int {
+                return (r >= 0 && r < kSize && c >= 0 && c < kSize) ? types[r * kSize + c] : -1;
+            };
+            uint32_t forbidden = 0;
+            auto forbidPair = [&](int a, int b) {
+                if (a >= 0 && a == b) forbidden |= 1u << a;
+            };
+            forbidPair(typeAt(row, col - 1), typeAt(row, col - 2));
+            forbidPair(typeAt(row, col - 1), typeAt(row, col + 1));
+            forbidPair(typeAt(row, col + 1), typeAt(row, col + 2));
+            forbidPair(typeAt(row - 1, col), typeAt(row - 2, col));
+            forbidPair(typeAt(row - 1, col), typeAt(row + 1, col));
+            forbidPair(typeAt(row + 1, col), typeAt(row + 2, col));
+
+            uint32_t allowedMask = ((1u << difficulty) - 1) & ~forbidden;
+            int allowed = __builtin_popcount(allowedMask);
+            if (allowed == 0) {
+                // 只有 difficulty < 3 才会走到这里，此时三连无法避免
+                cell = (int8_t)rng.bounded(difficulty);
+                continue;
+            }
+            int pick = rng.bounded(allowed);
+            while (pick-- > 0) allowedMask &= allowedMask - 1;
+            cell = (int8_t)__builtin_ctz(allowedMask);
+        }
+    }
+    return types;
+}
+
+void Board::placeCoins(GameRng& rng) {
+    if (mode == BoardMode::Puzzle || mode == BoardMode::Multiplayer) return;
+
+    int count = rng.bounded(1, 4);
+
+    std::vector<Pos> validPositions;
+    validPositions.reserve(kCells);
+    for (int row = 0; row < kSize; ++row) {
+        for (int col = 0; col < kSize; ++col) {
+            if (!at(row, col).empty()) validPositions.push_back({row, col});
+        }
+    }
+    if (validPositions.empty()) return;
+
+    int actualCount = std::min(count, (int)validPositions.size());
+
+    // 打乱位置顺序（与 generateCoinGems 相同的 Fisher-Yates）
+    for (int i = (int)validPositions.size() - 1; i > 0; --i) {
+        int j = rng.bounded(i + 1);
+        std::swap(validPositions[i], validPositions[j]);
+    }
+
+    for (int i = 0; i < actualCount; ++i) {
+        Cell& cell = at(validPositions[i].first, validPositions[i].second);
+        // 随机金币价值 1-5
+        cell.coinValue = (uint8_t)rng.bounded(1, 6);
+    }
+}
+
+std::vector<Board::Pos> Board::findMatches() const {
+    bool marked[kSize][kSize] = {};
+
+    // 检查水平方向
+    for (int i = 0; i < kSize; ++i) {
+        int j = 0;
+        while (j < kSize) {
+            int type = at(i, j).type;
+            int k = j + 1;
+            while (k < kSize && type >= 0 && at(i, k).type == type) ++k;
+            if (type >= 0 && k - j >= 3) {
+                for (int m = j; m < k; ++m) marked[i][m] = true;
+            }
+            j = k;
+        }
+    }
+
+    // 检查垂直方向
+    for (int j = 0; j < kSize; ++j) {
+        int i = 0;
+        while (i < kSize) {
+            int type = at(i, j).type;
+            int k = i + 1;
+            while (k < kSize && type >= 0 && at(k, j).type == type) ++k;
+            if (type >= 0 && k - i >= 3) {
+                for (int m = i; m < k; ++m) marked[m][j] = true;
+            }
+            i = k;
+        }
+    }
+
+    std::vector<Pos> matches;
+    for (int i = 0; i < kSize; ++i) {
+        for (int j = 0; j < kSize; ++j) {
+            if (marked[i][j]) matches.push_back({i, j});
+        }
+    }
+    return matches;
+}
+
+bool Board::swapCreatesMatch(int row1, int col1, int row2, int col2) const {
+    if (row1 < 0 || row1 >= kSize || col1 < 0 || col1 >= kSize) return false;
+    if (row2 < 0 || row2 >= kSize || col2 < 0 || col2 >= kSize) return false;
+    if (std::abs(row1 - row2) + std::abs(col1 - col2) != 1) return false;
+    if (at(row1, col1).empty()) return false;
+    if (at(row2, col2).empty() && mode != BoardMode::Puzzle) return false;
+
+    // 棋盘上原本没有三连，新形成的三连一定经过被交换的两个格子
+    std::array<int8_t, kCells> types = getTypes();
+    std::swap(types[row1 * kSize + col1], types[row2 * kSize + col2]);
+    return lineThrough(types.data(), row1, col1) || lineThrough(types.data(), row2, col2);
+}
+
+bool Board::rotateCreatesMatch(int topLeftRow, int topLeftCol) const {
+    if (topLeftRow < 0 || topLeftRow >= kSize - 1 || topLeftCol < 0 || topLeftCol >= kSize - 1) return false;
+
+    std::array<int8_t, kCells> types = getTypes();
+    int tl = topLeftRow * kSize + topLeftCol;
+    int tr = tl + 1;
+    int bl = tl + kSize;
+    int br = bl + 1;
+    if (types[tl] < 0 || types[tr] < 0 || types[bl] < 0 || types[br] < 0) return false;
+
+    int8_t old = types[tl];
+    types[tl] = types[bl];
+    types[bl] = types[br];
+    types[br] = types[tr];
+    types[tr] = old;
+    return lineThrough(types.data(), topLeftRow, topLeftCol) || lineThrough(types.data(), topLeftRow, topLeftCol + 1) ||
+           lineThrough(types.data(), topLeftRow + 1, topLeftCol) || lineThrough(types.data(), topLeftRow + 1, topLeftCol + 1);
+}
+
+int Board::findSwapMoves(MoveList& out) const {
+    int count = 0;
+    for (int row = 0; row < kSize; ++row) {
+        for (int col = 0; col < kSize; ++col) {
+            // 每对相邻格子只看一次（右边和下边）；起点是空位时反过来判断
+            const int targets[2][2] = {{row, col + 1}, {row + 1, col}};
+            for (const auto& t : targets) {
+                if (swapCreatesMatch(row, col, t[0], t[1])) {
+                    out[count++] = {(int8_t)row, (int8_t)col, (int8_t)t[0], (int8_t)t[1]};
+                } else if (swapCreatesMatch(t[0], t[1], row, col)) {
+                    out[count++] = {(int8_t)t[0], (int8_t)t[1], (int8_t)row, (int8_t)col};
+                }
+            }
+        }
+    }
+    return count;
+}
+
+bool Board::hasSwapMove() const {
+    // 每次连锁结束都会调用：只复制一次类型数组，原地交换再换回
+    std::array<int8_t, kCells> types = getTypes();
+    auto tryPair = [&](int a, int b) {
+        if (types[a] < 0 || (types[b] < 0 && mode != BoardMode::Puzzle) || types[a] == types[b]) return false;
+        std::swap(types[a], types[b]);
+        bool match = lineThrough(types.data(), a / kSize, a % kSize) || lineThrough(types.data(), b / kSize, b % kSize);
+        std::swap(types[a], types[b]);
+        return match;
+    };
+    for (int row = 0; row < kSize; ++row) {
+        for (int col = 0; col < kSize; ++col) {
+            int cell = row * kSize + col;
+            if (col + 1 < kSize && (tryPair(cell, cell + 1) || tryPair(cell + 1, cell))) return true;
+            if (row + 1 < kSize && (tryPair(cell, cell + kSize) || tryPair(cell + kSize, cell))) return true;
+        }
+    }
+    return false;
+}
+
+int Board::findRotateMoves(MoveList& out) const {
+    RotationFinder::MoveList moves;
+    int count = RotationFinder(getTypes()).findMoves(moves);
+    for (int i = 0; i < count; ++i) out[i] = {moves[i].row, moves[i].col, 0, 0};
+    return count;
+}
+
+bool Board::hasRotateMove() const {
+    return RotationFinder(getTypes()).hasMove();
+}
+
+std::vector<std::vector<Board::Pos>> Board::groupMatches(const std::vector<Pos>& matches) const {
+    bool inMatches[kSize][kSize] = {};
+    bool visited[kSize][kSize] = {};
+    for (const Pos& p : matches) inMatches[p.first][p.second] = true;
+
+    std::vector<std::vector<Pos>> groups;
+    for (const Pos& match : matches) {
+        if (visited[match.first][match.second]) continue;
+        const Cell& matchCell = at(match.first, match.second);
+        if (matchCell.empty()) continue;
+        int matchType = matchCell.type;
+
+        // 只把类型相同的相邻匹配位置归为一组
+        std::vector<Pos> group;
+        std::queue<Pos> q;
+        q.push(match);
+        visited[match.first][match.second] = true;
+
+        static const int dr[] = {-1, 1, 0, 0};
+        static const int dc[] = {0, 0, -1, 1};
+        while (!q.empty()) {
+            Pos current = q.front();
+            q.pop();
+            group.push_back(current);
+
+            for (int i = 0; i < 4; ++i) {
+                int nr = current.first + dr[i];
+                int nc = current.second + dc[i];
+                if (nr < 0 || nr >= kSize || nc < 0 || nc >= kSize) continue;
+                if (!inMatches[nr][nc] || visited[nr][nc]) continue;
+                if (at(nr, nc).type == matchType) {
+                    visited[nr][nc] = true;
+                    q.push({nr, nc});
+                }
+            }
+        }
+        groups.push_back(std::move(group));
+    }
+    return groups;
+}
+
+void Board::removeCell(int row, int col) {
+    Cell& cell = at(row, col);
+    if (cell.empty()) return;
+    // 如果是金币宝石，先收集金币
+    earnedCoins += cell.coinValue;
+    cell = Cell();
+    ++stats.removedGems;
+}
+
+void Board::addScore(int points) {
+    score += points;
+}
+
+void Board::removeMatches(const std::vector<Pos>& matches) {
+    if (matches.empty()) return;
+
+    auto groups = groupMatches(matches);
+    int removedCount = 0;
+
+    for (const auto& group : groups) {
+        bool hasSpecial = false;
+        for (const Pos& pos : group) {
+            if (at(pos.first, pos.second).special) hasSpecial = true;
+        }
+
+        if (hasSpecial) {
+            std::vector<Pos> specialPositions;
+            for (const Pos& pos : group) {
+                if (at(pos.first, pos.second).special) specialPositions.push_back(pos);
+            }
+            // 先消除组内的非特殊宝石
+            for (const Pos& pos : group) {
+                const Cell& cell = at(pos.first, pos.second);
+                if (!cell.empty() && !cell.special) {
+                    removedCount++;
+                    removeCell(pos.first, pos.second);
+                }
+            }
+            // 然后触发所有特殊宝石（支持连锁）
+            for (const Pos& specialPos : specialPositions) {
+                const Cell& cell = at(specialPos.first, specialPos.second);
+                if (!cell.empty() && cell.special) {
+                    remove3x3Area(specialPos.first, specialPos.second, false);
+                }
+            }
+        } else if (group.size() >= 4) {
+            // 4连或更多：保留排序后的第2颗宝石作为特殊宝石
+            std::vector<Pos> sortedGroup = group;
+            std::sort(sortedGroup.begin(), sortedGroup.end());
+            Pos specialPos = sortedGroup[1];
+
+            for (const Pos& pos : sortedGroup) {
+                Cell& cell = at(pos.first, pos.second);
+                if (cell.empty()) continue;
+                if (pos == specialPos) {
+                    cell.special = true;
+                } else {
+                    removedCount++;
+                    removeCell(pos.first, pos.second);
+                }
+            }
+        } else {
+            // 普通3连：正常消除
+            for (const Pos& pos : group) {
+                if (!at(pos.first, pos.second).empty()) {
+                    removedCount++;
+                    removeCell(pos.first, pos.second);
+                }
+            }
+        }
+    }
+
+    if (removedCount > 0) {
+        if (mode == BoardMode::Puzzle) {
+            addScore(removedCount * 10);
+            if (getRemainingGems() == 0) finished = true;
+        } else {
+            comboCount++;
+            int comboBonus = comboCount > 1 ? (comboCount - 1) * 5 : 0;
+            addScore(removedCount * 10 + comboBonus);
+            if (score >= targetScore) finished = true;
+        }
+    }
+}
+
+void Board::remove3x3Area(int centerRow, int centerCol, bool chain) {
+    std::vector<Pos> chainSpecialGems;
+
+    for (int dr = -1; dr <= 1; ++dr) {
+        for (int dc = -1; dc <= 1; ++dc) {
+            int r = centerRow + dr;
+            int c = centerCol + dc;
+            if (r < 0 || r >= kSize || c < 0 || c >= kSize) continue;
+
+            const Cell& cell = at(r, c);
+            if (cell.empty()) continue;
+            // 首次触发时中心自身不算连锁，连锁触发时范围内所有特殊宝石都继续引爆
+            if (cell.special && (chain || !(r == centerRow && c == centerCol))) {
+                chainSpecialGems.push_back({r, c});
+            }
+            removeCell(r, c);
+            addScore(10);
+        }
+    }
+
+    for (const Pos& pos : chainSpecialGems) {
+        remove3x3Area(pos.first, pos.second, true);
+    }
+    if (mode == BoardMode::Puzzle && getRemainingGems() == 0) finished = true;
+}
+
+void Board::drop() {
+    for (int col = 0; col < kSize; ++col) {
+        int writePos = kSize - 1;  // 从底部开始写入
+        for (int row = kSize - 1; row >= 0; --row) {
+            if (!at(row, col).empty()) {
+                if (row < writePos) {
+                    at(writePos, col) = at(row, col);
+                    at(row, col) = Cell();
+                }
+                writePos--;
+            }
+        }
+    }
+}
+
+void Board::refill(GameRng& rng) {
+    // 与 resetGemstoneTable() 一致按列填充
+    for (int col = 0; col < kSize; ++col) {
+        for (int row = 0; row < kSize; ++row) {
+            if (at(row, col).empty()) {
+                at(row, col).type = (int8_t)pickType(row, col, rng);
+            }
+        }
+    }
+}
+
+bool Board::eliminateStep() {
+    std::vector<Pos> matches = findMatches();
+    if (matches.empty()) {
+        comboCount = 0;
+        return false;
+    }
+    // 界面的 eliminate() 和 removeMatches() 各自累加一次连击数，这里保持一致
+    comboCount++;
+    ++stats.cascadeSteps;
+    removeMatches(matches);
+    return true;
+}
+
+void Board::resolveCascade(GameRng& rng) {
+    while (!finished) {
+        drop();
+        if (refills()) refill(rng);
+        if (finished || !eliminateStep()) break;
+    }
+    if (mode == BoardMode::Puzzle && !finished) pushUndoState();
+    // 连锁结束后检查死局，与界面在 eliminate() 结束时的检查一致
+    if (reshufflesWhenDead()) reshuffle(rng);
+}
+
+bool Board::swap(int row1, int col1, int row2, int col2, GameRng& rng) {
+    if (finished) return false;
+    if (row1 < 0 || row1 >= kSize || col1 < 0 || col1 >= kSize) return false;
+    if (row2 < 0 || row2 >= kSize || col2 < 0 || col2 >= kSize) return false;
+    if (std::abs(row1 - row2) + std::abs(col1 - col2) != 1) return false;
+    if (at(row1, col1).empty()) return false;
+    // 只有解谜模式允许把宝石移到空位
+    if (at(row2, col2).empty() && mode != BoardMode::Puzzle) return false;
+
+    std::swap(at(row1, col1), at(row2, col2));
+    if (findMatches().empty()) {
+        std::swap(at(row1, col1), at(row2, col2));
+        if (mode == BoardMode::Puzzle) comboCount = 0;
+        ++stats.rejectedMoves;
+        return false;
+    }
+
+    ++stats.moves;
+    ++stats.cascades;
+    eliminateStep();
+    resolveCascade(rng);
+    return true;
+}
+
+bool Board::rotate(int topLeftRow, int topLeftCol, GameRng& rng) {
+    if (finished) return false;
+    if (topLeftRow < 0 || topLeftRow >= kSize - 1 || topLeftCol < 0 || topLeftCol >= kSize - 1) return false;
+    Cell& topLeft = at(topLeftRow, topLeftCol);
+    Cell& topRight = at(topLeftRow, topLeftCol + 1);
+    Cell& bottomLeft = at(topLeftRow + 1, topLeftCol);
+    Cell& bottomRight = at(topLeftRow + 1, topLeftCol + 1);
+    if (topLeft.empty() || topRight.empty() || bottomLeft.empty() || bottomRight.empty()) return false;
+
+    // 顺时针旋转：TL -> TR, TR -> BR, BR -> BL, BL -> TL
+    Cell tl = topLeft;
+    topLeft = bottomLeft;
+    bottomLeft = bottomRight;
+    bottomRight = topRight;
+    topRight = tl;
+
+    // 旋风模式旋转后没有匹配也不回退；转完可能变成死局，与界面一样检查并重排
+    ++stats.moves;
+    if (findMatches().empty()) {
+        reshuffle(rng);
+        return true;
+    }
+
+    ++stats.cascades;
+    eliminateStep();
+    resolveCascade(rng);
+    return true;
+}
+
+bool Board::hammer(int row, int col, GameRng& rng) {
+    if (finished) return false;
+    if (row < 0 || row >= kSize || col < 0 || col >= kSize) return false;
+    if (at(row, col).empty()) return false;
+
+    ++stats.moves;
+    removeMatches({{row, col}});
+    addScore(20);
+    resolveCascade(rng);
+    return true;
+}
+
+bool Board::resetBoard(GameRng& rng) {
+    if (finished) return false;
+    ++stats.moves;
+    fillRandom(rng);
+    placeCoins(rng);
+    return true;
+}
+
+bool Board::reshuffle(GameRng& rng) {
+    if (finished || !reshufflesWhenDead() || hasMove()) return false;
+    applyReshuffle(planReshuffle(rng));
+    return true;
+}
+
+Board::ReshufflePlan Board::planReshuffle(GameRng& rng) const {
+    ReshufflePlan plan;
+    plan.types.fill(-1);
+
+    // 每种宝石原来所在的格子，随机打乱后依次分配到新位置
+    std::array<std::array<int8_t, kCells>, kMaxDifficulty> cellsOfType;
+    std::array<int, kMaxDifficulty> remaining{};
+    const int typeCount = difficulty;  // 构造时已夹到 [kMinDifficulty, kMaxDifficulty]
+    for (int i = 0; i < kCells; ++i) {
+        int type = cells[i].type;
+        if (type < 0 || type >= typeCount) continue;
+        cellsOfType[type][remaining[type]++] = (int8_t)i;
+    }
+    for (int type = 0; type < typeCount; ++type) {
+        for (int i = remaining[type] - 1; i > 0; --i) {
+            std::swap(cellsOfType[type][i], cellsOfType[type][rng.bounded(i + 1)]);
+        }
+    }
+    std::array<int, kMaxDifficulty> taken{};
+    std::array<bool, kCells> used{};
+    auto takeGem = [&](int cell, int type) {
+        int source = cellsOfType[type][taken[type]++];
+        --remaining[type];
+        plan.source[cell] = (int8_t)source;
+        plan.types[cell] = (int8_t)type;
+        used[source] = true;
+    };
+
+    // 1. 先种下一步可走的棋：(r,c) (r,c+1) 同色，(r+1,c+2) 同色，交换 (r+1,c+2) 与 (r,c+2) 成三连；
+    //    旋风模式顺时针旋转以 (r,c+2) 为左上角的方框也能把 (r+1,c+2) 转到 (r,c+2)，方框需要 c+3 不越界
+    int plantType = 0;
+    for (int type = 1; type < typeCount; ++type) {
+        if (remaining[type] > remaining[plantType]) plantType = type;
+    }
+    int plantRow = rng.bounded(kSize - 1);
+    int plantCol = rng.bounded(mode == BoardMode::Whirlwind ? kSize - 3 : kSize - 2);
+    if (remaining[plantType] >= 3) {
+        takeGem(plantRow * kSize + plantCol, plantType);
+        takeGem(plantRow * kSize + plantCol + 1, plantType);
+        takeGem((plantRow + 1) * kSize + plantCol + 2, plantType);
+    }
+
+    // 2. 其余格子按行填充：排除会和已填格子组成三连的类型（最多排除横竖两种），
+    //    在剩余宝石里加权随机选；选不出时给剩下的宝石改色，保证一次填完
+    std::array<int8_t, kCells> types = plan.types;
+    for (int cell = 0; cell < kCells; ++cell) {
+        if (types[cell] >= 0) continue;
+        int row = cell / kSize;
+        int col = cell % kSize;
+
+        int total = 0;
+        std::array<bool, kMaxDifficulty> allowed{};
+        std::array<int, kMaxDifficulty> weight{};
+        for (int type = 0; type < typeCount; ++type) {
+            types[cell] = (int8_t)type;
+            allowed[type] = !lineThrough(types.data(), row, col);
+            // 按剩余数量的平方加权，多的先用掉，避免最后只剩一种颜色
+            weight[type] = allowed[type] ? remaining[type] * remaining[type] : 0;
+            total += weight[type];
+        }
+        types[cell] = -1;
+
+        if (total > 0) {
+            int pick = rng.bounded(total);
+            int type = 0;
+            while (pick >= weight[type]) pick -= weight[type++];
+            takeGem(cell, type);
+        } else {
+            // difficulty >= kMinDifficulty 时总有类型可选，走不到这里；只作为防御，接受一个三连
+            int type = 0;
+            while (type < typeCount && !allowed[type]) ++type;
+            if (type == typeCount) type = 0;
+            plan.types[cell] = (int8_t)type;
+            plan.source[cell] = -1;  // 稍后从剩下的宝石里取一颗改色
+            ++plan.recolored;
+        }
+        types[cell] = plan.types[cell];
+    }
+
+    // 3. 改色的格子拿走还没分配的宝石
+    int next = 0;
+    for (int cell = 0; cell < kCells; ++cell) {
+        if (plan.source[cell] >= 0) continue;
+        while (used[next]) ++next;
+        plan.source[cell] = (int8_t)next;
+        used[next] = true;
+    }
+    return plan;
+}
+
+void Board::applyReshuffle(const ReshufflePlan& plan) {
+    std::array<Cell, kCells> old = cells;
+    for (int i = 0; i < kCells; ++i) {
+        cells[i] = old[plan.source[i]];
+        cells[i].type = plan.types[i];
+    }
+    ++stats.reshuffles;
+}
+
+bool Board::clearAll(GameRng& rng) {
+    if (finished) return false;
+    int removedCount = 0;
+    for (int i = 0; i < kSize; ++i) {
+        for (int j = 0; j < kSize; ++j) {
+            if (!at(i, j).empty()) {
+                removedCount++;
+                removeCell(i, j);
+            }
+        }
+    }
+    if (removedCount == 0) return false;
+
+    ++stats.moves;
+    addScore(removedCount * 5);
+    if (score >= targetScore) finished = true;
+    resolveCascade(rng);
+    return true;
+}
+
+bool Board::undo() {
+    if (mode != BoardMode::Puzzle || finished) return false;
+    if (!undoRing.pop()) return false;
+    const UndoRing::Snapshot& snapshot = undoRing.top();
+    for (int i = 0; i < kCells; ++i) {
+        cells[i] = Cell();
+        cells[i].type = static_cast<int8_t>(UndoRing::cellType(snapshot, i));
+    }
+    ++stats.moves;
+    return true;
+}
+
+void Board::pushUndoState() {
+    if (!undoEnabled) return;
+    undoRing.push(getTypes());
+}
+
+int Board::getRemainingGems() const {
+    int count = 0;
+    for (const Cell& cell : cells) {
+        if (!cell.empty()) ++count;
+    }
+    return count;
+}
+
+std::string Board::toString() const {
+    std::string out;
+    out.reserve(kCells + kSize);
+    for (int i = 0; i < kSize; ++i) {
+        for (int j = 0; j < kSize; ++j) {
+            const Cell& cell = at(i, j);
+            out += cell.empty() ? '-' : (char)('0' + cell.type);
+        }
+        out += '\n';
+    }
+    return out;
+}
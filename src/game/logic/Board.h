@@ -0,0 +1,184 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GameRng.h"
+#include "UndoRing.h"
+
+// 棋盘对应的游戏模式，数值与录像文件中的模式字段一致
+enum class BoardMode : uint8_t {
+    Classic = 1,     // 单人经典模式：交换 + 补充
+    Whirlwind = 2,   // 旋风模式：2x2 顺时针旋转 + 补充
+    Puzzle = 3,      // 解谜模式：交换，不补充，可撤销
+    Multiplayer = 4  // 联机模式：规则与经典模式相同
+};
+
+/**
+ * Board - 不依赖 Qt 的棋盘逻辑
+ *
+ * 消除、特殊宝石、下落和补充的规则与各 *ModeGameWidget 中的 findMatches / removeMatches /
+ * drop / resetGemstoneTable 等价，但实现各自独立，随机数的取用顺序不保证一致，
+ * 因此同一种子下不能指望与界面对局得到同一块棋盘。Board 自身是确定的：
+ * 同一种子和同样的操作序列总得到同样的棋盘和分数，录像的无界面回放、基准测试和求解器都基于这一点。
+ * 两条路径是否一致可以用 --replay-headless 检查：拿界面录下的录像在 Board 上重放，分数不符时报 MISMATCH。
+ */
+class Board {
+public:
+    static constexpr int kSize = 8;
+    static constexpr int kCells = kSize * kSize;
+
+    using Pos = std::pair<int, int>;
+
+    // 一步操作：交换 (row1,col1)-(row2,col2)，旋转时只用 (row1,col1) 作为左上角
+    struct Move {
+        int8_t row1 = 0, col1 = 0, row2 = 0, col2 = 0;
+    };
+    static constexpr int kMaxMoves = 2 * kSize * (kSize - 1);  // 所有相邻格子对
+    using MoveList = std::array<Move, kMaxMoves>;
+
+    struct Cell {
+        int8_t type = -1;       // -1 表示空位
+        bool special = false;   // 4 连生成的特殊宝石，被消除时炸掉 3x3
+        uint8_t coinValue = 0;  // 金币宝石的面值，0 表示普通宝石
+
+        bool empty() const { return type < 0; }
+    };
+
+    // 累计统计，供回放结果和基准测试使用
+    struct Stats {
+        int moves = 0;          // 生效的操作数（交换/旋转/锤子/道具）
+        int rejectedMoves = 0;  // 没有形成匹配而被换回的交换
+        int cascades = 0;       // 触发了消除的操作数
+        int cascadeSteps = 0;   // 消除轮数（一次操作可能连锁多轮）
+        int removedGems = 0;
+        int reshuffles = 0;     // 死局自动重排次数
+    };
+
+    // 死局重排方案：重排后第 i 格放原来第 source[i] 格的宝石，类型为 types[i]
+    // （只有宝石种类极度不均、无法只靠换位置避开三连时才会改色）
+    struct ReshufflePlan {
+        std::array<int8_t, kCells> source{};
+        std::array<int8_t, kCells> types{};
+        int recolored = 0;
+    };
+
+    // 开局棋盘的生成参数
+    struct GenerateOptions {
+        int minMoves = 1;           // 至少保证的可走交换数
+        double moveDensity = 0.0;   // 目标可走步密度（可走步数 / 格子数），与 minMoves 取较大者
+    };
+    // 种下的可走步各占一个 2x3 区块，最多 8 个
+    static constexpr int kMaxPlantedMoves = 8;
+    // 重排时种下可走步旁边的格子最多会被横、竖和种下的一对同时排除 3 种类型，
+    // 至少 4 种宝石才保证总有类型可选。上限与宝石模型数（gem_type_0~7）一致，
+    // RotationFinder 的位棋盘按这个上限开数组
+    static constexpr int kMinDifficulty = 4;
+    static constexpr int kMaxDifficulty = 8;
+
+    // difficulty 夹到 [kMinDifficulty, kMaxDifficulty]
+    Board(BoardMode mode = BoardMode::Classic, int difficulty = 4);
+
+    // 一次填满棋盘的类型：每格按禁止类型掩码均匀选取，不需要重试或连锁消除。
+    // 保证没有现成三连；difficulty >= 4 时保证至少有 minMoves 步可走（随机部分还会自然产生可走步）。
+    // 界面的 reset() 和 Board::generate 共用，同一随机数流得到同样的棋盘
+    static std::array<int8_t, kCells> generateTypes(int difficulty, GameRng& rng, const GenerateOptions& options);
+    // 各模式默认的生成参数：旋风模式任何旋转都合法，不需要种可走步
+    static GenerateOptions defaultGenerateOptions(BoardMode mode);
+
+    BoardMode getMode() const { return mode; }
+    int getDifficulty() const { return difficulty; }
+
+    const Cell& at(int row, int col) const { return cells[row * kSize + col]; }
+    Cell& at(int row, int col) { return cells[row * kSize + col]; }
+
+    // 与 reset() 相同：generateTypes 填满棋盘，然后放置 1-3 个金币宝石
+    void generate(GameRng& rng);
+    // 直接载入棋盘类型（-1 为空位），解谜模式的初始棋盘由录像提供
+    void loadTypes(const std::array<int8_t, kCells>& types);
+    std::array<int8_t, kCells> getTypes() const;
+
+    // 所有处于三连及以上中的位置，按行优先排序
+    std::vector<Pos> findMatches() const;
+
+    // 不修改棋盘、不分配内存，判断操作后是否会形成三连（找可走步、死局判断用）
+    bool swapCreatesMatch(int row1, int col1, int row2, int col2) const;
+    bool rotateCreatesMatch(int topLeftRow, int topLeftCol) const;
+    // 枚举所有能形成三连的交换 / 旋转，返回个数（解谜模式包括移到空位）
+    int findSwapMoves(MoveList& out) const;
+    int findRotateMoves(MoveList& out) const;
+    // 是否存在能形成三连的交换，找到第一个就返回
+    bool hasSwapMove() const;
+    // 是否存在能形成三连的顺时针旋转（位棋盘评估，见 RotationFinder）
+    bool hasRotateMove() const;
+
+    // 玩家操作，返回操作是否生效；生效后会结算完整个连锁
+    bool swap(int row1, int col1, int row2, int col2, GameRng& rng);
+    bool rotate(int topLeftRow, int topLeftCol, GameRng& rng);
+    bool hammer(int row, int col, GameRng& rng);
+    bool resetBoard(GameRng& rng);
+    bool clearAll(GameRng& rng);
+    bool undo();
+    // 没有可走步时重排现有宝石：保证没有现成三连且至少有一步可走（旋风模式为一个旋转），
+    // 固定 O(格子数 x 宝石种类) 时间，不重试。有可走步时不做任何事并返回 false
+    bool reshuffle(GameRng& rng);
+    ReshufflePlan planReshuffle(GameRng& rng) const;
+    void applyReshuffle(const ReshufflePlan& plan);
+
+    int getScore() const { return score; }
+    int getEarnedCoins() const { return earnedCoins; }
+    int getTargetScore() const { return targetScore; }
+    // 覆盖模式默认的目标分（难度标定时使用）
+    void setTargetScore(int target) { targetScore = target; }
+    // 求解器复制大量棋盘时关闭撤销栈，避免每步分配
+    void setUndoEnabled(bool enabled) { undoEnabled = enabled; }
+    bool isFinished() const { return finished; }
+    // 解谜模式剩余宝石数
+    int getRemainingGems() const;
+    const Stats& getStats() const { return stats; }
+
+    // 调试输出，每行 8 个字符，'-' 为空位
+    std::string toString() const;
+
+private:
+    bool refills() const { return mode != BoardMode::Puzzle; }
+    // 解谜模式不补充宝石，无步可走即结束；其余模式死局时重排
+    bool reshufflesWhenDead() const { return mode != BoardMode::Puzzle; }
+    bool hasMove() const { return mode == BoardMode::Whirlwind ? hasRotateMove() : hasSwapMove(); }
+
+    void resolveCascade(GameRng& rng);
+    bool eliminateStep();
+    void removeMatches(const std::vector<Pos>& matches);
+    void remove3x3Area(int centerRow, int centerCol, bool chain);
+    void removeCell(int row, int col);
+    void drop();
+    void refill(GameRng& rng);
+    void fillRandom(GameRng& rng);
+    void placeCoins(GameRng& rng);
+    int pickType(int row, int col, GameRng& rng) const;
+    std::vector<std::vector<Pos>> groupMatches(const std::vector<Pos>& matches) const;
+    void addScore(int points);
+    void pushUndoState();
+
+    BoardMode mode;
+    int difficulty;
+    std::array<Cell, kCells> cells;
+
+    int score = 0;
+    int targetScore = 0;
+    int earnedCoins = 0;
+    int comboCount = 0;
+    bool finished = false;
+    Stats stats;
+
+    // 解谜模式的撤销记录，与界面共用 UndoRing，撤销深度一致
+    UndoRing undoRing;
+    static_assert(UndoRing::kCells == kCells, "UndoRing must cover the whole board");
+    static_assert(kMaxDifficulty <= UndoRing::kMaxTypes, "UndoRing packs type + 1 into 4 bits");
+    bool undoEnabled = true;
+};
+
+#endif // BOARD_H
@@ -0,0 +1,89 @@
+#ifndef GAME_RNG_H
+#define GAME_RNG_H
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+/**
+ * GameRng - 每局游戏独立的可复现随机数流（PCG32）
+ *
+ * 棋盘初始化、下落补充、金币宝石、解谜模式出题都从这里取随机数，
+ * 同一个种子 + 同样的操作序列一定得到同样的棋盘，
+ * 用于录像回放、联机双方本地生成补充宝石以及可重复的基准测试。
+ * 纯 C++ 实现，不依赖 Qt，可以在无界面的模拟器里直接使用。
+ */
+class GameRng {
+public:
+    explicit GameRng(uint64_t seed = 0) { reseed(seed); }
+
+    // 重新播种，同一种子得到完全相同的序列
+    void reseed(uint64_t seed) {
+        seedValue = seed;
+        state = 0;
+        inc = (splitmix64(seed) << 1u) | 1u;
+        next();
+        state += splitmix64(seed ^ 0x9E3779B97F4A7C15ull);
+        next();
+    }
+
+    uint64_t seed() const { return seedValue; }
+
+    // 32 位均匀随机数
+    uint32_t next() {
+        uint64_t old = state;
+        state = old * 6364136223846793005ull + inc;
+        uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = (uint32_t)(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+    }
+
+    // [0, bound) 内的均匀整数，bound <= 0 时返回 0（Lemire 无偏取模）
+    int bounded(int bound) {
+        if (bound <= 0) return 0;
+        uint32_t range = (uint32_t)bound;
+        uint64_t m = (uint64_t)next() * range;
+        uint32_t low = (uint32_t)m;
+        if (low < range) {
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                m = (uint64_t)next() * range;
+                low = (uint32_t)m;
+            }
+        }
+        return (int)(m >> 32);
+    }
+
+    // [lowest, highest) 内的均匀整数，与 QRandomGenerator::bounded(lowest, highest) 语义一致
+    int bounded(int lowest, int highest) {
+        return lowest + bounded(highest - lowest);
+    }
+
+    // 从当前流派生一个新种子，用于局内重开棋盘，结果仍可复现
+    uint64_t deriveSeed() {
+        uint64_t high = next();
+        return (high << 32) | next();
+    }
+
+    // 新开一局时使用的随机种子
+    static uint64_t makeSeed() {
+        std::random_device device;
+        uint64_t seed = ((uint64_t)device() << 32) ^ device();
+        seed ^= (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+        return splitmix64(seed);
+    }
+
+private:
+    static uint64_t splitmix64(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t seedValue = 0;
+    uint64_t state = 0;
+    uint64_t inc = 1;
+};
+
+#endif // GAME_RNG_H
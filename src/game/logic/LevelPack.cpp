@@ -0,0 +1,124 @@
+#include "LevelPack.h"
+#include <cstring>
+#include <fstream>
+
+namespace {
+const char kMagic[4] = {'B', 'J', 'L', 'P'};
+
+void putU16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back((uint8_t)value);
+    out.push_back((uint8_t)(value >> 8));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back((uint8_t)(value >> (8 * i)));
+}
+}
+
+std::array<int8_t, Board::kCells> LevelPack::LevelRecord::types() const {
+    std::array<int8_t, Board::kCells> result;
+    for (int i = 0; i < Board::kCells; ++i) {
+        int value = (cells[i / 2] >> ((i % 2) * 4)) & 0x0F;
+        result[i] = (int8_t)(value - 1);
+    }
+    return result;
+}
+
+LevelPack::LevelRecord LevelPack::LevelRecord::fromTypes(const std::array<int8_t, Board::kCells>& types) {
+    LevelRecord record{};
+    for (int i = 0; i < Board::kCells; ++i) {
+        int value = types[i] < 0 ? 0 : types[i] + 1;
+        record.cells[i / 2] |= (uint8_t)(value << ((i % 2) * 4));
+    }
+    return record;
+}
+
+bool LevelPack::open(const uint8_t* data, size_t size) {
+    table = nullptr;
+    records = nullptr;
+    tableCount = 0;
+    totalLevels = 0;
+
+    if (!data || size < kHeaderSize || std::memcmp(data, kMagic, 4) != 0) return false;
+    if (data[4] != kVersion) return false;
+    // 直接按结构体读取映射内存，要求 4 字节对齐（文件映射按页对齐）
+    if (reinterpret_cast<uintptr_t>(data) % alignof(LevelRecord) != 0) return false;
+
+    uint16_t count = (uint16_t)(data[6] | (data[7] << 8));
+    uint32_t levels = 0;
+    std::memcpy(&levels, data + 8, 4);
+
+    size_t tableBytes = (size_t)count * sizeof(TableEntry);
+    if (size < kHeaderSize + tableBytes + (size_t)levels * sizeof(LevelRecord)) return false;
+
+    const TableEntry* entries = reinterpret_cast<const TableEntry*>(data + kHeaderSize);
+    for (int i = 0; i < count; ++i) {
+        if ((uint64_t)entries[i].firstRecord + entries[i].levelCount > levels) return false;
+    }
+
+    table = entries;
+    tableCount = count;
+    totalLevels = levels;
+    records = reinterpret_cast<const LevelRecord*>(data + kHeaderSize + tableBytes);
+    return true;
+}
+
+int LevelPack::levelCount(int difficulty) const {
+    for (int i = 0; i < tableCount; ++i) {
+        if (table[i].difficulty == difficulty) return (int)table[i].levelCount;
+    }
+    return 0;
+}
+
+const LevelPack::LevelRecord* LevelPack::level(int difficulty, int level) const {
+    for (int i = 0; i < tableCount; ++i) {
+        if (table[i].difficulty != difficulty) continue;
+        if (level < 1 || (uint32_t)level > table[i].levelCount) return nullptr;
+        return records + table[i].firstRecord + (level - 1);
+    }
+    return nullptr;
+}
+
+std::vector<uint8_t> LevelPack::build(const std::vector<Group>& groups) {
+    uint32_t total = 0;
+    for (const Group& group : groups) total += (uint32_t)group.levels.size();
+
+    std::vector<uint8_t> out;
+    out.reserve(kHeaderSize + groups.size() * sizeof(TableEntry) + total * sizeof(LevelRecord));
+    for (char c : kMagic) out.push_back((uint8_t)c);
+    out.push_back(kVersion);
+    out.push_back(0);
+    putU16(out, (uint16_t)groups.size());
+    putU32(out, total);
+    putU32(out, 0);
+
+    uint32_t first = 0;
+    for (const Group& group : groups) {
+        out.push_back((uint8_t)group.difficulty);
+        out.push_back(0);
+        out.push_back(0);
+        out.push_back(0);
+        putU32(out, (uint32_t)group.levels.size());
+        putU32(out, first);
+        first += (uint32_t)group.levels.size();
+    }
+
+    for (const Group& group : groups) {
+        for (const LevelRecord& record : group.levels) {
+            for (uint8_t byte : record.cells) out.push_back(byte);
+            out.push_back(record.optimalMoves);
+            out.push_back(record.gemCount);
+            putU16(out, record.grade);
+            putU32(out, record.solverNodes);
+        }
+    }
+    return out;
+}
+
+bool LevelPack::writeFile(const std::string& path, const std::vector<Group>& groups) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    std::vector<uint8_t> data = build(groups);
+    out.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+    return (bool)out;
+}
@@ -0,0 +1,73 @@
+#ifndef LEVEL_PACK_H
+#define LEVEL_PACK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+/**
+ * LevelPack - 离线编译的解谜关卡包
+ *
+ * 由 tools/levelpack 离线生成（regenerate_level_pack 目标，结果提交在 resources/levels/ 下）：批量倒推生成题目，用 PuzzleSolver 求出最少步数并评级，
+ * 每个难度按评级从易到难排好序写入。运行时整个文件只读映射进内存，
+ * 取第 N 关就是一次指针运算，不需要解析或分配。
+ *
+ * 二进制格式（小端，所有偏移 4 字节对齐）：
+ *   Header  16 字节: "BJLP" | version u8 | reserved u8 | tableCount u16 | totalLevels u32 | reserved u32
+ *   Table   tableCount x 12 字节: difficulty u8 | reserved u8[3] | levelCount u32 | firstRecord u32
+ *   Records totalLevels x 40 字节（见 LevelRecord），同一难度的关卡连续存放
+ */
+class LevelPack {
+public:
+    static constexpr uint8_t kVersion = 1;
+
+    struct LevelRecord {
+        uint8_t cells[32];      // 每格 4 位，行优先，低 4 位在前；0 为空位，否则为类型 + 1
+        uint8_t optimalMoves;   // 求解器给出的最少步数
+        uint8_t gemCount;
+        uint16_t grade;         // 评级，越大越难，包内按此升序排列
+        uint32_t solverNodes;   // 证明最少步数时展开的节点数
+
+        std::array<int8_t, Board::kCells> types() const;
+        static LevelRecord fromTypes(const std::array<int8_t, Board::kCells>& types);
+    };
+    static_assert(sizeof(LevelRecord) == 40, "LevelRecord must stay 40 bytes");
+    static_assert(Board::kMaxDifficulty <= 15, "LevelRecord packs type + 1 into 4 bits");
+
+    // 在已映射的内存上建立索引，不复制数据；data 需在 LevelPack 使用期间保持有效
+    bool open(const uint8_t* data, size_t size);
+    bool isOpen() const { return records != nullptr; }
+
+    int levelCount(int difficulty) const;
+    // level 从 1 开始；没有该难度或超出关卡数时返回 nullptr
+    const LevelRecord* level(int difficulty, int level) const;
+
+    // 编译器使用：按难度分组的关卡（每组已按 grade 排好序）写成一个包
+    struct Group {
+        int difficulty = 0;
+        std::vector<LevelRecord> levels;
+    };
+    static std::vector<uint8_t> build(const std::vector<Group>& groups);
+    static bool writeFile(const std::string& path, const std::vector<Group>& groups);
+
+private:
+    struct TableEntry {
+        uint8_t difficulty;
+        uint8_t reserved[3];
+        uint32_t levelCount;
+        uint32_t firstRecord;
+    };
+    static_assert(sizeof(TableEntry) == 12, "TableEntry must stay 12 bytes");
+
+    static constexpr size_t kHeaderSize = 16;
+
+    const TableEntry* table = nullptr;
+    int tableCount = 0;
+    const LevelRecord* records = nullptr;
+    uint32_t totalLevels = 0;
+};
+
+#endif // LEVEL_PACK_H
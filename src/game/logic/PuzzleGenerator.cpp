@@ -0,0 +1,189 @@
+#include "PuzzleGenerator.h"
+#include <algorithm>
+
+PuzzleGenerator::PuzzleGenerator(int difficulty, GameRng& rng)
+    : difficulty(difficulty), rng(rng) {
+}
+
+int PuzzleGenerator::generate(int level) {
+    ConstChange = 0;
+    for(int i=0; i<8; i++) {
+        TempGemState[i] = "--------";
+        lenthT[i] = 0;
+    }
+    GemNumber = 0;
+    midX = midY = 0;
+
+    int MemberNum = std::max(5 , std::min(8,3*level));
+    bool SpecialComplete = false;
+    while(MemberNum) {
+        if(level >= 2 && !SpecialComplete) {//可能 生成一个残缺匹配，需要特殊宝石来消除
+            if(rng.bounded(2) == 20) {//暂时不写
+                GemNumber += 5;
+            } else {
+                generateSimpleMatch();
+            }
+            SpecialComplete = true;
+        } 
+        generateSimpleMatch();
+        MemberNum --;
+    }
+    // 每次 generateSimpleMatch 倒推一步消除，放入 3 颗宝石
+    return GemNumber / 3;
+}
+
+std::array<int8_t, Board::kCells> PuzzleGenerator::getTypes() const {
+    std::array<int8_t, Board::kCells> types;
+    for (int i = 0; i < 8; ++i) {
+        for (int j = 0; j < 8; ++j) {
+            char c = TempGemState[j][i];
+            types[(7 - i) * Board::kSize + j] = (c < '0' || c > '9') ? -1 : static_cast<int8_t>(c - '0');
+        }
+    }
+    return types;
+}
+
+bool PuzzleGenerator::checkConflict(int x,int y,int type) {
+    int dx[4] = {0,0,1,-1};
+    int dy[4] = {1,-1,0,0};
+    for(int i=0;i<4;i++) {
+        if(x+dx[i] >= 0&& x+dx[i] < 8&& y+dy[i] >= 0&& y+dy[i] < 8) {
+            if(TempGemState[x+dx[i]][y+dy[i]] == type + '0') return true;
+        }
+    }
+    return false;
+}
+
+void PuzzleGenerator::changeIndex(int a,int b,int c,int d,int e,int f) {
+    int type = rng.bounded(difficulty);
+    TempGemState[a][b] = TempGemState[c][d] = TempGemState[e][f] = '-';
+    //清空要放当前这一匹配的位置
+    while(checkConflict(a,b,type) ||
+        checkConflict(c,d,type) || checkConflict(e,f,type)) type = (type + 1)% 8;
+    TempGemState[a][b] = TempGemState[c][d] = TempGemState[e][f] = type + '0';
+}
+
+void PuzzleGenerator::checkLenthT() {
+    for(int i=0;i<8;i++) {
+        lenthT[i] = 0;
+        for(int j=0;j<8;j++) {
+            if(TempGemState[i][j] == '-') break;
+            lenthT[i] ++;
+        }
+    }
+}
+
+void PuzzleGenerator::generateSimpleMatch() {//Tem是 列 行 存储
+    bool CrossOrVertical = rng.bounded(2);
+    int StartPos = rng.bounded(6);
+    
+    if(ConstChange) {
+        if(lenthT[midX - 1] < 8&&lenthT[midX] < 8&&lenthT[midX + 1] < 8) {
+            for(int i=-1;i<=1;i++) {
+                for(int j = 7;j > midY;j--) 
+                    TempGemState[midX + i][j] = TempGemState[midX + i][j-1];
+            }
+            TempGemState[midX][midY+1] = TempGemState[midX][midY];
+            changeIndex( midX-1,midY , midX,midY+1 ,midX+1,midY);
+            GemNumber += 3;
+        } else if(lenthT[midX] <= 5) {
+            for(int i=1;i<=3;i++) {
+                for(int j = 7;j > midY + i;j --) 
+                    TempGemState[midX][j] = TempGemState[midX][j-1];
+            }
+            TempGemState[midX][midY + 1] = TempGemState[midX][midY];
+            changeIndex(midX,midY,midX,midY+2,midX,midY+3);
+            GemNumber += 3;
+        } else {
+            ConstChange = 0;
+            generateSimpleMatch();
+        }
+        ConstChange = 0;
+        midX = midY = 0;
+    } else if(CrossOrVertical || GemNumber == 0 || !CrossOrVertical) { // Cross
+        int VertBound = 10;
+        for(int i=0;i<3;i++) {
+            VertBound = std::min(VertBound , lenthT[StartPos + i]);
+        }
+
+        int Choice_01 = rng.bounded(4);
+        if(Choice_01 == 30 && VertBound >= 1) {//横着的上下交换，前提是当前三列都有宝石
+            Choice_01 = rng.bounded(3);
+            rng.bounded(difficulty);  // 未实现的分支，保留随机数取用顺序
+            
+        } else { 
+            VertBound = 10;
+            StartPos = rng.bounded(5);
+            for(int i=1;i<=7;i++) {
+                StartPos = (StartPos + 1) % 5 , VertBound = 10;
+                for(int i=0;i<=3;i++) {
+                    VertBound = std::min(VertBound , lenthT[StartPos + i]);
+                    if(lenthT[StartPos + i] == 8) {
+                        VertBound = 10;
+                        break;
+                    }
+                }
+                if(VertBound < 8) break;
+            }
+            VertBound = 0;
+            rng.bounded(difficulty);  // 类型由 changeIndex 决定，这里只保留原来的随机数取用顺序
+            
+            //中间两列的上移
+            for(int i = 7;i>VertBound;i--) 
+                TempGemState[StartPos+2][i] = TempGemState[StartPos+2][i-1] ,
+                TempGemState[StartPos+1][i] = TempGemState[StartPos+1][i-1];
+
+            if(StartPos >= 3) {//XXOX形式
+
+                //第一列上移
+                for(int i = 7;i>VertBound;i--) 
+                    TempGemState[StartPos][i] = TempGemState[StartPos][i-1];
+                
+                //第三列变成第四列的，交换当前这个后恢复原样
+                if(TempGemState[StartPos+2][VertBound] != '-' && TempGemState[StartPos+3][VertBound] == '-') {//这时交换会出现悬空，不正确
+                    if(VertBound > 0) {//与下面交换 减少开局出错概率
+                        TempGemState[StartPos+2][VertBound] = TempGemState[StartPos+2][VertBound-1];
+                        changeIndex(StartPos,VertBound,StartPos+1,VertBound,StartPos+2,VertBound-1);
+                    } else {
+                        // TempGemState[StartPos+2][VertBound] = TempGemState[StartPos+2][VertBound+1];
+                        changeIndex(StartPos,VertBound,StartPos+1,VertBound,StartPos+2,VertBound+1);
+                    }
+                    midX = StartPos + 1; midY = VertBound;
+                    ConstChange = 1;
+                } else {
+                    TempGemState[StartPos+2][VertBound] = TempGemState[StartPos+3][VertBound];
+
+                    changeIndex(StartPos,VertBound,StartPos+1,VertBound,StartPos+3,VertBound);
+                    //替换0 1 3
+                }
+
+            } else {//XOXX形式
+                for(int i = 7;i>VertBound;i--) 
+                     TempGemState[StartPos+3][i] = TempGemState[StartPos+3][i-1];
+
+                //第二列变成第一列的，交换当前这个后恢复原样
+                if(TempGemState[StartPos+1][VertBound] != '-' && TempGemState[StartPos][VertBound] == '-') {//这时交换会出现悬空，不正确
+                    if(VertBound > 0) {
+                        TempGemState[StartPos+1][VertBound] = TempGemState[StartPos+1][VertBound-1];
+                        changeIndex(StartPos+1,VertBound-1,StartPos+2,VertBound,StartPos+3,VertBound);
+                    } else {
+                        // TempGemState[StartPos+1][VertBound] = TempGemState[StartPos+1][VertBound+1];
+                        changeIndex(StartPos+1,VertBound+1,StartPos+2,VertBound,StartPos+3,VertBound);
+                    }
+                    midX = StartPos + 1; midY = VertBound;
+                    ConstChange = 1;
+                } else {
+                    TempGemState[StartPos+1][VertBound] = TempGemState[StartPos][VertBound];
+
+                    changeIndex(StartPos,VertBound,StartPos+2,VertBound,StartPos+3,VertBound);
+                    //替换0 2 3
+                }
+            }
+
+        }
+        GemNumber += 3;
+    } else { // Vertical
+        
+    }
+    checkLenthT();
+}
@@ -0,0 +1,46 @@
+#ifndef PUZZLE_GENERATOR_H
+#define PUZZLE_GENERATOR_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include "Board.h"
+#include "GameRng.h"
+
+/**
+ * PuzzleGenerator - 解谜关卡的倒推生成器
+ *
+ * 从空棋盘开始，每一步把一组"交换一次即可消除"的三颗宝石插入到列中（其余宝石上移），
+ * 倒推若干步得到题目。原来写在 PuzzleModeGameWidget 中，移到这里后界面的运行时生成
+ * 和离线关卡包编译器（tools/levelpack）共用同一份代码。
+ *
+ * 生成结果不保证有解（偶尔会留下悬空宝石），需要用 PuzzleSolver 验证。
+ */
+class PuzzleGenerator {
+public:
+    PuzzleGenerator(int difficulty, GameRng& rng);
+
+    // 生成第 level 关，返回倒推的步数（即题目设计的步数上限）
+    int generate(int level);
+
+    // 行优先的 64 格类型，-1 为空位
+    std::array<int8_t, Board::kCells> getTypes() const;
+    int getGemCount() const { return GemNumber; }
+
+private:
+    void generateSimpleMatch();
+    bool checkConflict(int x,int y,int type);
+    void changeIndex(int a,int b,int c,int d,int e,int f);
+    void checkLenthT();
+
+    int difficulty;
+    GameRng& rng;
+
+    int GemNumber = 0;
+    std::string TempGemState[8];  // 按 列 / 自底向上 存储，'-' 为空位
+    int lenthT[8] = {};
+    bool ConstChange = 0;
+    int midX = 0, midY = 0;
+};
+
+#endif // PUZZLE_GENERATOR_H
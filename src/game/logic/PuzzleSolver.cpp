@@ -0,0 +1,99 @@
+#include "PuzzleSolver.h"
+#include <algorithm>
+
+PuzzleSolver::PuzzleSolver(long long nodeLimit)
+    : nodeLimit(nodeLimit), rng(0) {
+}
+
+size_t PuzzleSolver::KeyHash::operator()(const Key& key) const {
+    uint64_t hash = 0x9E3779B97F4A7C15ull;
+    for (uint64_t word : key.words) {
+        hash ^= word + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+        hash *= 0xBF58476D1CE4E5B9ull;
+    }
+    return (size_t)(hash ^ (hash >> 31));
+}
+
+PuzzleSolver::Key PuzzleSolver::pack(const Board& board) {
+    Key key;
+    for (int i = 0; i < Board::kCells; ++i) {
+        const Board::Cell& cell = board.at(i / Board::kSize, i % Board::kSize);
+        if (cell.empty()) continue;
+        uint64_t value = (uint64_t)(cell.type + 1) | (cell.special ? 0x10u : 0u);
+        int bit = i * 5;
+        key.words[bit / 64] |= value << (bit % 64);
+        if (bit % 64 > 59) key.words[bit / 64 + 1] |= value >> (64 - bit % 64);
+    }
+    return key;
+}
+
+bool PuzzleSolver::hopeless(const Board& board) {
+    int counts[16] = {};
+    for (int i = 0; i < Board::kCells; ++i) {
+        const Board::Cell& cell = board.at(i / Board::kSize, i % Board::kSize);
+        if (cell.empty()) continue;
+        if (cell.special) return false;
+        if (cell.type < 16) ++counts[cell.type];
+    }
+    // 4 连以上会生成特殊宝石，之后的 3x3 爆炸能带走落单的宝石，这时不能剪枝
+    bool stranded = false;
+    for (int count : counts) {
+        if (count >= 4) return false;
+        if (count == 1 || count == 2) stranded = true;
+    }
+    return stranded;
+}
+
+bool PuzzleSolver::search(const Board& board, int depth, std::vector<Board::Move>& path) {
+    if (board.getRemainingGems() == 0) return true;
+    if (depth == 0 || hopeless(board)) return false;
+    if (++nodes > nodeLimit) {
+        aborted = true;
+        return false;
+    }
+
+    Key key = pack(board);
+    auto it = failedDepth.find(key);
+    if (it != failedDepth.end() && it->second >= depth) return false;
+
+    Board::MoveList moves;
+    int count = board.findSwapMoves(moves);
+    for (int i = 0; i < count && !aborted; ++i) {
+        const Board::Move& move = moves[i];
+        Board next = board;
+        if (!next.swap(move.row1, move.col1, move.row2, move.col2, rng)) continue;
+        path.push_back(move);
+        if (search(next, depth - 1, path)) return true;
+        path.pop_back();
+    }
+
+    if (!aborted) {
+        int& failed = failedDepth[key];
+        failed = std::max(failed, depth);
+    }
+    return false;
+}
+
+PuzzleSolver::Result PuzzleSolver::solve(const std::array<int8_t, Board::kCells>& types, int difficulty, int moveBudget) {
+    nodes = 0;
+    aborted = false;
+    failedDepth.clear();
+
+    Board board(BoardMode::Puzzle, difficulty);
+    board.setUndoEnabled(false);
+    board.loadTypes(types);
+
+    Result result;
+    std::vector<Board::Move> path;
+    for (int depth = 0; depth <= moveBudget && !aborted; ++depth) {
+        if (search(board, depth, path)) {
+            result.status = Status::Solved;
+            result.moves = depth;
+            result.solution = path;
+            break;
+        }
+    }
+    if (result.status != Status::Solved && aborted) result.status = Status::NodeLimit;
+    result.nodes = nodes;
+    return result;
+}
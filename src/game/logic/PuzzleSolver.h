@@ -0,0 +1,65 @@
+#ifndef PUZZLE_SOLVER_H
+#define PUZZLE_SOLVER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Board.h"
+
+/**
+ * PuzzleSolver - 解谜关卡的求解器 / 验证器
+ *
+ * 直接用 Board 的解谜规则（交换、下落、4 连特殊宝石、3x3 爆炸）做迭代加深搜索，
+ * 置换表以打包后的 64 格状态为键，记录该状态已被证明"剩余 k 步内清不完"的最大 k，
+ * 不同顺序走到同一局面时不会重复搜索。深度从 1 开始递增，第一次找到的解就是最少步数。
+ *
+ * 节点数有上限，保证能在每关载入前同步调用；超过上限视为无法证明可解。
+ */
+class PuzzleSolver {
+public:
+    enum class Status {
+        Solved,      // 在步数预算内可以清空棋盘
+        Unsolvable,  // 已证明预算内无解
+        NodeLimit    // 搜索超过节点上限，结果未知
+    };
+
+    struct Result {
+        Status status = Status::Unsolvable;
+        int moves = 0;                          // 最少步数，仅 Solved 时有效
+        std::vector<Board::Move> solution;      // 一组最优解
+        long long nodes = 0;                    // 展开的节点数
+    };
+
+    static constexpr long long kDefaultNodeLimit = 200000;
+
+    explicit PuzzleSolver(long long nodeLimit = kDefaultNodeLimit);
+
+    // types 为行优先的 64 格类型（-1 为空位），moveBudget 为允许的最多步数
+    Result solve(const std::array<int8_t, Board::kCells>& types, int difficulty, int moveBudget);
+
+private:
+    // 每格 5 位：0 为空位，1-16 为类型 + 1，第 5 位为特殊宝石
+    struct Key {
+        std::array<uint64_t, 5> words{};
+        bool operator==(const Key& other) const { return words == other.words; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    static Key pack(const Board& board);
+    // 某种颜色只剩 1-2 颗、棋盘上没有特殊宝石、也没有哪种颜色还剩 4 颗以上（无法再造出特殊宝石）时，
+    // 这一颜色永远消不掉
+    static bool hopeless(const Board& board);
+    bool search(const Board& board, int depth, std::vector<Board::Move>& path);
+
+    long long nodeLimit;
+    long long nodes = 0;
+    bool aborted = false;
+    GameRng rng;  // 解谜模式不补充宝石，只是满足 Board 接口
+    std::unordered_map<Key, int, KeyHash> failedDepth;
+};
+
+#endif // PUZZLE_SOLVER_H
@@ -0,0 +1,207 @@
+#include "Replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+constexpr char kMagic[4] = {'B', 'J', 'R', 'P'};
+constexpr uint8_t kFlagInitialBoard = 0x01;
+
+void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+// 简单的游标读取器，越界后 ok 置为 false，之后的读取都返回 0
+struct Reader {
+    const std::vector<uint8_t>& data;
+    size_t pos = 0;
+    bool ok = true;
+
+    uint8_t u8() {
+        if (pos >= data.size()) { ok = false; return 0; }
+        return data[pos++];
+    }
+    uint64_t fixed(int bytes) {
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) value |= (uint64_t)u8() << (8 * i);
+        return value;
+    }
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = u8();
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+};
+
+int positionBytes(ReplayAction::Kind kind) {
+    switch (kind) {
+        case ReplayAction::Swap: return 2;
+        case ReplayAction::Rotate:
+        case ReplayAction::Hammer: return 1;
+        default: return 0;
+    }
+}
+}
+
+std::vector<uint8_t> Replay::encode() const {
+    std::vector<uint8_t> out;
+    out.reserve(32 + (hasInitialBoard ? Board::kCells : 0) + actions.size() * 4);
+
+    for (char c : kMagic) out.push_back((uint8_t)c);
+    out.push_back(kVersion);
+    out.push_back((uint8_t)mode);
+    out.push_back((uint8_t)difficulty);
+    out.push_back(hasInitialBoard ? kFlagInitialBoard : 0);
+    for (int i = 0; i < 8; ++i) out.push_back((uint8_t)(seed >> (8 * i)));
+    out.push_back((uint8_t)(level & 0xFF));
+    out.push_back((uint8_t)((level >> 8) & 0xFF));
+    if (hasInitialBoard) {
+        for (int8_t type : initialBoard) out.push_back((uint8_t)type);
+    }
+
+    writeVarint(out, actions.size());
+    uint32_t lastTime = 0;
+    for (const ReplayAction& action : actions) {
+        // 时间戳单调递增，存差值，通常 1~2 字节
+        uint32_t time = std::max(action.timeMs, lastTime);
+        writeVarint(out, time - lastTime);
+        lastTime = time;
+        out.push_back(action.kind);
+        int bytes = positionBytes(action.kind);
+        if (bytes >= 1) out.push_back((uint8_t)(action.row1 * Board::kSize + action.col1));
+        if (bytes >= 2) out.push_back((uint8_t)(action.row2 * Board::kSize + action.col2));
+    }
+
+    writeVarint(out, (uint64_t)std::max(0, finalScore));
+    writeVarint(out, (uint64_t)std::max(0, finalCoins));
+    return out;
+}
+
+bool Replay::decode(const std::vector<uint8_t>& data) {
+    Reader in{data};
+    for (char c : kMagic) {
+        if (in.u8() != (uint8_t)c) return false;
+    }
+    if (in.u8() != kVersion) return false;
+
+    uint8_t modeValue = in.u8();
+    if (modeValue < (uint8_t)BoardMode::Classic || modeValue > (uint8_t)BoardMode::Multiplayer) return false;
+    mode = (BoardMode)modeValue;
+    difficulty = in.u8();
+    // 损坏或伪造的文件：难度超出棋盘支持的范围直接拒绝
+    if (difficulty < Board::kMinDifficulty || difficulty > Board::kMaxDifficulty) return false;
+    uint8_t flags = in.u8();
+    seed = in.fixed(8);
+    level = (int)in.fixed(2);
+
+    hasInitialBoard = (flags & kFlagInitialBoard) != 0;
+    if (hasInitialBoard) {
+        for (int8_t& type : initialBoard) type = (int8_t)in.u8();
+    }
+
+    uint64_t count = in.varint();
+    // 每条操作至少 2 字节，防止损坏文件导致巨量分配
+    if (!in.ok || count > data.size()) return false;
+    actions.clear();
+    actions.reserve((size_t)count);
+
+    uint32_t time = 0;
+    for (uint64_t i = 0; i < count && in.ok; ++i) {
+        ReplayAction action;
+        time += (uint32_t)in.varint();
+        action.timeMs = time;
+        action.kind = (ReplayAction::Kind)in.u8();
+        if (action.kind < ReplayAction::Swap || action.kind > ReplayAction::Reshuffle) return false;
+        int bytes = positionBytes(action.kind);
+        if (bytes >= 1) {
+            uint8_t p = in.u8();
+            action.row1 = p / Board::kSize;
+            action.col1 = p % Board::kSize;
+        }
+        if (bytes >= 2) {
+            uint8_t p = in.u8();
+            action.row2 = p / Board::kSize;
+            action.col2 = p % Board::kSize;
+        }
+        actions.push_back(action);
+    }
+
+    finalScore = (int)in.varint();
+    finalCoins = (int)in.varint();
+    return in.ok;
+}
+
+bool Replay::saveToFile(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    std::vector<uint8_t> data = encode();
+    out.write(reinterpret_cast<const char*>(data.data()), (std::streamsize)data.size());
+    return (bool)out;
+}
+
+bool Replay::loadFromFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return decode(data);
+}
+
+bool applyReplayAction(Board& board, GameRng& rng, const ReplayAction& action) {
+    switch (action.kind) {
+        case ReplayAction::Swap:
+            return board.swap(action.row1, action.col1, action.row2, action.col2, rng);
+        case ReplayAction::Rotate:
+            return board.rotate(action.row1, action.col1, rng);
+        case ReplayAction::Hammer:
+            return board.hammer(action.row1, action.col1, rng);
+        case ReplayAction::FreezeTime:
+            return true;
+        case ReplayAction::ResetBoard:
+            return board.resetBoard(rng);
+        case ReplayAction::ClearAll:
+            return board.clearAll(rng);
+        case ReplayAction::Undo:
+            return board.undo();
+        case ReplayAction::Reshuffle:
+            // 连锁后的死局 Board 已经自动重排，这里通常什么都不用做
+            board.reshuffle(rng);
+            return true;
+    }
+    return false;
+}
+
+ReplayOutcome runReplayHeadless(const Replay& replay) {
+    GameRng rng(replay.seed);
+    Board board(replay.mode, replay.difficulty);
+    if (replay.hasInitialBoard) {
+        board.loadTypes(replay.initialBoard);
+    } else {
+        board.generate(rng);
+    }
+
+    ReplayOutcome outcome;
+    for (const ReplayAction& action : replay.actions) {
+        if (board.isFinished()) break;
+        if (applyReplayAction(board, rng, action)) {
+            ++outcome.appliedActions;
+        } else {
+            ++outcome.skippedActions;
+        }
+    }
+
+    outcome.score = board.getScore();
+    outcome.coins = board.getEarnedCoins();
+    outcome.finished = board.isFinished();
+    outcome.stats = board.getStats();
+    outcome.matchesRecording = outcome.score == replay.finalScore && outcome.coins == replay.finalCoins;
+    return outcome;
+}
@@ -0,0 +1,80 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+// 录像中的一条玩家操作
+struct ReplayAction {
+    enum Kind : uint8_t {
+        Swap = 1,        // 交换 (row1,col1) 与 (row2,col2)
+        Rotate = 2,      // 旋风模式以 (row1,col1) 为左上角顺时针旋转
+        Hammer = 3,      // 锤子敲掉 (row1,col1)
+        FreezeTime = 4,  // 道具：冻结时间（不影响棋盘）
+        ResetBoard = 5,  // 道具：重置棋盘
+        ClearAll = 6,    // 道具：清空棋盘
+        Undo = 7,        // 解谜模式撤销
+        Reshuffle = 8    // 无可走步时系统重排棋盘
+    };
+
+    uint32_t timeMs = 0;  // 距本局开始的毫秒数
+    Kind kind = Swap;
+    uint8_t row1 = 0, col1 = 0, row2 = 0, col2 = 0;
+};
+
+/**
+ * Replay - 一局游戏的录像
+ *
+ * 只记录种子、模式、难度和带时间戳的玩家操作，棋盘变化全部由 GameRng + Board 重新推演，
+ * 一局下来通常只有几百字节到几 KB。解谜模式的题目不由 Board 生成，额外保存初始棋盘。
+ *
+ * 二进制格式（小端）：
+ *   "BJRP" | version u8 | mode u8 | difficulty u8 | flags u8 | seed u64 | level u16
+ *   [flags & HasInitialBoard] 64 x i8
+ *   actionCount varint | 每条: deltaMs varint, kind u8, 按类型 0~2 字节位置 (row*8+col)
+ *   finalScore varint | finalCoins varint
+ */
+class Replay {
+public:
+    static constexpr uint8_t kVersion = 1;
+
+    BoardMode mode = BoardMode::Classic;
+    int difficulty = 4;
+    uint64_t seed = 0;
+    int level = 1;
+    bool hasInitialBoard = false;
+    std::array<int8_t, Board::kCells> initialBoard{};
+    std::vector<ReplayAction> actions;
+
+    // 录制结束时的结果，回放后用来校验是否一致
+    int finalScore = 0;
+    int finalCoins = 0;
+
+    std::vector<uint8_t> encode() const;
+    bool decode(const std::vector<uint8_t>& data);
+
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+};
+
+// 无界面回放的结果
+struct ReplayOutcome {
+    int score = 0;
+    int coins = 0;
+    int appliedActions = 0;
+    int skippedActions = 0;  // 没有生效的操作（无匹配被换回的交换、越界的位置等）
+    bool finished = false;
+    bool matchesRecording = false;
+    Board::Stats stats;
+};
+
+// 以最快速度在 Board 上重放录像，不依赖 Qt
+ReplayOutcome runReplayHeadless(const Replay& replay);
+
+// 把一条操作应用到棋盘，返回是否生效
+bool applyReplayAction(Board& board, GameRng& rng, const ReplayAction& action);
+
+#endif // REPLAY_H
@@ -0,0 +1,135 @@
+#include "RotationFinder.h"
+#include <algorithm>
+
+namespace {
+
+constexpr uint64_t kNotColA = 0xFEFEFEFEFEFEFEFEull;  // 去掉第 0 列
+constexpr uint64_t kNotColH = 0x7F7F7F7F7F7F7F7Full;  // 去掉第 7 列
+constexpr uint64_t kLowCols = 0x3F3F3F3F3F3F3F3Full;  // 第 0-5 列，横向三连的起点
+
+inline uint64_t bit(int index) { return 1ull << index; }
+
+// b 中所有横向三连覆盖的格子
+inline uint64_t horizontalRuns(uint64_t b) {
+    uint64_t start = b & (b >> 1) & (b >> 2) & kLowCols;
+    return start | (start << 1) | (start << 2);
+}
+
+// b 中所有纵向三连覆盖的格子
+inline uint64_t verticalRuns(uint64_t b) {
+    uint64_t start = b & (b >> 8) & (b >> 16);
+    return start | (start << 8) | (start << 16);
+}
+
+// 从 seed 出发，在 runs 内沿一个方向扩展（最多 7 步就能走完一整行 / 列）
+inline uint64_t floodRow(uint64_t seed, uint64_t runs) {
+    for (int i = 0; i < 7; ++i) {
+        uint64_t next = seed | ((((seed << 1) & kNotColA) | ((seed >> 1) & kNotColH)) & runs);
+        if (next == seed) break;
+        seed = next;
+    }
+    return seed;
+}
+
+inline uint64_t floodColumn(uint64_t seed, uint64_t runs) {
+    for (int i = 0; i < 7; ++i) {
+        uint64_t next = seed | (((seed << 8) | (seed >> 8)) & runs);
+        if (next == seed) break;
+        seed = next;
+    }
+    return seed;
+}
+
+// 特殊宝石被消除时引爆的 3x3 范围
+inline uint64_t area3x3(int index) {
+    uint64_t b = bit(index);
+    uint64_t row = b | ((b << 1) & kNotColA) | ((b >> 1) & kNotColH);
+    return row | (row << 8) | (row >> 8);
+}
+
+}  // namespace
+
+RotationFinder::RotationFinder(const std::array<int8_t, kCells>& types, uint64_t specialMask)
+    : types(types) {
+    for (int i = 0; i < kCells; ++i) {
+        int type = types[i];
+        if (type < 0 || type >= kMaxTypes) continue;
+        bits[type] |= bit(i);
+        occupied |= bit(i);
+    }
+    special = specialMask & occupied;
+}
+
+int RotationFinder::evaluate(int row, int col, Direction direction) const {
+    if (row < 0 || row >= kSize - 1 || col < 0 || col >= kSize - 1) return 0;
+    int tl = row * kSize + col;
+    int tr = tl + 1;
+    int bl = tl + kSize;
+    int br = bl + 1;
+    uint64_t square = bit(tl) | bit(tr) | bit(bl) | bit(br);
+    if ((occupied & square) != square) return 0;
+
+    // 旋转后每个格子的新类型
+    int cell[4] = {tl, tr, br, bl};
+    int moved[4];
+    for (int i = 0; i < 4; ++i) {
+        int from = direction == Direction::Clockwise ? cell[(i + 3) % 4] : cell[(i + 1) % 4];
+        moved[i] = types[from];
+    }
+
+    uint64_t cleared = 0;
+    for (int i = 0; i < 4; ++i) {
+        int type = moved[i];
+        bool seen = false;
+        for (int j = 0; j < i; ++j) seen |= moved[j] == type;
+        if (seen) continue;
+
+        uint64_t b = bits[type] & ~square;
+        for (int j = 0; j < 4; ++j) {
+            if (moved[j] == type) b |= bit(cell[j]);
+        }
+        uint64_t seed = b & square;
+        cleared |= floodRow(seed & horizontalRuns(b), horizontalRuns(b));
+        cleared |= floodColumn(seed & verticalRuns(b), verticalRuns(b));
+    }
+    if (!cleared) return 0;
+
+    // 特殊宝石随旋转移动：被消除的格子里如果有特殊宝石，加上它引爆的范围
+    uint64_t specialAfter = special & ~square;
+    for (int i = 0; i < 4; ++i) {
+        int from = direction == Direction::Clockwise ? cell[(i + 3) % 4] : cell[(i + 1) % 4];
+        if (special & bit(from)) specialAfter |= bit(cell[i]);
+    }
+    uint64_t blast = 0;
+    for (uint64_t s = specialAfter & cleared; s; s &= s - 1) {
+        blast |= area3x3(__builtin_ctzll(s));
+    }
+    return __builtin_popcountll((cleared | blast) & occupied);
+}
+
+int RotationFinder::findMoves(MoveList& out, Direction direction) const {
+    int count = 0;
+    for (int row = 0; row < kSize - 1; ++row) {
+        for (int col = 0; col < kSize - 1; ++col) {
+            int score = evaluate(row, col, direction);
+            if (score > 0) out[count++] = {(int8_t)row, (int8_t)col, (int8_t)score};
+        }
+    }
+    return count;
+}
+
+int RotationFinder::findRankedMoves(MoveList& out, Direction direction) const {
+    int count = findMoves(out, direction);
+    std::stable_sort(out.begin(), out.begin() + count,
+                     [](const Move& a, const Move& b) { return a.clearCount > b.clearCount; });
+    return count;
+}
+
+bool RotationFinder::hasMove(Direction direction) const {
+    for (int row = 0; row < kSize - 1; ++row) {
+        for (int col = 0; col < kSize - 1; ++col) {
+            if (evaluate(row, col, direction) > 0) return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,55 @@
+#ifndef ROTATION_FINDER_H
+#define ROTATION_FINDER_H
+
+#include <array>
+#include <cstdint>
+
+/**
+ * RotationFinder - 旋风模式的 2x2 旋转着法评估
+ *
+ * 按宝石类型建立 64 位位棋盘（第 row * 8 + col 位），评估一个旋转只需改动方框的 4 位，
+ * 用移位与运算找出横竖三连，再从方框内的格子沿行 / 列扩展出被消除的整段。
+ * 49 个位置全部评估一遍只有几微秒，每次连锁结束都可以重新计算提示和死局。
+ *
+ * 与 Board::rotateCreatesMatch 的判定一致：只统计经过方框内格子的三连，
+ * 稳定棋盘（没有现成三连）上的消除数就是旋转后第一轮实际消除的宝石数。
+ */
+class RotationFinder {
+public:
+    static constexpr int kSize = 8;
+    static constexpr int kCells = kSize * kSize;
+    static constexpr int kMaxTypes = 8;  // 不小于 Board::kMaxDifficulty，Board.cpp 中有 static_assert
+    static constexpr int kPositions = (kSize - 1) * (kSize - 1);
+
+    enum class Direction {
+        Clockwise,         // 界面和 Board 使用的方向：左下 -> 左上 -> 右上 -> 右下
+        CounterClockwise
+    };
+
+    struct Move {
+        int8_t row;         // 方框左上角
+        int8_t col;
+        int8_t clearCount;  // 评分：第一轮消除的宝石数，特殊宝石按 3x3 范围另加
+    };
+    using MoveList = std::array<Move, kPositions>;
+
+    // types 为行优先的 64 格类型，-1 为空位；specialMask 标记特殊宝石所在的格子
+    explicit RotationFinder(const std::array<int8_t, kCells>& types, uint64_t specialMask = 0);
+
+    // 旋转 (row, col) 为左上角的方框后能消除的评分，不能形成三连时返回 0
+    int evaluate(int row, int col, Direction direction = Direction::Clockwise) const;
+    // 按行优先顺序列出所有能形成三连的旋转，返回个数
+    int findMoves(MoveList& out, Direction direction = Direction::Clockwise) const;
+    // 同上，按评分从高到低排序（同分保持行优先顺序）
+    int findRankedMoves(MoveList& out, Direction direction = Direction::Clockwise) const;
+    // 是否存在能形成三连的旋转，找到第一个就返回
+    bool hasMove(Direction direction = Direction::Clockwise) const;
+
+private:
+    std::array<uint64_t, kMaxTypes> bits{};
+    uint64_t occupied = 0;
+    uint64_t special = 0;
+    std::array<int8_t, kCells> types;
+};
+
+#endif // ROTATION_FINDER_H
@@ -0,0 +1,32 @@
+#include "UndoRing.h"
+
+UndoRing::Snapshot UndoRing::pack(const Types& types) {
+    Snapshot snapshot{};
+    for (int i = 0; i < kCells; ++i) {
+        uint8_t nibble = types[i] < 0 ? 0 : static_cast<uint8_t>(types[i] + 1);
+        snapshot[i >> 1] |= static_cast<uint8_t>(nibble << ((i & 1) * 4));
+    }
+    return snapshot;
+}
+
+UndoRing::Types UndoRing::unpack(const Snapshot& snapshot) {
+    Types types;
+    for (int i = 0; i < kCells; ++i) {
+        types[i] = static_cast<int8_t>(cellType(snapshot, i));
+    }
+    return types;
+}
+
+void UndoRing::push(const Types& types) {
+    if (slots.empty()) slots.resize(kCapacity);
+    slots[head] = pack(types);
+    head = (head + 1) % kCapacity;
+    if (count < kCapacity) ++count;
+}
+
+bool UndoRing::pop() {
+    if (count <= 1) return false;
+    head = (head + kCapacity - 1) % kCapacity;
+    --count;
+    return true;
+}
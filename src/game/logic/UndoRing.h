@@ -0,0 +1,47 @@
+#ifndef UNDO_RING_H
+#define UNDO_RING_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * UndoRing - 解谜模式的撤销记录
+ *
+ * 每个快照只保存宝石类型，每格 4 位打包成 32 字节（0 为空位，否则为类型 + 1，
+ * 最多容纳 15 种宝石；Board::kMaxDifficulty 用 static_assert 与 kMaxTypes 绑定）。快照存放在预分配的环形缓冲区里，
+ * 写满后覆盖最旧的一条，长时间游玩内存也不会增长。缓冲区在第一次 push 时一次分配，
+ * 求解器复制大量关闭了撤销的 Board 时不用复制它。
+ *
+ * 界面和 Board 使用同一个类，撤销深度一致，录像回放的结果才能对上。
+ */
+class UndoRing {
+public:
+    static constexpr int kCells = 64;
+    static constexpr int kCapacity = 128;
+    static constexpr int kMaxTypes = 15;  // 4 位里 0 留给空位
+    using Snapshot = std::array<uint8_t, kCells / 2>;
+    using Types = std::array<int8_t, kCells>;
+
+    static Snapshot pack(const Types& types);
+    static Types unpack(const Snapshot& snapshot);
+    // 取单格类型，-1 为空位
+    static int cellType(const Snapshot& snapshot, int index) {
+        int nibble = (snapshot[index >> 1] >> ((index & 1) * 4)) & 0x0F;
+        return nibble - 1;
+    }
+
+    void clear() { count = 0; }
+    void push(const Types& types);
+    // 丢弃最新的快照，只剩一条（开局状态或最旧的可用状态）时返回 false
+    bool pop();
+    const Snapshot& top() const { return slots[(head + kCapacity - 1) % kCapacity]; }
+    int size() const { return count; }
+
+private:
+    std::vector<Snapshot> slots;
+    int head = 0;   // 下一次写入的位置
+    int count = 0;
+};
+
+#endif // UNDO_RING_H
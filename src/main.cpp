@@ -1,8 +1,11 @@
 #include "Auth/AuthWindow.h"
 #include <QApplication>
 #include <QTimer>
+#include <cstring>
 #include <iostream>
 #include "utils/ResourceUtils.h"
+#include "utils/BootProfiler.h"
+#include "game/logic/Replay.h"
 #include "Game/GameWindow.h"
 #include "Game/gameWidgets/SingleModeGameWidget.h"
 #include "game/TestWindow.h"
@@ -14,16 +17,72 @@ extern "C" {
 }
 
 #pragma comment(lib, "ws2_32")
+
+// 取命令行参数 name 后面的值，没有时返回 nullptr
+static const char* argValue(int argc, char* argv[], const char* name) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], name) == 0) return argv[i + 1];
+    }
+    return nullptr;
+}
+
+// --replay-headless <文件>：不创建界面，在 Board 上以最快速度重放并校验分数
+static int runHeadlessReplay(const char* path) {
+    Replay replay;
+    if (!replay.loadFromFile(path)) {
+        std::cerr << "Invalid replay file: " << path << std::endl;
+        return 2;
+    }
+    ReplayOutcome outcome = runReplayHeadless(replay);
+    std::cout << "actions: " << replay.actions.size()
+              << " (applied " << outcome.appliedActions << ", skipped " << outcome.skippedActions << ")\n"
+              << "score: " << outcome.score << " / recorded " << replay.finalScore << "\n"
+              << "coins: " << outcome.coins << " / recorded " << replay.finalCoins << "\n"
+              << "cascades: " << outcome.stats.cascades << ", steps: " << outcome.stats.cascadeSteps
+              << ", removed: " << outcome.stats.removedGems << "\n"
+              << (outcome.matchesRecording ? "OK" : "MISMATCH") << std::endl;
+    return outcome.matchesRecording ? 0 : 1;
+}
+
 int main(int argc, char *argv[])
 {
+    if (const char* path = argValue(argc, argv, "--replay-headless")) {
+        return runHeadlessReplay(path);
+    }
+
+    // 启动打点：BEJEWELED_TRACE=<文件> 或 --boot-profile 时启用
+    BootProfiler& profiler = BootProfiler::instance();
+    profiler.initialize(argc, argv);
+
+    int64_t appStart = profiler.nowUs();
     QApplication a(argc, argv);
+    profiler.addSpan("main/QApplication", appStart, profiler.nowUs() - appStart);
+    QObject::connect(&a, &QCoreApplication::aboutToQuit, []() {
+        BootProfiler::instance().writeTrace();
+    });
 
     // Verify resource path
     std::cout << "Current Resource Path: " << ResourceUtils::getResourcesDir() << std::endl;
 
     // 启动登录注册窗口
     AuthWindow w;
-    w.show();
+    const char* replayPath = argValue(argc, argv, "--replay");
+    if (replayPath) {
+        // 回放模式：以离线身份进入主界面并直接播放录像，--replay-speed 可选 1x / ff / max
+        const char* speedText = argValue(argc, argv, "--replay-speed");
+        ReplayPlayer::Speed speed = ReplayPlayer::parseSpeed(speedText ? speedText : "1x");
+        GameWindow* gameWindow = new GameWindow(nullptr, "$#SINGLE#$");
+        gameWindow->show();
+        if (!gameWindow->startReplay(QString::fromLocal8Bit(replayPath), speed)) {
+            std::cerr << "Failed to start replay: " << replayPath << std::endl;
+        }
+    } else if (profiler.isBootProfileMode()) {
+        // 启动剖析模式：跳过登录，以离线身份直接进入主界面，菜单第一帧绘制后自动退出
+        GameWindow* gameWindow = new GameWindow(nullptr, "$#SINGLE#$");
+        gameWindow->show();
+    } else {
+        w.show();
+    }
 
     //测试用
     // int randNum = QRandomGenerator::global()->bounded(1000000); //随机ID
@@ -0,0 +1,193 @@
+#include "MeshBinary.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr char kMagic[4] = {'G', 'M', 'S', 'H'};
+
+size_t align4(size_t value) {
+    return (value + 3) & ~size_t(3);
+}
+
+template <typename T>
+void put(std::vector<uint8_t>& out, size_t offset, T value) {
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+template <typename T>
+T get(const uint8_t* data, size_t offset) {
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+bool fail(std::string* error, const char* message) {
+    if (error) *error = message;
+    return false;
+}
+
+} // namespace
+
+namespace MeshBinary {
+
+std::vector<uint8_t> bake(MeshData& mesh, const BakeOptions& options, BakeReport* report) {
+    const int vertexCountBefore = mesh.vertexCount();
+    if (report) report->acmrBefore = MeshOptimizer::averageCacheMissRatio(mesh.indices, vertexCountBefore);
+    if (options.optimize) {
+        MeshOptimizer::optimizeVertexCache(mesh.indices, vertexCountBefore);
+        MeshOptimizer::optimizeVertexFetch(mesh);
+    }
+    const uint32_t vertexCount = (uint32_t)mesh.vertexCount();
+    if (report) report->acmrAfter = MeshOptimizer::averageCacheMissRatio(mesh.indices, (int)vertexCount);
+
+    // LOD 1 起每级格子数减半
+    float maxExtent = 0.0f;
+    for (int k = 0; k < 3; ++k) maxExtent = std::max(maxExtent, mesh.boundsMax[k] - mesh.boundsMin[k]);
+    std::vector<std::vector<uint32_t>> lods;
+    std::vector<float> cellSizes;
+    lods.push_back(mesh.indices);
+    cellSizes.push_back(0.0f);
+    for (int lod = 1; lod < std::max(options.lodCount, 1); ++lod) {
+        int gridSize = std::max(32 >> (lod - 1), 4);
+        std::vector<uint32_t> indices = MeshOptimizer::simplifyClustered(mesh, gridSize);
+        if (indices.empty()) break;
+        if (options.optimize) MeshOptimizer::optimizeVertexCache(indices, (int)vertexCount);
+        lods.push_back(std::move(indices));
+        cellSizes.push_back(maxExtent / (float)gridSize);
+    }
+    if (report) {
+        report->lodTriangles.clear();
+        for (const auto& indices : lods) report->lodTriangles.push_back((uint32_t)(indices.size() / 3));
+    }
+
+    const bool index32 = vertexCount > 0xFFFF;
+    const size_t indexSize = index32 ? 4 : 2;
+    const size_t lodTableOffset = kHeaderSize;
+    const size_t positionOffset = lodTableOffset + lods.size() * kLodEntrySize;
+    const size_t normalOffset = positionOffset + vertexCount * kPositionStride;
+    size_t indexOffset = align4(normalOffset + vertexCount * kNormalStride);
+    std::vector<size_t> lodOffsets;
+    for (const auto& indices : lods) {
+        lodOffsets.push_back(indexOffset);
+        indexOffset = align4(indexOffset + indices.size() * indexSize);
+    }
+
+    std::vector<uint8_t> out(indexOffset, 0);
+    std::memcpy(out.data(), kMagic, sizeof(kMagic));
+    put<uint16_t>(out, 4, kVersion);
+    put<uint16_t>(out, 6, index32 ? kFlagIndex32 : 0);
+    put<uint32_t>(out, 8, vertexCount);
+    put<uint32_t>(out, 12, (uint32_t)lods.size());
+    put<uint32_t>(out, 16, (uint32_t)positionOffset);
+    put<uint32_t>(out, 20, (uint32_t)normalOffset);
+    put<uint32_t>(out, 24, (uint32_t)lodTableOffset);
+    for (int k = 0; k < 3; ++k) {
+        put<float>(out, 28 + k * 4, mesh.boundsMin[k]);
+        put<float>(out, 40 + k * 4, mesh.boundsMax[k]);
+    }
+
+    for (size_t lod = 0; lod < lods.size(); ++lod) {
+        size_t entry = lodTableOffset + lod * kLodEntrySize;
+        put<uint32_t>(out, entry, (uint32_t)lodOffsets[lod]);
+        put<uint32_t>(out, entry + 4, (uint32_t)lods[lod].size());
+        put<float>(out, entry + 8, cellSizes[lod]);
+    }
+
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        const float* src = &mesh.vertices[(size_t)v * MeshData::kStride];
+        for (int k = 0; k < 3; ++k) {
+            float extent = mesh.boundsMax[k] - mesh.boundsMin[k];
+            float t = extent > 0.0f ? (src[MeshData::kPositionOffset + k] - mesh.boundsMin[k]) / extent : 0.0f;
+            uint16_t q = (uint16_t)std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f);
+            put<uint16_t>(out, positionOffset + v * kPositionStride + k * 2, q);
+        }
+
+        const float* n = src + MeshData::kNormalOffset;
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        float scale = length > 0.0f ? 127.0f / length : 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            out[normalOffset + v * kNormalStride + k] = (uint8_t)(int8_t)std::lround(n[k] * scale);
+        }
+    }
+
+    for (size_t lod = 0; lod < lods.size(); ++lod) {
+        size_t offset = lodOffsets[lod];
+        for (uint32_t index : lods[lod]) {
+            if (index32) {
+                put<uint32_t>(out, offset, index);
+            } else {
+                put<uint16_t>(out, offset, (uint16_t)index);
+            }
+            offset += indexSize;
+        }
+    }
+    return out;
+}
+
+bool View::open(const uint8_t* data, size_t size, std::string* error) {
+    m_data = nullptr;
+    if (!data || size < kHeaderSize) return fail(error, "file too small");
+    if (std::memcmp(data, kMagic, sizeof(kMagic)) != 0) return fail(error, "bad magic");
+    if (get<uint16_t>(data, 4) != kVersion) return fail(error, "unsupported version");
+
+    m_index32 = (get<uint16_t>(data, 6) & kFlagIndex32) != 0;
+    m_vertexCount = get<uint32_t>(data, 8);
+    m_lodCount = get<uint32_t>(data, 12);
+    m_positionOffset = get<uint32_t>(data, 16);
+    m_normalOffset = get<uint32_t>(data, 20);
+    m_lodTableOffset = get<uint32_t>(data, 24);
+    for (int k = 0; k < 3; ++k) {
+        m_boundsMin[k] = get<float>(data, 28 + k * 4);
+        m_boundsMax[k] = get<float>(data, 40 + k * 4);
+    }
+
+    // 映射内存直接交给 GPU 缓冲，所有段都必须对齐且落在文件内
+    auto inside = [size](uint64_t offset, uint64_t bytes) { return offset % 4 == 0 && offset + bytes <= size; };
+    if (m_vertexCount == 0 || m_lodCount == 0) return fail(error, "empty mesh");
+    if (!inside(m_lodTableOffset, (uint64_t)m_lodCount * kLodEntrySize)) return fail(error, "bad lod table");
+    if (!inside(m_positionOffset, (uint64_t)m_vertexCount * kPositionStride)) return fail(error, "bad position section");
+    if (!inside(m_normalOffset, (uint64_t)m_vertexCount * kNormalStride)) return fail(error, "bad normal section");
+
+    const uint64_t indexSize = m_index32 ? 4 : 2;
+    for (uint32_t lod = 0; lod < m_lodCount; ++lod) {
+        size_t entry = m_lodTableOffset + (size_t)lod * kLodEntrySize;
+        uint32_t offset = get<uint32_t>(data, entry);
+        uint32_t count = get<uint32_t>(data, entry + 4);
+        if (count == 0 || count % 3 != 0 || !inside(offset, count * indexSize)) return fail(error, "bad index section");
+        // 越界索引会让驱动读到缓冲外面，这里顺带扫一遍
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t index = m_index32 ? get<uint32_t>(data, offset + i * 4) : get<uint16_t>(data, offset + i * 2);
+            if (index >= m_vertexCount) return fail(error, "index out of range");
+        }
+    }
+
+    m_data = data;
+    return true;
+}
+
+const uint8_t* View::indexData(uint32_t lod) const {
+    if (!m_data || lod >= m_lodCount) return nullptr;
+    return m_data + get<uint32_t>(m_data, m_lodTableOffset + (size_t)lod * kLodEntrySize);
+}
+
+uint32_t View::indexCount(uint32_t lod) const {
+    if (!m_data || lod >= m_lodCount) return 0;
+    return get<uint32_t>(m_data, m_lodTableOffset + (size_t)lod * kLodEntrySize + 4);
+}
+
+void View::decodePositions(float* out) const {
+    float scale[3];
+    for (int k = 0; k < 3; ++k) scale[k] = (m_boundsMax[k] - m_boundsMin[k]) / 65535.0f;
+    const uint16_t* q = positions();
+    for (uint32_t v = 0; v < m_vertexCount; ++v, q += 4, out += 3) {
+        out[0] = m_boundsMin[0] + (float)q[0] * scale[0];
+        out[1] = m_boundsMin[1] + (float)q[1] * scale[1];
+        out[2] = m_boundsMin[2] + (float)q[2] * scale[2];
+    }
+}
+
+} // namespace MeshBinary
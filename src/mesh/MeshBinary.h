@@ -0,0 +1,95 @@
+#ifndef MESH_BINARY_H
+#define MESH_BINARY_H
+
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * MeshBinary - 预处理后的宝石网格格式（.gmsh）
+ *
+ * 由 bejeweled_meshbake 在构建时从 OBJ 生成，运行时整体内存映射，不再做文本解析。
+ * 所有整数小端，各段 4 字节对齐：
+ *
+ *   Header (64 字节)
+ *     char[4]  magic          "GMSH"
+ *     uint16   version        kVersion
+ *     uint16   flags          kFlagIndex32：索引为 uint32，否则为 uint16
+ *     uint32   vertexCount
+ *     uint32   lodCount       至少 1，LOD 0 为原始网格
+ *     uint32   positionOffset 顶点位置段偏移：每顶点 4 x uint16，前三个按包围盒归一化，第四个补 0
+ *     uint32   normalOffset   法线段偏移：每顶点 4 x int8（xyz 乘 127 取整，第四个补 0）
+ *     uint32   lodTableOffset LOD 表偏移
+ *     float    boundsMin[3], boundsMax[3]
+ *     uint8    reserved[12]
+ *   LOD 表：lodCount 项，每项 { uint32 indexOffset, uint32 indexCount, float cellSize, uint32 reserved }
+ *   索引段：各 LOD 的三角形索引，共用同一组顶点
+ *
+ * 宝石材质不采样纹理，UV 不写入。法线段可以直接作为 GPU 顶点属性使用（着色器里会重新归一化），
+ * 位置在加载时按包围盒还原成 float，保证拾取用的包围体计算仍然按 float 读取。
+ */
+namespace MeshBinary {
+
+constexpr uint16_t kVersion = 1;
+constexpr uint16_t kFlagIndex32 = 0x0001;
+constexpr size_t kHeaderSize = 64;
+constexpr size_t kLodEntrySize = 16;
+constexpr size_t kPositionStride = 4 * sizeof(uint16_t);
+constexpr size_t kNormalStride = 4 * sizeof(int8_t);
+
+struct BakeOptions {
+    bool optimize = true;  // 顶点缓存 + 顶点读取顺序优化
+    int lodCount = 1;      // 包含 LOD 0
+};
+
+struct BakeReport {
+    double acmrBefore = 0.0;
+    double acmrAfter = 0.0;
+    std::vector<uint32_t> lodTriangles;
+};
+
+// mesh 会被就地优化（三角形与顶点重排）
+std::vector<uint8_t> bake(MeshData& mesh, const BakeOptions& options, BakeReport* report = nullptr);
+
+/**
+ * View - 对映射内存的只读视图，不复制数据
+ */
+class View {
+public:
+    // 校验头部与各段范围，失败时 error 说明原因
+    bool open(const uint8_t* data, size_t size, std::string* error = nullptr);
+
+    uint32_t vertexCount() const { return m_vertexCount; }
+    uint32_t lodCount() const { return m_lodCount; }
+    bool hasIndex32() const { return m_index32; }
+    const float* boundsMin() const { return m_boundsMin; }
+    const float* boundsMax() const { return m_boundsMax; }
+
+    const uint16_t* positions() const { return reinterpret_cast<const uint16_t*>(m_data + m_positionOffset); }
+    const int8_t* normals() const { return reinterpret_cast<const int8_t*>(m_data + m_normalOffset); }
+    size_t normalBytes() const { return (size_t)m_vertexCount * kNormalStride; }
+
+    const uint8_t* indexData(uint32_t lod) const;
+    uint32_t indexCount(uint32_t lod) const;
+    size_t indexBytes(uint32_t lod) const { return (size_t)indexCount(lod) * (m_index32 ? 4 : 2); }
+
+    // 还原顶点位置，out 需容纳 vertexCount * 3 个 float
+    void decodePositions(float* out) const;
+
+private:
+    const uint8_t* m_data = nullptr;
+    uint32_t m_vertexCount = 0;
+    uint32_t m_lodCount = 0;
+    uint32_t m_positionOffset = 0;
+    uint32_t m_normalOffset = 0;
+    uint32_t m_lodTableOffset = 0;
+    bool m_index32 = false;
+    float m_boundsMin[3] = {};
+    float m_boundsMax[3] = {};
+};
+
+} // namespace MeshBinary
+
+#endif // MESH_BINARY_H
@@ -0,0 +1,29 @@
+#ifndef MESH_DATA_H
+#define MESH_DATA_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * MeshData - 解析后的三角网格（不依赖 Qt）
+ *
+ * 顶点交错存放：位置 xyz、法线 xyz、纹理坐标 uv，共 kStride 个 float；索引是 32 位三角形列表。
+ * 和 Qt3D QMesh 读取 OBJ 时生成的属性一致，可以直接作为 QBuffer 的数据上传。
+ */
+struct MeshData {
+    static constexpr int kStride = 8;
+    static constexpr int kPositionOffset = 0;
+    static constexpr int kNormalOffset = 3;
+    static constexpr int kTexCoordOffset = 6;
+
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+
+    int vertexCount() const { return (int)(vertices.size() / kStride); }
+    int indexCount() const { return (int)indices.size(); }
+    bool isEmpty() const { return indices.empty(); }
+};
+
+#endif // MESH_DATA_H
@@ -0,0 +1,202 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Forsyth 算法参数（见 "Linear-Speed Vertex Cache Optimisation"）
+constexpr int kCacheSize = 32;
+constexpr float kLastTriScore = 0.75f;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+float vertexScore(int cachePosition, int remainingTriangles) {
+    if (remainingTriangles == 0) return -1.0f;
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            score = kLastTriScore;
+        } else {
+            float scaler = 1.0f / (float)(kCacheSize - 3);
+            score = std::pow(1.0f - (float)(cachePosition - 3) * scaler, kCacheDecayPower);
+        }
+    }
+    score += kValenceBoostScale * std::pow((float)remainingTriangles, -kValenceBoostPower);
+    return score;
+}
+
+} // namespace
+
+namespace MeshOptimizer {
+
+void optimizeVertexCache(std::vector<uint32_t>& indices, int vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount <= 0) return;
+
+    // 每个顶点相邻的三角形列表（CSR 存储）
+    std::vector<int> remaining(vertexCount, 0);
+    for (uint32_t index : indices) ++remaining[index];
+    std::vector<int> offsets(vertexCount + 1, 0);
+    for (int v = 0; v < vertexCount; ++v) offsets[v + 1] = offsets[v] + remaining[v];
+    std::vector<int> adjacency(indices.size());
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) adjacency[fill[indices[t * 3 + k]]++] = (int)t;
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> score(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) score[v] = vertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<char> emitted(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    std::vector<int> cache;
+    cache.reserve(kCacheSize + 3);
+    std::vector<int> nextCache;
+    nextCache.reserve(kCacheSize + 3);
+
+    size_t scanCursor = 0;
+    int best = -1;
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (best < 0) {
+            // 缓存里没有候选时，顺序找下一个未输出、得分最高的三角形
+            float bestScore = -1.0f;
+            while (scanCursor < triangleCount && emitted[scanCursor]) ++scanCursor;
+            for (size_t t = scanCursor; t < triangleCount; ++t) {
+                if (!emitted[t] && triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = (int)t;
+                }
+            }
+        }
+
+        emitted[best] = 1;
+        const uint32_t* tri = &indices[(size_t)best * 3];
+        result.insert(result.end(), tri, tri + 3);
+
+        // 把三角形从顶点的相邻列表里移除
+        for (int k = 0; k < 3; ++k) {
+            int v = (int)tri[k];
+            int* begin = &adjacency[offsets[v]];
+            int* end = begin + remaining[v];
+            int* it = std::find(begin, end, best);
+            if (it != end) {
+                std::swap(*it, *(end - 1));
+                --remaining[v];
+            }
+        }
+
+        // 新三角形的顶点放到缓存最前面
+        nextCache.assign(tri, tri + 3);
+        for (int v : cache) {
+            if (v != (int)tri[0] && v != (int)tri[1] && v != (int)tri[2]) nextCache.push_back(v);
+        }
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            int v = nextCache[i];
+            cachePosition[v] = i < (size_t)kCacheSize ? (int)i : -1;
+            score[v] = vertexScore(cachePosition[v], remaining[v]);
+        }
+        if (nextCache.size() > (size_t)kCacheSize) nextCache.resize(kCacheSize);
+        cache.swap(nextCache);
+
+        // 只需要重新计算缓存内顶点相邻三角形的得分，下一个三角形从中选
+        best = -1;
+        float bestScore = -1.0f;
+        for (int v : cache) {
+            for (int i = 0; i < remaining[v]; ++i) {
+                int t = adjacency[offsets[v] + i];
+                const uint32_t* other = &indices[(size_t)t * 3];
+                float s = score[other[0]] + score[other[1]] + score[other[2]];
+                triangleScore[t] = s;
+                if (s > bestScore) {
+                    bestScore = s;
+                    best = t;
+                }
+            }
+        }
+    }
+    indices.swap(result);
+}
+
+void optimizeVertexFetch(MeshData& mesh) {
+    const int vertexCount = mesh.vertexCount();
+    std::vector<int> remap(vertexCount, -1);
+    std::vector<float> vertices;
+    vertices.reserve(mesh.vertices.size());
+    int next = 0;
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] < 0) {
+            remap[index] = next++;
+            const float* src = &mesh.vertices[(size_t)index * MeshData::kStride];
+            vertices.insert(vertices.end(), src, src + MeshData::kStride);
+        }
+        index = (uint32_t)remap[index];
+    }
+    // 没有被任何三角形引用的顶点直接丢弃
+    mesh.vertices.swap(vertices);
+}
+
+std::vector<uint32_t> simplifyClustered(const MeshData& mesh, int gridSize) {
+    const int vertexCount = mesh.vertexCount();
+    float extent[3];
+    for (int k = 0; k < 3; ++k) extent[k] = std::max(mesh.boundsMax[k] - mesh.boundsMin[k], 1e-6f);
+
+    // 每个格子取第一个落进来的顶点作为代表
+    std::unordered_map<uint32_t, uint32_t> cellRepresentative;
+    std::vector<uint32_t> representative(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        const float* p = &mesh.vertices[(size_t)v * MeshData::kStride];
+        uint32_t cell = 0;
+        for (int k = 0; k < 3; ++k) {
+            int c = (int)((p[k] - mesh.boundsMin[k]) / extent[k] * (float)gridSize);
+            cell = cell * 1024u + (uint32_t)std::clamp(c, 0, gridSize - 1);
+        }
+        auto [it, inserted] = cellRepresentative.try_emplace(cell, (uint32_t)v);
+        representative[v] = it->second;
+    }
+
+    std::vector<uint32_t> result;
+    std::unordered_set<uint64_t> seen;
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        uint32_t a = representative[mesh.indices[i]];
+        uint32_t b = representative[mesh.indices[i + 1]];
+        uint32_t c = representative[mesh.indices[i + 2]];
+        if (a == b || b == c || a == c) continue;  // 退化三角形
+
+        // 旋转到最小下标在前，去掉重复三角形（保持绕序）
+        uint32_t tri[3] = {a, b, c};
+        int first = (int)(std::min_element(tri, tri + 3) - tri);
+        uint32_t x = tri[first], y = tri[(first + 1) % 3], z = tri[(first + 2) % 3];
+        uint64_t key = ((uint64_t)x << 42) ^ ((uint64_t)y << 21) ^ (uint64_t)z;
+        if (!seen.insert(key).second) continue;
+        result.insert(result.end(), {x, y, z});
+    }
+    return result;
+}
+
+double averageCacheMissRatio(const std::vector<uint32_t>& indices, int vertexCount, int cacheSize) {
+    if (indices.size() < 3) return 0.0;
+    std::vector<int> stamp(vertexCount, -cacheSize - 1);
+    int misses = 0;
+    int clock = 0;
+    for (uint32_t index : indices) {
+        // FIFO：顶点进入缓存后经过 cacheSize 次未命中才被挤出
+        if (clock - stamp[index] > cacheSize) {
+            stamp[index] = clock++;
+            ++misses;
+        }
+    }
+    return (double)misses / (double)(indices.size() / 3);
+}
+
+} // namespace MeshOptimizer
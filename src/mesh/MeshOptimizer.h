@@ -0,0 +1,29 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include "MeshData.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * MeshOptimizer - 离线网格优化（不依赖 Qt，由 bejeweled_meshbake 使用）
+ *
+ * 思路与 meshoptimizer 相同的几步：
+ *   optimizeVertexCache  - Forsyth 线性时间算法重排三角形，提高 GPU 顶点缓存命中率；
+ *   optimizeVertexFetch  - 按索引首次出现的顺序重排顶点，顶点读取更连续；
+ *   simplifyClustered    - 网格聚类简化，生成共用同一顶点缓冲的低细节索引；
+ *   averageCacheMissRatio - 用 FIFO 缓存模拟统计 ACMR（每个三角形的平均顶点缓存未命中数）。
+ */
+namespace MeshOptimizer {
+
+void optimizeVertexCache(std::vector<uint32_t>& indices, int vertexCount);
+void optimizeVertexFetch(MeshData& mesh);
+
+// gridSize 为包围盒每个方向上的格子数，返回引用原顶点的三角形索引
+std::vector<uint32_t> simplifyClustered(const MeshData& mesh, int gridSize);
+
+double averageCacheMissRatio(const std::vector<uint32_t>& indices, int vertexCount, int cacheSize = 16);
+
+} // namespace MeshOptimizer
+
+#endif // MESH_OPTIMIZER_H
@@ -0,0 +1,181 @@
+#include "ObjParser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+namespace {
+
+struct Cursor {
+    const char* p;
+    const char* end;
+
+    void skipSpaces() {
+        while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    }
+    void skipLine() {
+        while (p < end && *p != '\n') ++p;
+        if (p < end) ++p;
+    }
+    bool atLineEnd() const {
+        return p >= end || *p == '\n' || *p == '\r' || *p == '#';
+    }
+    bool readFloat(float& value) {
+        skipSpaces();
+        // from_chars 不接受前导 '+'
+        if (p < end && *p == '+') ++p;
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+    bool readInt(long& value) {
+        std::from_chars_result result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) return false;
+        p = result.ptr;
+        return true;
+    }
+};
+
+// OBJ 索引从 1 开始，负数表示从末尾倒数；返回 0 基下标，缺省或越界返回 -1
+long resolveIndex(long index, size_t count) {
+    if (index > 0) return index <= (long)count ? index - 1 : -1;
+    if (index < 0) return (long)count + index >= 0 ? (long)count + index : -1;
+    return -1;
+}
+
+bool fail(std::string* error, const std::string& message) {
+    if (error) *error = message;
+    return false;
+}
+
+} // namespace
+
+namespace ObjParser {
+
+bool load(const std::string& path, MeshData& out, std::string* error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return fail(error, "cannot open " + path);
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return parse(data.data(), data.size(), out, error);
+}
+
+bool parse(const char* data, size_t size, MeshData& out, std::string* error) {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texCoords;
+    std::unordered_map<uint64_t, uint32_t> vertexMap;
+    std::vector<uint32_t> polygon;
+
+    out.vertices.clear();
+    out.indices.clear();
+
+    Cursor cursor{data, data + size};
+    int line = 0;
+    while (cursor.p < cursor.end) {
+        ++line;
+        cursor.skipSpaces();
+        const char* keyword = cursor.p;
+        while (cursor.p < cursor.end && *cursor.p != ' ' && *cursor.p != '\t' && *cursor.p != '\n') ++cursor.p;
+        size_t keywordLength = (size_t)(cursor.p - keyword);
+
+        if (keywordLength == 1 && keyword[0] == 'v') {
+            float xyz[3];
+            for (float& value : xyz) {
+                if (!cursor.readFloat(value)) return fail(error, "bad vertex at line " + std::to_string(line));
+            }
+            positions.insert(positions.end(), xyz, xyz + 3);
+        } else if (keywordLength == 2 && keyword[0] == 'v' && keyword[1] == 'n') {
+            float xyz[3];
+            for (float& value : xyz) {
+                if (!cursor.readFloat(value)) return fail(error, "bad normal at line " + std::to_string(line));
+            }
+            normals.insert(normals.end(), xyz, xyz + 3);
+        } else if (keywordLength == 2 && keyword[0] == 'v' && keyword[1] == 't') {
+            float uv[2] = {0.0f, 0.0f};
+            if (!cursor.readFloat(uv[0])) return fail(error, "bad texcoord at line " + std::to_string(line));
+            cursor.readFloat(uv[1]);
+            texCoords.insert(texCoords.end(), uv, uv + 2);
+        } else if (keywordLength == 1 && keyword[0] == 'f') {
+            polygon.clear();
+            while (true) {
+                cursor.skipSpaces();
+                if (cursor.atLineEnd()) break;
+                long v = 0, vt = 0, vn = 0;
+                if (!cursor.readInt(v)) return fail(error, "bad face at line " + std::to_string(line));
+                if (cursor.p < cursor.end && *cursor.p == '/') {
+                    ++cursor.p;
+                    if (cursor.p < cursor.end && *cursor.p != '/') cursor.readInt(vt);
+                    if (cursor.p < cursor.end && *cursor.p == '/') {
+                        ++cursor.p;
+                        cursor.readInt(vn);
+                    }
+                }
+                long pi = resolveIndex(v, positions.size() / 3);
+                long ti = resolveIndex(vt, texCoords.size() / 2);
+                long ni = resolveIndex(vn, normals.size() / 3);
+                if (pi < 0) return fail(error, "face index out of range at line " + std::to_string(line));
+
+                // 三个下标各占 21 位拼成键，-1 映射为 0
+                uint64_t key = (uint64_t)(pi + 1) | ((uint64_t)(ti + 1) << 21) | ((uint64_t)(ni + 1) << 42);
+                auto [it, inserted] = vertexMap.try_emplace(key, (uint32_t)(out.vertices.size() / MeshData::kStride));
+                if (inserted) {
+                    float vertex[MeshData::kStride] = {};
+                    std::copy_n(&positions[(size_t)pi * 3], 3, vertex + MeshData::kPositionOffset);
+                    if (ni >= 0) std::copy_n(&normals[(size_t)ni * 3], 3, vertex + MeshData::kNormalOffset);
+                    if (ti >= 0) std::copy_n(&texCoords[(size_t)ti * 2], 2, vertex + MeshData::kTexCoordOffset);
+                    out.vertices.insert(out.vertices.end(), vertex, vertex + MeshData::kStride);
+                }
+                polygon.push_back(it->second);
+            }
+            for (size_t i = 2; i < polygon.size(); ++i) {
+                out.indices.push_back(polygon[0]);
+                out.indices.push_back(polygon[i - 1]);
+                out.indices.push_back(polygon[i]);
+            }
+        }
+        cursor.skipLine();
+    }
+
+    if (out.indices.empty()) return fail(error, "no faces");
+
+    // 没有法线的顶点：累加相邻面的法线再归一化
+    if (normals.empty()) {
+        float* v = out.vertices.data();
+        for (size_t i = 0; i + 2 < out.indices.size(); i += 3) {
+            float* a = v + (size_t)out.indices[i] * MeshData::kStride;
+            float* b = v + (size_t)out.indices[i + 1] * MeshData::kStride;
+            float* c = v + (size_t)out.indices[i + 2] * MeshData::kStride;
+            float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+            float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+            float n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            for (float* corner : {a, b, c}) {
+                for (int k = 0; k < 3; ++k) corner[MeshData::kNormalOffset + k] += n[k];
+            }
+        }
+        for (size_t i = 0; i < out.vertices.size(); i += MeshData::kStride) {
+            float* n = v + i + MeshData::kNormalOffset;
+            float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length > 0.0f) {
+                for (int k = 0; k < 3; ++k) n[k] /= length;
+            }
+        }
+    }
+
+    for (int k = 0; k < 3; ++k) {
+        out.boundsMin[k] = out.vertices[k];
+        out.boundsMax[k] = out.vertices[k];
+    }
+    for (size_t i = 0; i < out.vertices.size(); i += MeshData::kStride) {
+        for (int k = 0; k < 3; ++k) {
+            out.boundsMin[k] = std::min(out.boundsMin[k], out.vertices[i + k]);
+            out.boundsMax[k] = std::max(out.boundsMax[k], out.vertices[i + k]);
+        }
+    }
+    return true;
+}
+
+} // namespace ObjParser
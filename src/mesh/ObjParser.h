@@ -0,0 +1,22 @@
+#ifndef OBJ_PARSER_H
+#define OBJ_PARSER_H
+
+#include "MeshData.h"
+#include <cstddef>
+#include <string>
+
+/**
+ * ObjParser - Wavefront OBJ 几何解析（不依赖 Qt，可在工作线程调用）
+ *
+ * 只读取 v / vt / vn / f，多边形按扇形拆成三角形，相同的 v/vt/vn 组合合并成一个顶点；
+ * 没有法线时按面法线累加生成平滑法线。材质（mtllib / usemtl）忽略，宝石颜色由材质组件决定。
+ * 数字用 from_chars 解析，不受进程 locale 影响。
+ */
+namespace ObjParser {
+
+bool parse(const char* data, size_t size, MeshData& out, std::string* error = nullptr);
+bool load(const std::string& path, MeshData& out, std::string* error = nullptr);
+
+} // namespace ObjParser
+
+#endif // OBJ_PARSER_H
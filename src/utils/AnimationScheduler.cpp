@@ -0,0 +1,138 @@
+#include "AnimationScheduler.h"
+#include <QAbstractAnimation>
+#include <QDebug>
+#include <QTimer>
+#include <QWidget>
+#include <Qt3DCore/QEntity>
+#include <Qt3DExtras/Qt3DWindow>
+#include <algorithm>
+
+AnimationScheduler& AnimationScheduler::instance() {
+    static AnimationScheduler scheduler;
+    return scheduler;
+}
+
+AnimationScheduler::Entry& AnimationScheduler::entryFor(QWidget* owner) {
+    pruneDestroyed();
+    for (Entry& entry : entries) {
+        if (entry.owner == owner) return entry;
+    }
+    Entry entry;
+    entry.owner = owner;
+    entries.push_back(std::move(entry));
+    return entries.back();
+}
+
+void AnimationScheduler::registerTimer(QWidget* owner, QTimer* timer) {
+    if (!owner || !timer) return;
+    Entry& entry = entryFor(owner);
+    entry.timers.append(timer);
+    // 在隐藏的界面里创建（例如后台预热）时立即挂起
+    if (entry.suspended && timer->isActive()) {
+        timer->stop();
+        entry.stoppedTimers.append(timer);
+    }
+    apply(entry);
+}
+
+void AnimationScheduler::registerScene(QWidget* owner, Qt3DExtras::Qt3DWindow* window, RootGetter root) {
+    if (!owner || !window) return;
+    Entry& entry = entryFor(owner);
+    Scene scene;
+    scene.window = window;
+    scene.root = std::move(root);
+    scene.savedPolicy = window->renderSettings()->renderPolicy();
+    if (entry.suspended) {
+        window->renderSettings()->setRenderPolicy(Qt3DRender::QRenderSettings::OnDemand);
+    }
+    entry.scenes.push_back(std::move(scene));
+    apply(entry);
+}
+
+bool AnimationScheduler::isOnActiveScreen(const QWidget* owner) const {
+    if (!activeScreen) return true;
+    return owner == activeScreen || activeScreen->isAncestorOf(owner);
+}
+
+void AnimationScheduler::setActiveScreen(QWidget* screen) {
+    activeScreen = screen;
+    pruneDestroyed();
+    int suspendedCount = 0;
+    for (Entry& entry : entries) {
+        apply(entry);
+        if (entry.suspended) ++suspendedCount;
+    }
+    qDebug() << "[AnimationScheduler] Active screen:" << (screen ? screen->metaObject()->className() : "none")
+             << "suspended owners:" << suspendedCount << "/" << entries.size();
+}
+
+void AnimationScheduler::apply(Entry& entry) {
+    if (!entry.owner) return;
+    if (isOnActiveScreen(entry.owner)) {
+        resume(entry);
+    } else {
+        suspend(entry);
+    }
+}
+
+void AnimationScheduler::suspend(Entry& entry) {
+    if (!entry.suspended) {
+        entry.suspended = true;
+        for (const QPointer<QTimer>& timer : entry.timers) {
+            if (timer && timer->isActive()) {
+                timer->stop();
+                entry.stoppedTimers.append(timer);
+            }
+        }
+        for (Scene& scene : entry.scenes) {
+            if (!scene.window) continue;
+            Qt3DRender::QRenderSettings* settings = scene.window->renderSettings();
+            scene.savedPolicy = settings->renderPolicy();
+            settings->setRenderPolicy(Qt3DRender::QRenderSettings::OnDemand);
+        }
+    }
+
+    // 已挂起的界面也可能在后台新建了动画（预热、回放前的 reset），每次都补一遍
+    pauseLoops(entry.owner, entry);
+    for (const Scene& scene : entry.scenes) {
+        if (!scene.root) continue;
+        if (Qt3DCore::QEntity* root = scene.root()) pauseLoops(root, entry);
+    }
+}
+
+void AnimationScheduler::resume(Entry& entry) {
+    if (!entry.suspended) return;
+    entry.suspended = false;
+
+    for (const QPointer<QTimer>& timer : entry.stoppedTimers) {
+        if (timer && !timer->isActive()) timer->start();
+    }
+    entry.stoppedTimers.clear();
+
+    for (const QPointer<QAbstractAnimation>& animation : entry.pausedAnimations) {
+        if (animation && animation->state() == QAbstractAnimation::Paused) animation->resume();
+    }
+    entry.pausedAnimations.clear();
+
+    for (const Scene& scene : entry.scenes) {
+        if (scene.window) scene.window->renderSettings()->setRenderPolicy(scene.savedPolicy);
+    }
+}
+
+void AnimationScheduler::pauseLoops(QObject* tree, Entry& entry) {
+    if (!tree) return;
+    const QList<QAbstractAnimation*> animations = tree->findChildren<QAbstractAnimation*>();
+    for (QAbstractAnimation* animation : animations) {
+        // 只暂停无限循环的顶层动画；组内的动画跟随所在的组
+        if (animation->loopCount() >= 0 || animation->group()) continue;
+        if (animation->state() != QAbstractAnimation::Running) continue;
+        animation->pause();
+        entry.pausedAnimations.append(animation);
+    }
+}
+
+void AnimationScheduler::pruneDestroyed() {
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [](const Entry& entry) { return entry.owner.isNull(); }),
+                  entries.end());
+}
@@ -0,0 +1,78 @@
+#ifndef ANIMATION_SCHEDULER_H
+#define ANIMATION_SCHEDULER_H
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <Qt3DRender/QRenderSettings>
+#include <functional>
+#include <vector>
+
+class QAbstractAnimation;
+class QTimer;
+class QWidget;
+namespace Qt3DCore { class QEntity; }
+namespace Qt3DExtras { class Qt3DWindow; }
+
+/**
+ * AnimationScheduler - 按界面可见性挂起/恢复动画
+ *
+ * GameWindow 切换界面时只隐藏旧界面，所有界面对象一直存活。各界面把自己的动画定时器
+ * 和 Qt3D 场景登记到这里，GameWindow::switchWidget 调用 setActiveScreen 后：
+ *   - 不在当前界面内的定时器停止，恢复时只重启挂起前正在运行的；
+ *   - 控件及其 3D 场景里无限循环的动画（菜单装饰、宝石待机自转等）暂停，恢复时继续；
+ *   - Qt3D 窗口切到 OnDemand 渲染，场景没有变化就不再出帧，恢复时还原原来的渲染策略。
+ * 有限次数的动画（连锁、交换）不会被暂停，离开界面时它们照常跑完，不影响游戏逻辑。
+ *
+ * 登记的控件可以是界面本身，也可以是界面内的任意子控件，是否可见按父子关系判断。
+ */
+class AnimationScheduler : public QObject {
+    Q_OBJECT
+public:
+    // 场景根实体会在重开一局时重建，所以登记的是取当前根实体的函数
+    using RootGetter = std::function<Qt3DCore::QEntity*()>;
+
+    static AnimationScheduler& instance();
+
+    void registerTimer(QWidget* owner, QTimer* timer);
+    void registerScene(QWidget* owner, Qt3DExtras::Qt3DWindow* window, RootGetter root = RootGetter());
+
+    // 切换到 screen：其他界面的动画源全部挂起，screen 内的恢复
+    void setActiveScreen(QWidget* screen);
+    QWidget* getActiveScreen() const { return activeScreen; }
+
+    // owner 当前是否在活动界面内（尚未设置活动界面时视为可见）
+    bool isOnActiveScreen(const QWidget* owner) const;
+
+private:
+    AnimationScheduler() = default;
+    AnimationScheduler(const AnimationScheduler&) = delete;
+    AnimationScheduler& operator=(const AnimationScheduler&) = delete;
+
+    struct Scene {
+        QPointer<Qt3DExtras::Qt3DWindow> window;
+        RootGetter root;
+        Qt3DRender::QRenderSettings::RenderPolicy savedPolicy = Qt3DRender::QRenderSettings::Always;
+    };
+
+    struct Entry {
+        QPointer<QWidget> owner;
+        QList<QPointer<QTimer>> timers;
+        std::vector<Scene> scenes;
+        bool suspended = false;
+        QList<QPointer<QTimer>> stoppedTimers;
+        QList<QPointer<QAbstractAnimation>> pausedAnimations;
+    };
+
+    Entry& entryFor(QWidget* owner);
+    void apply(Entry& entry);
+    void suspend(Entry& entry);
+    void resume(Entry& entry);
+    void pauseLoops(QObject* tree, Entry& entry);
+    void pruneDestroyed();
+
+    std::vector<Entry> entries;
+    QPointer<QWidget> activeScreen;
+};
+
+#endif // ANIMATION_SCHEDULER_H
@@ -0,0 +1,183 @@
+#include "AudioEngine.h"
+#include "../audio/NullAudioSink.h"
+#include "../audio/WavReader.h"
+#include <QAudioFormat>
+#include <QAudioSink>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QIODevice>
+#include <QMediaDevices>
+#include <QThread>
+
+namespace {
+
+constexpr int kFrameBytes = SfxMixer::kChannels * (int)sizeof(int16_t);
+
+// 拉模式数据源：QAudioSink 每次读取时当场混出对应帧数
+class MixerDevice : public QIODevice {
+public:
+    explicit MixerDevice(SfxMixer& mixer) : mixer(mixer) {}
+
+    bool isSequential() const override { return true; }
+
+    // 混音器永远有数据可读，告诉输出端至少还有一个缓冲的量
+    qint64 bytesAvailable() const override {
+        return (qint64)AudioEngine::kBufferFrames * kFrameBytes + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override {
+        int frames = (int)(maxSize / kFrameBytes);
+        if (frames <= 0) return 0;
+        mixer.render(reinterpret_cast<int16_t*>(data), frames);
+        return (qint64)frames * kFrameBytes;
+    }
+
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    SfxMixer& mixer;
+};
+
+} // namespace
+
+AudioEngine& AudioEngine::instance() {
+    static AudioEngine engine;
+    return engine;
+}
+
+AudioEngine::AudioEngine() : QObject(nullptr), mixer(kSampleRate) {
+}
+
+AudioEngine::~AudioEngine() {
+    stop();
+}
+
+int AudioEngine::addSound(const QString& path, float volume, int maxPolyphony) {
+    if (running) {
+        qWarning() << "[AudioEngine] addSound after start is not allowed:" << path;
+        return -1;
+    }
+    std::vector<int16_t> pcm;
+    std::string error;
+    if (!WavReader::load(path.toStdString(), kSampleRate, pcm, &error)) {
+        qWarning() << "[AudioEngine] Failed to decode" << path << ":" << QString::fromStdString(error);
+        return -1;
+    }
+    return mixer.addSound(std::move(pcm), volume, maxPolyphony);
+}
+
+bool AudioEngine::start() {
+    if (running) return true;
+
+    QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (qEnvironmentVariableIntValue("BEJEWELED_NULL_AUDIO") != 0 || device.isNull()) {
+        startNullSink();
+        running = true;
+        return true;
+    }
+
+    audioThread = new QThread();
+    audioThread->setObjectName("AudioEngine");
+    threadContext = new QObject();
+    threadContext->moveToThread(audioThread);
+    audioThread->start(QThread::TimeCriticalPriority);
+
+    bool opened = false;
+    QMetaObject::invokeMethod(threadContext, [this, device, &opened]() { opened = openSink(device); },
+                              Qt::BlockingQueuedConnection);
+    if (!opened) {
+        stop();
+        return false;
+    }
+
+    // 静态单例析构时 QCoreApplication 已经不在了，提前在退出时关掉音频线程
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &AudioEngine::stop, Qt::UniqueConnection);
+    running = true;
+    qDebug() << "[AudioEngine] Started on" << device.description() << "sounds:" << mixer.soundCount()
+             << "buffer frames:" << kBufferFrames;
+    return true;
+}
+
+void AudioEngine::stop() {
+    if (nullSink) {
+        nullSink->stop();
+        nullSink.reset();
+    }
+    if (audioThread) {
+        QMetaObject::invokeMethod(threadContext, [this]() { closeSink(); }, Qt::BlockingQueuedConnection);
+        audioThread->quit();
+        audioThread->wait();
+        delete threadContext;
+        delete audioThread;
+        threadContext = nullptr;
+        audioThread = nullptr;
+    }
+    running = false;
+}
+
+void AudioEngine::startNullSink() {
+    nullSink = std::make_unique<NullAudioSink>(mixer, kPeriodFrames);
+    nullSink->start();
+    qDebug() << "[AudioEngine] Using null sink, sounds:" << mixer.soundCount();
+}
+
+bool AudioEngine::openSink(const QAudioDevice& device) {
+    QAudioFormat format;
+    format.setSampleRate(kSampleRate);
+    format.setChannelCount(SfxMixer::kChannels);
+    format.setSampleFormat(QAudioFormat::Int16);
+    if (!device.isFormatSupported(format)) {
+        qWarning() << "[AudioEngine] Device does not support 44.1kHz stereo Int16:" << device.description();
+        return false;
+    }
+
+    sink = new QAudioSink(device, format);
+    sink->setBufferSize(kBufferFrames * kFrameBytes);
+    mixerDevice = new MixerDevice(mixer);
+    mixerDevice->open(QIODevice::ReadOnly);
+    sink->start(mixerDevice);
+    if (sink->error() != QAudio::NoError) {
+        qWarning() << "[AudioEngine] QAudioSink failed to start:" << sink->error();
+        closeSink();
+        return false;
+    }
+    return true;
+}
+
+void AudioEngine::closeSink() {
+    if (sink) {
+        sink->stop();
+        delete sink;
+        sink = nullptr;
+    }
+    delete mixerDevice;
+    mixerDevice = nullptr;
+}
+
+void AudioEngine::setDevice(const QAudioDevice& device) {
+    if (!running || nullSink || !audioThread || device.isNull()) return;
+    bool opened = false;
+    QMetaObject::invokeMethod(threadContext, [this, device, &opened]() {
+        closeSink();
+        opened = openSink(device);
+    }, Qt::BlockingQueuedConnection);
+    if (!opened) {
+        // 新设备打不开时保持混音器运转，命令队列不会积压
+        stop();
+        startNullSink();
+        running = true;
+    }
+}
+
+void AudioEngine::play(int sound, float gain) {
+    if (running) mixer.play(sound, gain);
+}
+
+void AudioEngine::setSoundVolume(int sound, float volume) {
+    mixer.setSoundVolume(sound, volume);
+}
+
+void AudioEngine::setMasterVolume(float volume) {
+    mixer.setMasterVolume(volume);
+}
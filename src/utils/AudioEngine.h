@@ -0,0 +1,72 @@
+#ifndef AUDIO_ENGINE_H
+#define AUDIO_ENGINE_H
+
+#include <QAudioDevice>
+#include <QObject>
+#include <QString>
+#include <memory>
+#include "../audio/SfxMixer.h"
+
+class QAudioSink;
+class QIODevice;
+class QThread;
+class NullAudioSink;
+
+/**
+ * AudioEngine - 低延迟音效输出
+ *
+ * 持有一个 SfxMixer，在独立的高优先级音频线程上以拉模式接到 QAudioSink：声卡要数据时
+ * 直接在音频线程里混音，输出缓冲只有 kBufferFrames 帧（约 12ms），UI 线程只往无锁队列里写命令。
+ * 音效在 start 之前一次性解码注册，之后播放不做任何磁盘 I/O 或解码。
+ *
+ * 环境变量 BEJEWELED_NULL_AUDIO=1 或没有输出设备时使用 NullAudioSink（无声、按真实时间混音），
+ * 便于在无头环境下测量；声卡不支持混音格式时 start 返回 false，由调用方退回 QSoundEffect。
+ */
+class AudioEngine : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int kSampleRate = 44100;
+    static constexpr int kPeriodFrames = 256;
+    static constexpr int kBufferFrames = kPeriodFrames * 2;
+
+    static AudioEngine& instance();
+
+    // 解码并注册音效，失败返回 -1。只能在 start 之前调用
+    int addSound(const QString& path, float volume = 1.0f, int maxPolyphony = 4);
+
+    bool start();
+    void stop();
+    bool isRunning() const { return running; }
+    bool isNullSink() const { return nullSink != nullptr; }
+
+    void play(int sound, float gain = 1.0f);
+    void setSoundVolume(int sound, float volume);
+    void setMasterVolume(float volume);
+
+    // 默认输出设备变化时切换，失败则改用无声输出
+    void setDevice(const QAudioDevice& device);
+
+    SfxMixer::Stats getStats() const { return mixer.getStats(); }
+
+private:
+    AudioEngine();
+    ~AudioEngine();
+    AudioEngine(const AudioEngine&) = delete;
+    AudioEngine& operator=(const AudioEngine&) = delete;
+
+    // 以下两个在音频线程上执行
+    bool openSink(const QAudioDevice& device);
+    void closeSink();
+
+    void startNullSink();
+
+    SfxMixer mixer;
+    bool running = false;
+    QThread* audioThread = nullptr;
+    QObject* threadContext = nullptr;   // 住在音频线程上，用来把调用投递过去
+    QAudioSink* sink = nullptr;
+    QIODevice* mixerDevice = nullptr;
+    std::unique_ptr<NullAudioSink> nullSink;
+};
+
+#endif // AUDIO_ENGINE_H
@@ -11,6 +11,7 @@
 #include <QDateTime>
 #include "../game/gameWidgets/SettingWidget.h" 
 #include "ResourceUtils.h"
+#include "AudioEngine.h"
 
 AudioManager& AudioManager::instance() {
     static AudioManager _instance;
@@ -44,30 +45,131 @@ AudioManager::AudioManager() : QObject(nullptr), lastHoverPlayTime(0) {
     
     // Set initial device
     updateAudioOutput();
+
+    setupEngine(soundDir);
+    reloadSettings();
+}
+
+void AudioManager::setupEngine(const QString& soundDir) {
+    // 所有音效类型都预先解码进混音器，切换类型时不需要重新加载
+    AudioEngine& engine = AudioEngine::instance();
+    engineHover = engine.addSound(soundDir + "MenuButtonHover.wav", 1.0f, 2);
+    engineClick = engine.addSound(soundDir + "MenuButtonClicked.wav", 1.0f, 2);
+    for (const QString& type : {QStringLiteral("Manbo"), QStringLiteral("Original")}) {
+        QList<int> ids;
+        for (int variant = 1; variant <= kEliminateVariants; ++variant) {
+            std::string soundFile = "sounds/" + type.toStdString() + std::to_string(variant) + ".wav";
+            int id = engine.addSound(QString::fromStdString(ResourceUtils::getPath(soundFile)), 1.0f, kVoicesPerVariant);
+            if (id < 0) break;
+            ids.append(id);
+        }
+        if (ids.size() == kEliminateVariants) engineEliminate.insert(type, ids);
+    }
+
+    useEngine = engineHover >= 0 && engineClick >= 0 && engine.start();
+    qDebug() << "[AudioManager] Mixer engine" << (useEngine ? "enabled" : "unavailable, using QSoundEffect")
+             << (useEngine && engine.isNullSink() ? "(null sink)" : "");
 }
 
 AudioManager::~AudioManager() {
 }
 
+void AudioManager::reloadSettings() {
+    soundEnabled = SettingWidget::isEliminateSoundEnabled();
+    soundVolume = qBound(0, SettingWidget::getEliminateSoundVolume(), 100);
+
+    QString soundType = SettingWidget::getEliminateSoundType();
+    if (useEngine && engineEliminate.contains(soundType)) {
+        // 混音器里已有这种类型，不再需要 QSoundEffect 音色池
+        qDeleteAll(eliminateVoices);
+        eliminateVoices.clear();
+        voiceStartedAt.clear();
+        eliminateType = soundType;
+    } else if (soundType != eliminateType || eliminateVoices.isEmpty()) {
+        rebuildEliminatePool(soundType);
+    }
+    applyVolume();
+}
+
+void AudioManager::rebuildEliminatePool(const QString& soundType) {
+    qDeleteAll(eliminateVoices);
+    eliminateVoices.clear();
+    voiceStartedAt.clear();
+    eliminateType = soundType;
+
+    QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    for (int variant = 0; variant < kEliminateVariants; ++variant) {
+        // 统一使用 resources/sounds/ 下的平铺结构（如"sounds/Manbo3.wav"）
+        std::string soundFile = "sounds/" + soundType.toStdString() + std::to_string(variant + 1) + ".wav";
+        QUrl source = QUrl::fromLocalFile(QString::fromStdString(ResourceUtils::getPath(soundFile)));
+        for (int voice = 0; voice < kVoicesPerVariant; ++voice) {
+            QSoundEffect* effect = new QSoundEffect(this);
+            if (!device.isNull()) effect->setAudioDevice(device);
+            effect->setSource(source);
+            connect(effect, &QSoundEffect::statusChanged, this, [effect]() {
+                if (effect->status() == QSoundEffect::Error) {
+                    qDebug() << "Sound effect error:" << effect->source();
+                }
+            });
+            eliminateVoices.append(effect);
+            voiceStartedAt.append(0);
+        }
+    }
+    qDebug() << "[AudioManager] Eliminate voice pool loaded:" << soundType
+             << kEliminateVariants << "x" << kVoicesPerVariant;
+}
+
+void AudioManager::applyVolume() {
+    float volume = soundVolume / 100.0f;
+    if (useEngine) AudioEngine::instance().setMasterVolume(volume);
+    hoverSound->setVolume(volume);
+    clickSound->setVolume(volume);
+    for (QSoundEffect* effect : eliminateVoices) {
+        effect->setVolume(volume);
+    }
+}
+
+QSoundEffect* AudioManager::pickEliminateVoice(int variant) {
+    const int base = variant * kVoicesPerVariant;
+    int chosen = base;
+    for (int voice = base; voice < base + kVoicesPerVariant; ++voice) {
+        if (!eliminateVoices[voice]->isPlaying()) {
+            chosen = voice;
+            break;
+        }
+        // 所有声部都在播放时抢占最早开始的那个
+        if (voiceStartedAt[voice] < voiceStartedAt[chosen]) chosen = voice;
+    }
+    QSoundEffect* effect = eliminateVoices[chosen];
+    if (effect->isPlaying()) effect->stop();
+    voiceStartedAt[chosen] = throttleTimer.elapsed();
+    return effect;
+}
+
 void AudioManager::updateAudioOutput() {
     QAudioDevice device = QMediaDevices::defaultAudioOutput();
+    if (useEngine) AudioEngine::instance().setDevice(device);
     if (!device.isNull()) {
         hoverSound->setAudioDevice(device);
         clickSound->setAudioDevice(device);
+        for (QSoundEffect* effect : eliminateVoices) {
+            effect->setAudioDevice(device);
+        }
     }
 }
 
 void AudioManager::playHoverSound() {
     // 补充：检查静态函数返回值的合理性，同时判断音效对象是否为空
-    if (!hoverSound || !SettingWidget::isEliminateSoundEnabled()) return;
+    if (!hoverSound || !soundEnabled) return;
     
     qint64 now = throttleTimer.elapsed();
     if (now - lastHoverPlayTime < 100) return;
     lastHoverPlayTime = now;
-    
-    // 补充：音量值范围检查（0-100）
-    int vol = qBound(0, SettingWidget::getEliminateSoundVolume(), 100);
-    hoverSound->setVolume(vol / 100.0f);
+
+    if (useEngine) {
+        AudioEngine::instance().play(engineHover);
+        return;
+    }
     
     if (hoverSound->status() == QSoundEffect::Ready || hoverSound->status() == QSoundEffect::Loading) {
         hoverSound->play();
@@ -76,10 +178,12 @@ void AudioManager::playHoverSound() {
 
 // playClickSound函数同理补充检查
 void AudioManager::playClickSound() {
-    if (!clickSound || !SettingWidget::isEliminateSoundEnabled()) return;
-    
-    int vol = qBound(0, SettingWidget::getEliminateSoundVolume(), 100);
-    clickSound->setVolume(vol / 100.0f);
+    if (!clickSound || !soundEnabled) return;
+
+    if (useEngine) {
+        AudioEngine::instance().play(engineClick);
+        return;
+    }
     
     if (clickSound->status() == QSoundEffect::Ready || clickSound->status() == QSoundEffect::Loading) {
         clickSound->play();
@@ -88,16 +192,10 @@ void AudioManager::playClickSound() {
 
 
 void AudioManager::playEliminateSound(int comboCount) {
-    // 1. 检查设置中是否启用消除音效，未启用则直接返回
-    if (!SettingWidget::isEliminateSoundEnabled()) return;
-
-    // 2. 从设置中获取用户选择的音效类型（默认值为"Manbo"）
-    QSettings settings("GemMatch", "Settings");
-    QString soundType = settings.value("Music/EliminateType", "Manbo").toString();
-    // 将QString转为std::string，方便拼接文件名
-    std::string soundTypeStr = soundType.toStdString();
+    // 1. 检查设置中是否启用消除音效（读取的是缓存，不访问 QSettings）
+    if (!soundEnabled) return;
 
-    // 3. 根据连续消除次数选择音效的数字后缀（1-5）
+    // 2. 根据连续消除次数选择音效的数字后缀（1-5）
     int soundSuffix = 1; // 默认后缀为1
     if (comboCount < 2) {
         // 普通消除：使用1/2/3后缀
@@ -107,44 +205,16 @@ void AudioManager::playEliminateSound(int comboCount) {
         soundSuffix = (comboCount % 2 == 0) ? 4 : 5;
     }
 
-    // 4. 拼接最终的音效文件路径（如"sounds/Manbo3.wav"）
-    // 移除对Manbo子目录的特殊处理，统一使用 resources/sounds/ 下的平铺结构
-    std::string soundFile = "sounds/" + soundTypeStr + std::to_string(soundSuffix) + ".wav";
-
-    // 5. 初始化音效播放器并设置资源路径
-    QSoundEffect* eliminateSound = new QSoundEffect(this);
-    std::string eliminatePath = ResourceUtils::getPath(soundFile);
-    eliminateSound->setSource(QUrl::fromLocalFile(QString::fromStdString(eliminatePath)));
-    
-    // Debug: 输出音频路径和加载状态
-    qDebug() << "Trying to play eliminate sound:" << QString::fromStdString(eliminatePath);
-    
-    // 设置默认音频输出设备
-    QAudioDevice device = QMediaDevices::defaultAudioOutput();
-    if (!device.isNull()) {
-        eliminateSound->setAudioDevice(device);
+    // 3. 优先交给混音器：只写一条命令，由音频线程在下一个周期开始混音
+    const QList<int> engineIds = engineEliminate.value(eliminateType);
+    if (useEngine && !engineIds.isEmpty()) {
+        AudioEngine::instance().play(engineIds[soundSuffix - 1]);
+        return;
     }
 
-    // 6. 应用设置中的音量（确保音量在0-100范围内，再转为0.0-1.0的浮点数）
-    int vol = qBound(0, SettingWidget::getEliminateSoundVolume(), 100);
-    eliminateSound->setVolume(vol / 100.0f);
-
-    // 7. 播放音效
-    // 连接信号以监控状态和自动清理
-    connect(eliminateSound, &QSoundEffect::statusChanged, this, [eliminateSound]() {
-        if (eliminateSound->status() == QSoundEffect::Error) {
-            qDebug() << "Sound effect error:" << eliminateSound->source();
-        }
-    });
-
-    // 8. 播放完成后自动释放资源，避免内存泄漏
-    connect(eliminateSound, &QSoundEffect::playingChanged, [eliminateSound]() {
-        if (!eliminateSound->isPlaying()) {
-            eliminateSound->deleteLater();
-        }
-    });
-
+    // 4. 否则从预加载的音色池里取一个空闲声部播放，音量和输出设备已提前设置好
+    if (eliminateVoices.isEmpty()) return;
+    QSoundEffect* eliminateSound = pickEliminateVoice(soundSuffix - 1);
+    if (eliminateSound->status() == QSoundEffect::Error) return;
     eliminateSound->play();
 }
-
-
@@ -6,31 +6,61 @@
 #include <QMediaDevices>
 #include <QAudioDevice>
 #include <QElapsedTimer>
-#include <QRandomGenerator> 
+#include <QRandomGenerator>
+#include <QList>
+#include <QString>
+#include <QHash>
 
 class AudioManager : public QObject {
     Q_OBJECT
 public:
     static AudioManager& instance();
-    
+
     void playHoverSound();
     void playClickSound();
     void playEliminateSound(int comboCount = 1);
 
+    // 重新读取音效设置（SettingWidget 保存后调用），音效类型变化时重建消除音色池
+    void reloadSettings();
+
 private slots:
     void updateAudioOutput();
 
 private:
     AudioManager();
     ~AudioManager();
-    
+
+    static constexpr int kEliminateVariants = 5;   // 每种类型 1~5 号音效
+    static constexpr int kVoicesPerVariant = 3;    // 同一音效允许叠加的声部数
+
+    // 把所有音效注册进 AudioEngine 并启动；不可用时退回 QSoundEffect
+    void setupEngine(const QString& soundDir);
+    void rebuildEliminatePool(const QString& soundType);
+    QSoundEffect* pickEliminateVoice(int variant);
+    void applyVolume();
+
     QSoundEffect* hoverSound;
     QSoundEffect* clickSound;
-    
+
+    // 消除音色池：下标 = (后缀 - 1) * kVoicesPerVariant + 声部，全部预先加载
+    QList<QSoundEffect*> eliminateVoices;
+    QList<qint64> voiceStartedAt;  // 各声部最近一次开始播放的时间，用于抢占
+    QString eliminateType;
+
+    // 混音器中的音效编号，按类型存放 1~5 号消除音效
+    bool useEngine = false;
+    int engineHover = -1;
+    int engineClick = -1;
+    QHash<QString, QList<int>> engineEliminate;
+
+    // 设置缓存，避免每次播放都打开 QSettings
+    bool soundEnabled = true;
+    int soundVolume = 50;
+
     QMediaDevices* mediaDevices;
     QElapsedTimer throttleTimer;
     qint64 lastHoverPlayTime;
-    QRandomGenerator m_randomGenerator;  
+    QRandomGenerator m_randomGenerator;
 };
 
 #endif // AUDIO_MANAGER_H
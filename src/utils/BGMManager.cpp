@@ -1,6 +1,10 @@
 #include "BGMManager.h"
 #include <QUrl>
 #include <QDebug>
+#include <QFileInfo>
+#include <QVariantAnimation>
+#include <algorithm>
+#include <cmath>
 #include "../game/gameWidgets/SettingWidget.h"
 #include "ResourceUtils.h"
 
@@ -12,61 +16,229 @@ BGMManager& BGMManager::instance() {
 
 // 构造函数实现（现在和头文件声明匹配）
 BGMManager::BGMManager(QObject* parent) : QObject(parent) {
-    player = new QMediaPlayer(this); // 父对象设为this，自动管理内存
-    audioOutput = new QAudioOutput(this);
-    player->setAudioOutput(audioOutput);
+    bool enabled = SettingWidget::isBackgroundMusicEnabled();
+    for (int i = 0; i < 2; ++i) {
+        Deck& deck = decks[i];
+        deck.player = new QMediaPlayer(this); // 父对象设为this，自动管理内存
+        deck.output = new QAudioOutput(this);
+        deck.player->setAudioOutput(deck.output);
+        deck.output->setMuted(!enabled);
+        connect(deck.player, &QMediaPlayer::mediaStatusChanged, this,
+                [this, i](QMediaPlayer::MediaStatus status) { onMediaStatusChanged(i, status); });
+        connect(deck.player, &QMediaPlayer::positionChanged, this,
+                [this, i](qint64 position) { onPositionChanged(i, position); });
+    }
 
-    // 从设置中获取初始音量和状态
+    // 等功率交叉淡入淡出：新的一路 sin，旧的一路 cos，总响度不凹陷
+    fade = new QVariantAnimation(this);
+    fade->setStartValue(0.0);
+    fade->setEndValue(1.0);
+    connect(fade, &QVariantAnimation::valueChanged, this, [this](const QVariant& value) {
+        double t = value.toDouble() * M_PI_2;
+        applyGain(activeDeck(), (float)std::sin(t));
+        applyGain(idleDeck(), (float)std::cos(t));
+    });
+    connect(fade, &QVariantAnimation::finished, this, &BGMManager::finishCrossfade);
+
+    // 从设置中获取初始音量
     int volume = SettingWidget::getBackgroundMusicVolume();
     setVolume(volume);
-
-    bool enabled = SettingWidget::isBackgroundMusicEnabled();
-    if (!enabled) {
-        audioOutput->setMuted(true);
-    }
 }
 
 // 析构函数
 BGMManager::~BGMManager() {
-    player->stop();
+    for (Deck& deck : decks) deck.player->stop();
     // QObject的子对象会被自动销毁，无需手动delete
 }
 
-// 以下原有函数实现保持不变（播放、停止、暂停、恢复、设置音量）
-void BGMManager::play(const QString& filePath) {
+// ==================== 两路播放器 ====================
+
+void BGMManager::load(Deck& deck, const QString& filePath) {
+    deck.player->stop();
+    deck.path = filePath;
+    // 后端在自己的线程里打开文件、初始化解码器，这里立即返回
+    deck.player->setSource(QUrl::fromLocalFile(filePath));
+}
+
+void BGMManager::release(Deck& deck) {
+    if (deck.path.isEmpty()) return;
+    deck.player->stop();
+    deck.player->setSource(QUrl());  // 关掉解码器，释放缓冲
+    deck.path.clear();
+    applyGain(deck, 0.0f);
+}
+
+void BGMManager::applyGain(Deck& deck, float gain) {
+    deck.gain = gain;
+    deck.output->setVolume(gain * masterVolume);
+}
+
+void BGMManager::startTrack(const QString& filePath, int crossfadeMs, bool loopForever) {
+    Deck& current = activeDeck();
+    bool alreadyPlaying = current.path == filePath && current.player->playbackState() == QMediaPlayer::PlayingState;
+    if (pendingFadeMs < 0 && alreadyPlaying) return;
+    if (pendingFadeMs >= 0 && idleDeck().path == filePath) return;
+
+    if (filePath.isEmpty() || !QFileInfo::exists(filePath)) {
+        // 不把不存在的文件交给解码器，当前曲目淡出即可
+        qDebug() << "[BGMManager] Track not found, fading out:" << filePath;
+        stop(crossfadeMs);
+        return;
+    }
+
+    // 上一次淡入淡出还没结束：直接跳到结束状态，空出一路给新曲目
+    if (fade->state() == QAbstractAnimation::Running) {
+        fade->stop();
+        finishCrossfade();
+    }
+
+    Deck& next = idleDeck();
+    if (next.path != filePath) load(next, filePath);
+    next.player->setLoops(loopForever ? QMediaPlayer::Infinite : 1);
+    applyGain(next, 0.0f);
+    next.player->play();
+
+    pendingFadeMs = std::max(0, crossfadeMs);
+    if (next.player->mediaStatus() == QMediaPlayer::BufferedMedia) beginCrossfade();
+}
+
+void BGMManager::beginCrossfade() {
+    int duration = pendingFadeMs;
+    pendingFadeMs = -1;
+    active = 1 - active;
+
+    bool outgoingPlaying = idleDeck().player->playbackState() == QMediaPlayer::PlayingState;
+    if (duration <= 0 || !outgoingPlaying) {
+        applyGain(activeDeck(), 1.0f);
+        release(idleDeck());
+        return;
+    }
+    fade->setDuration(duration);
+    fade->start();
+}
+
+void BGMManager::finishCrossfade() {
+    applyGain(activeDeck(), 1.0f);
+    release(idleDeck());
+}
+
+void BGMManager::onMediaStatusChanged(int deckIndex, QMediaPlayer::MediaStatus status) {
+    bool isIncoming = deckIndex != active && pendingFadeMs >= 0;
+    if (isIncoming && status == QMediaPlayer::BufferedMedia) {
+        beginCrossfade();
+    } else if (status == QMediaPlayer::InvalidMedia) {
+        qWarning() << "[BGMManager] Cannot play:" << decks[deckIndex].path << decks[deckIndex].player->errorString();
+        if (isIncoming) {
+            pendingFadeMs = -1;
+            release(decks[deckIndex]);
+            stop(kDefaultCrossfadeMs);
+        }
+    } else if (status == QMediaPlayer::EndOfMedia && deckIndex == active && !playlist.isEmpty()
+               && pendingFadeMs < 0) {
+        // 曲目比淡入淡出时长还短或没拿到时长时，在结尾直接接下一首
+        playlistIndex = (playlistIndex + 1) % playlist.size();
+        startTrack(playlist[playlistIndex], 0, false);
+    }
+}
+
+void BGMManager::onPositionChanged(int deckIndex, qint64 position) {
+    if (playlist.size() < 2 || deckIndex != active || pendingFadeMs >= 0) return;
+    if (fade->state() == QAbstractAnimation::Running) return;
+
+    qint64 duration = decks[deckIndex].player->duration();
+    if (duration <= 0) return;
+    int nextIndex = (playlistIndex + 1) % playlist.size();
+
+    if (position >= duration - playlistCrossfadeMs) {
+        playlistIndex = nextIndex;
+        startTrack(playlist[playlistIndex], playlistCrossfadeMs, false);
+    } else if (position >= duration / 2) {
+        // 播到一半时把下一首放进空闲的一路，切换时不用等解码器
+        preload(playlist[nextIndex]);
+    }
+}
+
+// ==================== 对外接口 ====================
+
+void BGMManager::play(const QString& filePath, int crossfadeMs) {
     if (!SettingWidget::isBackgroundMusicEnabled()) {
         return;
     }
+    playlist.clear();
+    playlistIndex = -1;
+    startTrack(filePath, crossfadeMs, true);
+}
 
-    if (currentFilePath == filePath && player->playbackState() == QMediaPlayer::PlayingState) {
+void BGMManager::playPlaylist(const QStringList& filePaths, int crossfadeMs) {
+    if (filePaths.size() == 1) {
+        play(filePaths.first(), crossfadeMs);
+        return;
+    }
+    if (!SettingWidget::isBackgroundMusicEnabled() || filePaths.isEmpty()) {
         return;
     }
+    if (playlist == filePaths) return;
+    playlist = filePaths;
+    playlistIndex = 0;
+    playlistCrossfadeMs = std::max(0, crossfadeMs);
+    startTrack(playlist.first(), crossfadeMs, false);
+}
 
-    currentFilePath = filePath;
-    player->setSource(QUrl::fromLocalFile(filePath));
-    player->setLoops(QMediaPlayer::Infinite); // 循环播放
-    player->play();
+void BGMManager::preload(const QString& filePath) {
+    if (pendingFadeMs >= 0 || fade->state() == QAbstractAnimation::Running) return;
+    if (activeDeck().path == filePath || idleDeck().path == filePath) return;
+    if (!QFileInfo::exists(filePath)) return;
+    load(idleDeck(), filePath);
 }
 
-void BGMManager::stop() {
-    player->stop();
-    currentFilePath.clear();
+void BGMManager::stop(int fadeMs) {
+    playlist.clear();
+    playlistIndex = -1;
+    if (pendingFadeMs >= 0) {
+        pendingFadeMs = -1;
+        release(idleDeck());
+    }
+    if (fade->state() == QAbstractAnimation::Running) {
+        fade->stop();
+        finishCrossfade();
+    }
+
+    bool playing = activeDeck().player->playbackState() == QMediaPlayer::PlayingState;
+    if (fadeMs <= 0 || !playing) {
+        release(decks[0]);
+        release(decks[1]);
+        return;
+    }
+    // 只淡出：把空的一路当作"新曲目"，沿用交叉淡入淡出的流程
+    release(idleDeck());
+    active = 1 - active;
+    fade->setDuration(fadeMs);
+    fade->start();
 }
 
 void BGMManager::pause() {
-    if (player->playbackState() == QMediaPlayer::PlayingState) {
-        player->pause();
+    if (pendingFadeMs >= 0) {
+        pendingFadeMs = -1;
+        release(idleDeck());
+    }
+    if (fade->state() == QAbstractAnimation::Running) {
+        fade->stop();
+        finishCrossfade();
+    }
+    if (activeDeck().player->playbackState() == QMediaPlayer::PlayingState) {
+        activeDeck().player->pause();
     }
 }
 
 void BGMManager::resume() {
     if (SettingWidget::isBackgroundMusicEnabled() &&
-        player->playbackState() == QMediaPlayer::PausedState) {
-        player->play();
+        activeDeck().player->playbackState() == QMediaPlayer::PausedState) {
+        activeDeck().player->play();
     }
 }
 
 void BGMManager::setVolume(int volume) {
     volume = qBound(0, volume, 100);
-    audioOutput->setVolume(volume / 100.0f);
+    masterVolume = volume / 100.0f;
+    for (Deck& deck : decks) applyGain(deck, deck.gain);
 }
@@ -5,16 +5,33 @@
 #include <QMediaPlayer>
 #include <QAudioOutput>
 #include <QString>
+#include <QStringList>
 
+class QVariantAnimation;
+
+/**
+ * BGMManager - 背景音乐
+ *
+ * 内部有两个播放器（A/B 两路）交替使用：切歌时新曲目在空闲的一路上加载，
+ * 解码器准备好（BufferedMedia）后才开始在 crossfadeMs 内等功率交叉淡入淡出，旧的一路淡出后停止并释放源。
+ * QMediaPlayer 边解码边播放，不把整首曲目读进内存，任何时候最多只有两路解码器打开。
+ *
+ * preload 可以提前把下一个界面的曲目放进空闲的一路，切换时直接开始淡入；
+ * playPlaylist 按顺序无缝播放一组曲目，当前曲目结束前 crossfadeMs 开始混入下一首，末尾回到第一首。
+ */
 class BGMManager : public QObject {
     Q_OBJECT  // 保留moc必需的宏
 public:
+    static constexpr int kDefaultCrossfadeMs = 800;
+
     // 单例获取接口
     static BGMManager& instance();
 
     // 背景音乐控制接口
-    void play(const QString& filePath);
-    void stop();
+    void play(const QString& filePath, int crossfadeMs = kDefaultCrossfadeMs);
+    void playPlaylist(const QStringList& filePaths, int crossfadeMs = kDefaultCrossfadeMs);
+    void preload(const QString& filePath);
+    void stop(int fadeMs = 0);
     void pause();
     void resume();
     void setVolume(int volume); // 0-100范围
@@ -24,14 +41,39 @@ private:
     explicit BGMManager(QObject* parent = nullptr); // 带parent参数，默认值nullptr
     ~BGMManager(); // 析构函数（无需override，因为QObject的析构函数是虚函数，但这里可以省略）
 
-    // 成员变量
-    QMediaPlayer* player;
-    QAudioOutput* audioOutput;
-    QString currentFilePath;
+    struct Deck {
+        QMediaPlayer* player = nullptr;
+        QAudioOutput* output = nullptr;
+        QString path;
+        float gain = 0.0f;   // 淡入淡出系数，实际音量 = gain * masterVolume
+    };
+
+    Deck& activeDeck() { return decks[active]; }
+    Deck& idleDeck() { return decks[1 - active]; }
+
+    void load(Deck& deck, const QString& filePath);
+    void release(Deck& deck);
+    void applyGain(Deck& deck, float gain);
+    void startTrack(const QString& filePath, int crossfadeMs, bool loopForever);
+    void beginCrossfade();
+    void finishCrossfade();
+    void onMediaStatusChanged(int deckIndex, QMediaPlayer::MediaStatus status);
+    void onPositionChanged(int deckIndex, qint64 position);
+
+    Deck decks[2];
+    int active = 0;
+    float masterVolume = 0.5f;
+
+    QVariantAnimation* fade = nullptr;
+    int pendingFadeMs = -1;   // >= 0 表示空闲一路在等解码器就绪后开始淡入
+
+    QStringList playlist;
+    int playlistIndex = -1;
+    int playlistCrossfadeMs = 0;
 
     // 禁止复制和赋值
     BGMManager(const BGMManager&) = delete;
     BGMManager& operator=(const BGMManager&) = delete;
 };
 
-#endif // BGM_MANAGER_H
\ No newline at end of file
+#endif // BGM_MANAGER_H
@@ -0,0 +1,52 @@
+#include "BackgroundCache.h"
+#include "ResourceUtils.h"
+#include <QDebug>
+
+BackgroundCache& BackgroundCache::instance() {
+    static BackgroundCache instance;
+    return instance;
+}
+
+QPixmap BackgroundCache::load(const QString& path) {
+    auto it = decoded.constFind(path);
+    if (it != decoded.constEnd()) return it.value();
+
+    QPixmap pixmap(path);
+    if (pixmap.isNull()) {
+        qDebug() << "[BackgroundCache] Failed to load" << path;
+    } else {
+        qDebug() << "[BackgroundCache] Decoded" << path << pixmap.size();
+    }
+    decoded.insert(path, pixmap);
+    return pixmap;
+}
+
+QPixmap BackgroundCache::loadResource(const std::string& resourcePath) {
+    return load(QString::fromStdString(ResourceUtils::getPath(resourcePath)));
+}
+
+void BackgroundCache::invalidate(const QString& path) {
+    decoded.remove(path);
+}
+
+void ScaledBackground::setSource(const QPixmap& pixmap) {
+    // 同一张图（共享同一份像素）不需要重新缩放
+    if (pixmap.cacheKey() == original.cacheKey()) return;
+    original = pixmap;
+    invalidate();
+}
+
+const QPixmap& ScaledBackground::scaled(const QSize& size, Qt::AspectRatioMode mode) {
+    if (original.isNull()) return original;
+    if (cached.isNull() || cachedSize != size || cachedMode != mode) {
+        cached = original.scaled(size, mode, Qt::SmoothTransformation);
+        cachedSize = size;
+        cachedMode = mode;
+    }
+    return cached;
+}
+
+void ScaledBackground::invalidate() {
+    cached = QPixmap();
+    cachedSize = QSize();
+}
@@ -0,0 +1,55 @@
+#ifndef BACKGROUND_CACHE_H
+#define BACKGROUND_CACHE_H
+
+#include <QHash>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include <string>
+
+/**
+ * BackgroundCache - 2D 界面背景图缓存
+ *
+ * BackgroundManager 只记录各界面背景图的资源路径，这里负责解码：每张图按路径只从磁盘
+ * 解码一次，之后返回共享的 QPixmap（隐式共享，不复制像素）。
+ *
+ * 缩放结果由各控件持有的 ScaledBackground 保存：每个控件只保留当前尺寸的一张，
+ * 尺寸变化或换图时才重新平滑缩放，paintEvent 里只剩一次 drawPixmap。
+ */
+class BackgroundCache {
+public:
+    static BackgroundCache& instance();
+
+    // 按文件路径取解码后的图片，失败返回空 QPixmap（失败结果也会缓存，避免反复读盘）
+    QPixmap load(const QString& path);
+    // BackgroundManager 中的资源相对路径，经 ResourceUtils 解析后加载
+    QPixmap loadResource(const std::string& resourcePath);
+    // 文件在磁盘上被替换后丢弃旧的解码结果
+    void invalidate(const QString& path);
+
+private:
+    BackgroundCache() = default;
+
+    QHash<QString, QPixmap> decoded;
+};
+
+// 控件自己的缩放缓存：同一尺寸和缩放方式只缩放一次
+class ScaledBackground {
+public:
+    void setSource(const QPixmap& pixmap);
+    const QPixmap& source() const { return original; }
+    bool isNull() const { return original.isNull(); }
+
+    // mode 与 QPixmap::scaled 相同，缩放使用 Qt::SmoothTransformation
+    const QPixmap& scaled(const QSize& size, Qt::AspectRatioMode mode = Qt::KeepAspectRatioByExpanding);
+    // 控件尺寸变化时调用，释放旧尺寸的缩放结果
+    void invalidate();
+
+private:
+    QPixmap original;
+    QPixmap cached;
+    QSize cachedSize;
+    Qt::AspectRatioMode cachedMode = Qt::KeepAspectRatioByExpanding;
+};
+
+#endif // BACKGROUND_CACHE_H
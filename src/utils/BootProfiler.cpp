@@ -0,0 +1,146 @@
+#include "BootProfiler.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QEvent>
+#include <QTimer>
+#include <QWidget>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <json.hpp>
+
+namespace {
+
+// 第一次 Paint 事件到达后记录打点，并在本帧绘制完成后（下一轮事件循环）回调
+class FirstFrameWatcher : public QObject {
+public:
+    FirstFrameWatcher(QWidget* widget, const char* name)
+        : QObject(widget), name(name) {
+        widget->installEventFilter(this);
+    }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override {
+        if (event->type() == QEvent::Paint && !fired) {
+            fired = true;
+            watched->removeEventFilter(this);
+            BootProfiler::instance().addInstant(name);
+            QTimer::singleShot(0, this, [this]() {
+                BootProfiler& profiler = BootProfiler::instance();
+                if (profiler.isBootProfileMode()) {
+                    profiler.writeTrace();
+                    qDebug() << "[BootProfiler] Boot profile finished, exiting";
+                    QCoreApplication::exit(0);
+                }
+                deleteLater();
+            });
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    const char* name;
+    bool fired = false;
+};
+
+}
+
+BootProfiler& BootProfiler::instance() {
+    static BootProfiler instance;
+    return instance;
+}
+
+BootProfiler::BootProfiler() : origin(std::chrono::steady_clock::now()) {
+}
+
+void BootProfiler::initialize(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--boot-profile") == 0) {
+            bootProfileMode = true;
+        }
+    }
+
+    const char* env = std::getenv("BEJEWELED_TRACE");
+    if (env && *env && std::strcmp(env, "0") != 0) {
+        enabled = true;
+        if (std::strcmp(env, "1") != 0) {
+            outputPath = env;
+        }
+    }
+    if (bootProfileMode) {
+        enabled = true;
+    }
+
+    if (enabled) {
+        events.reserve(256);
+        qDebug() << "[BootProfiler] Tracing enabled, output:" << QString::fromStdString(outputPath)
+                 << (bootProfileMode ? "(boot profile mode)" : "");
+    }
+}
+
+int64_t BootProfiler::nowUs() const {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - origin).count();
+}
+
+int BootProfiler::threadIndex() {
+    // 调用方已持有 mutex
+    auto id = std::this_thread::get_id();
+    auto it = threadIds.find(id);
+    if (it != threadIds.end()) return it->second;
+    int index = (int)threadIds.size() + 1;
+    threadIds.emplace(id, index);
+    return index;
+}
+
+void BootProfiler::addSpan(const char* name, int64_t startUs, int64_t durationUs) {
+    if (!enabled) return;
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back({name, 'X', startUs, durationUs, threadIndex()});
+}
+
+void BootProfiler::addInstant(const char* name) {
+    if (!enabled) return;
+    int64_t ts = nowUs();
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back({name, 'i', ts, 0, threadIndex()});
+}
+
+bool BootProfiler::writeTrace() {
+    if (!enabled) return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (written) return true;
+
+    nlohmann::json traceEvents = nlohmann::json::array();
+    for (const auto& [id, index] : threadIds) {
+        traceEvents.push_back({
+            {"name", "thread_name"}, {"ph", "M"}, {"pid", 1}, {"tid", index},
+            {"args", {{"name", index == 1 ? "main" : "worker-" + std::to_string(index)}}}
+        });
+    }
+    for (const TraceEvent& e : events) {
+        nlohmann::json j = {
+            {"name", e.name}, {"cat", "boot"}, {"ph", std::string(1, e.phase)},
+            {"ts", e.ts}, {"pid", 1}, {"tid", e.tid}
+        };
+        if (e.phase == 'X') j["dur"] = e.dur;
+        else j["s"] = "g";
+        traceEvents.push_back(std::move(j));
+    }
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        qDebug() << "[BootProfiler] Failed to open trace file:" << QString::fromStdString(outputPath);
+        return false;
+    }
+    out << nlohmann::json{{"traceEvents", traceEvents}, {"displayTimeUnit", "ms"}}.dump();
+    written = true;
+    qDebug() << "[BootProfiler] Wrote" << events.size() << "events to" << QString::fromStdString(outputPath);
+    return true;
+}
+
+void BootProfiler::watchFirstFrame(QWidget* widget, const char* name) {
+    if (!enabled || !widget) return;
+    new FirstFrameWatcher(widget, name);
+}
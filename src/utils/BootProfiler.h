@@ -0,0 +1,103 @@
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class QWidget;
+
+/**
+ * BootProfiler - 启动耗时打点
+ *
+ * 设置环境变量 BEJEWELED_TRACE=<输出文件>（值为 1 时输出到 boot_trace.json）
+ * 或以 --boot-profile 启动时启用，用 PROFILE_SCOPE("GameWindow::ctor/CoinSystem.load")
+ * 记录命名区间，退出时写成 Chrome trace-event JSON，可直接拖进 chrome://tracing 或 Perfetto 查看。
+ * 未启用时 PROFILE_SCOPE 只有一次布尔判断的开销。
+ *
+ * 时间原点是第一次调用 instance() 的时刻，即 main() 里处理完 --replay-headless 之后，
+ * 不包含进程加载和静态初始化。main.cpp 中的启动顺序：instance() / initialize() →
+ * main/QApplication → AuthWindow::ctor（正常登录）或 GameWindow::ctor 各段（--replay、--boot-profile
+ * 跳过登录），GameWindow 的菜单第一次绘制时记录 "MenuWidget first frame"。
+ */
+class BootProfiler {
+public:
+    static BootProfiler& instance();
+
+    // 根据环境变量和命令行参数初始化，在 QApplication 构造之前调用，这样 main/QApplication 也能记下来
+    void initialize(int argc, char* argv[]);
+
+    bool isEnabled() const { return enabled; }
+    bool isBootProfileMode() const { return bootProfileMode; }
+
+    // 距第一次调用 instance() 的微秒数
+    int64_t nowUs() const;
+
+    // 记录一个完整区间（ph = "X"）
+    void addSpan(const char* name, int64_t startUs, int64_t durationUs);
+    // 记录一个瞬时事件（ph = "i"），如 "first menu frame"
+    void addInstant(const char* name);
+
+    // 写出 trace 文件，返回是否成功
+    bool writeTrace();
+
+    // 监听 widget 的第一次绘制：记录瞬时事件，--boot-profile 模式下写出 trace 并退出程序
+    void watchFirstFrame(QWidget* widget, const char* name);
+
+private:
+    BootProfiler();
+    BootProfiler(const BootProfiler&) = delete;
+    BootProfiler& operator=(const BootProfiler&) = delete;
+
+    struct TraceEvent {
+        std::string name;
+        char phase;
+        int64_t ts;
+        int64_t dur;
+        int tid;
+    };
+
+    int threadIndex();
+
+    bool enabled = false;
+    bool bootProfileMode = false;
+    bool written = false;
+    std::string outputPath = "boot_trace.json";
+    std::chrono::steady_clock::time_point origin;
+
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    std::unordered_map<std::thread::id, int> threadIds;
+};
+
+// RAII 计时器：构造时记下起点，析构时提交区间
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* name)
+        : name(name), active(BootProfiler::instance().isEnabled()) {
+        if (active) startUs = BootProfiler::instance().nowUs();
+    }
+    ~ScopedTimer() {
+        if (active) {
+            BootProfiler& profiler = BootProfiler::instance();
+            profiler.addSpan(name, startUs, profiler.nowUs() - startUs);
+        }
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* name;
+    bool active;
+    int64_t startUs = 0;
+};
+
+#define PROFILE_SCOPE_CONCAT_INNER(a, b) a##b
+#define PROFILE_SCOPE_CONCAT(a, b) PROFILE_SCOPE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ScopedTimer PROFILE_SCOPE_CONCAT(profileScope_, __LINE__)(name)
+
+#endif // BOOT_PROFILER_H
@@ -0,0 +1,41 @@
+#include "FrameClock.h"
+#include <QTimer>
+#include <QDebug>
+#include <algorithm>
+
+FrameClock& FrameClock::instance() {
+    static FrameClock clock;
+    return clock;
+}
+
+FrameClock::FrameClock() {
+    timer = new QTimer(this);
+    timer->setTimerType(Qt::PreciseTimer);
+    timer->setInterval(kIntervalMs);
+    connect(timer, &QTimer::timeout, this, &FrameClock::onTimeout);
+}
+
+void FrameClock::acquire() {
+    if (holders++ == 0) {
+        elapsed.start();
+        timer->start();
+        qDebug() << "[FrameClock] Started";
+    }
+}
+
+void FrameClock::release() {
+    if (holders <= 0) return;
+    if (--holders == 0) {
+        timer->stop();
+        qDebug() << "[FrameClock] Stopped, no visible animations";
+    }
+}
+
+bool FrameClock::isRunning() const {
+    return timer->isActive();
+}
+
+void FrameClock::onTimeout() {
+    float dt = elapsed.restart() / 1000.0f;
+    emit tick(std::min(dt, kMaxDeltaSeconds));
+}
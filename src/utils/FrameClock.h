@@ -0,0 +1,46 @@
+#ifndef FRAME_CLOCK_H
+#define FRAME_CLOCK_H
+
+#include <QObject>
+#include <QElapsedTimer>
+
+class QTimer;
+
+/**
+ * FrameClock - 2D 界面动画共用的帧时钟
+ *
+ * 各界面原先各开一个 10~33ms 的 QTimer，节拍互相错开，主线程每秒被唤醒上百次。
+ * 现在所有需要逐帧推进的对象都连到同一个 tick 信号，一帧只唤醒一次。
+ * 只有持有者（acquire 计数 > 0）时定时器才运行，全部界面隐藏时时钟完全停下。
+ */
+class FrameClock : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int kIntervalMs = 16;
+    // 单帧最大步长：从暂停恢复或主线程卡顿后不让粒子一下跳太远
+    static constexpr float kMaxDeltaSeconds = 0.05f;
+
+    static FrameClock& instance();
+
+    // 引用计数：第一个持有者启动定时器，最后一个释放时停止
+    void acquire();
+    void release();
+    bool isRunning() const;
+
+signals:
+    // dt 为距上一帧的秒数，已限制在 kMaxDeltaSeconds 以内
+    void tick(float dt);
+
+private:
+    FrameClock();
+    FrameClock(const FrameClock&) = delete;
+    FrameClock& operator=(const FrameClock&) = delete;
+
+    void onTimeout();
+
+    QTimer* timer = nullptr;
+    QElapsedTimer elapsed;
+    int holders = 0;
+};
+
+#endif // FRAME_CLOCK_H
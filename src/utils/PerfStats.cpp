@@ -0,0 +1,52 @@
+#include "PerfStats.h"
+#include <QAbstractAnimation>
+#include <algorithm>
+
+PerfStats& PerfStats::instance() {
+    static PerfStats instance;
+    return instance;
+}
+
+void PerfStats::trackAnimation(QAbstractAnimation* animation) {
+    if (!animation) return;
+    ++liveAnimations;
+    if (animation->state() == QAbstractAnimation::Running) ++runningAnimations;
+
+    connect(animation, &QAbstractAnimation::stateChanged, this,
+        [this](QAbstractAnimation::State newState, QAbstractAnimation::State oldState) {
+            if (newState == QAbstractAnimation::Running) ++runningAnimations;
+            else if (oldState == QAbstractAnimation::Running) --runningAnimations;
+        });
+    // 析构时对象已不完整，不能再查询状态；运行中被删除的动画会先收到 Stopped
+    connect(animation, &QObject::destroyed, this, [this]() {
+        --liveAnimations;
+    });
+}
+
+void PerfStats::recordPhase(Phase phase, double ms) {
+    PhaseStat& stat = phases[phase];
+    stat.lastMs = ms;
+    stat.maxMs = std::max(stat.maxMs, ms);
+}
+
+void PerfStats::cascadeStep() {
+    if (!cascadeActive) {
+        cascadeActive = true;
+        cascadeSteps = 0;
+        cascadeTimer.start();
+    }
+    ++cascadeSteps;
+}
+
+void PerfStats::cascadeFinished() {
+    if (!cascadeActive) return;
+    cascadeActive = false;
+    lastCascadeMs = cascadeTimer.nsecsElapsed() / 1e6;
+    lastCascadeSteps = cascadeSteps;
+}
+
+void PerfStats::resetPeaks() {
+    for (PhaseStat& stat : phases) {
+        stat.maxMs = stat.lastMs;
+    }
+}
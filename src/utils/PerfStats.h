@@ -0,0 +1,101 @@
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <atomic>
+#include <chrono>
+
+class QAbstractAnimation;
+
+/**
+ * PerfStats - 运行时性能计数
+ *
+ * 汇总 PerfHud 需要展示的数据：存活的宝石实体数、QPropertyAnimation 数量、
+ * 连锁消除各阶段（eliminate / drop / resetGemstoneTable）的逻辑耗时、
+ * 一整次连锁从第一次消除到棋盘稳定的总耗时，以及最近一次网络请求的往返时间。
+ * 除网络 RTT 外都只在 UI 线程更新。
+ */
+class PerfStats : public QObject {
+    Q_OBJECT
+public:
+    enum Phase {
+        Eliminate = 0,
+        Drop,
+        Refill,
+        PhaseCount
+    };
+
+    struct PhaseStat {
+        double lastMs = 0.0;
+        double maxMs = 0.0;
+    };
+
+    static PerfStats& instance();
+
+    // 宝石实体计数（Gemstone 构造/析构时调用）
+    void gemstoneCreated() { ++liveGemstones; }
+    void gemstoneDestroyed() { --liveGemstones; }
+    int getLiveGemstones() const { return liveGemstones; }
+
+    // 登记一个动画：统计存活数量和正在运行的数量
+    void trackAnimation(QAbstractAnimation* animation);
+    int getLiveAnimations() const { return liveAnimations; }
+    int getRunningAnimations() const { return runningAnimations; }
+
+    // 连锁阶段的逻辑耗时
+    void recordPhase(Phase phase, double ms);
+    const PhaseStat& getPhase(Phase phase) const { return phases[phase]; }
+
+    // 连锁总耗时：eliminate 找到匹配时调用 cascadeStep，找不到匹配时调用 cascadeFinished
+    void cascadeStep();
+    void cascadeFinished();
+    bool isCascadeActive() const { return cascadeActive; }
+    double getLastCascadeMs() const { return lastCascadeMs; }
+    int getLastCascadeSteps() const { return lastCascadeSteps; }
+
+    // 网络往返时间（可在任意线程调用），尚无数据时返回 -1
+    void recordNetworkRtt(int ms) { lastRttMs.store(ms, std::memory_order_relaxed); }
+    int getNetworkRtt() const { return lastRttMs.load(std::memory_order_relaxed); }
+
+    // 清空峰值，HUD 上按 F3 重新打开时调用
+    void resetPeaks();
+
+private:
+    PerfStats() = default;
+    PerfStats(const PerfStats&) = delete;
+    PerfStats& operator=(const PerfStats&) = delete;
+
+    int liveGemstones = 0;
+    int liveAnimations = 0;
+    int runningAnimations = 0;
+
+    PhaseStat phases[PhaseCount];
+
+    QElapsedTimer cascadeTimer;
+    bool cascadeActive = false;
+    int cascadeSteps = 0;
+    double lastCascadeMs = 0.0;
+    int lastCascadeSteps = 0;
+
+    std::atomic<int> lastRttMs{-1};
+};
+
+// RAII 计时器：统计一个连锁阶段函数的同步逻辑耗时（不含动画播放时间）
+class PhaseTimer {
+public:
+    explicit PhaseTimer(PerfStats::Phase phase)
+        : phase(phase), start(std::chrono::steady_clock::now()) {}
+    ~PhaseTimer() {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        PerfStats::instance().recordPhase(phase, elapsed.count());
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    PerfStats::Phase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // PERF_STATS_H
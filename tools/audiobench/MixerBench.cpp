@@ -0,0 +1,167 @@
+// bejeweled_audiobench - 音效混音器基准测试
+//
+// 不依赖 Qt / 声卡，用 NullAudioSink 按真实时间节奏驱动 SfxMixer：
+//   realtime: 模拟大连锁时的触发节奏（每 --burst-gap ms 一次消除音效，外加按钮悬停音效），
+//             统计命令入队到开始混音的延迟，以及加上输出缓冲后的触发到出声延迟估计；
+//   offline : 所有声部满载时尽快混音，统计混音开销（实时倍数）。
+//
+// 用法: bejeweled_audiobench [--sounds DIR] [--type Manbo|Original] [--period FRAMES]
+//                            [--buffers N] [--seconds X] [--burst-gap MS]
+
+#include "NullAudioSink.h"
+#include "SfxMixer.h"
+#include "WavReader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::string soundDir = "resources/sounds";
+    std::string type = "Manbo";
+    int period = 256;       // 每次回调的帧数
+    int buffers = 2;        // 输出缓冲的周期数（QAudioSink 通常双缓冲）
+    double seconds = 5.0;
+    int burstGapMs = 90;    // 连锁中相邻两次消除的间隔
+};
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--sounds") == 0) {
+            options.soundDir = value();
+        } else if (std::strcmp(arg, "--type") == 0) {
+            options.type = value();
+        } else if (std::strcmp(arg, "--period") == 0) {
+            options.period = std::atoi(value());
+        } else if (std::strcmp(arg, "--buffers") == 0) {
+            options.buffers = std::atoi(value());
+        } else if (std::strcmp(arg, "--seconds") == 0) {
+            options.seconds = std::atof(value());
+        } else if (std::strcmp(arg, "--burst-gap") == 0) {
+            options.burstGapMs = std::atoi(value());
+        } else {
+            return false;
+        }
+    }
+    return options.period > 0 && options.buffers > 0 && options.seconds > 0.0 && options.burstGapMs > 0;
+}
+
+// 找不到音效文件时用 0.3 秒的衰减正弦代替，保证在任何机器上都能跑
+std::vector<int16_t> synthBlip(int sampleRate, double frequency) {
+    int frames = sampleRate * 3 / 10;
+    std::vector<int16_t> pcm((size_t)frames * 2);
+    for (int i = 0; i < frames; ++i) {
+        double t = (double)i / sampleRate;
+        double s = std::sin(2.0 * M_PI * frequency * t) * std::exp(-t * 10.0) * 0.5;
+        pcm[(size_t)i * 2] = pcm[(size_t)i * 2 + 1] = (int16_t)(s * 32767.0);
+    }
+    return pcm;
+}
+
+int loadSound(SfxMixer& mixer, const Options& options, const std::string& name, double fallbackHz, int polyphony) {
+    std::vector<int16_t> pcm;
+    std::string error;
+    std::string path = options.soundDir + "/" + name + ".wav";
+    if (!WavReader::load(path, mixer.getSampleRate(), pcm, &error)) {
+        std::fprintf(stderr, "  %s: %s, using synthetic tone\n", path.c_str(), error.c_str());
+        pcm = synthBlip(mixer.getSampleRate(), fallbackHz);
+    }
+    return mixer.addSound(std::move(pcm), 1.0f, polyphony);
+}
+
+void runRealtime(const Options& options) {
+    SfxMixer mixer;
+    std::vector<int> eliminate;
+    for (int i = 1; i <= 5; ++i) eliminate.push_back(loadSound(mixer, options, options.type + std::to_string(i), 300.0 + 80.0 * i, 3));
+    int hover = loadSound(mixer, options, "MenuButtonHover", 900.0, 2);
+
+    NullAudioSink sink(mixer, options.period);
+    sink.start();
+
+    Clock::time_point start = Clock::now();
+    Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+    int combo = 0;
+    int sent = 0;
+    while (Clock::now() < end) {
+        // 一轮 8 连消，然后停顿 400ms
+        ++combo;
+        int variant = combo < 2 ? combo % 3 : (combo % 2 == 0 ? 3 : 4);
+        mixer.play(eliminate[variant]);
+        if (combo % 3 == 0) mixer.play(hover, 0.6f);
+        sent += combo % 3 == 0 ? 2 : 1;
+        int gap = options.burstGapMs;
+        if (combo == 8) {
+            combo = 0;
+            gap += 400;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(gap));
+    }
+    // 等最后一批命令被取走
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    sink.stop();
+
+    SfxMixer::Stats stats = mixer.getStats();
+    double periodMs = 1000.0 * options.period / mixer.getSampleRate();
+    double avgQueueMs = stats.triggers ? stats.latencyTotalNs / 1e6 / stats.triggers : 0.0;
+    double maxQueueMs = stats.latencyMaxNs / 1e6;
+    double bufferMs = periodMs * options.buffers;
+    uint64_t periods = sink.getPeriods();
+
+    std::printf("realtime  period=%d frames (%.2f ms) buffers=%d\n", options.period, periodMs, options.buffers);
+    std::printf("  triggers sent/started  %d / %llu  (dropped %llu, stolen %llu)\n", sent,
+                (unsigned long long)stats.triggers, (unsigned long long)stats.dropped, (unsigned long long)stats.stolen);
+    std::printf("  queue -> mix           avg %.2f ms   max %.2f ms\n", avgQueueMs, maxQueueMs);
+    std::printf("  trigger -> sound (est) avg %.2f ms   max %.2f ms   (+%.2f ms output buffer)\n",
+                avgQueueMs + bufferMs, maxQueueMs + bufferMs, bufferMs);
+    std::printf("  render per period      avg %.1f us   max %.1f us   late periods %llu / %llu\n",
+                periods ? sink.getRenderTotalNs() / 1e3 / periods : 0.0, sink.getRenderMaxNs() / 1e3,
+                (unsigned long long)sink.getLatePeriods(), (unsigned long long)periods);
+}
+
+void runOffline(const Options& options) {
+    SfxMixer mixer;
+    // 一段 10 秒的长音，保证测量期间所有声部都处于活跃状态
+    std::vector<int16_t> pcm((size_t)mixer.getSampleRate() * 10 * 2);
+    for (size_t i = 0; i < pcm.size(); ++i) pcm[i] = (int16_t)((i * 37) % 2000 - 1000);
+    int sound = mixer.addSound(std::move(pcm), 1.0f, SfxMixer::kMaxVoices);
+    for (int i = 0; i < SfxMixer::kMaxVoices; ++i) mixer.play(sound, 0.1f);
+
+    std::vector<int16_t> out((size_t)options.period * SfxMixer::kChannels);
+    const int totalFrames = mixer.getSampleRate() * 5;
+    Clock::time_point start = Clock::now();
+    for (int done = 0; done < totalFrames; done += options.period) {
+        mixer.render(out.data(), options.period);
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    double audioSeconds = (double)totalFrames / mixer.getSampleRate();
+    std::printf("offline   %d voices, %.0f s of audio in %.3f s  (%.0fx realtime, %.2f%% of one core)\n",
+                mixer.getActiveVoices(), audioSeconds, seconds, audioSeconds / seconds, 100.0 * seconds / audioSeconds);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "usage: %s [--sounds DIR] [--type Manbo|Original] [--period FRAMES]\n"
+                     "          [--buffers N] [--seconds X] [--burst-gap MS]\n", argv[0]);
+        return 2;
+    }
+    std::printf("bejeweled_audiobench: sounds=%s type=%s\n", options.soundDir.c_str(), options.type.c_str());
+    runRealtime(options);
+    runOffline(options);
+    return 0;
+}
@@ -0,0 +1,264 @@
+// bejeweled_bench - 棋盘逻辑吞吐基准测试
+//
+// 不依赖 Qt / Qt3D，直接在 Board 上用随机合法操作打大量对局，统计：
+//   moves/s、cascades/s（每秒消除轮数）、每步的堆分配次数、单步耗时分位数。
+// 每次优化棋盘逻辑前后各跑一次，对比同一种子下的结果。
+// 解谜模式的题目由 PuzzleGenerator 倒推生成（与界面相同），随机走法常常走进死路，
+// 所以死局分两列：reshuf 是经典/旋风模式的自动重排次数，stuck 是解谜模式没清空就无步可走的局数。
+//
+// 用法: bejeweled_bench [--mode classic|whirlwind|puzzle|all] [--games N]
+//                       [--max-moves N] [--difficulty N] [--seed N]
+
+#include "Board.h"
+#include "GameRng.h"
+#include "PuzzleGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// 分配计数：替换全局 operator new，只在计时的操作区间内读取差值
+// ============================================================================
+static uint64_t gAllocCount = 0;
+
+void* operator new(std::size_t size) {
+    ++gAllocCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kPuzzleLevels = 4;  // 倒推生成器在第 4 关以后题目规模不再变化
+
+// 对数分桶的延迟直方图：每个 2 的幂区间再分 16 档，误差 < 7%，内存固定
+class LatencyHistogram {
+public:
+    void record(uint64_t ns) {
+        ++buckets[indexOf(ns)];
+        ++count;
+        if (ns > maxNs) maxNs = ns;
+    }
+
+    uint64_t percentile(double p) const {
+        if (count == 0) return 0;
+        uint64_t target = (uint64_t)std::ceil(p / 100.0 * (double)count);
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += buckets[i];
+            if (seen >= target) return upperBound(i);
+        }
+        return maxNs;
+    }
+
+    uint64_t getMax() const { return maxNs; }
+
+private:
+    static constexpr int kSubBits = 4;
+    static constexpr int kBuckets = 64 << kSubBits;
+
+    static int indexOf(uint64_t ns) {
+        if (ns < (1u << kSubBits)) return (int)ns;
+        int exp = 63 - __builtin_clzll(ns);
+        int sub = (int)((ns >> (exp - kSubBits)) & ((1u << kSubBits) - 1));
+        return ((exp - kSubBits + 1) << kSubBits) + sub;
+    }
+
+    static uint64_t upperBound(int index) {
+        if (index < (1 << kSubBits)) return (uint64_t)index;
+        int exp = (index >> kSubBits) + kSubBits - 1;
+        uint64_t sub = (uint64_t)(index & ((1 << kSubBits) - 1));
+        return ((1ull << kSubBits) + sub + 1) << (exp - kSubBits);
+    }
+
+    std::array<uint64_t, kBuckets> buckets{};
+    uint64_t count = 0;
+    uint64_t maxNs = 0;
+};
+
+struct Options {
+    std::string mode = "all";
+    long long games = 20000;  // 每个模式的局数，做完整基线时用 --games 1000000
+    int maxMoves = 300;
+    int difficulty = 6;
+    uint64_t seed = 20240601;
+};
+
+struct ModeResult {
+    long long games = 0;
+    long long finishedGames = 0;
+    long long moves = 0;
+    long long cascadeSteps = 0;
+    long long reshuffles = 0;   // 经典/旋风模式没有可走步而重排棋盘的次数
+    long long stuckGames = 0;   // 解谜模式没清空棋盘就无步可走的局数
+    long long totalScore = 0;
+    uint64_t allocs = 0;        // 只统计执行操作期间的分配
+    double applySeconds = 0.0;  // 只统计执行操作的时间
+    double wallSeconds = 0.0;   // 包括找可走步和开局
+    LatencyHistogram latency;
+};
+
+// 计时执行一步操作
+template <typename Fn>
+bool timedApply(ModeResult& result, Fn&& apply) {
+    uint64_t allocsBefore = gAllocCount;
+    Clock::time_point start = Clock::now();
+    bool applied = apply();
+    Clock::time_point end = Clock::now();
+    uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    if (applied) {
+        result.allocs += gAllocCount - allocsBefore;
+        result.applySeconds += ns * 1e-9;
+        result.latency.record(ns);
+        ++result.moves;
+    }
+    return applied;
+}
+
+void playGame(BoardMode mode, const Options& options, uint64_t seed, ModeResult& result) {
+    GameRng rng(seed);
+    Board board(mode, options.difficulty);
+    if (mode == BoardMode::Puzzle) {
+        // Board 不负责出题，和界面一样用 PuzzleGenerator 倒推生成
+        PuzzleGenerator generator(options.difficulty, rng);
+        generator.generate(1 + rng.bounded(kPuzzleLevels));
+        board.loadTypes(generator.getTypes());
+    } else {
+        board.generate(rng);
+    }
+
+    Board::MoveList moves;
+    for (int step = 0; step < options.maxMoves && !board.isFinished(); ++step) {
+        if (mode == BoardMode::Whirlwind) {
+            int count = board.findRotateMoves(moves);
+            // 旋风模式任何旋转都合法，没有能消除的旋转时随便转一个
+            Board::Move move = count > 0 ? moves[rng.bounded(count)]
+                                         : Board::Move{(int8_t)rng.bounded(Board::kSize - 1), (int8_t)rng.bounded(Board::kSize - 1), 0, 0};
+            timedApply(result, [&]() { return board.rotate(move.row1, move.col1, rng); });
+            continue;
+        }
+
+        int count = board.findSwapMoves(moves);
+        if (count == 0) {
+            // 解谜模式无步可走即结束；其余模式连锁后的死局由 Board 自动重排，这里只剩开局死局
+            if (mode == BoardMode::Puzzle) {
+                ++result.stuckGames;
+                break;
+            }
+            board.reshuffle(rng);
+            continue;
+        }
+        const Board::Move& move = moves[rng.bounded(count)];
+        timedApply(result, [&]() { return board.swap(move.row1, move.col1, move.row2, move.col2, rng); });
+    }
+
+    ++result.games;
+    if (board.isFinished()) ++result.finishedGames;
+    result.totalScore += board.getScore();
+    result.cascadeSteps += board.getStats().cascadeSteps;
+    result.reshuffles += board.getStats().reshuffles;
+}
+
+ModeResult runMode(BoardMode mode, const Options& options) {
+    ModeResult result;
+    // 每局的种子由总种子派生，换模式、换局数都不影响单局结果
+    GameRng seeds(options.seed ^ (uint64_t)mode);
+    Clock::time_point start = Clock::now();
+    for (long long i = 0; i < options.games; ++i) {
+        playGame(mode, options, seeds.deriveSeed(), result);
+    }
+    result.wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+const char* modeName(BoardMode mode) {
+    switch (mode) {
+        case BoardMode::Classic: return "classic";
+        case BoardMode::Whirlwind: return "whirlwind";
+        case BoardMode::Puzzle: return "puzzle";
+        case BoardMode::Multiplayer: return "multiplayer";
+    }
+    return "?";
+}
+
+void printResult(BoardMode mode, const ModeResult& r) {
+    double moves = (double)std::max(1LL, r.moves);
+    double us = 1e-3;
+    std::printf("%-10s %9lld %11lld %12.0f %12.0f %8.2f %8.2f %8.2f %8.2f %8.2f %9.2f  %6.1f%% %9.1f %8lld %8lld %8.2fs\n",
+                modeName(mode), r.games, r.moves,
+                r.moves / std::max(1e-9, r.applySeconds),
+                r.cascadeSteps / std::max(1e-9, r.applySeconds),
+                r.allocs / moves,
+                r.latency.percentile(50) * us, r.latency.percentile(90) * us,
+                r.latency.percentile(99) * us, r.latency.percentile(99.9) * us,
+                r.latency.getMax() * us,
+                100.0 * r.finishedGames / std::max(1LL, r.games),
+                (double)r.totalScore / std::max(1LL, r.games),
+                r.reshuffles, r.stuckGames, r.wallSeconds);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+        if (std::strcmp(argv[i], "--mode") == 0) {
+            options.mode = value();
+        } else if (std::strcmp(argv[i], "--games") == 0) {
+            options.games = std::atoll(value());
+        } else if (std::strcmp(argv[i], "--max-moves") == 0) {
+            options.maxMoves = std::atoi(value());
+        } else if (std::strcmp(argv[i], "--difficulty") == 0) {
+            options.difficulty = std::atoi(value());
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            options.seed = std::strtoull(value(), nullptr, 10);
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--mode classic|whirlwind|puzzle|all] [--games N] [--max-moves N]"
+                         " [--difficulty N] [--seed N]\n", argv[0]);
+            return false;
+        }
+    }
+    return options.games > 0 && options.maxMoves > 0 && options.difficulty >= Board::kMinDifficulty &&
+           options.difficulty <= Board::kMaxDifficulty;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) return 2;
+
+    std::vector<BoardMode> modes;
+    if (options.mode == "all" || options.mode == "classic") modes.push_back(BoardMode::Classic);
+    if (options.mode == "all" || options.mode == "whirlwind") modes.push_back(BoardMode::Whirlwind);
+    if (options.mode == "all" || options.mode == "puzzle") modes.push_back(BoardMode::Puzzle);
+    if (modes.empty()) {
+        std::fprintf(stderr, "unknown mode: %s\n", options.mode.c_str());
+        return 2;
+    }
+
+    std::printf("bejeweled_bench: games=%lld max-moves=%d difficulty=%d seed=%llu\n",
+                options.games, options.maxMoves, options.difficulty, (unsigned long long)options.seed);
+    std::printf("%-10s %9s %11s %12s %12s %8s %8s %8s %8s %8s %9s  %7s %9s %8s %8s %9s\n",
+                "mode", "games", "moves", "moves/s", "cascades/s", "alloc/mv",
+                "p50us", "p90us", "p99us", "p999us", "maxus", "finished", "avgScore", "reshuf", "stuck", "wall");
+    for (BoardMode mode : modes) {
+        ModeResult result = runMode(mode, options);
+        printResult(mode, result);
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,390 @@
+// bejeweled_calibrate - 多线程蒙特卡洛难度标定
+//
+// 在 Board 上用机器人（随机 / 贪心 / 两步前瞻）按难度（宝石种类数）批量打局，输出：
+//   分数分布（十分位）、达到目标分需要的步数和估算时间、死局频率、金币宝石产出。
+// 对局按批次分给工作窃取线程池，每局的种子只由 (总种子, 难度, 局号) 决定，
+// 线程数不同结果也完全一致。
+//
+// 用法: bejeweled_calibrate [--mode classic|whirlwind] [--bot random|greedy|lookahead]
+//                           [--difficulties 4,5,6,7] [--games N] [--target N] [--max-moves N]
+//                           [--threads N] [--seed N] [--think-seconds X] [--scaling]
+
+#include "Board.h"
+#include "GameRng.h"
+#include "../common/WorkStealingPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 估算真实游戏时间用的动画时长，取自各 *ModeGameWidget 的定时器
+constexpr double kSwapSeconds = 0.3;          // 交换动画
+constexpr double kRotateSeconds = 0.55;       // 旋风模式旋转后 550ms 检查匹配
+constexpr double kCascadeStepSeconds = 0.9;   // 消除 600ms + 下落/补充动画
+constexpr int kTimeBucketSeconds = 5;
+constexpr int kScoreBucket = 50;
+constexpr int kMaxCoinsTracked = 255;
+constexpr size_t kGamesPerTask = 64;
+
+enum class Bot { Random, Greedy, Lookahead };
+
+struct Options {
+    BoardMode mode = BoardMode::Classic;
+    Bot bot = Bot::Greedy;
+    std::vector<int> difficulties = {4, 5, 6, 7};
+    long long games = 20000;
+    int target = 0;  // 0 表示使用模式默认目标分
+    int maxMoves = 400;
+    unsigned threads = 0;
+    uint64_t seed = 20240601;
+    double thinkSeconds = 1.5;  // 玩家每步的思考时间
+    bool scaling = false;
+};
+
+// 按桶计数的分布，支持合并和分位数
+class Histogram {
+public:
+    Histogram(int bucketCount = 1, int bucketWidth = 1) : counts(bucketCount, 0), width(bucketWidth) {}
+
+    void add(long long value) {
+        long long index = std::max(0LL, value / width);
+        ++counts[(size_t)std::min<long long>(index, (long long)counts.size() - 1)];
+        ++total;
+    }
+
+    void merge(const Histogram& other) {
+        for (size_t i = 0; i < counts.size(); ++i) counts[i] += other.counts[i];
+        total += other.total;
+    }
+
+    // 返回所在桶的下界
+    long long percentile(double p) const {
+        if (total == 0) return 0;
+        long long target = std::max(1LL, (long long)(p / 100.0 * (double)total + 0.5));
+        long long seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= target) return (long long)i * width;
+        }
+        return (long long)(counts.size() - 1) * width;
+    }
+
+    long long getTotal() const { return total; }
+
+private:
+    std::vector<long long> counts;
+    int width;
+    long long total = 0;
+};
+
+struct Stats {
+    long long games = 0;
+    long long finishedGames = 0;
+    long long moves = 0;
+    long long cascadeSteps = 0;
+    long long deadBoards = 0;
+    long long coins = 0;
+    Histogram finalScore;
+    Histogram movesToTarget;   // 只统计达到目标分的对局
+    Histogram timeToTarget;    // 秒
+    Histogram coinsPerGame;
+
+    Stats() = default;
+    Stats(int target, int maxMoves)
+        : finalScore(target / kScoreBucket + 40, kScoreBucket),
+          movesToTarget(maxMoves + 1, 1),
+          timeToTarget(3600 / kTimeBucketSeconds + 1, kTimeBucketSeconds),
+          coinsPerGame(kMaxCoinsTracked + 1, 1) {}
+
+    void merge(const Stats& other) {
+        games += other.games;
+        finishedGames += other.finishedGames;
+        moves += other.moves;
+        cascadeSteps += other.cascadeSteps;
+        deadBoards += other.deadBoards;
+        coins += other.coins;
+        finalScore.merge(other.finalScore);
+        movesToTarget.merge(other.movesToTarget);
+        timeToTarget.merge(other.timeToTarget);
+        coinsPerGame.merge(other.coinsPerGame);
+    }
+};
+
+// 在棋盘副本上试走一步，返回得分增量；simRng 是机器人自己的随机流，看不到真实的补充宝石
+int simulateGain(const Board& board, const Board::Move& move, BoardMode mode, const GameRng& simRng, Board* after = nullptr) {
+    Board copy = board;
+    GameRng rng = simRng;
+    bool applied = mode == BoardMode::Whirlwind ? copy.rotate(move.row1, move.col1, rng)
+                                                : copy.swap(move.row1, move.col1, move.row2, move.col2, rng);
+    if (!applied) return -1;
+    if (after) *after = copy;
+    return copy.getScore() - board.getScore();
+}
+
+int findMoves(const Board& board, BoardMode mode, Board::MoveList& moves) {
+    return mode == BoardMode::Whirlwind ? board.findRotateMoves(moves) : board.findSwapMoves(moves);
+}
+
+// 选出下一步，返回 false 表示没有能消除的步
+bool chooseMove(const Board& board, const Options& options, GameRng& botRng, Board::Move& chosen) {
+    Board::MoveList moves;
+    int count = findMoves(board, options.mode, moves);
+    if (count == 0) return false;
+    if (options.bot == Bot::Random) {
+        chosen = moves[botRng.bounded(count)];
+        return true;
+    }
+
+    GameRng simRng(botRng.deriveSeed());
+    int bestValue = -1;
+    int ties = 0;
+    Board after(options.mode, board.getDifficulty());
+    for (int i = 0; i < count; ++i) {
+        int value = simulateGain(board, moves[i], options.mode, simRng,
+                                 options.bot == Bot::Lookahead ? &after : nullptr);
+        if (value < 0) continue;
+
+        if (options.bot == Bot::Lookahead && !after.isFinished()) {
+            // 两步前瞻：加上走完这一步后最好的下一步
+            Board::MoveList next;
+            int nextCount = findMoves(after, options.mode, next);
+            int bestNext = 0;
+            for (int j = 0; j < nextCount; ++j) {
+                bestNext = std::max(bestNext, simulateGain(after, next[j], options.mode, simRng));
+            }
+            value += bestNext;
+        }
+
+        // 同分的步之间等概率选择（蓄水池抽样）
+        if (value > bestValue) {
+            bestValue = value;
+            chosen = moves[i];
+            ties = 1;
+        } else if (value == bestValue && botRng.bounded(++ties) == 0) {
+            chosen = moves[i];
+        }
+    }
+    return bestValue >= 0;
+}
+
+uint64_t gameSeed(uint64_t seed, int difficulty, long long index) {
+    return seed ^ ((uint64_t)difficulty << 56) ^ (uint64_t)index * 0x9E3779B97F4A7C15ull;
+}
+
+void playGame(const Options& options, int difficulty, int target, long long index, Stats& stats) {
+    GameRng rng(gameSeed(options.seed, difficulty, index));
+    GameRng botRng(rng.deriveSeed());
+    Board board(options.mode, difficulty);
+    board.generate(rng);
+    board.setTargetScore(target);
+
+    double seconds = 0.0;
+    int moves = 0;
+    double moveSeconds = options.thinkSeconds + (options.mode == BoardMode::Whirlwind ? kRotateSeconds : kSwapSeconds);
+    while (moves < options.maxMoves && !board.isFinished()) {
+        Board::Move move;
+        if (!chooseMove(board, options, botRng, move)) {
+            if (options.mode == BoardMode::Whirlwind) {
+                // 旋风模式任何旋转都合法
+                move = {(int8_t)botRng.bounded(Board::kSize - 1), (int8_t)botRng.bounded(Board::kSize - 1), 0, 0};
+            } else {
+                // 连锁后的死局 Board 会自动重排，这里只剩开局就是死局的情况
+                board.reshuffle(rng);
+                continue;
+            }
+        }
+
+        int stepsBefore = board.getStats().cascadeSteps;
+        if (options.mode == BoardMode::Whirlwind) {
+            board.rotate(move.row1, move.col1, rng);
+        } else {
+            board.swap(move.row1, move.col1, move.row2, move.col2, rng);
+        }
+        ++moves;
+        seconds += moveSeconds + (board.getStats().cascadeSteps - stepsBefore) * kCascadeStepSeconds;
+    }
+
+    ++stats.games;
+    stats.moves += moves;
+    stats.cascadeSteps += board.getStats().cascadeSteps;
+    stats.deadBoards += board.getStats().reshuffles;
+    stats.coins += board.getEarnedCoins();
+    stats.finalScore.add(board.getScore());
+    stats.coinsPerGame.add(board.getEarnedCoins());
+    if (board.isFinished()) {
+        ++stats.finishedGames;
+        stats.movesToTarget.add(moves);
+        stats.timeToTarget.add((long long)seconds);
+    }
+}
+
+Stats runDifficulty(WorkStealingPool& pool, const Options& options, int difficulty, int target) {
+    std::vector<Stats> perWorker(pool.size(), Stats(target, options.maxMoves));
+    pool.parallelFor((size_t)options.games, kGamesPerTask, [&](size_t begin, size_t end, unsigned worker) {
+        Stats& stats = perWorker[worker];
+        for (size_t i = begin; i < end; ++i) playGame(options, difficulty, target, (long long)i, stats);
+    });
+
+    Stats total(target, options.maxMoves);
+    for (const Stats& stats : perWorker) total.merge(stats);
+    return total;
+}
+
+void printHeader() {
+    std::printf("%4s %8s %7s | %5s %5s %5s | %6s %6s | %6s %6s %6s | %8s | %6s %5s | %6s\n",
+                "diff", "games", "reach%", "mv10", "mv50", "mv90", "t50s", "t90s",
+                "sc10", "sc50", "sc90", "dead/100", "coins", "c90", "casc/mv");
+}
+
+void printStats(int difficulty, const Stats& s) {
+    double games = (double)std::max(1LL, s.games);
+    double moves = (double)std::max(1LL, s.moves);
+    std::printf("%4d %8lld %6.1f%% | %5lld %5lld %5lld | %6lld %6lld | %6lld %6lld %6lld | %8.2f | %6.2f %5lld | %6.2f\n",
+                difficulty, s.games, 100.0 * s.finishedGames / games,
+                s.movesToTarget.percentile(10), s.movesToTarget.percentile(50), s.movesToTarget.percentile(90),
+                s.timeToTarget.percentile(50), s.timeToTarget.percentile(90),
+                s.finalScore.percentile(10), s.finalScore.percentile(50), s.finalScore.percentile(90),
+                100.0 * s.deadBoards / moves,
+                s.coins / games, s.coinsPerGame.percentile(90),
+                s.cascadeSteps / moves);
+}
+
+// 分数分布：十分位
+void printDeciles(int difficulty, const Stats& s) {
+    std::printf("  d=%d score deciles:", difficulty);
+    for (int p = 10; p <= 90; p += 10) std::printf(" %lld", s.finalScore.percentile(p));
+    std::printf("\n");
+}
+
+std::vector<int> parseList(const char* text) {
+    std::vector<int> values;
+    std::string item;
+    for (const char* p = text;; ++p) {
+        if (*p == ',' || *p == '\0') {
+            if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+            item.clear();
+            if (*p == '\0') break;
+        } else {
+            item += *p;
+        }
+    }
+    return values;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--mode") == 0) {
+            std::string mode = value();
+            if (mode == "classic") options.mode = BoardMode::Classic;
+            else if (mode == "whirlwind") options.mode = BoardMode::Whirlwind;
+            else return false;
+        } else if (std::strcmp(arg, "--bot") == 0) {
+            std::string bot = value();
+            if (bot == "random") options.bot = Bot::Random;
+            else if (bot == "greedy") options.bot = Bot::Greedy;
+            else if (bot == "lookahead") options.bot = Bot::Lookahead;
+            else return false;
+        } else if (std::strcmp(arg, "--difficulties") == 0) {
+            options.difficulties = parseList(value());
+        } else if (std::strcmp(arg, "--games") == 0) {
+            options.games = std::atoll(value());
+        } else if (std::strcmp(arg, "--target") == 0) {
+            options.target = std::atoi(value());
+        } else if (std::strcmp(arg, "--max-moves") == 0) {
+            options.maxMoves = std::atoi(value());
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = (unsigned)std::atoi(value());
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.seed = std::strtoull(value(), nullptr, 10);
+        } else if (std::strcmp(arg, "--think-seconds") == 0) {
+            options.thinkSeconds = std::atof(value());
+        } else if (std::strcmp(arg, "--scaling") == 0) {
+            options.scaling = true;
+        } else {
+            return false;
+        }
+    }
+    if (options.games <= 0 || options.maxMoves <= 0 || options.difficulties.empty()) return false;
+    for (int difficulty : options.difficulties) {
+        if (difficulty < Board::kMinDifficulty || difficulty > Board::kMaxDifficulty) return false;
+    }
+    return true;
+}
+
+// 同一批对局分别用 1, 2, 4 ... N 个线程跑，检查吞吐是否线性增长
+void runScaling(const Options& options, int target) {
+    unsigned maxThreads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::printf("\nscaling (difficulty %d, %lld games):\n", options.difficulties.front(), options.games);
+    std::printf("%8s %10s %8s %10s\n", "threads", "games/s", "speedup", "efficiency");
+    double baseRate = 0.0;
+    for (unsigned threads = 1;; threads = std::min(maxThreads, threads * 2)) {
+        WorkStealingPool pool(threads);
+        Clock::time_point start = Clock::now();
+        runDifficulty(pool, options, options.difficulties.front(), target);
+        double rate = options.games / std::chrono::duration<double>(Clock::now() - start).count();
+        if (threads == 1) baseRate = rate;
+        std::printf("%8u %10.0f %7.2fx %9.1f%%\n", threads, rate, rate / baseRate, 100.0 * rate / baseRate / threads);
+        std::fflush(stdout);
+        if (threads == maxThreads) break;
+    }
+}
+
+const char* botName(Bot bot) {
+    switch (bot) {
+        case Bot::Random: return "random";
+        case Bot::Greedy: return "greedy";
+        case Bot::Lookahead: return "lookahead";
+    }
+    return "?";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "usage: %s [--mode classic|whirlwind] [--bot random|greedy|lookahead]\n"
+                     "          [--difficulties 4,5,6,7] [--games N] [--target N] [--max-moves N]\n"
+                     "          [--threads N] [--seed N] [--think-seconds X] [--scaling]\n", argv[0]);
+        return 2;
+    }
+
+    int target = options.target > 0 ? options.target : Board(options.mode).getTargetScore();
+    WorkStealingPool pool(options.threads);
+    std::printf("bejeweled_calibrate: mode=%s bot=%s target=%d games=%lld max-moves=%d threads=%u seed=%llu\n",
+                options.mode == BoardMode::Whirlwind ? "whirlwind" : "classic", botName(options.bot),
+                target, options.games, options.maxMoves, pool.size(), (unsigned long long)options.seed);
+    std::printf("reach%%: games reaching the target; mvNN / tNNs: moves / estimated seconds to target (percentiles);\n"
+                "scNN: final score percentiles; dead/100: board resets per 100 moves; coins: coin value per game\n\n");
+    printHeader();
+
+    Clock::time_point start = Clock::now();
+    long long totalGames = 0;
+    std::vector<Stats> results;
+    for (int difficulty : options.difficulties) {
+        results.push_back(runDifficulty(pool, options, difficulty, target));
+        printStats(difficulty, results.back());
+        std::fflush(stdout);
+        totalGames += results.back().games;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("\n");
+    for (size_t i = 0; i < results.size(); ++i) printDeciles(options.difficulties[i], results[i]);
+    std::printf("\n%lld games in %.2fs (%.0f games/s, %u threads)\n", totalGames, seconds, totalGames / seconds, pool.size());
+
+    if (options.scaling) runScaling(options, target);
+    return 0;
+}
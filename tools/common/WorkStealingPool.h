@@ -0,0 +1,156 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * WorkStealingPool - 离线工具用的工作窃取线程池
+ *
+ * 每个工作线程有自己的任务队列：自己从队尾取（刚提交的任务缓存更热），
+ * 空了就从其他线程的队首偷。任务粒度为一批对局（几百局），队列锁的开销可以忽略，
+ * 各线程把统计写进自己的槽位，最后再合并，线程数增加时吞吐基本线性增长。
+ */
+class WorkStealingPool {
+public:
+    // 参数为执行任务的工作线程编号 [0, size())
+    using Task = std::function<void(unsigned worker)>;
+
+    explicit WorkStealingPool(unsigned threadCount = 0) {
+        if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+        queues.reserve(threadCount);
+        for (unsigned i = 0; i < threadCount; ++i) queues.push_back(std::make_unique<Queue>());
+        workers.reserve(threadCount);
+        for (unsigned i = 0; i < threadCount; ++i) {
+            workers.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            stopping = true;
+        }
+        wakeCv.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return (unsigned)workers.size(); }
+
+    // 工作线程内提交的任务进自己的队列，外部提交的轮流分到各队列
+    void submit(Task task) {
+        unsigned index = currentWorker() >= 0 ? (unsigned)currentWorker()
+                                              : nextQueue.fetch_add(1, std::memory_order_relaxed) % size();
+        pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queues[index]->mutex);
+            queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            ++wakeEpoch;
+        }
+        wakeCv.notify_one();
+    }
+
+    // 阻塞到目前提交的所有任务完成（不能在工作线程里调用）
+    void wait() {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        doneCv.wait(lock, [this]() { return pending.load(std::memory_order_acquire) == 0; });
+    }
+
+    // 把 [0, count) 按 chunk 切成任务并等待完成，fn(begin, end, worker)
+    template <typename Fn>
+    void parallelFor(size_t count, size_t chunk, Fn fn) {
+        if (chunk == 0) chunk = 1;
+        for (size_t begin = 0; begin < count; begin += chunk) {
+            size_t end = std::min(count, begin + chunk);
+            submit([fn, begin, end](unsigned worker) { fn(begin, end, worker); });
+        }
+        wait();
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    static int& currentWorker() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    bool popLocal(unsigned index, Task& task) {
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned thief, Task& task) {
+        unsigned count = size();
+        for (unsigned offset = 1; offset < count; ++offset) {
+            Queue& queue = *queues[(thief + offset) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned index) {
+        currentWorker() = (int)index;
+        for (;;) {
+            uint64_t epoch;
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                epoch = wakeEpoch;
+            }
+
+            Task task;
+            if (popLocal(index, task) || steal(index, task)) {
+                task(index);
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(wakeMutex);
+                    doneCv.notify_all();
+                }
+                continue;
+            }
+
+            // 所有队列都空：等到有新任务提交（epoch 变化）或线程池析构
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wakeCv.wait(lock, [this, epoch]() { return stopping || wakeEpoch != epoch; });
+            if (stopping) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending{0};
+    std::atomic<unsigned> nextQueue{0};
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+    uint64_t wakeEpoch = 0;
+    bool stopping = false;
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,197 @@
+// bejeweled_levelpack - 解谜关卡包编译器
+//
+// 由 regenerate_level_pack 目标运行，输出提交到 resources/levels/：按难度批量倒推生成解谜题目（与界面相同的 PuzzleGenerator），
+// 用 PuzzleSolver 证明可解并求出最少步数，按评级排序、去重后均匀抽取若干关，
+// 写成 LevelPack 二进制包。界面运行时直接映射这个文件，按 (难度, 关卡) 取题。
+// 每个候选题目的种子只由 (总种子, 难度, 序号) 决定，线程数不同输出也完全一致。
+//
+// 用法: bejeweled_levelpack --out FILE [--difficulties 4,6,8] [--levels N]
+//                           [--candidates N] [--threads N] [--seed N]
+
+#include "LevelPack.h"
+#include "PuzzleGenerator.h"
+#include "PuzzleSolver.h"
+#include "GameRng.h"
+#include "../common/WorkStealingPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kCandidatesPerTask = 32;
+constexpr int kGeneratorLevels = 4;  // 倒推生成器在第 4 关以后题目规模不再变化
+
+struct Options {
+    std::string out;
+    std::vector<int> difficulties = {4, 6, 8};
+    int levels = 200;           // 每个难度写入的关卡数
+    long long candidates = 4000;  // 每个难度生成的候选题目数
+    unsigned threads = 0;
+    uint64_t seed = 20240601;
+};
+
+// 评级：先看最少步数，再看求解器的搜索量（分支多、陷阱多的题目更难）
+uint16_t gradeOf(int optimalMoves, long long nodes) {
+    int effort = std::min(99, (int)(8.0 * std::log2(1.0 + (double)nodes)));
+    return (uint16_t)std::min(65535, optimalMoves * 100 + effort);
+}
+
+struct DifficultyResult {
+    LevelPack::Group group;
+    long long candidates = 0;
+    long long solved = 0;
+    long long unique = 0;
+};
+
+DifficultyResult compileDifficulty(WorkStealingPool& pool, const Options& options, int difficulty) {
+    std::vector<std::vector<LevelPack::LevelRecord>> perWorker(pool.size());
+    std::vector<long long> solvedPerWorker(pool.size(), 0);
+
+    pool.parallelFor((size_t)options.candidates, kCandidatesPerTask, [&](size_t begin, size_t end, unsigned worker) {
+        PuzzleSolver solver;
+        for (size_t i = begin; i < end; ++i) {
+            GameRng rng(options.seed ^ ((uint64_t)difficulty << 56) ^ ((uint64_t)i * 0x9E3779B97F4A7C15ull));
+            PuzzleGenerator generator(difficulty, rng);
+            int budget = generator.generate(1 + (int)(i % kGeneratorLevels));
+            std::array<int8_t, Board::kCells> types = generator.getTypes();
+
+            PuzzleSolver::Result result = solver.solve(types, difficulty, budget);
+            if (result.status != PuzzleSolver::Status::Solved) continue;
+
+            LevelPack::LevelRecord record = LevelPack::LevelRecord::fromTypes(types);
+            record.optimalMoves = (uint8_t)result.moves;
+            record.gemCount = (uint8_t)generator.getGemCount();
+            record.solverNodes = (uint32_t)std::min<long long>(result.nodes, UINT32_MAX);
+            record.grade = gradeOf(result.moves, result.nodes);
+            perWorker[worker].push_back(record);
+            ++solvedPerWorker[worker];
+        }
+    });
+
+    DifficultyResult result;
+    result.group.difficulty = difficulty;
+    result.candidates = options.candidates;
+    std::vector<LevelPack::LevelRecord> all;
+    for (size_t w = 0; w < perWorker.size(); ++w) {
+        all.insert(all.end(), perWorker[w].begin(), perWorker[w].end());
+        result.solved += solvedPerWorker[w];
+    }
+
+    // 按 (评级, 棋盘) 排序后去重，输出与线程调度无关
+    auto less = [](const LevelPack::LevelRecord& a, const LevelPack::LevelRecord& b) {
+        if (a.grade != b.grade) return a.grade < b.grade;
+        return std::memcmp(a.cells, b.cells, sizeof(a.cells)) < 0;
+    };
+    auto same = [](const LevelPack::LevelRecord& a, const LevelPack::LevelRecord& b) {
+        return std::memcmp(a.cells, b.cells, sizeof(a.cells)) == 0;
+    };
+    std::sort(all.begin(), all.end(), less);
+    all.erase(std::unique(all.begin(), all.end(), same), all.end());
+    result.unique = (long long)all.size();
+
+    // 在从易到难的序列上均匀抽取，关卡号越大越难
+    int count = std::min<int>(options.levels, (int)all.size());
+    for (int k = 0; k < count; ++k) {
+        size_t index = count == 1 ? 0 : (size_t)((double)k * (double)(all.size() - 1) / (double)(count - 1) + 0.5);
+        result.group.levels.push_back(all[index]);
+    }
+    return result;
+}
+
+std::vector<int> parseList(const char* text) {
+    std::vector<int> values;
+    std::string item;
+    for (const char* p = text;; ++p) {
+        if (*p == ',' || *p == '\0') {
+            if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+            item.clear();
+            if (*p == '\0') break;
+        } else {
+            item += *p;
+        }
+    }
+    return values;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--out") == 0) {
+            options.out = value();
+        } else if (std::strcmp(arg, "--difficulties") == 0) {
+            options.difficulties = parseList(value());
+        } else if (std::strcmp(arg, "--levels") == 0) {
+            options.levels = std::atoi(value());
+        } else if (std::strcmp(arg, "--candidates") == 0) {
+            options.candidates = std::atoll(value());
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            options.threads = (unsigned)std::atoi(value());
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            options.seed = std::strtoull(value(), nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+    if (options.out.empty() || options.levels <= 0 || options.candidates <= 0 || options.difficulties.empty()) return false;
+    for (int difficulty : options.difficulties) {
+        if (difficulty < Board::kMinDifficulty || difficulty > Board::kMaxDifficulty) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "usage: %s --out FILE [--difficulties 4,6,8] [--levels N]\n"
+                     "          [--candidates N] [--threads N] [--seed N]\n", argv[0]);
+        return 2;
+    }
+
+    WorkStealingPool pool(options.threads);
+    std::printf("bejeweled_levelpack: levels=%d candidates=%lld threads=%u seed=%llu\n",
+                options.levels, options.candidates, pool.size(), (unsigned long long)options.seed);
+    std::printf("%4s %10s %8s %8s %7s | %5s %5s %5s | %6s %6s\n",
+                "diff", "candidates", "solved%", "unique", "levels", "mvMin", "mvMed", "mvMax", "grade0", "gradeN");
+
+    Clock::time_point start = Clock::now();
+    std::vector<LevelPack::Group> groups;
+    for (int difficulty : options.difficulties) {
+        DifficultyResult result = compileDifficulty(pool, options, difficulty);
+        const std::vector<LevelPack::LevelRecord>& levels = result.group.levels;
+        if (levels.empty()) {
+            std::fprintf(stderr, "no solvable levels for difficulty %d\n", difficulty);
+            return 1;
+        }
+        std::vector<int> moves;
+        for (const LevelPack::LevelRecord& record : levels) moves.push_back(record.optimalMoves);
+        std::sort(moves.begin(), moves.end());
+        std::printf("%4d %10lld %7.1f%% %8lld %7zu | %5d %5d %5d | %6u %6u\n",
+                    difficulty, result.candidates, 100.0 * result.solved / result.candidates, result.unique,
+                    levels.size(), moves.front(), moves[moves.size() / 2], moves.back(),
+                    levels.front().grade, levels.back().grade);
+        std::fflush(stdout);
+        groups.push_back(std::move(result.group));
+    }
+
+    if (!LevelPack::writeFile(options.out, groups)) {
+        std::fprintf(stderr, "cannot write %s\n", options.out.c_str());
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::printf("\nwrote %s in %.2fs\n", options.out.c_str(), seconds);
+    return 0;
+}
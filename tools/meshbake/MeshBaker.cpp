@@ -0,0 +1,152 @@
+// bejeweled_meshbake - 宝石模型预处理
+//
+// 构建时运行：把 resources/<风格>/gem_type_N.obj 解析成 MeshData，做顶点缓存与顶点读取顺序优化，
+// 可选生成聚类简化的 LOD，位置/法线量化后写成 MeshBinary (.gmsh)。
+// 运行时 GemMeshLibrary 映射 .gmsh，不再解析文本。每个文件顺带对比 OBJ 解析与 .gmsh 加载的耗时。
+//
+// 用法: bejeweled_meshbake [--lods N] [--no-optimize] [--runs N] IN.obj OUT.gmsh [IN.obj OUT.gmsh ...]
+
+#include "MeshBinary.h"
+#include "ObjParser.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    MeshBinary::BakeOptions bake;
+    int runs = 5;  // 计时取中位数，0 表示不计时
+    std::vector<std::pair<std::string, std::string>> files;
+};
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; ++i) {
+        auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : ""; };
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--lods") == 0) {
+            options.bake.lodCount = std::atoi(value());
+        } else if (std::strcmp(arg, "--no-optimize") == 0) {
+            options.bake.optimize = false;
+        } else if (std::strcmp(arg, "--runs") == 0) {
+            options.runs = std::atoi(value());
+        } else if (arg[0] == '-') {
+            return false;
+        } else {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.empty() || positional.size() % 2 != 0) return false;
+    if (options.bake.lodCount < 1 || options.bake.lodCount > 4 || options.runs < 0) return false;
+    for (size_t i = 0; i < positional.size(); i += 2) options.files.emplace_back(positional[i], positional[i + 1]);
+    return true;
+}
+
+bool readFile(const std::string& path, std::string& data) {
+    // 整块读入，接近运行时映射文件的开销
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) return false;
+    data.resize((size_t)file.tellg());
+    file.seekg(0);
+    return (bool)file.read(data.data(), (std::streamsize)data.size());
+}
+
+template <typename F>
+double medianMs(int runs, F&& body) {
+    std::vector<double> samples;
+    for (int run = 0; run < runs; ++run) {
+        Clock::time_point start = Clock::now();
+        body();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr,
+                     "usage: %s [--lods 1-4] [--no-optimize] [--runs N] IN.obj OUT.gmsh [IN.obj OUT.gmsh ...]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    if (options.runs > 0) {
+        std::printf("%-36s %6s %6s %8s %8s %5s %5s %8s %8s %6s  %s\n", "file", "verts", "tris", "objKB", "gmshKB",
+                    "acmr0", "acmr", "objMs", "gmshMs", "speed", "lods");
+    }
+    double totalObjMs = 0.0;
+    double totalBinMs = 0.0;
+    for (const auto& [input, output] : options.files) {
+        std::string objText;
+        if (!readFile(input, objText)) {
+            std::fprintf(stderr, "cannot read %s\n", input.c_str());
+            return 1;
+        }
+        MeshData mesh;
+        std::string error;
+        if (!ObjParser::parse(objText.data(), objText.size(), mesh, &error)) {
+            std::fprintf(stderr, "%s: %s\n", input.c_str(), error.c_str());
+            return 1;
+        }
+
+        MeshBinary::BakeReport report;
+        std::vector<uint8_t> baked = MeshBinary::bake(mesh, options.bake, &report);
+
+        std::filesystem::path outPath(output);
+        if (outPath.has_parent_path()) std::filesystem::create_directories(outPath.parent_path());
+        std::ofstream file(output, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(baked.data()), (std::streamsize)baked.size())) {
+            std::fprintf(stderr, "cannot write %s\n", output.c_str());
+            return 1;
+        }
+        file.close();
+        if (options.runs == 0) continue;
+
+        // 两边都从读文件算起，.gmsh 一侧包含校验和位置还原（与运行时加载相同的工作量）
+        double objMs = medianMs(options.runs, [&]() {
+            MeshData parsed;
+            ObjParser::load(input, parsed, nullptr);
+        });
+        double binMs = medianMs(options.runs, [&]() {
+            std::string data;
+            readFile(output, data);
+            MeshBinary::View view;
+            if (!view.open(reinterpret_cast<const uint8_t*>(data.data()), data.size())) return;
+            std::vector<float> positions((size_t)view.vertexCount() * 3);
+            view.decodePositions(positions.data());
+        });
+        totalObjMs += objMs;
+        totalBinMs += binMs;
+
+        std::string lods;
+        for (uint32_t triangles : report.lodTriangles) lods += (lods.empty() ? "" : "/") + std::to_string(triangles);
+        std::string name = std::filesystem::path(input).parent_path().filename().string() + "/" +
+                           std::filesystem::path(input).filename().string();
+        std::printf("%-36s %6d %6zu %8.1f %8.1f %5.2f %5.2f %8.3f %8.3f %5.1fx  %s\n", name.c_str(),
+                    mesh.vertexCount(), mesh.indices.size() / 3, objText.size() / 1024.0, baked.size() / 1024.0,
+                    report.acmrBefore, report.acmrAfter, objMs, binMs, binMs > 0.0 ? objMs / binMs : 0.0,
+                    lods.c_str());
+    }
+
+    if (options.runs > 0 && options.files.size() > 1) {
+        std::printf("\ntotal: obj %.2f ms, gmsh %.2f ms (%.1fx)\n", totalObjMs, totalBinMs,
+                    totalBinMs > 0.0 ? totalObjMs / totalBinMs : 0.0);
+    }
+    return 0;
+}